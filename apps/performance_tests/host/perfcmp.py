@@ -0,0 +1,338 @@
+#!/usr/bin/env python3
+"""perfcmp: performance baseline store and regression comparator.
+
+Reads the results of the performance tests, either the serial log of the
+target ("perf report json" prints the PERF-ENV / PERF-JSON lines, the
+openloop test the PERF-CURVE lines) or the JSON output of the POSIX
+qpbench ("qpbench -f json"). A log may contain several runs, every
+PERF-ENV line starts a new one.
+
+    perfcmp.py store   BASEDIR RUN...   add the runs to the baseline
+    perfcmp.py show    BASEDIR          summarize the baseline
+    perfcmp.py compare BASEDIR RUN...   compare the runs with the baseline
+
+"compare" tests every metric of every case with the one-sided Mann-Whitney
+U test, over the values of the repeated runs (or over the raw samples of
+qpbench -r, when there are fewer than --min-runs runs). A metric regressed
+when the shift is significant (p <= --alpha) AND the medians differ by
+more than --threshold. The exit status is 1 when any metric regressed,
+0 when none did and 2 on errors.
+"""
+
+import argparse
+import glob
+import json
+import math
+import os
+import sys
+import time
+
+# metrics where a larger value is better; all other metrics are times
+HIGHER_IS_BETTER = ("rate", "achieved")
+
+DEFAULT_METRICS = "p50,p90,mean,rate"
+
+# environment keys that legitimately change between runs
+ENV_VOLATILE = ("build", "date")
+
+
+# ---------------------------------------------------------------------------
+# reading the results
+
+def _run(env, source):
+    return {"env": env, "source": source, "cases": {}}
+
+
+def _case_key(bench, param):
+    return "%s[%s]" % (bench, param) if param else bench
+
+
+def parse_log(text, source):
+    """Runs in a serial log with PERF-ENV/PERF-JSON lines."""
+    runs = []
+    for line in text.splitlines():
+        for tag in ("PERF-ENV ", "PERF-JSON ", "PERF-CURVE "):
+            pos = line.find(tag)
+            if pos >= 0:
+                break
+        else:
+            continue
+        try:
+            obj = json.loads(line[pos + len(tag):])
+        except ValueError:
+            sys.stderr.write("%s: garbled line skipped: %s\n" % (source, line))
+            continue
+        if tag == "PERF-ENV ":
+            runs.append(_run(obj, source))
+            continue
+        if not runs:
+            runs.append(_run({}, source))
+        name = obj.pop("name")
+        if tag == "PERF-CURVE ":  # one case per point of the curve
+            name = _case_key(name, "offered=%d" % obj.pop("offered"))
+        runs[-1]["cases"][name] = obj
+    return runs
+
+
+def parse_qpbench(doc, source):
+    """Run in the JSON output of qpbench."""
+    run = _run(doc.get("env", {}), source)
+    for res in doc.get("results", []):
+        res = dict(res)
+        key = _case_key(res.pop("bench"), res.pop("param", ""))
+        run["cases"][key] = res
+    return [run]
+
+
+def read_runs(path):
+    with open(path) as f:
+        text = f.read()
+    try:
+        doc = json.loads(text)
+    except ValueError:
+        doc = None
+    if isinstance(doc, dict) and "cases" in doc:   # stored baseline run
+        return [doc]
+    if isinstance(doc, dict) and "results" in doc:
+        return parse_qpbench(doc, path)
+    runs = parse_log(text, path)
+    if not runs:
+        raise ValueError("%s: no performance results found" % path)
+    return runs
+
+
+def read_all(paths):
+    runs = []
+    for path in paths:
+        runs.extend(read_runs(path))
+    return runs
+
+
+def read_baseline(basedir):
+    paths = sorted(glob.glob(os.path.join(basedir, "run-*.json")))
+    return [r for p in paths for r in read_runs(p)]
+
+
+def env_diff(a, b):
+    keys = set(a) | set(b)
+    return sorted(k for k in keys
+                  if k not in ENV_VOLATILE and a.get(k) != b.get(k))
+
+
+# ---------------------------------------------------------------------------
+# statistics
+
+def median(xs):
+    s = sorted(xs)
+    n = len(s)
+    return s[n // 2] if n % 2 else 0.5 * (s[n // 2 - 1] + s[n // 2])
+
+
+def _ranks(values):
+    order = sorted(range(len(values)), key=values.__getitem__)
+    ranks = [0.0] * len(values)
+    ties = []
+    i = 0
+    while i < len(order):
+        j = i
+        while j + 1 < len(order) and values[order[j + 1]] == values[order[i]]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[order[k]] = 0.5 * (i + j) + 1.0
+        if j > i:
+            ties.append(j - i + 1)
+        i = j + 1
+    return ranks, ties
+
+
+def _exact_upper(u, n1, n2):
+    """P(U >= u) for the U statistic of n1 vs. n2 values without ties."""
+    # cnt[k] = number of arrangements with U == k (built up for growing n1)
+    rows = [[1] for _ in range(n2 + 1)]  # n1 == 0: U is always 0
+    for a in range(1, n1 + 1):
+        new = [[1]]                       # n2 == 0: U is always 0
+        for b in range(1, n2 + 1):
+            # the largest value is either from the 1st sample (adds b)
+            # or from the 2nd one (adds nothing)
+            x, y = rows[b], new[b - 1]
+            cnt = [0] * (a * b + 1)
+            for k, c in enumerate(x):
+                cnt[k + b] += c
+            for k, c in enumerate(y):
+                cnt[k] += c
+            new.append(cnt)
+        rows = new
+    cnt = rows[n2]
+    total = sum(cnt)
+    k0 = int(math.ceil(u))
+    return sum(cnt[k0:]) / total if k0 < len(cnt) else 0.0
+
+
+def mann_whitney_greater(xs, ys):
+    """One-sided p-value of the hypothesis that ys tend to exceed xs."""
+    n1, n2 = len(ys), len(xs)
+    ranks, ties = _ranks(list(ys) + list(xs))
+    u = sum(ranks[:n1]) - n1 * (n1 + 1) / 2.0
+    if not ties and n1 * n2 <= 400:
+        return _exact_upper(u, n1, n2)
+    n = n1 + n2
+    mu = n1 * n2 / 2.0
+    tie = sum(t * t * t - t for t in ties)
+    var = n1 * n2 / 12.0 * ((n + 1) - tie / float(n * (n - 1)))
+    if var <= 0.0:
+        return 1.0
+    z = (u - mu - 0.5) / math.sqrt(var)
+    return 0.5 * math.erfc(z / math.sqrt(2.0))
+
+
+# ---------------------------------------------------------------------------
+# commands
+
+def cmd_store(args):
+    runs = read_all(args.runs)
+    os.makedirs(args.basedir, exist_ok=True)
+    base = read_baseline(args.basedir)
+    stamp = time.strftime("%Y%m%d-%H%M%S")
+    for i, run in enumerate(runs):
+        if base:
+            diff = env_diff(base[0]["env"], run["env"])
+            if diff:
+                sys.stderr.write("warning: %s differs from the baseline in: %s\n"
+                                 % (run["source"], ", ".join(diff)))
+        path = os.path.join(args.basedir, "run-%s-%03d.json" % (stamp, i))
+        with open(path, "w") as f:
+            json.dump(run, f, indent=1, sort_keys=True)
+    print("stored %d run(s), the baseline has %d"
+          % (len(runs), len(base) + len(runs)))
+    return 0
+
+
+def _values(runs, key, metric):
+    return [r["cases"][key][metric] for r in runs
+            if key in r["cases"] and metric in r["cases"][key]]
+
+
+def _samples(runs, key):
+    out = []
+    for r in runs:
+        out.extend(r["cases"].get(key, {}).get("samples", []))
+    return out
+
+
+def cmd_show(args):
+    base = read_baseline(args.basedir)
+    if not base:
+        sys.stderr.write("%s: empty baseline\n" % args.basedir)
+        return 2
+    print("%d run(s), env: %s" % (len(base), json.dumps(base[0]["env"])))
+    keys = sorted({k for r in base for k in r["cases"]})
+    metrics = args.metrics.split(",")
+    print("%-28s %-6s %5s  %s" % ("case", "metric", "runs", "median [min..max]"))
+    for key in keys:
+        for m in metrics:
+            xs = _values(base, key, m)
+            if xs:
+                print("%-28s %-6s %5d  %g [%g..%g]"
+                      % (key, m, len(xs), median(xs), min(xs), max(xs)))
+    return 0
+
+
+def cmd_compare(args):
+    base = read_baseline(args.basedir)
+    new = read_all(args.runs)
+    if not base:
+        sys.stderr.write("%s: empty baseline\n" % args.basedir)
+        return 2
+    diff = env_diff(base[0]["env"], new[0]["env"])
+    if diff:
+        sys.stderr.write("warning: environment differs from the baseline in: %s\n"
+                         % ", ".join(diff))
+
+    metrics = args.metrics.split(",")
+    keys = sorted({k for r in base for k in r["cases"]}
+                  & {k for r in new for k in r["cases"]})
+    if not keys:
+        sys.stderr.write("no common test cases in the baseline and the runs\n")
+        return 2
+
+    regressed = 0
+    print("%-28s %-6s %12s %12s %8s %9s  %s"
+          % ("case", "metric", "base", "new", "change", "p", "verdict"))
+    for key in keys:
+        for m in metrics:
+            xs, ys = _values(base, key, m), _values(new, key, m)
+            if not xs or not ys:
+                continue
+            mb, mn = median(xs), median(ys)
+            change = (mn - mb) / mb if mb else 0.0
+            higher = m in HIGHER_IS_BETTER
+            if min(len(xs), len(ys)) >= args.min_runs:
+                dx, dy, how = xs, ys, ""
+            else:
+                dx, dy, how = _samples(base, key), _samples(new, key), " (samples)"
+                if m not in ("p50", "mean") or not dx or not dy:
+                    print("%-28s %-6s %12g %12g %+7.1f%% %9s  too few runs"
+                          % (key, m, mb, mn, 100.0 * change, "-"))
+                    continue
+            if higher:
+                p_worse = mann_whitney_greater(dy, dx)
+                p_better = mann_whitney_greater(dx, dy)
+                worse = -change
+            else:
+                p_worse = mann_whitney_greater(dx, dy)
+                p_better = mann_whitney_greater(dy, dx)
+                worse = change
+            if p_worse <= args.alpha and worse > args.threshold:
+                verdict, p = "REGRESSION", p_worse
+                regressed += 1
+            elif p_better <= args.alpha and -worse > args.threshold:
+                verdict, p = "improved", p_better
+            else:
+                verdict, p = "ok", min(p_worse, p_better)
+            print("%-28s %-6s %12g %12g %+7.1f%% %9.2g  %s%s"
+                  % (key, m, mb, mn, 100.0 * change, p, verdict, how))
+
+    print("%d regression(s) at alpha=%g, threshold=%g%%"
+          % (regressed, args.alpha, 100.0 * args.threshold))
+    return 1 if regressed else 0
+
+
+def main(argv=None):
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    sub = ap.add_subparsers(dest="cmd")
+    sub.required = True
+
+    p = sub.add_parser("store", help="add runs to the baseline")
+    p.add_argument("basedir")
+    p.add_argument("runs", nargs="+")
+    p.set_defaults(fun=cmd_store)
+
+    p = sub.add_parser("show", help="summarize the baseline")
+    p.add_argument("basedir")
+    p.add_argument("-m", "--metrics", default=DEFAULT_METRICS)
+    p.set_defaults(fun=cmd_show)
+
+    p = sub.add_parser("compare", help="compare runs with the baseline")
+    p.add_argument("basedir")
+    p.add_argument("runs", nargs="+")
+    p.add_argument("-m", "--metrics", default=DEFAULT_METRICS,
+                   help="comma-separated metrics (default %(default)s)")
+    p.add_argument("-a", "--alpha", type=float, default=0.05,
+                   help="significance level (default %(default)s)")
+    p.add_argument("-t", "--threshold", type=float, default=0.05,
+                   help="minimum relative change (default %(default)s)")
+    p.add_argument("--min-runs", type=int, default=3,
+                   help="runs per side to test the run values "
+                        "(default %(default)s)")
+    p.set_defaults(fun=cmd_compare)
+
+    args = ap.parse_args(argv)
+    try:
+        return args.fun(args)
+    except (IOError, OSError, ValueError, KeyError) as err:
+        sys.stderr.write("perfcmp: %s\n" % err)
+        return 2
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -54,6 +54,9 @@ enum PerformanceAppSignals {
     TIMER_REPORT_SIG,
     TIMER_TIMEOUT_SIG,
 
+    /* Open-loop load signals */
+    LOAD_SIG,
+
     /* Application control signals */
     APP_START_SIG,
     APP_STOP_SIG,
@@ -66,6 +69,13 @@ enum PerformanceAppSignals {
 /* Performance Test Events */
 /*==========================================================================*/
 
+/* Load event of the open-loop load test (tests/openloop_test.c) */
+typedef struct {
+    QEvt super;             /* inherits QEvt */
+    rt_uint32_t intended;   /* intended send time [cycles] */
+    rt_uint32_t posted;     /* actual send time [cycles] */
+} PerfLoadEvt;
+
 /*==========================================================================*/
 /* Global Synchronization Objects */
 /*==========================================================================*/
@@ -4,6 +4,26 @@ extern "C" {
 
 #include <rtthread.h>
 
+/*
+ * Resolution of the per-test sample histogram: each power-of-two range of
+ * the sample values is split into 2^PERF_TEST_HIST_SUB_BITS buckets, so the
+ * percentiles are accurate to 1/2^(PERF_TEST_HIST_SUB_BITS+1) of the value.
+ */
+#ifndef PERF_TEST_HIST_SUB_BITS
+#define PERF_TEST_HIST_SUB_BITS 3
+#endif
+#define PERF_TEST_HIST_BUCKETS \
+    ((33 - PERF_TEST_HIST_SUB_BITS) << PERF_TEST_HIST_SUB_BITS)
+
+/* Histogram of sample values, for the percentiles */
+typedef struct {
+    rt_uint32_t count;
+    rt_uint32_t min;
+    rt_uint32_t max;
+    rt_uint64_t sum;
+    rt_uint16_t bucket[PERF_TEST_HIST_BUCKETS];
+} perf_hist_t;
+
 /* Performance Test Statistics Structure */
 typedef struct {
     /* Common statistics */
@@ -13,6 +33,10 @@ typedef struct {
     rt_uint32_t max_value;
     rt_uint32_t avg_value;
 
+    /* Sample distribution (filled by perf_test_sample()) */
+    perf_hist_t hist;
+    const char *unit;                   /*< Unit of the samples, e.g. "cycles" */
+
     /* Latency specific */
     rt_uint32_t total_latency;
 
@@ -76,6 +100,7 @@ typedef struct perf_test_case {
     rt_uint32_t      iterations;        /*< Operation count for performance statistics */
     int              result_code;       /*< Return value from run() */
     perf_test_stats_t stats;            /*< Detailed test statistics */
+    perf_test_func_t  report_json;      /*< Optional extra lines for perf_test_report_json() */
 } perf_test_case_t;
 
 /*
@@ -136,4 +161,57 @@ rt_int32_t  perf_test_restart(const char *name);
  */
 void perf_test_report(void);
 
+/*
+ * Clear a histogram.
+ */
+void perf_hist_reset(perf_hist_t *h);
+
+/*
+ * Add one sample value to a histogram.
+ */
+void perf_hist_add(perf_hist_t *h, rt_uint32_t value);
+
+/*
+ * Add one sample value measured by a closed loop that issues a request
+ * every interval, correcting for coordinated omission: a sample longer than
+ * the interval also adds the latencies of the requests that the loop did
+ * not issue while it was stalled (value - interval, value - 2*interval...).
+ */
+void perf_hist_add_corrected(perf_hist_t *h, rt_uint32_t value,
+                             rt_uint32_t interval);
+
+/*
+ * Return the p-th percentile (p in 1..999 per mille) of a histogram,
+ * or 0 when the histogram is empty.
+ */
+rt_uint32_t perf_hist_percentile(const perf_hist_t *h, rt_uint32_t p);
+
+/*
+ * Record one sample of a test (e.g. the latency of one operation).
+ * Updates measurements, min/max/avg and the histogram used for percentiles.
+ * The unit of the samples is stats.unit ("cycles" when left RT_NULL).
+ */
+void perf_test_sample(perf_test_case_t *tc, rt_uint32_t value);
+
+/*
+ * Record one sample of a closed-loop test that issues a request every
+ * interval, with the coordinated-omission correction of
+ * perf_hist_add_corrected() (interval 0: same as perf_test_sample()).
+ */
+void perf_test_sample_corrected(perf_test_case_t *tc, rt_uint32_t value,
+                                rt_uint32_t interval);
+
+/*
+ * Return the p-th percentile (p in 1..999 per mille) of the samples recorded
+ * with perf_test_sample(), or 0 when the test has no samples.
+ */
+rt_uint32_t perf_test_percentile(const perf_test_case_t *tc, rt_uint32_t p);
+
+/*
+ * Print the results of the finished test cases in the serialized format
+ * read by the host comparator (host/perfcmp.py): one "PERF-ENV" line with
+ * the environment fingerprint, followed by one "PERF-JSON" line per test.
+ */
+void perf_test_report_json(void);
+
 #endif /* PERF_TEST_H_ */
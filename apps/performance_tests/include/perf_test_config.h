@@ -42,6 +42,24 @@
 #define MEMORY_TEST_MAX_ALLOCATED       20480
 #define MEMORY_TEST_FAILURES            0
 
+/* Open-loop Load Test Configuration */
+#define OPENLOOP_ARRIVAL_CONST          0   /* fixed inter-arrival time */
+#define OPENLOOP_ARRIVAL_POISSON        1   /* exponential inter-arrival time */
+#define OPENLOOP_ARRIVAL_BURST          2   /* OPENLOOP_BURST_LEN back-to-back */
+#define OPENLOOP_ARRIVAL                OPENLOOP_ARRIVAL_POISSON
+#define OPENLOOP_BURST_LEN              16
+#define OPENLOOP_RATE_MIN               500     /* events/s of the 1st step */
+#define OPENLOOP_RATE_MAX               64000   /* rate doubles every step */
+#define OPENLOOP_STEP_MS                1000
+#define OPENLOOP_DRAIN_MS               500
+#define OPENLOOP_SINKS                  2
+#define OPENLOOP_SINK_PRIO              2       /* QF priority of the 1st sink */
+#define OPENLOOP_SINK_WORK_CYCLES       2000    /* busy-work per event */
+#define OPENLOOP_QUEUE_LEN              32
+#define OPENLOOP_POOL_SIZE              64
+#define OPENLOOP_MAX_PER_TICK           64      /* posts per generator tick */
+#define OPENLOOP_GEN_PRIORITY           1       /* RT-Thread prio of generator */
+
 /* DWT (Data Watchpoint and Trace) Configuration */
 #define DWT_CTRL_ADDR                   0xE0001000
 #define DWT_CYCCNT_ADDR                 0xE0001004
@@ -0,0 +1,242 @@
+/*============================================================================
+* QP/C Real-Time Embedded Framework (RTEF)
+* Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+*
+* SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+*
+* This software is dual-licensed under the terms of the open source GNU
+* General Public License version 3 (or any later version), or alternatively,
+* under the terms of one of the closed source Quantum Leaps commercial
+* licenses.
+*
+* The terms of the open source GNU General Public License version 3
+* can be found at: <www.gnu.org/licenses/gpl-3.0>
+*
+* The terms of the closed source Quantum Leaps commercial licenses
+* can be found at: <www.state-machine.com/licensing>
+*
+* Redistributions in source code must retain this top-level comment block.
+* Plagiarizing this software to sidestep the license obligations is illegal.
+*
+* Contact information:
+* <www.state-machine.com>
+* <info@state-machine.com>
+============================================================================*/
+/*!
+* @date Last updated on: 2026-10-18
+* @version Last updated for: @ref qpc_7_2_2
+*
+* @file
+* @brief qpbench: active-object benchmarks (ping-pong and publish fan-out)
+*/
+#include "qpc.h"
+#include "qpbench.h"
+
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <stdio.h>
+
+Q_DEFINE_THIS_FILE
+
+#define PING_WARMUP  100U /* round-trips not recorded */
+#define FANOUT_WIN   16U  /* # events published per sample */
+#define AO_QLEN      (2U * FANOUT_WIN)
+
+/*..........................................................................*/
+typedef struct {
+    QActive super;
+    uint32_t nRounds;  /* # round-trips to perform */
+    uint32_t round;    /* current round-trip */
+    uint64_t t0;       /* time-stamp of the last PING */
+} Ping;
+
+typedef struct {
+    QActive super;
+} Pong;
+
+typedef struct {
+    QActive super;
+} Sub;
+
+static QState Ping_initial(Ping * const me, void const * const par);
+static QState Ping_active(Ping * const me, QEvt const * const e);
+static QState Pong_initial(Pong * const me, void const * const par);
+static QState Pong_active(Pong * const me, QEvt const * const e);
+static QState Sub_initial(Sub * const me, void const * const par);
+static QState Sub_active(Sub * const me, QEvt const * const e);
+
+static Ping l_ping;
+static Pong l_pong;
+static Sub  l_sub[QPB_SUBS_MAX];
+
+static QEvt const l_startEvt = QEVT_INITIALIZER(START_SIG);
+static QEvt const l_pingEvt  = QEVT_INITIALIZER(PING_SIG);
+static QEvt const l_pongEvt  = QEVT_INITIALIZER(PONG_SIG);
+
+static sem_t l_done;                   /* signaled by the AOs to the driver */
+static atomic_uint_fast32_t l_nRecv;   /* # FANOUT_SIG events received */
+static atomic_uint_fast32_t l_nTarget; /* l_nRecv that completes a sample */
+
+static QSubscrList l_subscrSto[MAX_PUB_SIG];
+
+/*..........................................................................*/
+void QPB_startAOs(void) {
+    static QEvt const *pingQSto[AO_QLEN];
+    static QEvt const *pongQSto[AO_QLEN];
+    static QEvt const *subQSto[QPB_SUBS_MAX][AO_QLEN];
+    uint_fast8_t n;
+
+    sem_init(&l_done, 0, 0U);
+    QActive_psInit(l_subscrSto, Q_DIM(l_subscrSto));
+
+    QActive_ctor(&l_ping.super, Q_STATE_CAST(&Ping_initial));
+    QActive_ctor(&l_pong.super, Q_STATE_CAST(&Pong_initial));
+    QACTIVE_START(&l_ping.super, 2U, pingQSto, Q_DIM(pingQSto),
+                  (void *)0, 0U, (void *)0);
+    QACTIVE_START(&l_pong.super, 1U, pongQSto, Q_DIM(pongQSto),
+                  (void *)0, 0U, (void *)0);
+
+    for (n = 0U; n < QPB_SUBS_MAX; ++n) {
+        QActive_ctor(&l_sub[n].super, Q_STATE_CAST(&Sub_initial));
+        QACTIVE_START(&l_sub[n].super, 3U + n, subQSto[n], AO_QLEN,
+                      (void *)0, 0U, (void *)0);
+    }
+}
+/*..........................................................................*/
+/* round-trip time of an event from the Ping AO to the Pong AO and back */
+void QPB_pingPong(void) {
+    uint32_t const n = QPB_nSamples();
+
+    l_ping.nRounds = PING_WARMUP + n;
+    QACTIVE_POST(&l_ping.super, &l_startEvt, (void *)0);
+    sem_wait(&l_done);
+
+    QPB_report("ao.pingpong", "", "ns", QPB_samples(), n);
+}
+/*..........................................................................*/
+/* cost of publishing an event to a growing number of subscribers, each
+* sample is the time from publishing a window of FANOUT_WIN events until
+* all the subscribers processed them, divided by FANOUT_WIN
+*/
+void QPB_fanOut(void) {
+    uint32_t const n = QPB_nSamples();
+    double * const samples = QPB_samples();
+    uint_fast8_t nSubs = 0U;
+    uint_fast8_t k;
+
+    for (k = 1U; k <= QPB_SUBS_MAX; k *= 2U) {
+        char param[16];
+        uint32_t i;
+
+        for (; nSubs < k; ++nSubs) {
+            QActive_subscribe(&l_sub[nSubs].super, FANOUT_SIG);
+        }
+        for (i = 0U; i < n; ++i) {
+            uint_fast32_t const nRecv = atomic_load(&l_nRecv);
+            uint64_t const t0 = QPB_now();
+            uint_fast8_t w;
+
+            atomic_store(&l_nTarget, nRecv + (k * FANOUT_WIN));
+            for (w = 0U; w < FANOUT_WIN; ++w) {
+                QEvt *e = Q_NEW(QEvt, FANOUT_SIG);
+                QACTIVE_PUBLISH(e, (void *)0);
+            }
+            sem_wait(&l_done);
+            samples[i] = (double)(QPB_now() - t0) / (double)FANOUT_WIN;
+        }
+        snprintf(param, sizeof(param), "subs=%u", (unsigned)k);
+        QPB_report("ao.fanout", param, "ns", samples, n);
+    }
+    for (k = 0U; k < nSubs; ++k) {
+        QActive_unsubscribeAll(&l_sub[k].super);
+    }
+}
+
+/*..........................................................................*/
+static QState Ping_initial(Ping * const me, void const * const par) {
+    Q_UNUSED_PAR(par);
+    me->nRounds = 0U;
+    me->round = 0U;
+    return Q_TRAN(&Ping_active);
+}
+/*..........................................................................*/
+static QState Ping_active(Ping * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case START_SIG: {
+            me->round = 0U;
+            me->t0 = QPB_now();
+            QACTIVE_POST(&l_pong.super, &l_pingEvt, &me->super);
+            status_ = Q_HANDLED();
+            break;
+        }
+        case PONG_SIG: {
+            uint64_t const t1 = QPB_now();
+            if (me->round >= PING_WARMUP) {
+                QPB_samples()[me->round - PING_WARMUP]
+                    = (double)(t1 - me->t0);
+            }
+            ++me->round;
+            if (me->round < me->nRounds) {
+                me->t0 = QPB_now();
+                QACTIVE_POST(&l_pong.super, &l_pingEvt, &me->super);
+            }
+            else {
+                sem_post(&l_done);
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState Pong_initial(Pong * const me, void const * const par) {
+    Q_UNUSED_PAR(par);
+    return Q_TRAN(&Pong_active);
+}
+/*..........................................................................*/
+static QState Pong_active(Pong * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case PING_SIG: {
+            QACTIVE_POST(&l_ping.super, &l_pongEvt, &me->super);
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState Sub_initial(Sub * const me, void const * const par) {
+    Q_UNUSED_PAR(par);
+    return Q_TRAN(&Sub_active);
+}
+/*..........................................................................*/
+static QState Sub_active(Sub * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case FANOUT_SIG: {
+            if ((atomic_fetch_add(&l_nRecv, 1U) + 1U)
+                == atomic_load(&l_nTarget))
+            {
+                sem_post(&l_done); /* the last event of the window */
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
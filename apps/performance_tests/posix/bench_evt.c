@@ -0,0 +1,120 @@
+/*============================================================================
+* QP/C Real-Time Embedded Framework (RTEF)
+* Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+*
+* SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+*
+* This software is dual-licensed under the terms of the open source GNU
+* General Public License version 3 (or any later version), or alternatively,
+* under the terms of one of the closed source Quantum Leaps commercial
+* licenses.
+*
+* The terms of the open source GNU General Public License version 3
+* can be found at: <www.gnu.org/licenses/gpl-3.0>
+*
+* The terms of the closed source Quantum Leaps commercial licenses
+* can be found at: <www.state-machine.com/licensing>
+*
+* Redistributions in source code must retain this top-level comment block.
+* Plagiarizing this software to sidestep the license obligations is illegal.
+*
+* Contact information:
+* <www.state-machine.com>
+* <info@state-machine.com>
+============================================================================*/
+/*!
+* @date Last updated on: 2026-10-18
+* @version Last updated for: @ref qpc_7_2_2
+*
+* @file
+* @brief qpbench: event-pool and time-event benchmarks
+*/
+#include "qpc.h"
+#include "qpbench.h"
+
+#include <stdio.h>
+
+#define POOL_LEN   128U  /* # blocks in every event pool */
+#define TE_MAX     1024U /* max # armed time events */
+#define TE_RATE    1U    /* tick rate of the time events (not ticked by QF) */
+
+/* event sizes allocated from the 3 event pools */
+static uint_fast16_t const l_poolEvtSize[3] = {
+    sizeof(QEvt), 32U, 64U
+};
+
+static QTimeEvt l_te[TE_MAX];
+static QActive  l_teOwner; /* owner of the time events, never posted to */
+
+/*..........................................................................*/
+void QPB_poolInit(void) {
+    static QF_MPOOL_EL(QEvt) pool1Sto[POOL_LEN];
+    static uint64_t pool2Sto[POOL_LEN * 32U / sizeof(uint64_t)];
+    static uint64_t pool3Sto[POOL_LEN * 64U / sizeof(uint64_t)];
+
+    QF_poolInit(pool1Sto, sizeof(pool1Sto), sizeof(pool1Sto[0]));
+    QF_poolInit(pool2Sto, sizeof(pool2Sto), 32U);
+    QF_poolInit(pool3Sto, sizeof(pool3Sto), 64U);
+}
+/*..........................................................................*/
+/* cost of a Q_NEW()/QF_gc() pair from the 1st, 2nd and 3rd event pool
+* (the pool is selected by a linear search over the pool block sizes)
+*/
+void QPB_pool(void) {
+    uint32_t const n = QPB_nSamples();
+    double * const samples = QPB_samples();
+    uint_fast8_t p;
+
+    for (p = 0U; p < Q_DIM(l_poolEvtSize); ++p) {
+        char param[16];
+        uint32_t i;
+
+        for (i = 0U; i < n; ++i) {
+            uint64_t const t0 = QPB_now();
+            uint_fast16_t k;
+            for (k = 0U; k < QPB_BATCH; ++k) {
+                QEvt const * const e = QF_newX_(l_poolEvtSize[p],
+                                                QF_NO_MARGIN, FANOUT_SIG);
+                QF_gc(e);
+            }
+            samples[i] = (double)(QPB_now() - t0) / (double)QPB_BATCH;
+        }
+        snprintf(param, sizeof(param), "pool=%u", (unsigned)(p + 1U));
+        QPB_report("evt.new_gc", param, "ns", samples, n);
+    }
+}
+/*..........................................................................*/
+/* cost of one clock tick vs. the number of armed time events, which never
+* expire during the measurement
+*/
+void QPB_timeEvt(void) {
+    static uint16_t const armed[] = { 0U, 1U, 16U, 128U, TE_MAX };
+    uint32_t const n = QPB_nSamples();
+    double * const samples = QPB_samples();
+    uint_fast16_t nArmed = 0U;
+    uint_fast8_t a;
+
+    for (a = 0U; a < Q_DIM(armed); ++a) {
+        char param[16];
+        uint32_t i;
+
+        for (; nArmed < armed[a]; ++nArmed) {
+            QTimeEvt_ctorX(&l_te[nArmed], &l_teOwner, TIMEOUT_SIG, TE_RATE);
+            QTimeEvt_armX(&l_te[nArmed], 0x7FFFFFFFU, 0U);
+        }
+        QTIMEEVT_TICK_X(TE_RATE, (void *)0); /* link the newly armed */
+
+        for (i = 0U; i < n; ++i) {
+            uint64_t const t0 = QPB_now();
+            QTIMEEVT_TICK_X(TE_RATE, (void *)0);
+            samples[i] = (double)(QPB_now() - t0);
+        }
+        snprintf(param, sizeof(param), "armed=%u", (unsigned)armed[a]);
+        QPB_report("evt.tick", param, "ns", samples, n);
+    }
+    while (nArmed > 0U) {
+        --nArmed;
+        QTimeEvt_disarm(&l_te[nArmed]);
+    }
+    QTIMEEVT_TICK_X(TE_RATE, (void *)0); /* unlink the disarmed */
+}
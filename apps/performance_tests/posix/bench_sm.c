@@ -0,0 +1,310 @@
+/*============================================================================
+* QP/C Real-Time Embedded Framework (RTEF)
+* Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+*
+* SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+*
+* This software is dual-licensed under the terms of the open source GNU
+* General Public License version 3 (or any later version), or alternatively,
+* under the terms of one of the closed source Quantum Leaps commercial
+* licenses.
+*
+* The terms of the open source GNU General Public License version 3
+* can be found at: <www.gnu.org/licenses/gpl-3.0>
+*
+* The terms of the closed source Quantum Leaps commercial licenses
+* can be found at: <www.state-machine.com/licensing>
+*
+* Redistributions in source code must retain this top-level comment block.
+* Plagiarizing this software to sidestep the license obligations is illegal.
+*
+* Contact information:
+* <www.state-machine.com>
+* <info@state-machine.com>
+============================================================================*/
+/*!
+* @date Last updated on: 2026-10-18
+* @version Last updated for: @ref qpc_7_2_2
+*
+* @file
+* @brief qpbench: QHsm and QMsm dispatch cost vs. state nesting depth
+*
+* @details
+* Both state machines consist of two branches of nested states a1..a5 and
+* b1..b5 (ak and bk are nested at the depth k, a1 and b1 are the outermost
+* states). The leaf state is selected by the nesting depth of the test.
+* TOGGLE_SIG causes a transition between the leaf states aD and bD, which
+* exits and enters D states, and BUBBLE_SIG is handled in the outermost
+* state, so it is passed up through D - 1 superstates. The entry and exit
+* actions of all the states only count. The depth is limited by the
+* maximum nesting depth supported by QHsm.
+*/
+#include "qpc.h"
+#include "qpbench.h"
+
+#include <stdio.h>
+
+Q_DEFINE_THIS_FILE
+
+/*==========================================================================*/
+typedef struct {
+    QHsm super;
+    uint_fast8_t depth; /* nesting depth of the leaf states */
+    uint32_t ctr;       /* # entry/exit actions and BUBBLE_SIG events */
+} HsmBench;
+
+static QState HsmBench_initial(HsmBench * const me, void const * const par);
+
+#define HSM_STATE_DECL(br_, k_) \
+    static QState HsmBench_##br_##k_(HsmBench * const me, \
+                                     QEvt const * const e);
+
+#define HSM_STATE_DEF(br_, k_, super_, other_) \
+static QState HsmBench_##br_##k_(HsmBench * const me, \
+                                 QEvt const * const e) \
+{ \
+    QState status_; \
+    switch (e->sig) { \
+        case Q_ENTRY_SIG: /* intentionally fall through */ \
+        case Q_EXIT_SIG: { \
+            ++me->ctr; \
+            status_ = Q_HANDLED(); \
+            break; \
+        } \
+        default: { \
+            if ((e->sig == TOGGLE_SIG) && (me->depth == (k_))) { \
+                status_ = Q_TRAN(&HsmBench_##other_##k_); \
+            } \
+            else if ((e->sig == BUBBLE_SIG) && ((k_) == 1U)) { \
+                ++me->ctr; \
+                status_ = Q_HANDLED(); \
+            } \
+            else { \
+                status_ = Q_SUPER(super_); \
+            } \
+            break; \
+        } \
+    } \
+    return status_; \
+}
+
+HSM_STATE_DECL(a, 1) HSM_STATE_DECL(a, 2) HSM_STATE_DECL(a, 3)
+HSM_STATE_DECL(a, 4) HSM_STATE_DECL(a, 5)
+HSM_STATE_DECL(b, 1) HSM_STATE_DECL(b, 2) HSM_STATE_DECL(b, 3)
+HSM_STATE_DECL(b, 4) HSM_STATE_DECL(b, 5)
+
+/* leaf states of the "a" branch by the nesting depth */
+static QStateHandler const l_hsmLeaf[QPB_DEPTH_MAX + 1U] = {
+    Q_STATE_CAST(0),
+    Q_STATE_CAST(&HsmBench_a1), Q_STATE_CAST(&HsmBench_a2),
+    Q_STATE_CAST(&HsmBench_a3), Q_STATE_CAST(&HsmBench_a4),
+    Q_STATE_CAST(&HsmBench_a5)
+};
+
+/*..........................................................................*/
+static QState HsmBench_initial(HsmBench * const me, void const * const par) {
+    Q_UNUSED_PAR(par);
+    return Q_TRAN(l_hsmLeaf[me->depth]);
+}
+
+HSM_STATE_DEF(a, 1, &QHsm_top, b)
+HSM_STATE_DEF(a, 2, &HsmBench_a1, b)
+HSM_STATE_DEF(a, 3, &HsmBench_a2, b)
+HSM_STATE_DEF(a, 4, &HsmBench_a3, b)
+HSM_STATE_DEF(a, 5, &HsmBench_a4, b)
+HSM_STATE_DEF(b, 1, &QHsm_top, a)
+HSM_STATE_DEF(b, 2, &HsmBench_b1, a)
+HSM_STATE_DEF(b, 3, &HsmBench_b2, a)
+HSM_STATE_DEF(b, 4, &HsmBench_b3, a)
+HSM_STATE_DEF(b, 5, &HsmBench_b4, a)
+
+/*==========================================================================*/
+typedef struct {
+    QMsm super;
+    uint_fast8_t depth; /* nesting depth of the leaf states */
+    uint32_t ctr;       /* # entry/exit actions and BUBBLE_SIG events */
+} MsmBench;
+
+/* transition-action table long enough for the deepest transition
+* (layout-compatible with ::QMTranActTable)
+*/
+typedef struct {
+    QMState const *target;
+    QActionHandler act[(2U * QPB_DEPTH_MAX) + 1U];
+} MsmTatbl;
+
+static QState MsmBench_initial(MsmBench * const me, void const * const par);
+
+#define MSM_STATE_DECL(br_, k_) \
+    static QState MsmBench_##br_##k_(MsmBench * const me, \
+                                     QEvt const * const e); \
+    static QState MsmBench_##br_##k_##_e(MsmBench * const me); \
+    static QState MsmBench_##br_##k_##_x(MsmBench * const me);
+
+#define MSM_STATE_OBJ(br_, k_, super_) \
+    static QMState const MsmBench_##br_##k_##_s = { \
+        (super_), \
+        Q_STATE_CAST(&MsmBench_##br_##k_), \
+        Q_ACTION_CAST(&MsmBench_##br_##k_##_e), \
+        Q_ACTION_CAST(&MsmBench_##br_##k_##_x), \
+        Q_ACTION_NULL \
+    };
+
+#define MSM_STATE_DEF(br_, k_, tatbl_) \
+static QState MsmBench_##br_##k_##_e(MsmBench * const me) { \
+    ++me->ctr; \
+    return QM_ENTRY(&MsmBench_##br_##k_##_s); \
+} \
+static QState MsmBench_##br_##k_##_x(MsmBench * const me) { \
+    ++me->ctr; \
+    return QM_EXIT(&MsmBench_##br_##k_##_s); \
+} \
+static QState MsmBench_##br_##k_(MsmBench * const me, \
+                                 QEvt const * const e) \
+{ \
+    QState status_; \
+    if ((e->sig == TOGGLE_SIG) && (me->depth == (k_))) { \
+        status_ = QM_TRAN(&(tatbl_)[k_]); \
+    } \
+    else if ((e->sig == BUBBLE_SIG) && ((k_) == 1U)) { \
+        ++me->ctr; \
+        status_ = QM_HANDLED(); \
+    } \
+    else { \
+        status_ = QM_SUPER(); \
+    } \
+    return status_; \
+}
+
+MSM_STATE_DECL(a, 1) MSM_STATE_DECL(a, 2) MSM_STATE_DECL(a, 3)
+MSM_STATE_DECL(a, 4) MSM_STATE_DECL(a, 5)
+MSM_STATE_DECL(b, 1) MSM_STATE_DECL(b, 2) MSM_STATE_DECL(b, 3)
+MSM_STATE_DECL(b, 4) MSM_STATE_DECL(b, 5)
+
+MSM_STATE_OBJ(a, 1, QM_STATE_NULL)
+MSM_STATE_OBJ(a, 2, &MsmBench_a1_s)
+MSM_STATE_OBJ(a, 3, &MsmBench_a2_s)
+MSM_STATE_OBJ(a, 4, &MsmBench_a3_s)
+MSM_STATE_OBJ(a, 5, &MsmBench_a4_s)
+MSM_STATE_OBJ(b, 1, QM_STATE_NULL)
+MSM_STATE_OBJ(b, 2, &MsmBench_b1_s)
+MSM_STATE_OBJ(b, 3, &MsmBench_b2_s)
+MSM_STATE_OBJ(b, 4, &MsmBench_b3_s)
+MSM_STATE_OBJ(b, 5, &MsmBench_b4_s)
+
+/* nested states of both branches by the nesting depth */
+static QMState const * const l_msmA[QPB_DEPTH_MAX + 1U] = {
+    QM_STATE_NULL,
+    &MsmBench_a1_s, &MsmBench_a2_s, &MsmBench_a3_s,
+    &MsmBench_a4_s, &MsmBench_a5_s
+};
+static QMState const * const l_msmB[QPB_DEPTH_MAX + 1U] = {
+    QM_STATE_NULL,
+    &MsmBench_b1_s, &MsmBench_b2_s, &MsmBench_b3_s,
+    &MsmBench_b4_s, &MsmBench_b5_s
+};
+
+/* transition-action tables by the nesting depth (see QPB_msm()) */
+static MsmTatbl l_msmInit[QPB_DEPTH_MAX + 1U]; /* initial tran. to aD */
+static MsmTatbl l_msmToB[QPB_DEPTH_MAX + 1U];  /* aD -> bD */
+static MsmTatbl l_msmToA[QPB_DEPTH_MAX + 1U];  /* bD -> aD */
+
+/*..........................................................................*/
+static void MsmTatbl_init(MsmTatbl * const me,
+                          QMState const * const from[],
+                          QMState const * const to[],
+                          uint_fast8_t const depth)
+{
+    uint_fast8_t n = 0U;
+    uint_fast8_t k;
+
+    me->target = to[depth];
+    if (from != (QMState const * const *)0) {
+        for (k = depth; k > 0U; --k) {
+            me->act[n] = from[k]->exitAction;
+            ++n;
+        }
+    }
+    for (k = 1U; k <= depth; ++k) {
+        me->act[n] = to[k]->entryAction;
+        ++n;
+    }
+    me->act[n] = Q_ACTION_NULL;
+}
+/*..........................................................................*/
+static QState MsmBench_initial(MsmBench * const me, void const * const par) {
+    Q_UNUSED_PAR(par);
+    return QM_TRAN_INIT(&l_msmInit[me->depth]);
+}
+
+MSM_STATE_DEF(a, 1, l_msmToB) MSM_STATE_DEF(a, 2, l_msmToB)
+MSM_STATE_DEF(a, 3, l_msmToB) MSM_STATE_DEF(a, 4, l_msmToB)
+MSM_STATE_DEF(a, 5, l_msmToB)
+MSM_STATE_DEF(b, 1, l_msmToA) MSM_STATE_DEF(b, 2, l_msmToA)
+MSM_STATE_DEF(b, 3, l_msmToA) MSM_STATE_DEF(b, 4, l_msmToA)
+MSM_STATE_DEF(b, 5, l_msmToA)
+
+/*==========================================================================*/
+/* time QPB_BATCH dispatches of the event 'e' to the SM 'sm' per sample */
+static void measure(QHsm * const sm, QEvt const * const e,
+                    char const * const bench, char const * const param)
+{
+    uint32_t const n = QPB_nSamples();
+    double * const samples = QPB_samples();
+    uint32_t i;
+
+    for (i = 0U; i < n; ++i) {
+        uint64_t const t0 = QPB_now();
+        uint_fast16_t k;
+        for (k = 0U; k < QPB_BATCH; ++k) {
+            QHSM_DISPATCH(sm, e, 0U);
+        }
+        samples[i] = (double)(QPB_now() - t0) / (double)QPB_BATCH;
+    }
+    QPB_report(bench, param, "ns", samples, n);
+}
+/*..........................................................................*/
+void QPB_hsm(void) {
+    static QEvt const toggleEvt = QEVT_INITIALIZER(TOGGLE_SIG);
+    static QEvt const bubbleEvt = QEVT_INITIALIZER(BUBBLE_SIG);
+    static HsmBench sm;
+    uint_fast8_t d;
+
+    for (d = 1U; d <= QPB_DEPTH_MAX; ++d) {
+        char param[16];
+
+        QHsm_ctor(&sm.super, Q_STATE_CAST(&HsmBench_initial));
+        sm.depth = d;
+        sm.ctr = 0U;
+        QHSM_INIT(&sm.super, (void *)0, 0U);
+
+        snprintf(param, sizeof(param), "depth=%u", (unsigned)d);
+        measure(&sm.super, &toggleEvt, "hsm.tran", param);
+        measure(&sm.super, &bubbleEvt, "hsm.bubble", param);
+    }
+}
+/*..........................................................................*/
+void QPB_msm(void) {
+    static QEvt const toggleEvt = QEVT_INITIALIZER(TOGGLE_SIG);
+    static QEvt const bubbleEvt = QEVT_INITIALIZER(BUBBLE_SIG);
+    static MsmBench sm;
+    uint_fast8_t d;
+
+    for (d = 1U; d <= QPB_DEPTH_MAX; ++d) {
+        MsmTatbl_init(&l_msmInit[d], (QMState const * const *)0, l_msmA, d);
+        MsmTatbl_init(&l_msmToB[d], l_msmA, l_msmB, d);
+        MsmTatbl_init(&l_msmToA[d], l_msmB, l_msmA, d);
+    }
+    for (d = 1U; d <= QPB_DEPTH_MAX; ++d) {
+        char param[16];
+
+        QMsm_ctor(&sm.super, Q_STATE_CAST(&MsmBench_initial));
+        sm.depth = d;
+        sm.ctr = 0U;
+        QHSM_INIT(&sm.super.super, (void *)0, 0U);
+
+        snprintf(param, sizeof(param), "depth=%u", (unsigned)d);
+        measure(&sm.super.super, &toggleEvt, "msm.tran", param);
+        measure(&sm.super.super, &bubbleEvt, "msm.bubble", param);
+    }
+}
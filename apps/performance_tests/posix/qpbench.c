@@ -0,0 +1,376 @@
+/*============================================================================
+* QP/C Real-Time Embedded Framework (RTEF)
+* Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+*
+* SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+*
+* This software is dual-licensed under the terms of the open source GNU
+* General Public License version 3 (or any later version), or alternatively,
+* under the terms of one of the closed source Quantum Leaps commercial
+* licenses.
+*
+* The terms of the open source GNU General Public License version 3
+* can be found at: <www.gnu.org/licenses/gpl-3.0>
+*
+* The terms of the closed source Quantum Leaps commercial licenses
+* can be found at: <www.state-machine.com/licensing>
+*
+* Redistributions in source code must retain this top-level comment block.
+* Plagiarizing this software to sidestep the license obligations is illegal.
+*
+* Contact information:
+* <www.state-machine.com>
+* <info@state-machine.com>
+============================================================================*/
+/*!
+* @date Last updated on: 2026-10-18
+* @version Last updated for: @ref qpc_7_2_2
+*
+* @file
+* @brief qpbench: QP/C micro-benchmarks on the POSIX port (driver)
+*
+* @details
+* Usage:
+* qpbench [-n samples] [-f text|json|csv] [-o file] [-r] [-l] [bench...]
+*
+* -n  number of samples per benchmark case (default 1000)
+* -f  output format (default text)
+* -o  write the results to the file instead of stdout
+* -r  include the raw samples in the JSON output
+* -l  list the benchmarks and exit
+* bench...  run only the benchmarks with names starting with any of the
+*           given prefixes, e.g., "ao." or "hsm"
+*
+* Each benchmark produces one or more cases (bench + param), and every
+* case reports the min, mean, standard deviation, percentiles and max of
+* its samples. A sample is either a single operation (ao.pingpong,
+* evt.tick) or the mean of #QPB_BATCH operations timed together, because
+* those operations are too short for the clock resolution.
+*/
+#include "qpc.h"
+#include "qpbench.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/utsname.h>
+
+Q_DEFINE_THIS_FILE
+
+#define RESULT_MAX  64U
+
+typedef struct {
+    char const *name;
+    void (*run)(void);
+} QPBench;
+
+typedef struct {
+    char const *bench;
+    char param[16];
+    char const *unit;
+    uint32_t n;
+    double min;
+    double mean;
+    double sd;
+    double p50;
+    double p90;
+    double p99;
+    double p999;
+    double max;
+    double *samples; /* raw samples (-r option) or NULL */
+} QPBResult;
+
+static QPBench const l_bench[] = {
+    { "ao.pingpong", &QPB_pingPong },
+    { "ao.fanout",   &QPB_fanOut   },
+    { "evt.new_gc",  &QPB_pool     },
+    { "evt.tick",    &QPB_timeEvt  },
+    { "hsm",         &QPB_hsm      },
+    { "msm",         &QPB_msm      }
+};
+
+static uint32_t l_nSamples = 1000U;
+static double  *l_samples;
+static bool     l_raw;
+static char const * const *l_filter;
+static int      l_nFilter;
+
+static QPBResult l_result[RESULT_MAX];
+static uint32_t  l_nResult;
+static bool volatile l_finished;
+
+static bool isSelected(char const *name);
+static void *driver(void *arg);
+static void writeText(FILE *f);
+static void writeJson(FILE *f);
+static void writeCsv(FILE *f);
+static int  cmpDouble(void const *a, void const *b);
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    char const *format = "text";
+    char const *outFile = (char const *)0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:f:o:rl")) != -1) {
+        switch (opt) {
+            case 'n':
+                l_nSamples = (uint32_t)strtoul(optarg, (char **)0, 10);
+                break;
+            case 'f':
+                format = optarg;
+                break;
+            case 'o':
+                outFile = optarg;
+                break;
+            case 'r':
+                l_raw = true;
+                break;
+            case 'l': {
+                uint_fast8_t i;
+                for (i = 0U; i < Q_DIM(l_bench); ++i) {
+                    printf("%s\n", l_bench[i].name);
+                }
+                return 0;
+            }
+            default:
+                fprintf(stderr, "usage: %s [-n samples] [-f text|json|csv]"
+                        " [-o file] [-r] [-l] [bench...]\n", argv[0]);
+                return 2;
+        }
+    }
+    if ((l_nSamples == 0U)
+        || ((strcmp(format, "text") != 0) && (strcmp(format, "json") != 0)
+            && (strcmp(format, "csv") != 0)))
+    {
+        fprintf(stderr, "%s: invalid -n or -f option\n", argv[0]);
+        return 2;
+    }
+    l_filter = (char const * const *)&argv[optind];
+    l_nFilter = argc - optind;
+
+    l_samples = malloc(l_nSamples * sizeof(double));
+    Q_ASSERT(l_samples != (double *)0);
+
+    QF_init();
+    QPB_poolInit();
+    QPB_startAOs();
+    QF_run(); /* returns after the driver thread finished, see QF_onClockTick() */
+
+    FILE *f = stdout;
+    if (outFile != (char const *)0) {
+        f = fopen(outFile, "w");
+        if (f == (FILE *)0) {
+            perror(outFile);
+            return 1;
+        }
+    }
+    if (strcmp(format, "json") == 0) {
+        writeJson(f);
+    }
+    else if (strcmp(format, "csv") == 0) {
+        writeCsv(f);
+    }
+    else {
+        writeText(f);
+    }
+    if (f != stdout) {
+        fclose(f);
+    }
+    return 0;
+}
+
+/*..........................................................................*/
+uint64_t QPB_now(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return ((uint64_t)t.tv_sec * 1000000000U) + (uint64_t)t.tv_nsec;
+}
+/*..........................................................................*/
+uint32_t QPB_nSamples(void) {
+    return l_nSamples;
+}
+/*..........................................................................*/
+double *QPB_samples(void) {
+    return l_samples;
+}
+/*..........................................................................*/
+void QPB_report(char const *bench, char const *param, char const *unit,
+                double const *samples, uint32_t n)
+{
+    Q_REQUIRE((l_nResult < RESULT_MAX) && (n > 0U));
+
+    QPBResult * const r = &l_result[l_nResult];
+    double * const sorted = malloc(n * sizeof(double));
+    double sum = 0.0;
+    double sum2 = 0.0;
+    uint32_t i;
+
+    Q_ASSERT(sorted != (double *)0);
+    memcpy(sorted, samples, n * sizeof(double));
+    qsort(sorted, n, sizeof(double), &cmpDouble);
+    for (i = 0U; i < n; ++i) {
+        sum += sorted[i];
+    }
+
+    r->bench = bench;
+    snprintf(r->param, sizeof(r->param), "%s", param);
+    r->unit = unit;
+    r->n = n;
+    r->mean = sum / (double)n;
+    for (i = 0U; i < n; ++i) {
+        sum2 += (sorted[i] - r->mean) * (sorted[i] - r->mean);
+    }
+    r->sd = (n > 1U) ? sqrt(sum2 / (double)(n - 1U)) : 0.0;
+    r->min = sorted[0];
+    r->max = sorted[n - 1U];
+    /* nearest-rank percentiles */
+    r->p50  = sorted[(uint32_t)ceil(0.500 * (double)n) - 1U];
+    r->p90  = sorted[(uint32_t)ceil(0.900 * (double)n) - 1U];
+    r->p99  = sorted[(uint32_t)ceil(0.990 * (double)n) - 1U];
+    r->p999 = sorted[(uint32_t)ceil(0.999 * (double)n) - 1U];
+
+    if (l_raw) { /* keep the samples in the measurement order */
+        memcpy(sorted, samples, n * sizeof(double));
+        r->samples = sorted;
+    }
+    else {
+        free(sorted);
+        r->samples = (double *)0;
+    }
+    ++l_nResult;
+
+    fprintf(stderr, "%-12s %-10s p50=%.1f%s\n", bench, param, r->p50, unit);
+}
+
+/*..........................................................................*/
+static bool isSelected(char const *name) {
+    int i;
+    if (l_nFilter == 0) {
+        return true;
+    }
+    for (i = 0; i < l_nFilter; ++i) {
+        if (strncmp(name, l_filter[i], strlen(l_filter[i])) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+/*..........................................................................*/
+/* runs the benchmarks outside of the AO and ticker threads */
+static void *driver(void *arg) {
+    uint_fast8_t i;
+
+    (void)arg;
+    for (i = 0U; i < Q_DIM(l_bench); ++i) {
+        if (isSelected(l_bench[i].name)) {
+            (*l_bench[i].run)();
+        }
+    }
+    l_finished = true;
+    return (void *)0;
+}
+/*..........................................................................*/
+static int cmpDouble(void const *a, void const *b) {
+    double const x = *(double const *)a;
+    double const y = *(double const *)b;
+    return (x < y) ? -1 : ((x > y) ? 1 : 0);
+}
+
+/*..........................................................................*/
+static void writeText(FILE *f) {
+    uint32_t i;
+    fprintf(f, "%-12s %-10s %5s %10s %10s %10s %10s %10s %10s %10s %10s\n",
+            "bench", "param", "unit", "min", "mean", "sd",
+            "p50", "p90", "p99", "p99.9", "max");
+    for (i = 0U; i < l_nResult; ++i) {
+        QPBResult const * const r = &l_result[i];
+        fprintf(f, "%-12s %-10s %5s %10.1f %10.1f %10.1f %10.1f %10.1f"
+                " %10.1f %10.1f %10.1f\n",
+                r->bench, r->param, r->unit, r->min, r->mean, r->sd,
+                r->p50, r->p90, r->p99, r->p999, r->max);
+    }
+}
+/*..........................................................................*/
+static void writeJson(FILE *f) {
+    struct utsname un;
+    char date[32];
+    time_t const now = time((time_t *)0);
+    uint32_t i;
+
+    uname(&un);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+    fprintf(f, "{\n  \"suite\": \"qpbench\",\n  \"env\": {\n");
+    fprintf(f, "    \"qp_version\": \"%s\",\n", QP_VERSION_STR);
+    fprintf(f, "    \"port\": \"posix\",\n");
+#ifdef __VERSION__
+    fprintf(f, "    \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+    fprintf(f, "    \"os\": \"%s %s\",\n", un.sysname, un.release);
+    fprintf(f, "    \"machine\": \"%s\",\n", un.machine);
+    fprintf(f, "    \"cpus\": %ld,\n", sysconf(_SC_NPROCESSORS_ONLN));
+    fprintf(f, "    \"batch\": %u,\n", (unsigned)QPB_BATCH);
+    fprintf(f, "    \"date\": \"%s\"\n  },\n  \"results\": [", date);
+
+    for (i = 0U; i < l_nResult; ++i) {
+        QPBResult const * const r = &l_result[i];
+        fprintf(f, "%s\n    { \"bench\": \"%s\", \"param\": \"%s\","
+                " \"unit\": \"%s\", \"n\": %u,\n"
+                "      \"min\": %.1f, \"mean\": %.1f, \"sd\": %.1f,"
+                " \"p50\": %.1f, \"p90\": %.1f, \"p99\": %.1f,"
+                " \"p999\": %.1f, \"max\": %.1f",
+                (i == 0U) ? "" : ",",
+                r->bench, r->param, r->unit, (unsigned)r->n,
+                r->min, r->mean, r->sd, r->p50, r->p90, r->p99, r->p999,
+                r->max);
+        if (r->samples != (double *)0) {
+            uint32_t k;
+            fprintf(f, ",\n      \"samples\": [");
+            for (k = 0U; k < r->n; ++k) {
+                fprintf(f, "%s%.1f", (k == 0U) ? "" : ",", r->samples[k]);
+            }
+            fprintf(f, "]");
+        }
+        fprintf(f, " }");
+    }
+    fprintf(f, "\n  ]\n}\n");
+}
+/*..........................................................................*/
+static void writeCsv(FILE *f) {
+    uint32_t i;
+    fprintf(f, "bench,param,unit,n,min,mean,sd,p50,p90,p99,p999,max\n");
+    for (i = 0U; i < l_nResult; ++i) {
+        QPBResult const * const r = &l_result[i];
+        fprintf(f, "%s,%s,%s,%u,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f\n",
+                r->bench, r->param, r->unit, (unsigned)r->n,
+                r->min, r->mean, r->sd, r->p50, r->p90, r->p99, r->p999,
+                r->max);
+    }
+}
+
+/* QF callbacks ============================================================*/
+void QF_onStartup(void) {
+    pthread_t thread;
+    pthread_create(&thread, (pthread_attr_t const *)0, &driver, (void *)0);
+    pthread_detach(thread);
+}
+/*..........................................................................*/
+void QF_onCleanup(void) {
+}
+/*..........................................................................*/
+void QF_onClockTick(void) {
+    /* the benchmarks tick the time events themselves (see QPB_timeEvt()) */
+    if (l_finished) {
+        QF_stop();
+    }
+}
+/*..........................................................................*/
+Q_NORETURN Q_onAssert(char const * const module, int_t const location) {
+    fprintf(stderr, "Assertion failed in %s:%d\n", module, (int)location);
+    exit(-1);
+}
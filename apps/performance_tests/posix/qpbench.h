@@ -0,0 +1,83 @@
+/*============================================================================
+* QP/C Real-Time Embedded Framework (RTEF)
+* Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+*
+* SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+*
+* This software is dual-licensed under the terms of the open source GNU
+* General Public License version 3 (or any later version), or alternatively,
+* under the terms of one of the closed source Quantum Leaps commercial
+* licenses.
+*
+* The terms of the open source GNU General Public License version 3
+* can be found at: <www.gnu.org/licenses/gpl-3.0>
+*
+* The terms of the closed source Quantum Leaps commercial licenses
+* can be found at: <www.state-machine.com/licensing>
+*
+* Redistributions in source code must retain this top-level comment block.
+* Plagiarizing this software to sidestep the license obligations is illegal.
+*
+* Contact information:
+* <www.state-machine.com>
+* <info@state-machine.com>
+============================================================================*/
+/*!
+* @date Last updated on: 2026-10-18
+* @version Last updated for: @ref qpc_7_2_2
+*
+* @file
+* @brief qpbench: QP/C micro-benchmarks on the POSIX port (shared header)
+*/
+#ifndef QPBENCH_H
+#define QPBENCH_H
+
+#include <stdint.h>
+
+enum QPBenchSignals {
+    FANOUT_SIG = Q_USER_SIG, /* published to the subscriber AOs */
+    MAX_PUB_SIG,             /* the last published signal */
+
+    START_SIG,   /* starts the ping-pong exchange */
+    PING_SIG,    /* ping -> pong */
+    PONG_SIG,    /* pong -> ping */
+    TIMEOUT_SIG, /* time events of the time-event benchmark (never fire) */
+    TOGGLE_SIG,  /* transition between the deepest states of the SMs */
+    BUBBLE_SIG,  /* handled in the outermost state of the SMs */
+    MAX_SIG      /* the last signal */
+};
+
+#define QPB_SUBS_MAX   32U  /*!< max # subscriber AOs in the fan-out test */
+#define QPB_DEPTH_MAX  5U   /*!< max state nesting depth in the SM tests */
+#define QPB_BATCH      100U /*!< # operations timed together as one sample */
+
+/*! time-stamp [ns] from the monotonic clock */
+uint64_t QPB_now(void);
+
+/*! number of samples per benchmark case (the "-n" option) */
+uint32_t QPB_nSamples(void);
+
+/*! buffer for QPB_nSamples() samples, reused by all the benchmark cases */
+double *QPB_samples(void);
+
+/*! compute the statistics of the samples of one benchmark case and
+* store them (with the samples) for the final report
+*/
+void QPB_report(char const *bench, char const *param, char const *unit,
+                double const *samples, uint32_t n);
+
+/* benchmark AOs (bench_ao.c) */
+void QPB_startAOs(void);
+void QPB_pingPong(void);
+void QPB_fanOut(void);
+
+/* event pools and time events (bench_evt.c) */
+void QPB_poolInit(void);
+void QPB_pool(void);
+void QPB_timeEvt(void);
+
+/* hierarchical state machines (bench_sm.c) */
+void QPB_hsm(void);
+void QPB_msm(void);
+
+#endif /* QPBENCH_H */
@@ -27,6 +27,7 @@
 * <info@state-machine.com>
 ============================================================================*/
 #include "perf_test.h"
+#include "perf_test_config.h"
 #include "app_main.h"
 #include "bsp.h"
 #include <finsh.h>
@@ -40,6 +41,7 @@ Q_DEFINE_THIS_MODULE("perf_main")
 
 /* QF event pools for performance testing (used for event allocation) */
 static QF_MPOOL_EL(QEvt) l_smlPoolSto[100U];
+static QF_MPOOL_EL(PerfLoadEvt) l_medPoolSto[OPENLOOP_POOL_SIZE];
 
 /* Framework initialization flag (ensures single init) */
 static rt_bool_t l_framework_initialized = RT_FALSE;
@@ -83,6 +85,7 @@ void PerformanceFramework_init(void)
 
         /* Initialize event pools */
         QF_poolInit(l_smlPoolSto, sizeof(l_smlPoolSto), sizeof(QEvt));
+        QF_poolInit(l_medPoolSto, sizeof(l_medPoolSto), sizeof(PerfLoadEvt));
 
         l_framework_initialized = RT_TRUE;
     }
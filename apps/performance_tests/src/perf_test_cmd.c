@@ -3,13 +3,13 @@
 
 /*
  * Command handler for performance test shell commands.
- * Supports: list, start, stop, restart, report.
+ * Supports: list, start, stop, restart, report [json].
  */
 static int cmd_perf(int argc, char **argv)
 {
     if (argc < 2)
     {
-        rt_kprintf("Usage: perf <list|start|stop|restart|report> [name]\n");
+        rt_kprintf("Usage: perf <list|start|stop|restart|report> [name|json]\n");
         return -1;
     }
     const char *op = argv[1];
@@ -30,6 +30,11 @@ static int cmd_perf(int argc, char **argv)
                    op, argv[2],
                    res == 0 ? "OK" : "FAIL", res);
     }
+    else if (strcmp(op, "report") == 0 && argc == 3 &&
+             strcmp(argv[2], "json") == 0)
+    {
+        perf_test_report_json();
+    }
     else if (strcmp(op, "report") == 0)
     {
         perf_test_report();
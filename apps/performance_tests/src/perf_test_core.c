@@ -1,6 +1,12 @@
 #include "perf_test.h"
+#include "qpc.h"
 #include <string.h>
 
+/* Board name reported in the environment fingerprint of the results */
+#ifndef PERF_TEST_BOARD
+#define PERF_TEST_BOARD "unknown"
+#endif
+
 /* Simple static test case registry - no linker script dependency */
 #define MAX_TEST_CASES 16
 perf_test_case_t *s_test_registry[MAX_TEST_CASES];
@@ -181,3 +187,209 @@ void perf_test_report(void)
                    tc->name, ms, tc->iterations, tc->result_code);
     }
 }
+
+/* Histogram bucket of a sample value (log-linear, see PERF_TEST_HIST_SUB_BITS) */
+static rt_uint32_t hist_index(rt_uint32_t value)
+{
+    rt_uint32_t msb = 0;
+
+    if (value < (1U << PERF_TEST_HIST_SUB_BITS))
+    {
+        return value;
+    }
+    while ((value >> msb) > 1U)
+    {
+        msb++;
+    }
+    return ((msb - PERF_TEST_HIST_SUB_BITS + 1U) << PERF_TEST_HIST_SUB_BITS)
+           + ((value >> (msb - PERF_TEST_HIST_SUB_BITS))
+              & ((1U << PERF_TEST_HIST_SUB_BITS) - 1U));
+}
+
+/* Number of samples in the buckets of a histogram */
+static rt_uint32_t hist_total(const perf_hist_t *h)
+{
+    rt_uint32_t total = 0;
+
+    for (rt_uint32_t i = 0; i < PERF_TEST_HIST_BUCKETS; i++)
+    {
+        total += h->bucket[i];
+    }
+    return total;
+}
+
+/* Middle of the value range covered by a histogram bucket */
+static rt_uint32_t hist_value(rt_uint32_t idx)
+{
+    rt_uint32_t grp = idx >> PERF_TEST_HIST_SUB_BITS;
+    rt_uint32_t sub = idx & ((1U << PERF_TEST_HIST_SUB_BITS) - 1U);
+    rt_uint32_t low;
+
+    if (grp == 0U)
+    {
+        return idx;
+    }
+    low = ((1U << PERF_TEST_HIST_SUB_BITS) + sub) << (grp - 1U);
+    return low + ((1U << (grp - 1U)) >> 1);
+}
+
+void perf_hist_reset(perf_hist_t *h)
+{
+    rt_memset(h, 0, sizeof(*h));
+}
+
+void perf_hist_add(perf_hist_t *h, rt_uint32_t value)
+{
+    rt_uint32_t idx = hist_index(value);
+
+    if (h->count == 0U || value < h->min)
+    {
+        h->min = value;
+    }
+    if (value > h->max)
+    {
+        h->max = value;
+    }
+    h->count++;
+    h->sum += value;
+    if (h->bucket[idx] != 0xFFFFU) /* saturate rather than wrap around */
+    {
+        h->bucket[idx]++;
+    }
+}
+
+void perf_hist_add_corrected(perf_hist_t *h, rt_uint32_t value,
+                             rt_uint32_t interval)
+{
+    perf_hist_add(h, value);
+    if (interval == 0U)
+    {
+        return;
+    }
+    /* the requests that a stalled closed loop did not issue while waiting
+     * would have seen the remaining part of the stall as their latency
+     */
+    while (value > interval && (value - interval) >= interval)
+    {
+        value -= interval;
+        perf_hist_add(h, value);
+    }
+}
+
+rt_uint32_t perf_hist_percentile(const perf_hist_t *h, rt_uint32_t p)
+{
+    rt_uint32_t total = hist_total(h);
+    rt_uint32_t rank;
+    rt_uint32_t acc = 0;
+    rt_uint32_t i;
+
+    if (total == 0U)
+    {
+        return 0U;
+    }
+
+    /* nearest-rank percentile, clamped to the exact min/max */
+    rank = (rt_uint32_t)(((rt_uint64_t)total * p + 999U) / 1000U);
+    if (rank == 0U)
+    {
+        rank = 1U;
+    }
+    for (i = 0; i < PERF_TEST_HIST_BUCKETS; i++)
+    {
+        acc += h->bucket[i];
+        if (acc >= rank)
+        {
+            break;
+        }
+    }
+    if (acc == total)
+    {
+        return h->max;
+    }
+    i = hist_value(i);
+    return (i < h->min) ? h->min
+         : (i > h->max) ? h->max
+         : i;
+}
+
+void perf_test_sample(perf_test_case_t *tc, rt_uint32_t value)
+{
+    perf_test_sample_corrected(tc, value, 0U);
+}
+
+void perf_test_sample_corrected(perf_test_case_t *tc, rt_uint32_t value,
+                                rt_uint32_t interval)
+{
+    perf_test_stats_t *st = &tc->stats;
+
+    perf_hist_add_corrected(&st->hist, value, interval);
+    st->measurements++;
+    st->min_value = st->hist.min;
+    st->max_value = st->hist.max;
+    st->avg_value = (rt_uint32_t)(st->hist.sum / st->hist.count);
+}
+
+rt_uint32_t perf_test_percentile(const perf_test_case_t *tc, rt_uint32_t p)
+{
+    return perf_hist_percentile(&tc->stats.hist, p);
+}
+
+void perf_test_report_json(void)
+{
+    rt_kprintf("PERF-ENV {\"qp\":\"%s\",\"rtthread\":\"%d.%d.%d\","
+               "\"board\":\"%s\",\"tick_hz\":%d,\"hist_sub_bits\":%d,"
+#ifdef __VERSION__
+               "\"compiler\":\"" __VERSION__ "\","
+#endif
+               "\"build\":\"" __DATE__ " " __TIME__ "\"}\n",
+               QP_VERSION_STR,
+#ifdef RT_VERSION_MAJOR
+               RT_VERSION_MAJOR, RT_VERSION_MINOR, RT_VERSION_PATCH,
+#else
+               RT_VERSION, RT_SUBVERSION, RT_REVISION,
+#endif
+               PERF_TEST_BOARD, RT_TICK_PER_SECOND, PERF_TEST_HIST_SUB_BITS);
+
+    for (rt_int32_t i = 0; i < s_test_count; i++)
+    {
+        perf_test_case_t *tc = s_test_registry[i];
+        perf_test_stats_t *st = &tc->stats;
+        rt_tick_t dt = tc->end_tick - tc->start_tick;
+        rt_uint32_t ms = (rt_uint32_t)(dt * 1000 / RT_TICK_PER_SECOND);
+
+        if (tc->state != STATE_FINISHED)
+        {
+            continue;
+        }
+        rt_kprintf("PERF-JSON {\"name\":\"%s\",\"ret\":%d,"
+                   "\"iterations\":%u,\"duration_ms\":%u,\"rate\":%u",
+                   tc->name, tc->result_code, tc->iterations, ms,
+                   (ms > 0U)
+                       ? (rt_uint32_t)((rt_uint64_t)tc->iterations * 1000U / ms)
+                       : 0U);
+        if (st->hist.count > 0U)
+        {
+            rt_kprintf(",\"unit\":\"%s\",\"n\":%u,\"min\":%u,"
+                       "\"mean\":%u,\"max\":%u",
+                       (st->unit != RT_NULL) ? st->unit : "cycles",
+                       st->measurements, st->min_value,
+                       st->avg_value, st->max_value);
+            rt_kprintf(",\"p50\":%u,\"p90\":%u,\"p99\":%u",
+                       perf_test_percentile(tc, 500U),
+                       perf_test_percentile(tc, 900U),
+                       perf_test_percentile(tc, 990U));
+        }
+        else if (st->measurements > 0U)
+        {
+            /* counted without perf_test_sample() (e.g. idle_cpu), so
+             * min/mean/max were never set: mark the measurements as unsampled
+             */
+            rt_kprintf(",\"n\":%u,\"sampled\":false", st->measurements);
+        }
+        rt_kprintf("}\n");
+        if (tc->report_json != RT_NULL)
+        {
+            tc->report_json(tc);
+        }
+    }
+}
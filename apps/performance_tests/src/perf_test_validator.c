@@ -21,7 +21,8 @@ static void validate_test_registration(void)
         "counter_ao",
         "timer_ao",
         "mem_stress",
-        "multithread"
+        "multithread",
+        "openloop"
     };
 
     rt_uint32_t expected_count = sizeof(expected_tests) / sizeof(expected_tests[0]);
@@ -19,6 +19,7 @@ typedef struct {
     rt_uint32_t total_jitter;
     rt_bool_t test_running;
     rt_timer_t test_timer;
+    perf_test_case_t *tc;
 } jitter_test_data_t;
 
 static jitter_test_data_t s_jitter_data;
@@ -83,6 +84,7 @@ static void jitter_timer_callback(void *parameter)
 
         /* Update statistics */
         data->total_jitter += jitter;
+        perf_test_sample(data->tc, jitter);
 
         if (jitter < data->min_jitter) {
             data->min_jitter = jitter;
@@ -136,7 +138,9 @@ static int jitter_test_init(perf_test_case_t *tc)
     tc->stats.min_value = 0xFFFFFFFF;
     tc->stats.max_value = 0;
     tc->stats.avg_value = 0;
+    tc->stats.unit = "cycles";
 
+    s_jitter_data.tc = tc;
     tc->user_data = &s_jitter_data;
     tc->iterations = 0;
 
@@ -170,11 +174,6 @@ static int jitter_test_run(perf_test_case_t *tc)
 
     /* Calculate final statistics */
     if (data->measurement_count > 1) { /* First measurement doesn't count */
-        tc->stats.measurements = data->measurement_count - 1;
-        tc->stats.min_value = data->min_jitter;
-        tc->stats.max_value = data->max_jitter;
-        tc->stats.avg_value = data->total_jitter / (data->measurement_count - 1);
-
         rt_kprintf("[Jitter Test] Performance Summary: Min=%u, Max=%u, Avg=%u cycles\n",
                    data->min_jitter, data->max_jitter, tc->stats.avg_value);
     }
@@ -17,6 +17,7 @@ typedef struct {
     rt_uint32_t min_latency;
     rt_uint32_t max_latency;
     rt_uint32_t total_latency;
+    rt_uint32_t interval;       /* intended request interval [cycles] */
     rt_bool_t test_running;
 } latency_test_data_t;
 
@@ -71,12 +72,21 @@ static int latency_test_init(perf_test_case_t *tc)
     s_latency_data.total_latency = 0;
     s_latency_data.test_running = RT_TRUE;
 
+    /* the cycles in the 1 ms request interval of the closed loop, for the
+     * coordinated-omission correction of the samples
+     */
+    rt_thread_mdelay(1);
+    s_latency_data.interval = dwt_get_cycles();
+    rt_thread_mdelay(10);
+    s_latency_data.interval = (dwt_get_cycles() - s_latency_data.interval) / 10U;
+
     /* Initialize statistics */
     tc->stats.measurements = 0;
     tc->stats.min_value = 0xFFFFFFFF;
     tc->stats.max_value = 0;
     tc->stats.total_latency = 0;
     tc->stats.avg_value = 0;
+    tc->stats.unit = "cycles";
 
     tc->user_data = &s_latency_data;
     tc->iterations = 0;
@@ -127,17 +137,14 @@ static int latency_test_run(perf_test_case_t *tc)
             data->max_latency = latency;
         }
 
+        perf_test_sample_corrected(tc, latency, data->interval);
         tc->iterations++;
 
         /* Small delay to avoid overwhelming the system */
         rt_thread_mdelay(1);
     }    /* Calculate final statistics */
     if (data->measurement_count > 0) {
-        tc->stats.measurements = data->measurement_count;
-        tc->stats.min_value = data->min_latency;
-        tc->stats.max_value = data->max_latency;
         tc->stats.total_latency = data->total_latency;
-        tc->stats.avg_value = data->total_latency / data->measurement_count;
 
         rt_kprintf("[Latency Test] Performance Summary: Min=%u, Max=%u, Avg=%u cycles\n",
                    data->min_latency, data->max_latency, tc->stats.avg_value);
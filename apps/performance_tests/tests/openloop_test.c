@@ -0,0 +1,499 @@
+/*============================================================================
+* Product: Open-loop Load Test for QPC-RT-Thread
+* Integrated into performance_tests framework
+*
+* Posts events into sink AOs at a configured arrival rate, independent of
+* how fast the sinks consume them, and measures the latency from the
+* *intended* send time of every event to its dispatch. Unlike the closed
+* loops of the other tests, a stalled sink does not slow down the
+* generator, so the queueing delay at saturation is not hidden
+* (no coordinated omission). The rate doubles every step from
+* OPENLOOP_RATE_MIN to OPENLOOP_RATE_MAX, which gives the throughput vs.
+* latency curve of the port and the dispatcher configuration.
+============================================================================*/
+#include "perf_test.h"
+#include "perf_test_config.h"
+#include "app_main.h"
+#include "qpc.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*==========================================================================*/
+/* Open-loop Test Data Structure */
+/*==========================================================================*/
+typedef struct {
+    QActive super;
+    rt_uint32_t work;               /* busy-work per event [cycles] */
+} LoadSink;
+
+typedef struct {
+    rt_uint32_t offered;            /* offered rate [events/s] */
+    rt_uint32_t achieved;           /* dispatched during the step [events/s] */
+    rt_uint32_t dropped;            /* events lost to full queues/pool */
+    rt_uint32_t p50, p90, p99, max; /* latency from intended send [us] */
+    rt_uint32_t naive_p99;          /* latency from actual send [us] */
+} openloop_point_t;
+
+#define OPENLOOP_STEPS_MAX 16
+
+typedef struct {
+    perf_test_case_t *tc;
+    rt_thread_t gen_thread;
+    rt_bool_t gen_started;          /* gen_thread was started */
+    volatile rt_bool_t gen_exited;  /* gen_thread returned */
+    rt_uint32_t cyc_per_tick;       /* calibrated cycle counter rate */
+    rt_uint32_t interval;           /* mean inter-arrival time [cycles] */
+    rt_uint32_t next;               /* intended time of the next arrival */
+    rt_uint32_t burst;              /* arrivals left in the current burst */
+    rt_uint32_t rng;
+    rt_uint32_t seq;
+    volatile rt_bool_t generating;
+    volatile rt_bool_t test_running;
+
+    /* statistics of the current step */
+    volatile rt_uint32_t sent;
+    volatile rt_uint32_t dropped;
+    volatile rt_uint32_t done;
+    perf_hist_t lat;                /* intended send -> dispatch */
+    perf_hist_t naive;              /* actual send -> dispatch */
+
+    openloop_point_t curve[OPENLOOP_STEPS_MAX];
+    rt_uint8_t n_points;
+} openloop_test_data_t;
+
+static openloop_test_data_t s_openloop_data;
+
+static int openloop_report_json(perf_test_case_t *tc);
+
+/* run-time configuration, see the openloop_cfg command */
+static rt_uint8_t s_arrival = OPENLOOP_ARRIVAL;
+static rt_bool_t s_staged = RT_FALSE; /* post through the staging buffers */
+static rt_uint32_t s_work = OPENLOOP_SINK_WORK_CYCLES;
+
+static LoadSink s_sinks[OPENLOOP_SINKS];
+static QEvt const *s_sinkQueueSto[OPENLOOP_SINKS][OPENLOOP_QUEUE_LEN];
+static rt_uint8_t s_sinkStack[OPENLOOP_SINKS][1024];
+static rt_bool_t s_sinks_started = RT_FALSE;
+
+/*==========================================================================*/
+/* DWT Cycle Counter Functions */
+/*==========================================================================*/
+#define DWT_CTRL     (*(volatile rt_uint32_t*)0xE0001000)
+#define DWT_CYCCNT   (*(volatile rt_uint32_t*)0xE0001004)
+#define CoreDebug_DEMCR (*(volatile rt_uint32_t*)0xE000EDFC)
+
+static void dwt_init(void) {
+    /* Enable DWT unit */
+    CoreDebug_DEMCR |= (1 << 24); /* Enable DWT */
+    DWT_CYCCNT = 0; /* Reset cycle counter */
+    DWT_CTRL |= 1; /* Enable cycle counter */
+
+    if (DWT_CTRL == 0) {
+        rt_kprintf("[OpenLoop Test] Warning: DWT not available, using RT-Thread ticks as fallback\n");
+    }
+}
+
+static rt_uint32_t dwt_get_cycles(void) {
+    /* If DWT is not available, use RT-Thread tick as fallback */
+    if (DWT_CTRL == 0) {
+        return rt_tick_get() * 1000; /* Scale ticks to approximate cycles */
+    }
+    return DWT_CYCCNT;
+}
+
+/* cycles -> microseconds with the calibrated counter rate */
+static rt_uint32_t cycles_to_us(rt_uint32_t cycles)
+{
+    return (rt_uint32_t)((rt_uint64_t)cycles * 1000000U
+                         / ((rt_uint64_t)s_openloop_data.cyc_per_tick
+                            * RT_TICK_PER_SECOND));
+}
+
+/*==========================================================================*/
+/* Arrival Process */
+/*==========================================================================*/
+static rt_uint32_t rng_next(openloop_test_data_t *data)
+{
+    rt_uint32_t x = data->rng; /* xorshift32 */
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    data->rng = x;
+    return x;
+}
+
+/* -ln(x / 2^32) in Q16, for x != 0 (without the floating point library) */
+static rt_uint32_t neg_ln_q16(rt_uint32_t x)
+{
+    rt_uint32_t msb = 31;
+    rt_uint32_t m;
+    rt_uint32_t log2x;
+
+    while ((x >> msb) == 0U) {
+        msb--;
+    }
+    /* mantissa in Q16 and log2(1 + m) ~= m * (1.3465 - 0.3465 * m) */
+    m = (rt_uint32_t)(((rt_uint64_t)x << (31U - msb)) >> 15) & 0xFFFFU;
+    log2x = (msb << 16) + ((m * (88245U - ((22709U * m) >> 16))) >> 16);
+    return (rt_uint32_t)(((rt_uint64_t)((32U << 16) - log2x) * 45426U) >> 16);
+}
+
+static const char *arrival_name(void)
+{
+    return (s_arrival == OPENLOOP_ARRIVAL_POISSON) ? "poisson"
+         : (s_arrival == OPENLOOP_ARRIVAL_BURST)   ? "burst"
+         : "const";
+}
+
+/* time from one intended arrival to the next [cycles] */
+static rt_uint32_t next_gap(openloop_test_data_t *data)
+{
+    rt_uint32_t x;
+
+    switch (s_arrival) {
+        case OPENLOOP_ARRIVAL_POISSON:
+            do {
+                x = rng_next(data);
+            } while (x == 0U);
+            return (rt_uint32_t)(((rt_uint64_t)data->interval
+                                  * neg_ln_q16(x)) >> 16);
+        case OPENLOOP_ARRIVAL_BURST:
+            if (data->burst > 1U) {
+                data->burst--;
+                return 0U;
+            }
+            data->burst = OPENLOOP_BURST_LEN;
+            return data->interval * OPENLOOP_BURST_LEN;
+        default:
+            return data->interval;
+    }
+}
+
+/*==========================================================================*/
+/* Generator Thread */
+/*==========================================================================*/
+static void post_one(openloop_test_data_t *data, rt_uint32_t intended,
+                     rt_uint32_t now)
+{
+    QActive *sink = &s_sinks[data->seq % OPENLOOP_SINKS].super;
+    PerfLoadEvt *e;
+    bool posted;
+
+    ++data->seq;
+    ++data->sent;
+    Q_NEW_X(e, PerfLoadEvt, 0U, LOAD_SIG);
+    if (e == (PerfLoadEvt *)0) {
+        ++data->dropped;  /* event pool exhausted */
+        return;
+    }
+    e->intended = intended;
+    e->posted = now;
+    if (s_staged) { /* from thread context, see generator_thread_func() */
+        posted = QF_postFromISR(sink, &e->super);
+        if (!posted) {
+            QF_gc(&e->super);
+        }
+    }
+    else {
+        posted = QACTIVE_POST_X(sink, &e->super, 0U, data);
+    }
+    if (!posted) {
+        ++data->dropped;
+    }
+}
+
+/*
+ * Wakes up every tick and posts the arrivals that are due. It runs in a
+ * thread rather than in a timer ISR, because the QF critical section of the
+ * RT-Thread port only locks the scheduler, so Q_NEW() is not ISR-safe.
+ * The "staged" mode therefore measures the QF_postFromISR() staging path
+ * called from thread context, not the interrupt entry and exit.
+ */
+static void generator_thread_func(void *parameter)
+{
+    openloop_test_data_t *data = (openloop_test_data_t *)parameter;
+
+    while (data->test_running) {
+        rt_uint32_t now;
+        rt_uint32_t n = 0;
+
+        rt_thread_delay(1);
+        if (!data->generating) {
+            continue;
+        }
+        /* the arrivals exceeding the limit per tick keep their intended
+         * time, so the generator lag counts in the latency as well
+         */
+        now = dwt_get_cycles();
+        while ((rt_int32_t)(now - data->next) >= 0 && n < OPENLOOP_MAX_PER_TICK) {
+            post_one(data, data->next, now);
+            data->next += next_gap(data);
+            n++;
+        }
+    }
+    data->gen_exited = RT_TRUE;
+}
+
+/* stop the generator thread and wait for it to exit, or delete it when
+ * the test is stopped before it runs
+ */
+static void generator_stop(openloop_test_data_t *data)
+{
+    data->generating = RT_FALSE;
+    data->test_running = RT_FALSE; /* the generator thread exits */
+    if (data->gen_thread == RT_NULL) {
+        return;
+    }
+    if (data->gen_started) {
+        while (!data->gen_exited) {
+            rt_thread_mdelay(1);
+        }
+    }
+    else {
+        rt_thread_delete(data->gen_thread);
+    }
+    data->gen_thread = RT_NULL;
+}
+
+/*==========================================================================*/
+/* Sink AO */
+/*==========================================================================*/
+static QState LoadSink_active(LoadSink * const me, QEvt const * const e)
+{
+    QState status;
+
+    switch (e->sig) {
+        case LOAD_SIG: {
+            PerfLoadEvt const *le = Q_EVT_CAST(PerfLoadEvt);
+            openloop_test_data_t *data = &s_openloop_data;
+            rt_uint32_t now = dwt_get_cycles();
+
+            /* the sinks run at different priorities */
+            rt_enter_critical();
+            perf_hist_add(&data->lat, now - le->intended);
+            perf_hist_add(&data->naive, now - le->posted);
+            perf_test_sample(data->tc, now - le->intended);
+            ++data->done;
+            rt_exit_critical();
+
+            /* simulate the processing of the event */
+            while ((dwt_get_cycles() - now) < me->work) {
+            }
+            status = Q_HANDLED();
+            break;
+        }
+        default: {
+            status = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status;
+}
+
+static QState LoadSink_initial(LoadSink * const me, QEvt const * const e)
+{
+    (void)e; /* Unused parameter */
+    (void)me;
+    return Q_TRAN(&LoadSink_active);
+}
+
+/*==========================================================================*/
+/* Test Implementation Functions */
+/*==========================================================================*/
+static int openloop_test_init(perf_test_case_t *tc)
+{
+    rt_uint32_t c0;
+    rt_uint8_t i;
+
+    dwt_init();
+
+    rt_memset(&s_openloop_data, 0, sizeof(s_openloop_data));
+    s_openloop_data.tc = tc;
+    s_openloop_data.rng = 0x2545F491U;
+    s_openloop_data.test_running = RT_TRUE;
+    tc->stats.unit = "cycles";
+    tc->user_data = &s_openloop_data;
+    tc->report_json = &openloop_report_json;
+    tc->iterations = 0;
+
+    /* calibrate the cycle counter against the system tick */
+    rt_thread_delay(1);
+    c0 = dwt_get_cycles();
+    rt_thread_delay(RT_TICK_PER_SECOND / 10);
+    s_openloop_data.cyc_per_tick = (dwt_get_cycles() - c0)
+                                   / (RT_TICK_PER_SECOND / 10);
+    if (s_openloop_data.cyc_per_tick == 0U) {
+        s_openloop_data.cyc_per_tick = 1U;
+    }
+
+    /* the AO threads cannot be stopped, so the sinks outlive the test */
+    for (i = 0; i < OPENLOOP_SINKS; i++) {
+        s_sinks[i].work = s_work;
+        if (!s_sinks_started) {
+            QActive_ctor(&s_sinks[i].super, Q_STATE_CAST(&LoadSink_initial));
+            QActive_setAttr(&s_sinks[i].super, THREAD_NAME_ATTR, "ol_sink");
+            QActive_start_(&s_sinks[i].super,
+                           OPENLOOP_SINK_PRIO + i,
+                           s_sinkQueueSto[i], OPENLOOP_QUEUE_LEN,
+                           s_sinkStack[i], sizeof(s_sinkStack[i]),
+                           (void *)0);
+        }
+    }
+    s_sinks_started = RT_TRUE;
+
+    s_openloop_data.gen_thread = rt_thread_create("ol_gen",
+                                                  generator_thread_func,
+                                                  &s_openloop_data,
+                                                  1024,
+                                                  OPENLOOP_GEN_PRIORITY,
+                                                  10);
+
+    rt_kprintf("[OpenLoop Test] Initialized - arrival=%s post=%s sinks=%u work=%u cycles, %u cycles/tick\n",
+               arrival_name(),
+               s_staged ? "QF_postFromISR (thread)" : "QACTIVE_POST",
+               OPENLOOP_SINKS, s_work, s_openloop_data.cyc_per_tick);
+
+    return (s_openloop_data.gen_thread != RT_NULL) ? 0 : -1;
+}
+
+/* run one step of the curve at the given offered rate */
+static void openloop_step(openloop_test_data_t *data, rt_uint32_t rate)
+{
+    openloop_point_t *pt = &data->curve[data->n_points];
+    rt_uint32_t done;
+    rt_uint32_t waited = 0;
+
+    rt_enter_critical();
+    perf_hist_reset(&data->lat);
+    perf_hist_reset(&data->naive);
+    data->sent = data->dropped = data->done = 0;
+    rt_exit_critical();
+
+    data->interval = (rt_uint32_t)((rt_uint64_t)data->cyc_per_tick
+                                   * RT_TICK_PER_SECOND / rate);
+    data->burst = OPENLOOP_BURST_LEN;
+    data->next = dwt_get_cycles() + data->interval;
+    data->generating = RT_TRUE;
+    rt_thread_mdelay(OPENLOOP_STEP_MS);
+    data->generating = RT_FALSE;
+    done = data->done;
+
+    /* let the sinks dispatch the queued events, their latency counts too */
+    while (data->done + data->dropped < data->sent && waited < OPENLOOP_DRAIN_MS) {
+        rt_thread_mdelay(10);
+        waited += 10;
+    }
+
+    rt_enter_critical();
+    pt->offered = rate;
+    pt->achieved = (rt_uint32_t)((rt_uint64_t)done * 1000U / OPENLOOP_STEP_MS);
+    pt->dropped = data->dropped;
+    pt->p50 = cycles_to_us(perf_hist_percentile(&data->lat, 500U));
+    pt->p90 = cycles_to_us(perf_hist_percentile(&data->lat, 900U));
+    pt->p99 = cycles_to_us(perf_hist_percentile(&data->lat, 990U));
+    pt->max = cycles_to_us(data->lat.max);
+    pt->naive_p99 = cycles_to_us(perf_hist_percentile(&data->naive, 990U));
+    rt_exit_critical();
+
+    data->tc->iterations += data->done;
+    data->n_points++;
+}
+
+static int openloop_test_run(perf_test_case_t *tc)
+{
+    openloop_test_data_t *data = (openloop_test_data_t *)tc->user_data;
+    rt_uint32_t rate;
+    rt_uint8_t i;
+    rt_uint32_t saturation = 0;
+
+    rt_kprintf("[OpenLoop Test] Starting open-loop load steps...\n");
+
+    data->gen_started = RT_TRUE;
+    rt_thread_startup(data->gen_thread);
+    for (rate = OPENLOOP_RATE_MIN;
+         data->test_running && rate <= OPENLOOP_RATE_MAX
+         && data->n_points < OPENLOOP_STEPS_MAX;
+         rate *= 2U) {
+        openloop_step(data, rate);
+    }
+    generator_stop(data);
+
+    rt_kprintf("[OpenLoop Test] Throughput vs. latency (latency from the intended send time):\n");
+    rt_kprintf("  offered  achieved  dropped  p50(us)  p90(us)  p99(us)  max(us)  naive-p99(us)\n");
+    for (i = 0; i < data->n_points; i++) {
+        openloop_point_t const *pt = &data->curve[i];
+        rt_kprintf("  %7u  %8u  %7u  %7u  %7u  %7u  %7u  %13u\n",
+                   pt->offered, pt->achieved, pt->dropped,
+                   pt->p50, pt->p90, pt->p99, pt->max, pt->naive_p99);
+        /* saturated: losing events or falling behind the offered rate */
+        if (saturation == 0U && (pt->dropped > 0U
+                                 || pt->achieved < pt->offered - pt->offered / 20U)) {
+            saturation = pt->offered;
+        }
+    }
+    if (saturation != 0U) {
+        rt_kprintf("[OpenLoop Test] Saturates at ~%u events/s\n", saturation);
+    }
+    else {
+        rt_kprintf("[OpenLoop Test] No saturation up to %u events/s\n",
+                   OPENLOOP_RATE_MAX);
+    }
+    return 0;
+}
+
+/* the curve points for the host comparator (perf report json) */
+static int openloop_report_json(perf_test_case_t *tc)
+{
+    openloop_test_data_t *data = (openloop_test_data_t *)tc->user_data;
+    rt_uint8_t i;
+
+    for (i = 0; i < data->n_points; i++) {
+        openloop_point_t const *pt = &data->curve[i];
+        rt_kprintf("PERF-CURVE {\"name\":\"%s\",\"offered\":%u,\"achieved\":%u,"
+                   "\"dropped\":%u,\"p50\":%u,\"p90\":%u,\"p99\":%u,\"max\":%u,"
+                   "\"naive_p99\":%u,\"unit\":\"us\"}\n",
+                   tc->name, pt->offered, pt->achieved, pt->dropped,
+                   pt->p50, pt->p90, pt->p99, pt->max, pt->naive_p99);
+    }
+    return 0;
+}
+
+static int openloop_test_stop(perf_test_case_t *tc)
+{
+    openloop_test_data_t *data = (openloop_test_data_t *)tc->user_data;
+    if (data) {
+        generator_stop(data);
+    }
+
+    rt_kprintf("[OpenLoop Test] Stopped\n");
+    return 0;
+}
+
+/* Register the test case */
+PERF_TEST_REG(openloop, openloop_test_init, openloop_test_run, openloop_test_stop);
+
+/*
+ * openloop_cfg [const|poisson|burst] [post|staged] [work_cycles]
+ * Select the arrival process, the posting path (staged posts through
+ * QF_postFromISR and needs the QF optimization layer enabled) and the
+ * busy-work of the sinks.
+ */
+static int cmd_openloop_cfg(int argc, char **argv)
+{
+    if (argc > 1) {
+        s_arrival = (strcmp(argv[1], "poisson") == 0) ? OPENLOOP_ARRIVAL_POISSON
+                  : (strcmp(argv[1], "burst") == 0)   ? OPENLOOP_ARRIVAL_BURST
+                  : OPENLOOP_ARRIVAL_CONST;
+    }
+    if (argc > 2) {
+        s_staged = (strcmp(argv[2], "staged") == 0) ? RT_TRUE : RT_FALSE;
+    }
+    if (argc > 3) {
+        s_work = (rt_uint32_t)atoi(argv[3]);
+    }
+    rt_kprintf("openloop: arrival=%s post=%s work=%u cycles\n",
+               arrival_name(),
+               s_staged ? "staged" : "post", s_work);
+    return 0;
+}
+MSH_CMD_EXPORT(cmd_openloop_cfg, openloop_cfg [const|poisson|burst] [post|staged] [work_cycles]);
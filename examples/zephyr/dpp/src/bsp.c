@@ -199,8 +199,8 @@ static void uart_cb(const struct device *dev, void *user_data) {
     if (uart_irq_rx_ready(uart_dev)) {
         uint8_t buf[32];
         int n = uart_fifo_read(uart_dev, buf, sizeof(buf));
-        for (uint8_t const *p = buf; n > 0; --n, ++p) {
-            QS_RX_PUT(*p);
+        if (n > 0) {
+            (void)QS_rxPutBuf(buf, (uint16_t)n);
         }
     }
 }
@@ -113,6 +113,14 @@
 #if (QF_EVENT_SIZ_SIZE != 1U) && (QF_EVENT_SIZ_SIZE != 2U) && (QF_EVENT_SIZ_SIZE != 4U)
 #error QF_EVENT_SIZ_SIZE defined incorrectly, expected 1U, 2U, or 4U;
 #endif /*  (QF_EVENT_SIZ_SIZE != 1U) && (QF_EVENT_SIZ_SIZE != 2U) && (QF_EVENT_SIZ_SIZE != 4U) */
+
+/*${QF-config::QF_DEFER_BUCKETS} ...........................................*/
+#ifndef QF_DEFER_BUCKETS
+/*! Maximum number of buckets of a ::QDeferQueue (configurable in qf_port.h)
+* Valid values: 1U..8U, or up to the number of bits in ::QPSetBits
+*/
+#define QF_DEFER_BUCKETS 8U
+#endif /* ndef QF_DEFER_BUCKETS */
 /*$enddecl${QF-config} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 
 /*==========================================================================*/
@@ -336,6 +344,96 @@ static inline uint_fast8_t QPSet_findMax(QPSet const * const me) {
 * bit corresponds to the unique QF-priority of an AO (see ::QPrioSpec).
 */
 typedef QPSet QSubscrList;
+
+/*${QF-types::QDeferSlot} ..................................................*/
+/*! Storage slot of a ::QDeferQueue (provided by the application) */
+typedef struct QDeferSlot {
+    QEvt const *e;           /*!< the deferred event */
+    struct QDeferSlot *next; /*!< next slot in the bucket or in free list */
+    QTimeEvtCtr deadline;    /*!< expiration tick (valid when 'ttl' set) */
+    bool ttl;                /*!< does the deferred event expire? */
+} QDeferSlot;
+
+/*${QF-types::QDeferQueue} .................................................*/
+/*! Deferred-event queue with buckets of different urgency
+*
+* @details
+* The deferred events are kept in up to #QF_DEFER_BUCKETS FIFO buckets
+* selected by the AO when it defers an event, for example by the priority
+* (urgency) of the request or by its signal. The bucket with the highest
+* number is recalled first. All operations are O(1), except the batch
+* recall, which is O(n) in the number of recalled events and takes
+* a single critical section with the native QF event queue.
+*
+* Events deferred with QActive_deferTTL() expire after the given number
+* of clock ticks (see QDeferQueue_setExpiry()). The expired events are
+* detected at the head of the buckets when recalling, and in all the
+* buckets by QActive_expireDeferred(), which is also called when deferring
+* into a full queue. The expired events are either garbage-collected, or
+* a notification with the signal `expSig` is recalled instead, so that the
+* AO can respond to the stale request. The notification is a copy of
+* a dynamic event, or a bare ::QEvt for an immutable event. The expired
+* events are counted in QDeferQueue::nExpired.
+*
+* @note
+* Unlike the "raw" ::QEQueue, a ::QDeferQueue is not thread-safe and must
+* be accessed only by the AO that owns it.
+*
+* @sa QDeferQueue_init(), QActive_deferKey(), QActive_deferTTL(),
+* QActive_recallKey(), QActive_recallTop(), QActive_recallBatch(),
+* QActive_flushDeferQueue()
+*/
+typedef struct QDeferQueue {
+    QDeferSlot *head[QF_DEFER_BUCKETS]; /*!< oldest event of each bucket */
+    QDeferSlot *tail[QF_DEFER_BUCKETS]; /*!< newest event of each bucket */
+    uint16_t nUsed[QF_DEFER_BUCKETS]; /*!< number of events in each bucket */
+    QDeferSlot *freeList; /*!< list of the free slots */
+    QPSetBits bits;       /*!< set of the non-empty buckets */
+    uint16_t nFree;       /*!< number of free slots */
+    uint16_t nMin;        /*!< minimum number of free slots ever */
+    uint8_t  nBuckets;    /*!< number of buckets in use */
+    uint8_t  tickRate;    /*!< tick rate of the time-to-live */
+    enum_t   expSig;      /*!< signal of the expired events (0 for none) */
+    uint32_t nExpired;    /*!< number of the expired events */
+} QDeferQueue;
+
+/*${QF-types::QDeferQueue_init} ............................................*/
+/*! Initialize a ::QDeferQueue with the given storage
+* @public @memberof QDeferQueue
+*
+* @param[in,out] me       pointer (see @ref oop)
+* @param[in]     slots    storage for the deferred events
+* @param[in]     nSlots   number of slots in the storage
+* @param[in]     nBuckets number of buckets (1..#QF_DEFER_BUCKETS)
+*/
+void QDeferQueue_init(
+    QDeferQueue * const me,
+    QDeferSlot * const slots,
+    uint_fast16_t const nSlots,
+    uint_fast8_t const nBuckets);
+
+/*${QF-types::QDeferQueue_setExpiry} .......................................*/
+/*! Configure the expiration of the events deferred in a ::QDeferQueue
+* @public @memberof QDeferQueue
+*
+* @param[in,out] me       pointer (see @ref oop)
+* @param[in]     tickRate clock tick rate of the time-to-live
+* @param[in]     expSig   signal of the recalled notification of an
+*                         expired event, or 0 to garbage-collect the
+*                         expired events
+*/
+void QDeferQueue_setExpiry(
+    QDeferQueue * const me,
+    uint_fast8_t const tickRate,
+    enum_t const expSig);
+
+/*${QF-types::QDeferQueue_getCount} ........................................*/
+/*! Number of events deferred in a ::QDeferQueue bucket
+* @public @memberof QDeferQueue
+*/
+uint_fast16_t QDeferQueue_getCount(
+    QDeferQueue const * const me,
+    uint_fast8_t const bucket);
 /*$enddecl${QF-types} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 /*$declare${QF::QActive} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 
@@ -591,6 +689,27 @@ void QActive_postLIFO_(QActive * const me,
 */
 QEvt const * QActive_get_(QActive * const me);
 
+/*! Get up to `nMax` events from the AO's event queue at once (used only
+* inside QF ports with the batch-drain mode of the AO event loops)
+* @private @memberof QActive
+*
+* @details
+* Same as QActive_get_(), but after the first event arrives all the
+* events available in the queue, up to `nMax`, are removed from the queue
+* in one critical section. Every removed event is traced as with
+* QActive_get_().
+*
+* @param[in,out] me   current instance pointer (see @ref oop)
+* @param[out]    evts array receiving the events
+* @param[in]     nMax capacity of the array `evts` (> 0)
+*
+* @returns
+* The number of the events copied to `evts` (at least 1).
+*/
+uint_fast16_t QActive_getN_(QActive * const me,
+    QEvt const * evts[],
+    uint_fast16_t const nMax);
+
 /* public: */
 
 /*! Subscribes for delivery of signal `sig` to the active object
@@ -814,6 +933,117 @@ bool QActive_recall(QActive * const me,
 uint_fast16_t QActive_flushDeferred(QActive const * const me,
     QEQueue * const eq);
 
+/*! Defer an event to a given bucket of a ::QDeferQueue
+* @protected @memberof QActive
+*
+* @details
+* Similar to QActive_defer(), but the event is appended to the bucket
+* `bucket` of the priority-ordered deferred queue `dq`. The bucket can
+* stand for the urgency of the event (higher number is recalled first)
+* or for the signal of the event (e.g., `e->sig - FIRST_DEFERRED_SIG`),
+* in which case QActive_recallKey() recalls the events by signal.
+*
+* @param[in] dq     pointer to the deferred queue owned by this AO
+* @param[in] e      pointer to the event to be deferred
+* @param[in] bucket bucket of the deferred event (0..dq->nBuckets-1)
+*
+* @returns
+* 'true' (success) when the event could be deferred and 'false'
+* (failure) if the deferred queue has no free slots.
+*/
+bool QActive_deferKey(QActive * const me,
+    QDeferQueue * const dq,
+    QEvt const * const e,
+    uint_fast8_t const bucket);
+
+/*! Defer an event with a time-to-live to a given ::QDeferQueue bucket
+* @protected @memberof QActive
+*
+* @details
+* Same as QActive_deferKey(), but the event expires `ttl` clock ticks
+* (at the rate set by QDeferQueue_setExpiry()) after deferring. When the
+* queue is full, the expired events in all the buckets are expired first
+* (see QActive_expireDeferred()) to make room for the new one.
+*
+* @param[in] ttl  time-to-live [ticks], 0 for no expiration, at most
+*                 half of the range of ::QTimeEvtCtr
+*/
+bool QActive_deferTTL(QActive * const me,
+    QDeferQueue * const dq,
+    QEvt const * const e,
+    uint_fast8_t const bucket,
+    QTimeEvtCtr const ttl);
+
+/*! Recall the oldest deferred event from a given ::QDeferQueue bucket
+* @protected @memberof QActive
+*
+* @details
+* The event is removed from the bucket and posted (LIFO) to the event
+* queue of the AO. The reference held by the deferred queue is handed
+* over to the AO's queue after posting, in a single critical section.
+*
+* @returns
+* 'true' if an event has been recalled and 'false' if the bucket is empty.
+*/
+bool QActive_recallKey(QActive * const me,
+    QDeferQueue * const dq,
+    uint_fast8_t const bucket);
+
+/*! Recall the oldest event of the highest non-empty ::QDeferQueue bucket
+* @protected @memberof QActive
+*
+* @returns
+* 'true' if an event has been recalled and 'false' if `dq` is empty.
+*/
+bool QActive_recallTop(QActive * const me,
+    QDeferQueue * const dq);
+
+/*! Recall up to `nMax` deferred events from a ::QDeferQueue at once
+* @protected @memberof QActive
+*
+* @details
+* The events are taken from the highest non-empty bucket first and are
+* posted (LIFO) to the event queue of the AO, so that the AO processes
+* them next in the order of the buckets and in the FIFO order within
+* each bucket. With the native QF event queue, all the recalled events are
+* linked into the AO's queue and the references held by the deferred queue
+* are handed over to it in one critical section.
+*
+* @note
+* The AO's event queue must be able to accept all the recalled events.
+*
+* @returns
+* the number of events actually recalled.
+*/
+uint_fast16_t QActive_recallBatch(QActive * const me,
+    QDeferQueue * const dq,
+    uint_fast16_t const nMax);
+
+/*! Expire all the stale events deferred in a ::QDeferQueue
+* @protected @memberof QActive
+*
+* @details
+* Sweeps all the buckets of `dq` and expires the events whose time-to-live
+* has elapsed, also behind the live events at the head of the buckets.
+* The notifications with the signal `expSig` (see QDeferQueue_setExpiry())
+* are posted (LIFO) to the event queue of the AO. The cost is O(n) in
+* the number of deferred events.
+*
+* @returns
+* the number of the expired events.
+*/
+uint_fast16_t QActive_expireDeferred(QActive * const me,
+    QDeferQueue * const dq);
+
+/*! Flush all the events deferred in a ::QDeferQueue
+* @protected @memberof QActive
+*
+* @returns
+* the number of events actually flushed from the queue.
+*/
+uint_fast16_t QActive_flushDeferQueue(QActive const * const me,
+    QDeferQueue * const dq);
+
 /* public: */
 
 /*! Generic setting of additional attributes (useful in QP ports)
@@ -924,6 +1154,151 @@ extern enum_t QActive_maxPubSignal_;
 */
 extern QActive * QActive_registry_[QF_MAX_ACTIVE + 1U];
 /*$enddecl${QF::QActive} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+
+/*==========================================================================*/
+#ifdef QF_RTC_TIME
+/* RTC-step budget of the active objects, enabled when the QF port
+* defines the high-resolution time source QF_RTC_TIME(), see ::QRtcStat
+*/
+
+#ifndef QF_RTC_BUCKETS
+/*! Number of the log2 buckets of the RTC-step histogram of every AO
+* (configurable value in qf_port.h, the last bucket collects all the
+* longer steps)
+*/
+#define QF_RTC_BUCKETS 16U
+#endif /* ndef QF_RTC_BUCKETS */
+
+/*! Duration of an RTC step in the units of QF_RTC_TIME() */
+typedef uint32_t QRtcTime;
+
+/*! RTC-step statistics of an active object
+*
+* @details
+* When the QF port defines QF_RTC_TIME(), the event loops dispatch events
+* through QF_RTC_DISPATCH_(), which measures every RTC step of the AOs and
+* collects the statistics below. When a step takes longer than the budget
+* set with QActive_setRtcBudget(), the overrun is counted, the handler set
+* by QF_setRtcOverrunHandler() is called and the ::QS_RTC_OVERRUN record
+* is produced, both with the state and the signal of the offending step.
+*
+* @note
+* The statistics are updated by the thread of the AO only, so reading
+* them from other threads might see a partially updated snapshot.
+*/
+typedef struct {
+    QRtcTime budget;    /*!< RTC-step budget, 0 for no budget */
+    QRtcTime max;       /*!< the longest RTC step */
+    QSignal  maxSig;    /*!< signal of the longest RTC step */
+    QStateHandler maxState; /*!< state that started the longest RTC step */
+    uint32_t nSteps;    /*!< number of the measured RTC steps */
+    uint32_t nOverruns; /*!< number of the RTC steps over the budget */
+    uint64_t total;     /*!< total duration of the measured RTC steps */
+    uint32_t hist[QF_RTC_BUCKETS]; /*!< log2 histogram of the RTC steps */
+} QRtcStat;
+
+/*! Handler of the RTC-step overruns, called in the thread of the AO
+* with the event, the state that started the step and its duration
+*/
+typedef void (*QRtcOverrunHandler)(QActive const * const act,
+    QEvt const * const e,
+    QStateHandler const state,
+    QRtcTime const dt);
+
+/*! Set the RTC-step budget of an active object
+* @public @memberof QActive
+*
+* @param[in] budget  longest allowed RTC step in the units of
+*                    QF_RTC_TIME(), 0 for no budget
+*/
+void QActive_setRtcBudget(QActive * const me,
+    QRtcTime const budget);
+
+/*! RTC-step statistics of an active object
+* @public @memberof QActive
+*/
+QRtcStat const *QActive_getRtcStat(QActive const * const me);
+
+/*! Percentile of the RTC-step durations of an active object
+* @public @memberof QActive
+*
+* @param[in] pct  percentile [1..100]
+*
+* @returns
+* the upper bound of the histogram bucket containing the given percentile
+* of the RTC steps (the maximum for the last bucket), or 0 when no steps
+* have been measured yet.
+*/
+QRtcTime QActive_getRtcPercentile(QActive const * const me,
+    uint_fast8_t const pct);
+
+/*! Reset the RTC-step statistics (but not the budget) of an active object
+* @public @memberof QActive
+*/
+void QActive_resetRtcStat(QActive * const me);
+
+/*! Set the handler of the RTC-step overruns (NULL for none)
+* @static @public @memberof QF
+*/
+void QF_setRtcOverrunHandler(QRtcOverrunHandler const handler);
+
+/*! Dispatch an event to an active object, measuring the RTC step
+* @private @memberof QActive
+*
+* @details
+* Should be called only through the macro QF_RTC_DISPATCH_().
+*/
+void QActive_rtcDispatch_(QActive * const me,
+    QEvt const * const e,
+    uint_fast8_t const qs_id);
+
+#endif /* QF_RTC_TIME */
+
+/*==========================================================================*/
+#ifdef QF_AO_TELEM
+/* Telemetry of the active objects, enabled by defining QF_AO_TELEM in
+* qf_port.h (or on the command line), see QActive_getTelem()
+*/
+
+/*! Telemetry of an active object, see QActive_getTelem()
+*
+* @details
+* The fields that the QF port cannot measure are 0. The RTC-step times
+* are available only when the QF port defines QF_RTC_TIME().
+*/
+typedef struct {
+    uint32_t nDispatch; /*!< number of the events dispatched to the AO */
+    uint32_t rtcAvg;    /*!< average RTC step [QF_RTC_TIME() units] */
+    uint32_t rtcMax;    /*!< longest RTC step [QF_RTC_TIME() units] */
+    uint32_t stackSize; /*!< size of the stack of the AO [bytes] */
+    uint32_t stackUsed; /*!< high-water mark of the stack [bytes] */
+    uint16_t queueSize; /*!< capacity of the event queue of the AO */
+    uint16_t queueMax;  /*!< high-water mark of the event queue */
+} QActiveTelem;
+
+/*! Telemetry of an active object
+* @public @memberof QActive
+*
+* @details
+* Sampling the telemetry is cheap (except the stack scan on the RTOS
+* ports, which is proportional to the unused part of the stack), so it
+* can be done periodically in production, e.g., with QF_telemTrace().
+*/
+void QActive_getTelem(QActive const * const me,
+    QActiveTelem * const telem);
+
+/*! Produce the ::QS_AO_TELEM record for every registered active object
+* @static @public @memberof QF
+*/
+void QF_telemTrace(void);
+
+/*! Queue and stack telemetry of an active object provided by the QF port
+* @private @memberof QActive
+*/
+void QActive_getPortTelem_(QActive const * const me,
+    QActiveTelem * const telem);
+
+#endif /* QF_AO_TELEM */
 /*$declare${QF::QActiveVtable} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 
 /*${QF::QActiveVtable} .....................................................*/
@@ -1710,6 +2085,173 @@ QEvt const * QF_newRef_(
 */
 void QF_deleteRef_(void const * const evtRef);
 /*$enddecl${QF::QF-dyn} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+
+/*==========================================================================*/
+#ifdef QF_POOL_STATS
+/* Event-pool sizing instrumentation, enabled by defining QF_POOL_STATS
+* in qf_port.h (or on the command line), see QF_poolAdvise()
+*/
+
+#ifndef QF_POOL_STAT_SIZES
+/*! Number of the distinct event sizes tracked by the pool statistics
+* (configurable value in qf_port.h). An event size beyond this number is
+* merged with the next larger tracked size (or it enlarges the largest).
+*/
+#define QF_POOL_STAT_SIZES 8U
+#endif /* ndef QF_POOL_STAT_SIZES */
+
+#ifndef QF_POOL_STAT_SIGS
+/*! Number of the signals with their own in-flight counters (configurable
+* value in qf_port.h), the higher signals share the last counter
+*/
+#define QF_POOL_STAT_SIGS 64U
+#endif /* ndef QF_POOL_STAT_SIGS */
+
+#ifndef QF_POOL_NEAR_MISS
+/*! An allocation leaving at most this many free blocks in the pool
+* counts as a near-miss (configurable value in qf_port.h)
+*/
+#define QF_POOL_NEAR_MISS 1U
+#endif /* ndef QF_POOL_NEAR_MISS */
+
+/*! Allocation statistics of an event pool, see QF_getPoolStat() */
+typedef struct {
+    uint32_t nAlloc;    /*!< number of the successful allocations */
+    uint32_t nFail;     /*!< number of the failed allocations (with margin) */
+    uint32_t nNearMiss; /*!< allocations leaving <= #QF_POOL_NEAR_MISS free */
+    uint16_t blockSize; /*!< block size of the pool [bytes] */
+    uint16_t nTot;      /*!< number of blocks in the pool */
+    uint16_t peak;      /*!< peak number of blocks in use (nTot - nMin) */
+    uint8_t  wastePct;  /*!< internal fragmentation of the allocations [%] */
+} QPoolStat;
+
+/*! Statistics of the allocations of one event size, see QF_getSizeStat() */
+typedef struct {
+    uint16_t evtSize;   /*!< the requested event size [bytes] */
+    uint16_t peak;      /*!< peak number of such events in flight */
+    uint32_t nAlloc;    /*!< number of the allocations */
+} QPoolSizeStat;
+
+/*! Recommended event pool, see QF_poolAdvise() */
+typedef struct {
+    uint16_t evtSize;   /*!< event size for QF_poolInit() [bytes] */
+    uint16_t nBlocks;   /*!< number of the blocks */
+    uint32_t poolSize;  /*!< size of the pool storage [bytes] */
+} QPoolAdvice;
+
+/*! Allocation statistics of the given event pool
+* @static @public @memberof QF
+*
+* @param[in]  poolId  event pool ID in the range 1..QF_maxPool_
+* @param[out] stat    the statistics of the pool
+*/
+void QF_getPoolStat(uint_fast8_t const poolId,
+    QPoolStat * const stat);
+
+/*! Statistics of the tracked event sizes in the ascending order
+* @static @public @memberof QF
+*
+* @param[out] stat  array of at least @p max entries
+* @param[in]  max   capacity of the @p stat array
+*
+* @returns the number of the entries filled in @p stat
+*/
+uint_fast8_t QF_getSizeStat(QPoolSizeStat * const stat,
+    uint_fast8_t const max);
+
+/*! Peak number of the dynamic events with the given signal in flight
+* @static @public @memberof QF
+*/
+uint_fast16_t QF_getSigPeak(enum_t const sig);
+
+/*! Recommend the event pools with the least RAM for the observed workload
+* @static @public @memberof QF
+*
+* @details
+* The recommended pools hold the peak numbers of the events in flight
+* observed since QF_poolInit() or QF_resetPoolStat(). The peaks are tracked
+* for every range of the event sizes, so the advice accounts for the events
+* of different sizes sharing a pool not being at their peaks at the same
+* time. Every pool gets @p headroom percent more blocks than the observed
+* peak, but at least one more block.
+*
+* @param[out] advice    array of at least @p maxPools entries
+* @param[in]  maxPools  maximum number of the pools (up to #QF_MAX_EPOOL)
+* @param[in]  headroom  extra blocks over the observed peaks [%]
+*
+* @returns the number of the recommended pools in @p advice, in the order
+* of the QF_poolInit() calls, or 0 when no events have been allocated.
+*/
+uint_fast8_t QF_poolAdvise(QPoolAdvice * const advice,
+    uint_fast8_t const maxPools,
+    uint_fast8_t const headroom);
+
+/*! Restart the pool statistics (the peaks from the events now in flight)
+* @static @public @memberof QF
+*/
+void QF_resetPoolStat(void);
+
+#endif /* QF_POOL_STATS */
+
+/*==========================================================================*/
+#ifdef QF_EVT_TRACK
+/* Lifetime tracking of the dynamic events, enabled by defining QF_EVT_TRACK
+* in qf_port.h (or on the command line), see QF_getLiveEvts()
+*/
+
+#ifndef QF_EVT_TRACK_MAX
+/*! Number of the event-pool blocks tracked (configurable value in
+* qf_port.h). The blocks of the pools are numbered in the order of the
+* QF_poolInit() calls and the blocks beyond this number are not tracked.
+*/
+#define QF_EVT_TRACK_MAX 256U
+#endif /* ndef QF_EVT_TRACK_MAX */
+
+/*! Sequence number of the event allocations
+* @static @private @memberof QF
+*/
+extern uint32_t QF_evtTrackSeq_;
+
+#ifndef QF_EVT_TRACK_TIME
+/*! Time-stamp of the event allocations (configurable in qf_port.h, e.g.,
+* the system clock tick). The default is the allocation sequence number.
+*/
+#define QF_EVT_TRACK_TIME() (QF_evtTrackSeq_)
+#endif /* ndef QF_EVT_TRACK_TIME */
+
+/*! Snapshot of a live dynamic event, see QF_getLiveEvts() */
+typedef struct {
+    QEvt const *e;       /*!< the event */
+    void const *sender;  /*!< the sender of the first post (or NULL) */
+    uint32_t age;        /*!< QF_EVT_TRACK_TIME() units since allocation */
+    QPSet holders;       /*!< priorities of the AOs holding the event */
+    QSignal sig;         /*!< the signal of the event */
+    uint8_t poolId;      /*!< the pool of the event */
+    uint8_t refCtr;      /*!< the reference counter of the event */
+} QEvtTrackInfo;
+
+/*! The oldest live dynamic events
+* @static @public @memberof QF
+*
+* @details
+* For every block of the event pools the tracker keeps a side-table entry
+* with the signal, the time of the allocation, the sender of the first
+* post and the set of the AOs holding the event. An AO holds an event
+* from posting it to the AO (QACTIVE_POST(), QACTIVE_PUBLISH()) until the
+* AO starts processing it, and from deferring it (QActive_defer()) until
+* recalling it. An event held by no AO is referenced from elsewhere
+* (e.g., QF_NEW_REF()) or it is leaked.
+*
+* @param[out] info  array of at least @p max entries, filled with the
+*                   oldest live events, the oldest first
+* @param[in]  max   capacity of the @p info array
+*
+* @returns the number of the live tracked events, which can exceed @p max
+*/
+uint_fast16_t QF_getLiveEvts(QEvtTrackInfo * const info,
+    uint_fast16_t const max);
+
+#endif /* QF_EVT_TRACK */
 /*$declare${QF::QF-extern-C} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 
 /*${QF::QF-extern-C::onContextSw} ..........................................*/
@@ -178,9 +178,16 @@ typedef struct QFreeBlock {
 * @trace
 * @tr{PQP11_8}
 */
+#ifndef QF_EVT_REFCTR_ATOMIC
 static inline void QEvt_refCtr_inc_(QEvt const *me) {
     ++((QEvt *)me)->refCtr_;
 }
+#else
+/* the QF port adjusts the refCtr also outside the QF critical section */
+static inline void QEvt_refCtr_inc_(QEvt const *me) {
+    (void)__atomic_fetch_add(&((QEvt *)me)->refCtr_, 1U, __ATOMIC_RELAXED);
+}
+#endif /* QF_EVT_REFCTR_ATOMIC */
 
 /*! decrement the refCtr of a const event (requires casting `const` away)
 * @private @memberof QEvt
@@ -188,8 +195,83 @@ static inline void QEvt_refCtr_inc_(QEvt const *me) {
 * @trace
 * @tr{PQP11_8}
 */
+#ifndef QF_EVT_REFCTR_ATOMIC
 static inline void QEvt_refCtr_dec_(QEvt const *me) {
     --((QEvt *)me)->refCtr_;
 }
+#else
+static inline void QEvt_refCtr_dec_(QEvt const *me) {
+    (void)__atomic_fetch_sub(&((QEvt *)me)->refCtr_, 1U, __ATOMIC_ACQ_REL);
+}
+#endif /* QF_EVT_REFCTR_ATOMIC */
+
+#if (defined QF_AO_TELEM) && (!defined QF_RTC_TIME)
+/*! number of the events dispatched to the AOs, indexed by AO priority
+* (without QF_RTC_TIME(), which counts the RTC steps in ::QRtcStat)
+* @static @private @memberof QActive
+*/
+extern uint32_t QActive_nDispatch_[QF_MAX_ACTIVE + 1U];
+#endif
+
+#ifndef QTIMEEVT_TICK_HOOK_
+/*! kernel-specific processing in every QTimeEvt_tick_() at the given
+* tick rate (e.g., the blocking timeouts in QXK)
+*/
+#define QTIMEEVT_TICK_HOOK_(tickRate_) ((void)0)
+#endif
+
+#ifdef QF_EVT_TRACK
+/*! record the event @p e posted to the AO with priority @p prio by
+* @p sender in the event tracker (in a critical section)
+* @static @private @memberof QF
+*/
+void QF_evtTrackPost_(QEvt const * const e,
+    uint_fast8_t const prio,
+    void const * const sender);
+
+/*! record the AO with priority @p prio no longer holding the event @p e
+* (in a critical section)
+* @static @private @memberof QF
+*/
+void QF_evtTrackRelease_(QEvt const * const e,
+    uint_fast8_t const prio);
+
+    #define QF_EVT_TRACK_POST_(e_, prio_, sender_) \
+        QF_evtTrackPost_((e_), (prio_), (sender_))
+#else
+    #define QF_EVT_TRACK_POST_(e_, prio_, sender_) ((void)0)
+#endif /* QF_EVT_TRACK */
+
+/*! dispatch an event to the AO `me_` in the event loops of the QF ports
+*
+* @details
+* When the QF port defines QF_RTC_TIME(), the RTC step is measured and
+* checked against the RTC budget of the AO (see ::QRtcStat). With
+* QF_EVT_TRACK, the AO stops holding the event in the event tracker.
+*/
+#ifdef QF_RTC_TIME
+    #define QF_RTC_STEP_(me_, e_, qs_id_) \
+        QActive_rtcDispatch_((me_), (e_), (qs_id_))
+#elif (defined QF_AO_TELEM)
+    #define QF_RTC_STEP_(me_, e_, qs_id_) do { \
+        ++QActive_nDispatch_[(me_)->prio]; \
+        QS_AGG_DISPATCH(&(me_)->super, (e_), (qs_id_)); \
+    } while (false)
+#else
+    #define QF_RTC_STEP_(me_, e_, qs_id_) \
+        QS_AGG_DISPATCH(&(me_)->super, (e_), (qs_id_))
+#endif
+#ifdef QF_EVT_TRACK
+    #define QF_RTC_DISPATCH_(me_, e_, qs_id_) do { \
+        QF_CRIT_STAT_ \
+        QF_CRIT_E_(); \
+        QF_evtTrackRelease_((e_), (me_)->prio); \
+        QF_CRIT_X_(); \
+        QF_RTC_STEP_((me_), (e_), (qs_id_)); \
+    } while (false)
+#else
+    #define QF_RTC_DISPATCH_(me_, e_, qs_id_) \
+        QF_RTC_STEP_((me_), (e_), (qs_id_))
+#endif
 
 #endif /* QF_PKG_H_ */
@@ -84,6 +84,67 @@
 #if (QS_TIME_SIZE != 1U) && (QS_TIME_SIZE != 2U) && (QS_TIME_SIZE != 4U)
 #error QS_TIME_SIZE defined incorrectly, expected 1U, 2U, or 4U;
 #endif /*  (QS_TIME_SIZE != 1U) && (QS_TIME_SIZE != 2U) && (QS_TIME_SIZE != 4U) */
+
+/*${QS-config::QS_RATE_MAX} ................................................*/
+#ifndef QS_RATE_MAX
+/*! Maximum number of the QS rate filters (0 disables the rate filters)
+*
+* @details
+* The QS rate filters are the third layer of filtering, applied to the
+* QS records already enabled by the global and local filters. A rate
+* filter for a record type or for a QS-ID passes only every n-th record
+* (1-in-n sampling) and/or at most one record per `period` (in the units
+* of QS_onGetTime()) with bursts of up to `burst` records (token bucket).
+* The suppressed records are counted and reported in the
+* ::QS_RATE_SUPPRESSED record preceding the next record passed by the
+* filter.
+*
+* @note
+* The rate filters are checked inside the QS critical section and
+* the port can enable them by defining QS_RATE_MAX in qs_port.h.
+*/
+#define QS_RATE_MAX 0U
+#endif /* ndef QS_RATE_MAX */
+
+/*${QS-config::QS_AGG_MAX} .................................................*/
+#ifndef QS_AGG_MAX
+/*! Maximum number of the QS aggregation counters (0 disables the QS
+* aggregation mode)
+*
+* @details
+* In the QS aggregation mode, turned on by QS_AGG_MODE(), the event loops
+* of the QF ports dispatch events through QS_AGG_DISPATCH(), which counts
+* the dispatched events and the state changes per AO, state and signal
+* and collects the log2-bucket histogram of the RTC-step durations per AO
+* (in the units of QS_onGetTime()), instead of producing the
+* ::QS_QEP_DISPATCH and ::QS_QEP_TRAN records. Every `period` the
+* aggregates are flushed as the ::QS_AGG_DISPATCH and ::QS_AGG_RTC
+* summary records. The counters are cumulative (modulo 2^32), so the host
+* obtains the rates from the differences of consecutive summaries.
+*
+* @note
+* Each counter covers one combination of AO, state and signal. The port
+* can enable the aggregation mode by defining QS_AGG_MAX in qs_port.h.
+*/
+#define QS_AGG_MAX 0U
+#endif /* ndef QS_AGG_MAX */
+
+/*${QS-config::QS_AGG_AO_MAX} ..............................................*/
+#ifndef QS_AGG_AO_MAX
+/*! Number of the RTC histograms (QS-IDs of AOs 0..QS_AGG_AO_MAX-1) */
+#define QS_AGG_AO_MAX (QF_MAX_ACTIVE + 1U)
+#endif /* ndef QS_AGG_AO_MAX */
+
+/*${QS-config::QS_AGG_BUCKETS} .............................................*/
+#ifndef QS_AGG_BUCKETS
+/*! Number of the log2 buckets of the RTC histograms
+*
+* @details
+* The bucket k > 0 counts the RTC steps lasting [2^(k-1), 2^k) ticks of
+* QS_onGetTime() and the last bucket also all the longer RTC steps.
+*/
+#define QS_AGG_BUCKETS 24U
+#endif /* ndef QS_AGG_BUCKETS */
 /*$enddecl${QS-config} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 
 /*==========================================================================*/
@@ -271,7 +332,21 @@ enum QSpyPre {
     QS_MTX_BLOCK_ATTEMPT, /*!< a mutex blocking was attempted */
     QS_MTX_UNLOCK_ATTEMPT,/*!< a mutex unlock was attempted */
 
-    /* [81] */
+    /* [81] QS rate filter and aggregation records (not maskable) */
+    QS_RATE_SUPPRESSED,   /*!< records suppressed by a QS rate filter */
+    QS_AGG_DISPATCH,      /*!< aggregated dispatch counters of a state */
+    QS_AGG_RTC,           /*!< aggregated RTC-step histogram of an AO */
+
+    /* [84] Deterministic replay records */
+    QS_REPLAY_EVT,        /*!< event consumed by an AO (with parameters) */
+
+    /* [85] RTC budget records */
+    QS_RTC_OVERRUN,       /*!< RTC step of an AO exceeded its budget */
+
+    /* [86] Telemetry records */
+    QS_AO_TELEM,          /*!< queue, RTC and stack telemetry of an AO */
+
+    /* [87] */
     QS_PRE_MAX            /*!< the number of predefined signals */
 };
 
@@ -346,6 +421,52 @@ typedef void (* QSpyFunPtr )(void);
 */
 typedef struct { uint8_t prio; } QSpyId;
 
+/*${QS::QSRateFilter} ......................................................*/
+#if (QS_RATE_MAX > 0U)
+/*! QS rate filter (1-in-n sampling and token bucket)
+* @static @private @memberof QS_tx
+*/
+typedef struct QSRateFilter {
+    QSTimeCtr period;     /*!< time per token, 0 for no token bucket */
+    QSTimeCtr last;       /*!< time of the last token refill */
+    uint32_t  suppressed; /*!< # suppressed records not reported yet */
+    uint16_t  n;          /*!< 1-in-n sampling, 0 or 1 for no sampling */
+    uint16_t  cnt;        /*!< sampling counter */
+    uint16_t  tokens;     /*!< tokens available in the bucket */
+    uint16_t  burst;      /*!< depth of the bucket */
+    uint8_t   kind;       /*!< ::QS_rateKind or 0 for unused filter */
+    uint8_t   key;        /*!< the record type or QS-ID */
+} QSRateFilter;
+#endif /*  (QS_RATE_MAX > 0U) */
+
+/*${QS::QSAggCtr} ..........................................................*/
+#if (QS_AGG_MAX > 0U)
+/*! QS aggregation counter of an AO, state and signal
+* @static @private @memberof QS_tx
+*/
+typedef struct QSAggCtr {
+    void const   *obj;   /*!< the AO or NULL for unused counter */
+    QStateHandler state; /*!< the state before the RTC step */
+    uint32_t      nDisp; /*!< # events dispatched in the state */
+    uint32_t      nTran; /*!< # RTC steps that changed the state */
+    QSignal       sig;   /*!< the signal of the dispatched events */
+    uint8_t       qs_id; /*!< QS-ID of the AO (for the local filter) */
+} QSAggCtr;
+#endif /*  (QS_AGG_MAX > 0U) */
+
+/*${QS::QSAggHist} .........................................................*/
+#if (QS_AGG_MAX > 0U)
+/*! QS aggregation RTC histogram of an AO
+* @static @private @memberof QS_tx
+*/
+typedef struct QSAggHist {
+    void const *obj;                 /*!< the AO or NULL when not used */
+    uint32_t    hist[QS_AGG_BUCKETS]; /*!< log2-bucket histogram */
+    QSTimeCtr   max;                 /*!< the longest RTC step */
+    uint32_t    lost;                /*!< # dispatches without counter */
+} QSAggHist;
+#endif /*  (QS_AGG_MAX > 0U) */
+
 /*${QS::QS-tx::tx} .........................................................*/
 /*! @brief Software tracing, output (QS-TX)
 * @class QS
@@ -549,6 +670,164 @@ void QS_glbFilter_(int_fast16_t const filter);
 */
 void QS_locFilter_(int_fast16_t const filter);
 
+/*${QS::QS-tx::rateKind} ...................................................*/
+#if (QS_RATE_MAX > 0U)
+/*! kinds of the QS rate filters */
+enum QS_rateKind {
+    QS_RATE_REC = 1U, /*!< rate filter for a QS record type */
+    QS_RATE_ID        /*!< rate filter for a QS-ID */
+};
+#endif /*  (QS_RATE_MAX > 0U) */
+
+/*${QS::QS-tx::rate} .......................................................*/
+#if (QS_RATE_MAX > 0U)
+/*! QS rate filters
+* @static @private @memberof QS_tx
+*/
+typedef struct QS_rate {
+    uint8_t recMask[16]; /*!< record types with a rate filter */
+    uint8_t idMask[16];  /*!< QS-IDs with a rate filter */
+    QSRateFilter filter[QS_RATE_MAX]; /*!< the rate filters */
+} QS_rate;
+#endif /*  (QS_RATE_MAX > 0U) */
+
+/*${QS::QS-tx::ratePriv_} ..................................................*/
+#if (QS_RATE_MAX > 0U)
+/*! the only instance of the QS rate filters */
+extern QS_rate QS_ratePriv_;
+#endif /*  (QS_RATE_MAX > 0U) */
+
+/*${QS::QS-tx::rateSet_} ...................................................*/
+#if (QS_RATE_MAX > 0U)
+/*! Set up or remove the QS rate filter for a record type or QS-ID
+* @static @public @memberof QS_tx
+*
+* @details
+* This function should be called indirectly through the macros
+* QS_REC_RATE() and QS_ID_RATE().
+*
+* @param[in] kind    ::QS_RATE_REC or ::QS_RATE_ID
+* @param[in] key     the record type or the QS-ID
+* @param[in] n       pass every n-th record (0 or 1 to pass all)
+* @param[in] period  time per passed record (0 for no rate limit)
+* @param[in] burst   max. number of records passed at once
+*
+* @note
+* The rate filter is removed when both `n` <= 1 and `period` == 0.
+*/
+void QS_rateSet_(
+    uint_fast8_t const kind,
+    uint_fast8_t const key,
+    uint_fast16_t const n,
+    QSTimeCtr const period,
+    uint_fast16_t const burst);
+#endif /*  (QS_RATE_MAX > 0U) */
+
+/*${QS::QS-tx::rateCheck_} .................................................*/
+#if (QS_RATE_MAX > 0U)
+/*! Check the QS rate filters for the record `rec` and QS-ID `qs_id`
+* @static @private @memberof QS_tx
+*
+* @note
+* Must be called inside the QS critical section, only when a rate filter
+* is set for `rec` or `qs_id` (see QS_RATE_CHECK_()). The record passes
+* only when all the matching filters allow it, and only then the tokens
+* are consumed (inside QS_GLB_CRIT_ENTRY()).
+*/
+bool QS_rateCheck_(
+    uint_fast8_t const rec,
+    uint_fast8_t const qs_id);
+#endif /*  (QS_RATE_MAX > 0U) */
+
+/*${QS::QS-tx::agg} ........................................................*/
+#if (QS_AGG_MAX > 0U)
+/*! QS aggregation mode
+* @static @private @memberof QS_tx
+*/
+typedef struct QS_agg {
+    QSAggCtr  ctr[QS_AGG_MAX];     /*!< dispatch counters */
+    QSAggHist rtc[QS_AGG_AO_MAX];  /*!< RTC histograms indexed by QS-ID */
+    QSTimeCtr period;  /*!< flush period, 0 when the mode is off */
+    QSTimeCtr last;    /*!< time of the last flush */
+    uint8_t   glbSave; /*!< saved global filters of the replaced records */
+} QS_agg;
+#endif /*  (QS_AGG_MAX > 0U) */
+
+/*${QS::QS-tx::aggPriv_} ...................................................*/
+#if (QS_AGG_MAX > 0U)
+/*! the only instance of the QS aggregation mode */
+extern QS_agg QS_aggPriv_;
+#endif /*  (QS_AGG_MAX > 0U) */
+
+/*${QS::QS-tx::aggMode_} ...................................................*/
+#if (QS_AGG_MAX > 0U)
+/*! Turn the QS aggregation mode on or off
+* @static @public @memberof QS_tx
+*
+* @details
+* This function should be called indirectly through the macro
+* QS_AGG_MODE().
+*
+* @param[in] period  time between the summary records (in the units of
+*                    QS_onGetTime()), 0 to turn the aggregation mode off
+*
+* @note
+* Turning the mode on clears the aggregates and disables the
+* ::QS_QEP_DISPATCH and ::QS_QEP_TRAN records. Turning it off flushes
+* the aggregates and restores the global filters of these records.
+*/
+void QS_aggMode_(QSTimeCtr const period);
+#endif /*  (QS_AGG_MAX > 0U) */
+
+/*${QS::QS-tx::aggDispatch_} ...............................................*/
+#if (QS_AGG_MAX > 0U)
+/*! Dispatch an event to an AO and aggregate the RTC step
+* @static @private @memberof QS_tx
+*
+* @note
+* Should be called only through the macro QS_AGG_DISPATCH().
+*/
+void QS_aggDispatch_(
+    QHsm * const me,
+    QEvt const * const e,
+    uint_fast8_t const qs_id);
+#endif /*  (QS_AGG_MAX > 0U) */
+
+/*${QS::QS-tx::aggFlush} ...................................................*/
+#if (QS_AGG_MAX > 0U)
+/*! Produce the summary records of the QS aggregation mode
+* @static @public @memberof QS_tx
+*
+* @details
+* Called periodically from QS_aggDispatch_() and can be also called
+* by the application, e.g., before QS_onCleanup().
+*/
+void QS_aggFlush(void);
+#endif /*  (QS_AGG_MAX > 0U) */
+
+/*${QS::QS-tx::replayEvt_} .................................................*/
+/*! Produce the ::QS_REPLAY_EVT record of an event consumed by an AO
+* @static @private @memberof QS_tx
+*
+* @details
+* The record carries the time-stamp, the priority of the AO, the signal
+* and the parameters of the event (the whole block of a dynamic event),
+* so that the host can re-run the exact event sequence consumed by the
+* AOs (see QS_REPLAY_REC()). The size of an immutable (static) event is
+* not known to QF, so its parameters cannot be recorded. Instead, the
+* length of the parameters is set to ::QS_REPLAY_IMMUTABLE and the replay
+* dispatches a bare ::QEvt with the recorded signal. This is exact for
+* the events without parameters (e.g., ::QTimeEvt), but not for the
+* immutable events with parameters, so the replay in the POSIX port
+* reports the number of the immutable events it dispatched.
+*
+* @note
+* Should be called only through the macro QS_REPLAY_REC().
+*/
+void QS_replayEvt_(
+    QEvt const * const e,
+    uint_fast8_t const prio);
+
 /*${QS::QS-tx::doOutput} ...................................................*/
 /*! Perform the QS-TX output (implemented in some QS ports)
 * @static @public @memberof QS_tx
@@ -951,6 +1230,13 @@ void QS_queryCurrObj(uint8_t const obj_kind);
 /*${QS::QS-rx::rxParse} ....................................................*/
 /*! Parse all bytes present in the QS-RX data buffer
 * @static @public @memberof QS_rx
+*
+* @details
+* Complete frames without any escaped bytes are parsed directly from the
+* QS-RX buffer, a whole frame at a time, after validating the checksum of
+* the entire frame, so that a corrupted frame has no side effects. Frames
+* with escaped bytes and frames wrapping around the end of the buffer are
+* parsed byte by byte.
 */
 void QS_rxParse(void);
 
@@ -981,6 +1267,17 @@ void QS_onCommand(
 * @static @public @memberof QS_rx
 */
 bool QS_RX_PUT(uint8_t const b);
+
+/*${QS::QS-rx::rxPutBuf} ...................................................*/
+/*! Put a block of bytes into the QS-RX lock-free buffer
+* @static @public @memberof QS_rx
+*
+* @returns the number of bytes placed in the buffer (less than `len`
+* when the buffer fills up)
+*/
+uint16_t QS_rxPutBuf(
+    uint8_t const * const buf,
+    uint16_t const len);
 /*$enddecl${QS} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 
 /*==========================================================================*/
@@ -1056,6 +1353,92 @@ bool QS_RX_PUT(uint8_t const b);
 */
 #define QS_LOC_FILTER(qs_id_) (QS_locFilter_((int_fast16_t)(qs_id_)))
 
+/*${QS-macros::QS_REC_RATE} ................................................*/
+#if (QS_RATE_MAX > 0U)
+/*! Rate filter for a given QS record type `rec_` (see QS_rateSet_())
+*
+* @details
+* For example, QS_REC_RATE(QS_QEP_DISPATCH, 10U, 0U, 0U) passes only
+* every 10th QS_QEP_DISPATCH record and QS_REC_RATE(QS_QF_ACTIVE_POST,
+* 1U, 10000U, 100U) passes at most one QS_QF_ACTIVE_POST record per
+* 10000 time units, with bursts of up to 100 records.
+*/
+#define QS_REC_RATE(rec_, n_, period_, burst_) \
+    (QS_rateSet_((uint_fast8_t)QS_RATE_REC, (uint_fast8_t)(rec_), \
+        (uint_fast16_t)(n_), (QSTimeCtr)(period_), (uint_fast16_t)(burst_)))
+#endif /*  (QS_RATE_MAX > 0U) */
+
+/*${QS-macros::QS_ID_RATE} .................................................*/
+#if (QS_RATE_MAX > 0U)
+/*! Rate filter for a given QS-ID `qs_id_` (see QS_rateSet_()) */
+#define QS_ID_RATE(qs_id_, n_, period_, burst_) \
+    (QS_rateSet_((uint_fast8_t)QS_RATE_ID, (uint_fast8_t)(qs_id_), \
+        (uint_fast16_t)(n_), (QSTimeCtr)(period_), (uint_fast16_t)(burst_)))
+#endif /*  (QS_RATE_MAX > 0U) */
+
+/*${QS-macros::QS_REPLAY_IMMUTABLE} ........................................*/
+/*! Length of the parameters in the ::QS_REPLAY_EVT record of an immutable
+* event, whose parameters are not recorded (see QS_replayEvt_())
+*/
+#define QS_REPLAY_IMMUTABLE 0xFFFFU
+
+/*${QS-macros::QS_REPLAY_REC} ..............................................*/
+/*! Record the event `e_` consumed by the AO of priority `prio_` for replay
+*
+* @details
+* Used in the event loops of the QF ports just before dispatching the
+* event. The ::QS_REPLAY_EVT records are produced only when enabled in
+* the global filter and the local filter of the AO.
+*/
+#define QS_REPLAY_REC(e_, prio_) do { \
+    if (QS_GLB_CHECK_(QS_REPLAY_EVT) && QS_LOC_CHECK_(prio_)) { \
+        QS_replayEvt_((e_), (uint_fast8_t)(prio_)); \
+    } \
+} while (false)
+
+/*${QS-macros::QS_AGG_DISPATCH} ............................................*/
+#if (QS_AGG_MAX > 0U)
+/*! Dispatch an event in the event loop of an AO (see QS_aggDispatch_())
+*
+* @details
+* Used by the QF ports instead of QHSM_DISPATCH(). Outside the QS
+* aggregation mode it is just QHSM_DISPATCH().
+*/
+#define QS_AGG_DISPATCH(me_, e_, qs_id_) do { \
+    if (QS_aggPriv_.period != 0U) { \
+        QS_aggDispatch_((me_), (e_), (uint_fast8_t)(qs_id_)); \
+    } \
+    else { \
+        QHSM_DISPATCH((me_), (e_), (qs_id_)); \
+    } \
+} while (false)
+#endif /*  (QS_AGG_MAX > 0U) */
+
+/*${QS-macros::QS_AGG_DISPATCH} ............................................*/
+#if (QS_AGG_MAX == 0U)
+/*! Dispatch an event in the event loop of an AO (aggregation disabled) */
+#define QS_AGG_DISPATCH(me_, e_, qs_id_) \
+    QHSM_DISPATCH((me_), (e_), (qs_id_))
+#endif /*  (QS_AGG_MAX == 0U) */
+
+/*${QS-macros::QS_AGG_MODE} ................................................*/
+#if (QS_AGG_MAX > 0U)
+/*! Turn the QS aggregation mode on every `period_` or off (see
+* QS_aggMode_())
+*
+* @details
+* For example, QS_AGG_MODE(10000000U) in the POSIX port (0.1us time
+* units) produces the summary records every second.
+*/
+#define QS_AGG_MODE(period_) (QS_aggMode_((QSTimeCtr)(period_)))
+#endif /*  (QS_AGG_MAX > 0U) */
+
+/*${QS-macros::QS_AGG_FLUSH} ...............................................*/
+#if (QS_AGG_MAX > 0U)
+/*! Produce the summary records of the QS aggregation mode now */
+#define QS_AGG_FLUSH() (QS_aggFlush())
+#endif /*  (QS_AGG_MAX > 0U) */
+
 /*${QS-macros::QS_BEGIN_ID} ................................................*/
 /*! Begin an application-specific QS record with entering critical section
 *
@@ -1073,6 +1456,7 @@ bool QS_RX_PUT(uint8_t const b);
 if (QS_GLB_CHECK_(rec_) && QS_LOC_CHECK_(qs_id_)) { \
     QS_CRIT_STAT_ \
     QS_CRIT_E_(); \
+    if (QS_RATE_CHECK_(rec_, qs_id_)) { \
     QS_beginRec_((uint_fast8_t)(rec_)); \
     QS_TIME_PRE_(); {
 
@@ -1084,6 +1468,7 @@ if (QS_GLB_CHECK_(rec_) && QS_LOC_CHECK_(qs_id_)) { \
 */
 #define QS_END() } \
     QS_endRec_(); \
+    } \
     QS_CRIT_X_(); \
 }
 
@@ -1101,7 +1486,8 @@ if (QS_GLB_CHECK_(rec_) && QS_LOC_CHECK_(qs_id_)) { \
 /*${QS-macros::QS_BEGIN_NOCRIT} ............................................*/
 /*! Begin an application-specific QS record WITHOUT entering critical section */
 #define QS_BEGIN_NOCRIT(rec_, qs_id_) \
-if (QS_GLB_CHECK_(rec_) && QS_LOC_CHECK_(qs_id_)) { \
+if (QS_GLB_CHECK_(rec_) && QS_LOC_CHECK_(qs_id_) \
+    && QS_RATE_CHECK_(rec_, qs_id_)) { \
     QS_beginRec_((uint_fast8_t)(rec_)); \
     QS_TIME_PRE_(); {
 
@@ -1123,6 +1509,28 @@ if (QS_GLB_CHECK_(rec_) && QS_LOC_CHECK_(qs_id_)) { \
     (((uint_fast8_t)QS_priv_.locFilter[(uint_fast8_t)(qs_id_) >> 3U] \
           & ((uint_fast8_t)1U << ((uint_fast8_t)(qs_id_) & 7U))) != 0U)
 
+/*${QS-macros::QS_RATE_CHECK_} .............................................*/
+#if (QS_RATE_MAX > 0U)
+/*! Helper macro for checking the QS rate filters (inside critical section)
+*
+* @details
+* QS_rateCheck_() is called only when a rate filter is set for the
+* record type or for the QS-ID.
+*/
+#define QS_RATE_CHECK_(rec_, qs_id_) \
+    ((((QS_ratePriv_.recMask[(uint_fast8_t)(rec_) >> 3U] \
+          & ((uint_fast8_t)1U << ((uint_fast8_t)(rec_) & 7U))) \
+       | (QS_ratePriv_.idMask[(uint_fast8_t)(qs_id_) >> 3U] \
+          & ((uint_fast8_t)1U << ((uint_fast8_t)(qs_id_) & 7U)))) == 0U) \
+     || QS_rateCheck_((uint_fast8_t)(rec_), (uint_fast8_t)(qs_id_)))
+#endif /*  (QS_RATE_MAX > 0U) */
+
+/*${QS-macros::QS_RATE_CHECK_} .............................................*/
+#if (QS_RATE_MAX == 0U)
+/*! Helper macro for checking the QS rate filters (disabled) */
+#define QS_RATE_CHECK_(rec_, qs_id_) (true)
+#endif /*  (QS_RATE_MAX == 0U) */
+
 /*${QS-macros::QS_REC_DONE} ................................................*/
 #ifndef QS_REC_DONE
 /*! Macro to execute user code when a QS record is produced
@@ -1133,6 +1541,27 @@ if (QS_GLB_CHECK_(rec_) && QS_LOC_CHECK_(qs_id_)) { \
 #define QS_REC_DONE() ((void)0)
 #endif /* ndef QS_REC_DONE */
 
+/*${QS-macros::QS_GLB_CRIT_ENTRY} ..........................................*/
+#ifndef QS_GLB_CRIT_ENTRY
+/*! Enter the critical section of the QS state shared by all the QS-TX
+* buffers (e.g., the rate filters), nested inside the QS critical section
+*
+* @note
+* This is a dummy definition for the ports, in which the QS critical
+* section is global already. A port with a QS critical section per thread
+* must define this macro and QS_GLB_CRIT_EXIT() in qs_port.h.
+*/
+#define QS_GLB_CRIT_ENTRY() ((void)0)
+#endif /* ndef QS_GLB_CRIT_ENTRY */
+
+/*${QS-macros::QS_GLB_CRIT_EXIT} ...........................................*/
+#ifndef QS_GLB_CRIT_EXIT
+/*! Exit the critical section of the QS state shared by all the QS-TX
+* buffers (dummy definition, see QS_GLB_CRIT_ENTRY())
+*/
+#define QS_GLB_CRIT_EXIT() ((void)0)
+#endif /* ndef QS_GLB_CRIT_EXIT */
+
 /*${QS-macros::QS_I8} ......................................................*/
 /*! Output formatted int8_t to the QS record */
 #define QS_I8(width_, data_) \
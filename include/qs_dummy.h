@@ -52,6 +52,13 @@
 #define QS_DUMP()                       ((void)0)
 #define QS_GLB_FILTER(rec_)             ((void)0)
 #define QS_LOC_FILTER(qs_id_)           ((void)0)
+#define QS_REC_RATE(rec_, n_, period_, burst_)   ((void)0)
+#define QS_ID_RATE(qs_id_, n_, period_, burst_)  ((void)0)
+#define QS_AGG_MODE(period_)            ((void)0)
+#define QS_AGG_FLUSH()                  ((void)0)
+#define QS_AGG_DISPATCH(me_, e_, qs_id_) \
+    QHSM_DISPATCH((me_), (e_), (qs_id_))
+#define QS_REPLAY_REC(e_, prio_)        ((void)0)
 
 #define QS_GET_BYTE(pByte_)             ((uint16_t)0xFFFFU)
 #define QS_GET_BLOCK(pSize_)            ((uint8_t *)0)
@@ -65,9 +65,19 @@ enum QSpyRxRecords {
     QS_RX_CURR_OBJ,       /*!< set the "current-object" in the Target */
     QS_RX_TEST_CONTINUE,  /*!< continue a test after QS_TEST_PAUSE() */
     QS_RX_QUERY_CURR,     /*!< query the "current object" in the Target */
-    QS_RX_EVENT           /*!< inject an event to the Target */
+    QS_RX_EVENT,          /*!< inject an event to the Target */
+    QS_RX_EVENT_BATCH     /*!< inject a batch of events to the Target */
 };
 
+/*! @note
+* The ::QS_RX_EVENT_BATCH record carries: prio (U8, as in ::QS_RX_EVENT),
+* the number of events N (U16, 1..QS_RX_BATCH_MAX), and N times: signal
+* (Q_SIGNAL_SIZE bytes), parameters length (U16) and the parameters.
+* The Target allocates all N events while receiving the record, and after
+* a good frame posts (or dispatches) them back-to-back, with one Ack and
+* one Done for the whole batch.
+*/
+
 /*==========================================================================*/
 /*! Frame character of the QS output protocol */
 #define QS_FRAME    (0x7EU)
@@ -97,6 +107,7 @@ enum QSpyRxRecords {
 #define QS_BEGIN_PRE_(rec_, qs_id_)                     \
     if (QS_GLB_CHECK_(rec_) && QS_LOC_CHECK_(qs_id_)) { \
         QS_CRIT_E_();                                   \
+        if (QS_RATE_CHECK_(rec_, qs_id_)) {             \
         QS_beginRec_((uint_fast8_t)(rec_));
 
 /*!  Internal QS macro to end a predefined QS record with
@@ -108,6 +119,7 @@ enum QSpyRxRecords {
 */
 #define QS_END_PRE_() \
         QS_endRec_(); \
+        }             \
         QS_CRIT_X_(); \
     }
 
@@ -119,7 +131,8 @@ enum QSpyRxRecords {
 * @sa QS_BEGIN_NOCRIT()
 */
 #define QS_BEGIN_NOCRIT_PRE_(rec_, qs_id_)              \
-    if (QS_GLB_CHECK_(rec_) && QS_LOC_CHECK_(qs_id_)) { \
+    if (QS_GLB_CHECK_(rec_) && QS_LOC_CHECK_(qs_id_)    \
+        && QS_RATE_CHECK_(rec_, qs_id_)) {              \
         QS_beginRec_((uint_fast8_t)(rec_));
 
 /*! Internal QS macro to end a predefined QS record without
@@ -248,6 +261,28 @@ enum QSpyRxRecords {
 #endif
 
 /*==========================================================================*/
+#ifndef QS_TX_
+/*! The QS-TX ring buffer written by the QS record-building functions
+*
+* @details
+* By default all QS records are inserted into the single QS_priv_ ring.
+* A multi-threaded QS port can define this macro in qs_port.h to redirect
+* the records produced by a given thread into that thread's own ring
+* (e.g., through a thread-local pointer). The QS output functions
+* QS_getByte()/QS_getBlock() always operate on QS_priv_.
+*/
+#define QS_TX_      QS_priv_
+#endif /* ndef QS_TX_ */
+
+/*! QS_tx::flags bit: ring holds time-stamped records for later merging
+*
+* @details
+* Each record inserted into a ring with this flag set is preceded by the
+* escaped QS_onGetTime() time-stamp, and an overrun discards whole records
+* only, so that the ring can be merged into QS_priv_ by the QS port.
+*/
+#define QS_TX_MERGE_FLAG (0x80U)
+
 /*! Internal QS macro to insert an un-escaped byte into the QS buffer */
 #define QS_INSERT_BYTE_(b_) \
     buf[head] = (b_);       \
@@ -265,7 +300,7 @@ enum QSpyRxRecords {
     else {                                           \
         QS_INSERT_BYTE_(QS_ESC)                      \
         QS_INSERT_BYTE_((uint8_t)((b_) ^ QS_ESC_XOR))\
-        ++QS_priv_.used;                             \
+        ++QS_TX_.used;                               \
     }
 
 #endif  /* QS_PKG_H_ */
@@ -294,6 +294,11 @@ typedef struct QXThread {
 
     /*! time event to handle blocking timeouts */
     QTimeEvt timeEvt;
+
+    /*! absolute deadline [ticks] of the blocking timeout
+    * (see QXThread_teArm_())
+    */
+    uint32_t deadline;
 } QXThread;
 
 /* public: */
@@ -555,11 +560,16 @@ void QXThread_unblock_(QXThread const * const me);
 * @private @memberof QXThread
 *
 * @details
-* Internal implementation of arming the private time event for a given
-* timeout at a given system tick rate.
+* Internal implementation of arming the blocking timeout for a given
+* number of ticks at the tick rate of the private time event. The timeout
+* is not linked into the list of time events, but into the separate
+* QXK deadline set of the tick rate (see ::QXK_Deadlines), so the blocking
+* of the extended threads does not add to the cost of QTimeEvt_tick_().
+* The timeout is signaled by setting the signal of the private time event
+* to zero.
 *
 * @precondition{qxk_xthr,700}
-* - the time event must be unused
+* - the timeout must not be armed already
 *
 * @note
 * Must be called from within a critical section
@@ -572,7 +582,11 @@ void QXThread_teArm_(QXThread * const me,
 * @private @memberof QXThread
 *
 * @details
-* Internal implementation of disarming the private time event.
+* Internal implementation of disarming the blocking timeout.
+*
+* @returns
+* 'true' if the timeout was armed and 'false' if it has already expired
+* (or was never armed).
 *
 * @note
 * Must be called from within a critical section
@@ -739,6 +753,34 @@ bool QXSemaphore_tryWait(QXSemaphore * const me);
 * threads (AOs), and extended threads.
 */
 bool QXSemaphore_signal(QXSemaphore * const me);
+
+/*! signal (unblock) the semaphore multiple times in one operation
+* @public @memberof QXSemaphore
+*
+* @details
+* Increments the semaphore counter by up to `n` (without exceeding the
+* maximum count) and makes the same number of the highest-priority
+* waiting threads ready to run, all within one critical section and
+* with a single invocation of the QXK scheduler. Passing the maximum
+* count as `n` broadcasts the semaphore to as many waiting threads as
+* the semaphore can admit.
+*
+* @param[in,out] me  current instance pointer (see @ref oop)
+* @param[in]     n   number of times to signal the semaphore
+*
+* @returns
+* the number of times the semaphore has actually been signaled, which
+* is less than `n` when the count reached the maximum.
+*
+* @precondition{qxk_sema,500}
+* - the semaphore must be initialized
+*
+* @note
+* A semaphore can be signaled from many places, including from ISRs, basic
+* threads (AOs), and extended threads.
+*/
+uint_fast8_t QXSemaphore_signalN(QXSemaphore * const me,
+    uint_fast8_t const n);
 /*$enddecl${QXK::QXSemaphore} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 /*$declare${QXK::QXMutex} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 
@@ -909,6 +951,277 @@ bool QXMutex_tryLock(QXMutex * const me);
 */
 void QXMutex_unlock(QXMutex * const me);
 /*$enddecl${QXK::QXMutex} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+/*$declare${QXK::QXCHANNEL_MAX_SLOTS} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+
+/*${QXK::QXCHANNEL_MAX_SLOTS} ..............................................*/
+#ifndef QXCHANNEL_MAX_SLOTS
+/*! maximum number of slots in a ::QXChannel */
+#define QXCHANNEL_MAX_SLOTS 16U
+#endif /* ndef QXCHANNEL_MAX_SLOTS */
+/*$enddecl${QXK::QXCHANNEL_MAX_SLOTS} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+/*$declare${QXK::QXChannel} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+
+/*${QXK::QXChannel} ........................................................*/
+/*! @brief Bounded zero-copy message channel of the QXK preemptive kernel
+* @class QXChannel
+*
+* @details
+* ::QXChannel passes fixed-size messages (e.g., samples) between threads
+* without allocating events from the event pools. The messages live in
+* the application-supplied ring of slots. A producer reserves the next
+* slot (QXChannel_reserve()), fills it in place and commits it
+* (QXChannel_commit()). A consumer receives the oldest committed slot
+* (QXChannel_receive()), reads it in place and releases it
+* (QXChannel_release()). The blocking operations can be called only from
+* the @ref ::QXThread "extended threads" and wait with a timeout for a free
+* or a committed slot, respectively. QXChannel_tryReserve() and
+* QXChannel_tryReceive() never block and, like QXChannel_commit() and
+* QXChannel_release(), can be called from any context, including ISRs.
+*
+* The slots are reserved and received in the ring order, so a slot
+* committed (released) out of order becomes available to the consumers
+* (producers) only after all the slots before it.
+*
+* @usage
+* @code
+* typedef struct { int16_t x, y, z; } Sample;
+* static Sample l_samples[8];
+* static QXChannel l_chan;
+*
+* QXCHANNEL_INIT(&l_chan, l_samples);
+*
+* // producer (extended thread)
+* Sample *s = QXCHANNEL_RESERVE(&l_chan, Sample, BSP_TICKS_PER_SEC);
+* if (s != (Sample *)0) {
+*     s->x = ...;
+*     QXChannel_commit(&l_chan, s);
+* }
+*
+* // consumer (extended thread)
+* Sample const *s = QXCHANNEL_RECEIVE(&l_chan, Sample, QXTHREAD_NO_TIMEOUT);
+* ... // use *s in place
+* QXChannel_release(&l_chan, s);
+* @endcode
+*/
+typedef struct {
+/* private: */
+
+    /*! set of extended threads waiting for a free slot */
+    QPSet sendSet;
+
+    /*! set of extended threads waiting for a committed slot */
+    QPSet recvSet;
+
+    /*! storage of the slots */
+    uint8_t * sto;
+
+    /*! size of one slot [bytes] */
+    uint16_t slotSize;
+
+    /*! number of the slots */
+    uint8_t nSlots;
+
+    /*! index of the next slot to reserve */
+    uint8_t head;
+
+    /*! index of the next slot to receive */
+    uint8_t tail;
+
+    /*! states of the slots */
+    uint8_t state[QXCHANNEL_MAX_SLOTS];
+} QXChannel;
+
+/* public: */
+
+/*! initialize the channel
+* @public @memberof QXChannel
+*
+* @param[in,out] me      current instance pointer (see @ref oop)
+* @param[in]     sto     storage for the slots
+* @param[in]     slotSize size of one slot [bytes]
+* @param[in]     nSlots  number of the slots
+*
+* @precondition{qxk_chan,100}
+* - the storage must be provided, the slot size must not be zero, and
+*   the number of the slots must be in range 1..#QXCHANNEL_MAX_SLOTS
+*/
+void QXChannel_init(QXChannel * const me,
+    void * const sto,
+    uint_fast16_t const slotSize,
+    uint_fast8_t const nSlots);
+
+/*! reserve the next free slot, blocking until one is available
+* @public @memberof QXChannel
+*
+* @param[in,out] me     current instance pointer (see @ref oop)
+* @param[in]     size   size of the message to put into the slot [bytes]
+* @param[in]     nTicks number of clock ticks (at the associated rate)
+*                       to wait for a free slot. The value of
+*                       ::QXTHREAD_NO_TIMEOUT waits indefinitely.
+* @returns
+* pointer to the reserved slot or NULL if the timeout expired.
+*
+* @precondition{qxk_chan,200}
+* - must NOT be called from an ISR;
+* - the channel must be initialized and the message must fit the slot;
+* - must be called from an extended thread;
+* - the thread must NOT be already blocked on any object.
+*
+* @precondition{qxk_chan,201}
+* - the thread must NOT be holding a scheduler lock.
+*
+* @note
+* The reserved slot must be committed with QXChannel_commit().
+*/
+void * QXChannel_reserve(QXChannel * const me,
+    uint_fast16_t const size,
+    uint_fast16_t const nTicks);
+
+/*! reserve the next free slot without blocking
+* @public @memberof QXChannel
+*
+* @returns
+* pointer to the reserved slot or NULL if no slot is free.
+*
+* @precondition{qxk_chan,300}
+* - the channel must be initialized and the message must fit the slot
+*/
+void * QXChannel_tryReserve(QXChannel * const me,
+    uint_fast16_t const size);
+
+/*! commit a reserved slot to the consumers
+* @public @memberof QXChannel
+*
+* @details
+* Makes the slot available to QXChannel_receive() and unblocks the
+* highest-priority thread waiting for a committed slot.
+*
+* @precondition{qxk_chan,400}
+* - the slot must be reserved in this channel
+*/
+void QXChannel_commit(QXChannel * const me,
+    void * const slot);
+
+/*! receive the oldest committed slot, blocking until one is available
+* @public @memberof QXChannel
+*
+* @param[in,out] me     current instance pointer (see @ref oop)
+* @param[in]     size   size of the message expected in the slot [bytes]
+* @param[in]     nTicks number of clock ticks (at the associated rate)
+*                       to wait for a committed slot. The value of
+*                       ::QXTHREAD_NO_TIMEOUT waits indefinitely.
+* @returns
+* pointer to the received slot or NULL if the timeout expired.
+*
+* @precondition{qxk_chan,200}
+* - must NOT be called from an ISR;
+* - the channel must be initialized and the message must fit the slot;
+* - must be called from an extended thread;
+* - the thread must NOT be already blocked on any object.
+*
+* @precondition{qxk_chan,201}
+* - the thread must NOT be holding a scheduler lock.
+*
+* @note
+* The received slot must be released with QXChannel_release().
+*/
+void const * QXChannel_receive(QXChannel * const me,
+    uint_fast16_t const size,
+    uint_fast16_t const nTicks);
+
+/*! receive the oldest committed slot without blocking
+* @public @memberof QXChannel
+*
+* @returns
+* pointer to the received slot or NULL if no slot is committed.
+*
+* @precondition{qxk_chan,300}
+* - the channel must be initialized and the message must fit the slot
+*/
+void const * QXChannel_tryReceive(QXChannel * const me,
+    uint_fast16_t const size);
+
+/*! release a received slot back to the producers
+* @public @memberof QXChannel
+*
+* @details
+* Makes the slot available to QXChannel_reserve() and unblocks the
+* highest-priority thread waiting for a free slot.
+*
+* @precondition{qxk_chan,400}
+* - the slot must be received from this channel
+*/
+void QXChannel_release(QXChannel * const me,
+    void const * const slot);
+
+/* private: */
+
+/*! unblock the highest-priority thread waiting on the channel
+* @private @memberof QXChannel
+*
+* @details
+* Unblocks the highest-priority thread in the given @p waitSet of the
+* channel.
+*
+* @note
+* Must be called from within a critical section
+*/
+void QXChannel_wakeOne_(QXChannel const * const me,
+    QPSet * const waitSet);
+
+/*! take the next slot, if it is available
+* @private @memberof QXChannel
+*
+* @details
+* Takes the next slot for a producer (@p isSend) or for a consumer.
+* @p woken is set when another waiting thread has been unblocked, because
+* the following slot is available as well.
+*
+* @returns
+* pointer to the taken slot or NULL if the slot is not available.
+*
+* @note
+* Must be called from within a critical section
+*/
+uint8_t * QXChannel_take_(QXChannel * const me,
+    bool const isSend,
+    bool * const woken);
+
+/*! take the next slot, blocking until it is available
+* @private @memberof QXChannel
+*
+* @details
+* Internal implementation of QXChannel_reserve() (@p isSend) and
+* QXChannel_receive().
+*/
+uint8_t * QXChannel_wait_(QXChannel * const me,
+    bool const isSend,
+    uint_fast16_t const size,
+    uint_fast16_t const nTicks);
+
+/*! take the next slot without blocking
+* @private @memberof QXChannel
+*
+* @details
+* Internal implementation of QXChannel_tryReserve() (@p isSend) and
+* QXChannel_tryReceive().
+*/
+uint8_t * QXChannel_tryTake_(QXChannel * const me,
+    bool const isSend,
+    uint_fast16_t const size);
+
+/*! give back a taken slot
+* @private @memberof QXChannel
+*
+* @details
+* Internal implementation of QXChannel_commit() (@p isSend) and
+* QXChannel_release(). Unblocks the highest-priority thread waiting on
+* the other side of the channel.
+*/
+void QXChannel_give_(QXChannel * const me,
+    bool const isSend,
+    void const * const slot);
+/*$enddecl${QXK::QXChannel} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 /*$declare${QXK-macros} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 
 /*${QXK-macros::QXTHREAD_START} ............................................*/
@@ -978,6 +1291,23 @@ do { \
 */
 #define QXTHREAD_POST_X(me_, e_, margin_, sender_) \
     QACTIVE_POST_X(&(me_)->super, (e_), (margin_), (sender_))
+
+/*${QXK-macros::QXCHANNEL_INIT} ............................................*/
+/*! Initialize the channel `me_` with the slots in the array `sto_` */
+#define QXCHANNEL_INIT(me_, sto_) \
+    (QXChannel_init((me_), &(sto_)[0], sizeof((sto_)[0]), Q_DIM(sto_)))
+
+/*${QXK-macros::QXCHANNEL_RESERVE} .........................................*/
+/*! Reserve a slot for the message of type `type_` (see QXChannel_reserve()) */
+#define QXCHANNEL_RESERVE(me_, type_, nTicks_) \
+    ((type_ *)QXChannel_reserve((me_), sizeof(type_), (nTicks_)))
+
+/*${QXK-macros::QXCHANNEL_RECEIVE} .........................................*/
+/*! Receive a slot with the message of type `type_`
+* (see QXChannel_receive())
+*/
+#define QXCHANNEL_RECEIVE(me_, type_, nTicks_) \
+    ((type_ const *)QXChannel_receive((me_), sizeof(type_), (nTicks_)))
 /*$enddecl${QXK-macros} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 
 /*==========================================================================*/
@@ -1034,6 +1364,49 @@ do { \
     } \
 } while (false)
 
+/*${QXK-impl::QXK_Deadlines} ...............................................*/
+/*! @brief Deadlines of the blocking timeouts at one tick rate
+* @class QXK_Deadlines
+*
+* @details
+* The timeouts of the extended threads blocked on semaphores, mutexes,
+* event queues and delays are kept out of the list of time events in the
+* set of the (current) priorities of the threads with an armed deadline.
+* Arming and disarming a timeout is O(1). Every tick only compares the tick
+* counter with the earliest deadline, so the set is scanned only when a
+* timeout might have expired. The earliest deadline is a lower bound,
+* because disarming does not update it.
+*/
+typedef struct QXK_Deadlines {
+    QPSet waitSet; /*!< threads with an armed deadline */
+    uint32_t now;  /*!< tick counter at this tick rate */
+    uint32_t next; /*!< earliest armed deadline (lower bound) */
+} QXK_Deadlines;
+
+/*${QXK-impl::QXK_deadlines_[QF_MAX_TICK_RATE]} ............................*/
+/*! the deadlines of the blocking timeouts for all tick rates
+* @static @private @memberof QXK
+*/
+extern QXK_Deadlines QXK_deadlines_[QF_MAX_TICK_RATE];
+
+/*${QXK-impl::QXK_tickDeadlines_} ..........................................*/
+/*! expire the blocking timeouts at the given tick rate
+* @static @private @memberof QXK
+*
+* @details
+* Called from QTimeEvt_tick_() (see ::QTIMEEVT_TICK_HOOK_). All the threads
+* whose deadline has been reached are made ready to run at once, with
+* a single invocation of the QXK scheduler.
+*
+* @precondition{qxk,950}
+* - the tick rate must be in range
+*/
+void QXK_tickDeadlines_(uint_fast8_t const tickRate);
+
+/*${QXK-impl::QTIMEEVT_TICK_HOOK_} .........................................*/
+/*! QXK hook into QTimeEvt_tick_() expiring the blocking timeouts */
+#define QTIMEEVT_TICK_HOOK_(tickRate_) (QXK_tickDeadlines_((tickRate_)))
+
 /*${QXK-impl::QXK_PTR_CAST_} ...............................................*/
 /*! internal macro to encapsulate casting of pointers for MISRA deviations
 *
@@ -0,0 +1,191 @@
+/*============================================================================
+* QP/C Real-Time Embedded Framework (RTEF)
+* Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+*
+* SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+*
+* This software is dual-licensed under the terms of the open source GNU
+* General Public License version 3 (or any later version), or alternatively,
+* under the terms of one of the closed source Quantum Leaps commercial
+* licenses.
+*
+* The terms of the open source GNU General Public License version 3
+* can be found at: <www.gnu.org/licenses/gpl-3.0>
+*
+* The terms of the closed source Quantum Leaps commercial licenses
+* can be found at: <www.state-machine.com/licensing>
+*
+* Redistributions in source code must retain this top-level comment block.
+* Plagiarizing this software to sidestep the license obligations is illegal.
+*
+* Contact information:
+* <www.state-machine.com>
+* <info@state-machine.com>
+============================================================================*/
+/*!
+* @date Last updated on: 2026-10-18
+* @version Last updated for: @ref qpc_7_2_2
+*
+* @file
+* @brief ::QLfPool implementation for the QF/C port to FreeRTOS
+*/
+/* NOTE: this module does not depend on FreeRTOS (see test/freertos/lfpool) */
+#define QP_IMPL           /* this is QP implementation */
+#include "qep_port.h"     /* QEP port */
+#include "qmpool.h"       /* QF memory pool (for the pool data types) */
+#include "qlfpool.h"      /* lock-free memory pool */
+#include "qassert.h"      /* QP embedded systems-friendly assertions */
+
+#ifndef __GNUC__
+    #error "QLfPool requires the GNU-compatible __atomic builtins"
+#endif
+
+Q_DEFINE_THIS_MODULE("qf_lfpool")
+
+/* the head of the free list: tag in the upper and index in the lower half */
+#define QLFPOOL_IDX_MASK  0xFFFFU
+#define QLFPOOL_TAG_INC   0x10000U
+
+/* the free-list link stored in the free block with the 1-based index idx_ */
+#define QLFPOOL_LINK_(me_, idx_) \
+    ((uint16_t *)((uint8_t *)(me_)->start \
+        + ((uint_fast32_t)(idx_) - 1U) * (uint_fast32_t)(me_)->blockSize))
+
+/* the new head with the index idx_ and the tag of head_ advanced */
+#define QLFPOOL_HEAD_(head_, idx_) \
+    ((((head_) + QLFPOOL_TAG_INC) & ~(uint32_t)QLFPOOL_IDX_MASK) \
+     | (uint32_t)(idx_))
+
+/*==========================================================================*/
+/*! @public @memberof QLfPool */
+void QLfPool_init(QLfPool * const me,
+    void * const poolSto,
+    uint_fast32_t const poolSize,
+    uint_fast16_t const blockSize)
+{
+    /** @pre the pool storage must be provided and aligned at the pointer
+    * boundary and the block size must not overflow when rounded up
+    */
+    Q_REQUIRE_ID(100, (poolSto != (void *)0)
+        && (((uintptr_t)poolSto & (sizeof(void *) - 1U)) == 0U)
+        && ((uint_fast16_t)(blockSize + sizeof(void *)) > blockSize));
+
+    /* round up the blockSize to the multiple of the pointer size */
+    uint_fast16_t size = (uint_fast16_t)sizeof(void *);
+    while (size < blockSize) {
+        size += (uint_fast16_t)sizeof(void *);
+    }
+    uint_fast32_t const n = poolSize / size;
+
+    /* the storage must fit at least one block, the block indices must fit
+    * in 16 bits and the block size and count must fit the pool counters
+    */
+    Q_ASSERT_ID(110, (n > 0U) && (n < QLFPOOL_IDX_MASK)
+        && ((uint_fast32_t)(QMPoolCtr)n == n)
+        && ((uint_fast16_t)(QMPoolSize)size == size));
+
+    me->start     = poolSto;
+    me->blockSize = (QMPoolSize)size;
+    me->nTot      = (QMPoolCtr)n;
+    me->nFree     = (QMPoolCtr)n;
+    me->nMin      = (QMPoolCtr)n;
+    me->end       = QLFPOOL_LINK_(me, n);
+
+    /* chain all blocks together in a free-list... */
+    for (uint_fast32_t i = 1U; i < n; ++i) {
+        *QLFPOOL_LINK_(me, i) = (uint16_t)(i + 1U);
+    }
+    *QLFPOOL_LINK_(me, n) = 0U; /* the last link is empty */
+    me->head = 1U;              /* tag 0, the first block on top */
+}
+
+/*..........................................................................*/
+/*! @public @memberof QLfPool */
+void *QLfPool_get(QLfPool * const me,
+    uint_fast16_t const margin,
+    uint_fast8_t const qs_id)
+{
+    Q_UNUSED_PAR(qs_id);
+
+    /* reserve one of the free blocks above the margin... */
+    QMPoolCtr nFree = __atomic_load_n(&me->nFree, __ATOMIC_RELAXED);
+    bool reserved = false;
+    while ((!reserved) && (nFree > (QMPoolCtr)margin)) {
+        reserved = __atomic_compare_exchange_n(&me->nFree, &nFree,
+            (QMPoolCtr)(nFree - 1U), false,
+            __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+    }
+
+    uint16_t *fb = (uint16_t *)0;
+    if (reserved) {
+        /* is the number of free blocks the new minimum so far? */
+        QMPoolCtr const n = (QMPoolCtr)(nFree - 1U);
+        QMPoolCtr nMin = __atomic_load_n(&me->nMin, __ATOMIC_RELAXED);
+        while ((n < nMin)
+               && (!__atomic_compare_exchange_n(&me->nMin, &nMin, n, false,
+                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)))
+        {
+        }
+
+        /* pop the top block off the free list... */
+        uint32_t head = __atomic_load_n(&me->head, __ATOMIC_ACQUIRE);
+        uint32_t next;
+        do {
+            uint32_t const idx = head & QLFPOOL_IDX_MASK;
+
+            /* a block was reserved, so the free list cannot be empty */
+            Q_ASSERT_ID(210, (idx != 0U) && (idx <= (uint32_t)me->nTot));
+
+            fb = QLFPOOL_LINK_(me, idx);
+
+            /* NOTE: the link can be overwritten when the block is popped
+            * and used by a preempting context, but then the tag of the
+            * head changes as well and the following CAS fails.
+            */
+            next = (uint32_t)__atomic_load_n(fb, __ATOMIC_RELAXED);
+        } while (!__atomic_compare_exchange_n(&me->head, &head,
+                     QLFPOOL_HEAD_(head, next), false,
+                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+        /* the next free block must be in range
+        *
+        * NOTE: the next free block index can fall out of range
+        * when the client code writes past the memory block, thus
+        * corrupting the next block.
+        */
+        Q_ASSERT_ID(220, next <= (uint32_t)me->nTot);
+    }
+    return fb; /* return the pointer to memory block or NULL to the caller */
+}
+
+/*..........................................................................*/
+/*! @public @memberof QLfPool */
+void QLfPool_put(QLfPool * const me,
+    void * const b,
+    uint_fast8_t const qs_id)
+{
+    Q_UNUSED_PAR(qs_id);
+
+    /** @pre # free blocks cannot exceed the total # blocks and
+    * the block pointer must be from this pool.
+    */
+    Q_REQUIRE_ID(300, (__atomic_load_n(&me->nFree, __ATOMIC_RELAXED)
+                       < me->nTot)
+                      && (me->start <= b) && (b <= me->end));
+
+    uint32_t const idx = (uint32_t)(((uint8_t *)b - (uint8_t *)me->start)
+                                    / me->blockSize) + 1U;
+    uint16_t * const fb = (uint16_t *)b;
+
+    /* push the block onto the free list... */
+    uint32_t head = __atomic_load_n(&me->head, __ATOMIC_RELAXED);
+    do {
+        __atomic_store_n(fb, (uint16_t)(head & QLFPOOL_IDX_MASK),
+                         __ATOMIC_RELAXED);
+    } while (!__atomic_compare_exchange_n(&me->head, &head,
+                 QLFPOOL_HEAD_(head, idx), false,
+                 __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+    /* ...and only then make it available for reservation */
+    (void)__atomic_add_fetch(&me->nFree, 1U, __ATOMIC_RELEASE);
+}
@@ -74,6 +74,53 @@ static void task_function(void *pvParameters); /* FreeRTOS task signature */
 #define FREERTOS_QUEUE_GET_FREE(me_) \
     ((me_)->osObject.uxDummy4[1] - (me_)->osObject.uxDummy4[0])
 
+#ifdef QF_AO_TELEM
+static uint16_t l_queueMax[QF_MAX_ACTIVE + 1U];  /* queue high-water marks */
+static uint32_t l_stackSize[QF_MAX_ACTIVE + 1U]; /* stack sizes [bytes] */
+
+/* update the queue high-water mark of the AO before posting an event
+* (in a critical section), see NOTE1
+*/
+#define FREERTOS_QUEUE_HWM_(me_) do { \
+    uint16_t const used_ = (uint16_t)((me_)->osObject.uxDummy4[0] + 1U); \
+    if (l_queueMax[(me_)->prio] < used_) { \
+        l_queueMax[(me_)->prio] = used_; \
+    } \
+} while (false)
+#else
+#define FREERTOS_QUEUE_HWM_(me_) ((void)0)
+#endif /* QF_AO_TELEM */
+
+/* interrupt masking in the "FromISR" APIs: with QF_ISR_LOCKFREE only for
+* the optional trace records, event tracking and the queue high-water marks,
+* see NOTE4 in qf_port.h
+*/
+#if (!defined QF_ISR_LOCKFREE) || (defined Q_SPY) \
+    || (defined QF_EVT_TRACK) || (defined QF_AO_TELEM)
+#define FREERTOS_ISR_STAT_     UBaseType_t uxSavedInterruptStatus;
+#define FREERTOS_ISR_MASK_() \
+    (uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR())
+#define FREERTOS_ISR_UNMASK_() \
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus)
+#else
+#define FREERTOS_ISR_STAT_
+#define FREERTOS_ISR_MASK_()   ((void)0)
+#define FREERTOS_ISR_UNMASK_() ((void)0)
+#endif
+
+/* the event reference counting in the "FromISR" APIs */
+#ifdef QF_ISR_LOCKFREE
+#define FREERTOS_REFCTR_INC_(e_) \
+    ((void)__atomic_fetch_add(&((QEvt *)(e_))->refCtr_, 1U, __ATOMIC_RELAXED))
+#else
+#define FREERTOS_REFCTR_INC_(e_) QEvt_refCtr_inc_(e_)
+#endif
+
+/* decrement the reference counter of the event e unless it is the last
+* reference; returns false for the last reference (the event to recycle)
+*/
+static bool refCtr_decFromISR(QEvt const * const e);
+
 /*==========================================================================*/
 void QF_init(void) {
     /* empty for FreeRTOS */
@@ -104,7 +151,8 @@ static void task_function(void *pvParameters) { /* FreeRTOS task signature */
     /* event-loop */
     for (;;) { /* for-ever */
         QEvt const *e = QActive_get_(act);
-        QHSM_DISPATCH(&act->super, e, act->prio);
+        QS_REPLAY_REC(e, act->prio); /* record the event for replay */
+        QF_RTC_DISPATCH_(act, e, act->prio);
         QF_gc(e); /* check if the event is garbage, and collect it if so */
     }
 }
@@ -140,6 +188,10 @@ void QActive_start_(QActive * const me, QPrioSpec const prioSpec,
                              ? (char const *)me->thread.pxDummy1
                              : (char const *)"AO";
 
+#ifdef QF_AO_TELEM
+    l_stackSize[me->prio] = (uint32_t)stkSize;
+#endif
+
     /* statically create the FreeRTOS task for the AO */
     Q_ALLEGE_ID(220,
          (TaskHandle_t)0 != xTaskCreateStatic(
@@ -208,6 +260,8 @@ bool QActive_post_(QActive * const me, QEvt const * const e,
         if (e->poolId_ != 0U) { /* is it a pool event? */
             QEvt_refCtr_inc_(e); /* increment the reference counter */
         }
+        QF_EVT_TRACK_POST_(e, me->prio, sender); /* the AO holds e */
+        FREERTOS_QUEUE_HWM_(me);
 
         QF_CRIT_X_();
 
@@ -250,6 +304,8 @@ void QActive_postLIFO_(QActive * const me, QEvt const * const e) {
     if (e->poolId_ != 0U) { /* is it a pool event? */
         QEvt_refCtr_inc_(e); /* increment the reference counter */
     }
+    QF_EVT_TRACK_POST_(e, me->prio, (void *)0); /* the AO holds e */
+    FREERTOS_QUEUE_HWM_(me);
 
     QF_CRIT_X_();
 
@@ -275,6 +331,28 @@ QEvt const *QActive_get_(QActive * const me) {
     return e;
 }
 
+#ifdef QF_AO_TELEM
+/*..........................................................................*/
+void QActive_getPortTelem_(QActive const * const me,
+                           QActiveTelem * const telem)
+{
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+    telem->queueSize = (uint16_t)me->osObject.uxDummy4[1];
+    telem->queueMax  = l_queueMax[me->prio];
+    QF_CRIT_X_();
+
+    /* the minimum of the free stack ever, which requires
+    * INCLUDE_uxTaskGetStackHighWaterMark in FreeRTOSConfig.h
+    */
+    UBaseType_t const nFree = uxTaskGetStackHighWaterMark(
+                                 (TaskHandle_t)&me->thread);
+    telem->stackSize = l_stackSize[me->prio];
+    telem->stackUsed = l_stackSize[me->prio]
+                       - ((uint32_t)nFree * sizeof(StackType_t));
+}
+#endif /* QF_AO_TELEM */
+
 /*==========================================================================*/
 /* The "FromISR" QP APIs for the FreeRTOS port... */
 bool QActive_postFromISR_(QActive * const me, QEvt const * const e,
@@ -282,7 +360,8 @@ bool QActive_postFromISR_(QActive * const me, QEvt const * const e,
                           BaseType_t * const pxHigherPriorityTaskWoken,
                           void const * const sender)
 {
-    UBaseType_t uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    FREERTOS_ISR_STAT_
+    FREERTOS_ISR_MASK_();
 
     /* find out the number of free slots in the queue */
     uint_fast16_t const nFree = (uint_fast16_t)FREERTOS_QUEUE_GET_FREE(me);
@@ -317,10 +396,12 @@ bool QActive_postFromISR_(QActive * const me, QEvt const * const e,
         QS_END_NOCRIT_PRE_()
 
         if (e->poolId_ != 0U) { /* is it a pool event? */
-            QEvt_refCtr_inc_(e); /* increment the reference counter */
+            FREERTOS_REFCTR_INC_(e); /* increment the reference counter */
         }
+        QF_EVT_TRACK_POST_(e, me->prio, sender); /* the AO holds e */
+        FREERTOS_QUEUE_HWM_(me);
 
-        portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+        FREERTOS_ISR_UNMASK_();
 
         /* posting to the FreeRTOS message queue must succeed */
         Q_ALLEGE_ID(820,
@@ -340,7 +421,7 @@ bool QActive_postFromISR_(QActive * const me, QEvt const * const e,
             QS_EQC_PRE_(margin); /* margin requested */
         QS_END_NOCRIT_PRE_()
 
-        portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+        FREERTOS_ISR_UNMASK_();
 
         QF_gcFromISR(e); /* recycle the event to avoid a leak */
     }
@@ -355,7 +436,8 @@ void QActive_publishFromISR_(QEvt const * const e,
     /** @pre the published signal must be within the configured range */
     Q_REQUIRE_ID(500, e->sig < (QSignal)QActive_maxPubSignal_);
 
-    UBaseType_t uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    FREERTOS_ISR_STAT_
+    FREERTOS_ISR_MASK_();
 
     QS_BEGIN_NOCRIT_PRE_(QS_QF_PUBLISH, 0U)
         QS_TIME_PRE_();          /* the timestamp */
@@ -373,12 +455,16 @@ void QActive_publishFromISR_(QEvt const * const e,
         * recycles the event if the counter drops to zero. This covers the
         * case when the event was published without any subscribers.
         */
-        QEvt_refCtr_inc_(e);
+        FREERTOS_REFCTR_INC_(e);
     }
 
-    /* make a local, modifiable copy of the subscriber list */
+    /* make a local, modifiable copy of the subscriber list
+    *
+    * NOTE: the subscriber lists change only in the task-level critical
+    * section, which cannot be preempted by the "FromISR" APIs.
+    */
     QPSet subscrList = QActive_subscrList_[e->sig];
-    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+    FREERTOS_ISR_UNMASK_();
 
     if (QPSet_notEmpty(&subscrList)) { /* any subscribers? */
         /* the highest-prio subscriber */
@@ -420,8 +506,9 @@ void QTimeEvt_tickFromISR_(uint_fast8_t const tickRate,
 
     UBaseType_t uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 
+    ++prev->ctr; /* count the ticks, see QActive_deferTTL() */
+
     QS_BEGIN_NOCRIT_PRE_(QS_QF_TICK, 0U)
-        ++prev->ctr;
         QS_TEC_PRE_(prev->ctr); /* tick ctr */
         QS_U8_PRE_(tickRate);   /* tick rate */
     QS_END_NOCRIT_PRE_()
@@ -524,13 +611,14 @@ QEvt *QF_newXFromISR_(uint_fast16_t const evtSize,
     Q_ASSERT_ID(710, idx < QF_maxPool_);
 
     /* get e -- platform-dependent */
+    QEvt *e;
 #ifdef Q_SPY
-    QEvt *e = QMPool_getFromISR(&QF_ePool_[idx],
+    QF_EPOOL_GET_FROM_ISR_(QF_ePool_[idx], e,
                   ((margin != QF_NO_MARGIN) ? margin : 0U),
                   (uint_fast8_t)QS_EP_ID + idx + 1U);
 #else
-    QEvt *e = QMPool_getFromISR(&QF_ePool_[idx],
-                      ((margin != QF_NO_MARGIN) ? margin : 0U), 0U);
+    QF_EPOOL_GET_FROM_ISR_(QF_ePool_[idx], e,
+                  ((margin != QF_NO_MARGIN) ? margin : 0U), 0U);
 #endif
 
     /* was e allocated correctly? */
@@ -541,7 +629,7 @@ QEvt *QF_newXFromISR_(uint_fast16_t const evtSize,
 
 #ifdef Q_SPY
         UBaseType_t uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
-        QS_BEGIN_PRE_(QS_QF_NEW, (uint_fast8_t)QS_EP_ID + e->poolId_)
+        QS_BEGIN_NOCRIT_PRE_(QS_QF_NEW, (uint_fast8_t)QS_EP_ID + e->poolId_)
             QS_TIME_PRE_();         /* timestamp */
             QS_EVS_PRE_(evtSize);   /* the size of the event */
             QS_SIG_PRE_(sig);       /* the signal of the event */
@@ -556,7 +644,7 @@ QEvt *QF_newXFromISR_(uint_fast16_t const evtSize,
 
 #ifdef Q_SPY
         UBaseType_t uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
-        QS_BEGIN_PRE_(QS_QF_NEW_ATTEMPT, (uint_fast8_t)QS_EP_ID + idx + 1U)
+        QS_BEGIN_NOCRIT_PRE_(QS_QF_NEW_ATTEMPT, (uint_fast8_t)QS_EP_ID + idx + 1U)
             QS_TIME_PRE_();         /* timestamp */
             QS_EVS_PRE_(evtSize);   /* the size of the event */
             QS_SIG_PRE_(sig);       /* the signal of the event */
@@ -571,11 +659,11 @@ void QF_gcFromISR(QEvt const * const e) {
 
     /* is it a dynamic event? */
     if (e->poolId_ != 0U) {
-        UBaseType_t uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        FREERTOS_ISR_STAT_
+        FREERTOS_ISR_MASK_();
 
-        /* isn't this the last ref? */
-        if (e->refCtr_ > 1U) {
-            QEvt_refCtr_dec_(e); /* decrements the ref counter */
+        /* isn't this the last ref? (decrements the ref counter if not) */
+        if (refCtr_decFromISR(e)) {
 
             QS_BEGIN_NOCRIT_PRE_(QS_QF_GC_ATTEMPT, (uint_fast8_t)e->poolId_)
                 QS_TIME_PRE_();      /* timestamp */
@@ -583,7 +671,7 @@ void QF_gcFromISR(QEvt const * const e) {
                 QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
             QS_END_NOCRIT_PRE_()
 
-            portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+            FREERTOS_ISR_UNMASK_();
         }
         /* this is the last reference to this event, recycle it */
         else {
@@ -595,7 +683,7 @@ void QF_gcFromISR(QEvt const * const e) {
                 QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
             QS_END_NOCRIT_PRE_()
 
-            portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+            FREERTOS_ISR_UNMASK_();
 
             /* pool ID must be in range */
             Q_ASSERT_ID(810, idx < QF_maxPool_);
@@ -603,15 +691,34 @@ void QF_gcFromISR(QEvt const * const e) {
 #ifdef Q_SPY
             /* cast 'const' away in (QEvt *)e is OK,
              * because it's a pool event */
-            QMPool_putFromISR(&QF_ePool_[idx], (QEvt *)e,
+            QF_EPOOL_PUT_FROM_ISR_(QF_ePool_[idx], (QEvt *)e,
                               (uint_fast8_t)QS_EP_ID + e->poolId_);
 #else
-            QMPool_putFromISR(&QF_ePool_[idx], (QEvt *)e, 0U);
+            QF_EPOOL_PUT_FROM_ISR_(QF_ePool_[idx], (QEvt *)e, 0U);
 #endif
         }
     }
 }
 /*..........................................................................*/
+static bool refCtr_decFromISR(QEvt const * const e) {
+#ifdef QF_ISR_LOCKFREE
+    uint8_t volatile * const ctr = &((QEvt *)e)->refCtr_;
+    uint8_t n = __atomic_load_n(ctr, __ATOMIC_ACQUIRE);
+    while ((n > 1U)
+           && (!__atomic_compare_exchange_n(ctr, &n, (uint8_t)(n - 1U),
+                    false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)))
+    {
+    }
+    return (n > 1U);
+#else
+    bool const more = (e->refCtr_ > 1U);
+    if (more) {
+        QEvt_refCtr_dec_(e);
+    }
+    return more;
+#endif /* QF_ISR_LOCKFREE */
+}
+/*..........................................................................*/
 void QMPool_putFromISR(QMPool * const me, void *b,
                        uint_fast8_t const qs_id)
 {
@@ -40,6 +40,11 @@
 /* The maximum number of active objects in the application, see NOTE1 */
 #define QF_MAX_ACTIVE         32U
 
+/* lock-free event pools and reference counting in the "FromISR" APIs,
+* see NOTE4
+*/
+/*#define QF_ISR_LOCKFREE*/
+
 /* QF interrupt disabling/enabling (task level) */
 #define QF_INT_DISABLE()      taskDISABLE_INTERRUPTS()
 #define QF_INT_ENABLE()       taskENABLE_INTERRUPTS()
@@ -56,6 +61,7 @@
 #include "qep_port.h"  /* QEP port */
 #include "qequeue.h"   /* QF event queue (for deferring events) */
 #include "qmpool.h"    /* QF memory pool (for event pools) */
+#include "qlfpool.h"   /* lock-free memory pool (for event pools) */
 #include "qf.h"        /* QF platform-independent public interface */
 
 /* the "FromISR" versions of the QF APIs, see NOTE3 */
@@ -201,6 +207,7 @@ enum FreeRTOS_TaskAttrs {
              vTaskPrioritySet(curr_task, curr_prio);                \
          } else ((void)0)
 
+#ifndef QF_ISR_LOCKFREE
     /* native QF event pool operations */
     #define QF_EPOOL_TYPE_            QMPool
     #define QF_EPOOL_INIT_(p_, poolSto_, poolSize_, evtSize_) \
@@ -210,6 +217,25 @@ enum FreeRTOS_TaskAttrs {
         ((e_) = (QEvt *)QMPool_get(&(p_), (m_), (qs_id_)))
     #define QF_EPOOL_PUT_(p_, e_, qs_id_) \
         (QMPool_put(&(p_), (e_), (qs_id_)))
+    #define QF_EPOOL_GET_FROM_ISR_(p_, e_, m_, qs_id_) \
+        ((e_) = (QEvt *)QMPool_getFromISR(&(p_), (m_), (qs_id_)))
+    #define QF_EPOOL_PUT_FROM_ISR_(p_, e_, qs_id_) \
+        (QMPool_putFromISR(&(p_), (e_), (qs_id_)))
+#else
+    /* lock-free QF event pool operations, see NOTE4 */
+    #define QF_EPOOL_TYPE_            QLfPool
+    #define QF_EPOOL_INIT_(p_, poolSto_, poolSize_, evtSize_) \
+        (QLfPool_init(&(p_), (poolSto_), (poolSize_), (evtSize_)))
+    #define QF_EPOOL_EVENT_SIZE_(p_)  ((uint_fast16_t)(p_).blockSize)
+    #define QF_EPOOL_GET_(p_, e_, m_, qs_id_) \
+        ((e_) = (QEvt *)QLfPool_get(&(p_), (m_), (qs_id_)))
+    #define QF_EPOOL_PUT_(p_, e_, qs_id_) \
+        (QLfPool_put(&(p_), (e_), (qs_id_)))
+    #define QF_EPOOL_GET_FROM_ISR_(p_, e_, m_, qs_id_) \
+        QF_EPOOL_GET_(p_, e_, m_, qs_id_)
+    #define QF_EPOOL_PUT_FROM_ISR_(p_, e_, qs_id_) \
+        QF_EPOOL_PUT_(p_, e_, qs_id_)
+#endif /* QF_ISR_LOCKFREE */
 
 #endif /* ifdef QP_IMPL */
 
@@ -230,6 +256,25 @@ enum FreeRTOS_TaskAttrs {
 * provides the "FromISR" variants for QP functions and "FROM_ISR" variants
 * for QP macros to be used inside ISRs. ONLY THESE "FROM_ISR" VARIANTS
 * ARE ALLOWED INSIDE ISRs AND CALLING THE TASK-LEVEL APIs IS AN ERROR.
+*
+* NOTE4:
+* With QF_ISR_LOCKFREE defined, the QF event pools are the lock-free
+* ::QLfPool (qf_lfpool.c must then be added to the build) and the "FromISR"
+* APIs adjust the event reference counters with atomic read-modify-write
+* operations. Interrupts are then masked in the "FromISR" APIs only around
+* the optional QS trace records, the event tracker (QF_EVT_TRACK) and the
+* queue high-water marks (QF_AO_TELEM). The QS_QF_MPOOL_GET/PUT records are
+* not produced for the lock-free event pools (the QS_QF_NEW and QS_QF_GC
+* records still are).
+*
+* The lock-free operations use the GNU-compatible __atomic builtins, which
+* on ARMv7-M/ARMv8-M compile to the LDREX/STREX loops. On ARMv6-M (Cortex-M0
+* /M0+/M1) the builtins fall back to library helpers, which mask interrupts,
+* so QF_ISR_LOCKFREE brings no benefit there. The task-level QF APIs still
+* adjust the reference counters in the FreeRTOS critical section, which is
+* correct only on a single core, where that critical section cannot be
+* preempted by the ISRs calling the "FromISR" APIs (FreeRTOS SMP is not
+* supported).
 */
 
 #endif /* QF_PORT_H */
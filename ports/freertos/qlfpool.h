@@ -0,0 +1,133 @@
+/*============================================================================
+* QP/C Real-Time Embedded Framework (RTEF)
+* Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+*
+* SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+*
+* This software is dual-licensed under the terms of the open source GNU
+* General Public License version 3 (or any later version), or alternatively,
+* under the terms of one of the closed source Quantum Leaps commercial
+* licenses.
+*
+* The terms of the open source GNU General Public License version 3
+* can be found at: <www.gnu.org/licenses/gpl-3.0>
+*
+* The terms of the closed source Quantum Leaps commercial licenses
+* can be found at: <www.state-machine.com/licensing>
+*
+* Redistributions in source code must retain this top-level comment block.
+* Plagiarizing this software to sidestep the license obligations is illegal.
+*
+* Contact information:
+* <www.state-machine.com>
+* <info@state-machine.com>
+============================================================================*/
+/*!
+* @date Last updated on: 2026-10-18
+* @version Last updated for: @ref qpc_7_2_2
+*
+* @file
+* @brief Lock-free fixed block-size memory pool ::QLfPool for the QF/C port
+* to FreeRTOS (see NOTE4 in qf_port.h)
+*/
+#ifndef QLFPOOL_H_
+#define QLFPOOL_H_
+
+/*! @brief Lock-free fixed block-size memory pool
+* @class QLfPool
+*
+* @details
+* ::QLfPool offers the same services as the native ::QMPool, but the free
+* blocks are kept in a tagged Treiber stack manipulated only with the
+* compare-and-swap (CAS) of a single 32-bit word. Consequently, the blocks
+* can be allocated and recycled from tasks and from ISRs (at any priority
+* allowed to call the FreeRTOS "FromISR" APIs) without masking interrupts.
+*
+* The free-list links are stored as 16-bit block indices inside the free
+* blocks themselves, and the head of the free list keeps the index of the
+* top free block in the lower 16 bits and a modification tag in the upper
+* 16 bits. The tag changes with every successful push and pop, which
+* prevents the ABA problem when a pop is preempted between reading the
+* head and swapping it.
+*
+* The number of free blocks @c nFree is reserved *before* a block is
+* popped and released only *after* a block is pushed, so a successful
+* reservation always finds a block on the stack.
+*
+* @note
+* The data members @c start, @c end, @c blockSize, @c nTot, @c nFree and
+* @c nMin have the same meaning as in ::QMPool, so the pool statistics and
+* the event tracker in QF work unchanged with ::QLfPool as the event pool.
+*/
+typedef struct {
+/* private: */
+
+    /*! start of the memory managed by this memory pool */
+    void *start;
+
+    /*! end of the memory managed by this memory pool */
+    void *end;
+
+    /*! tag (upper 16 bits) and 1-based index of the top free block
+    * (lower 16 bits, 0 for the empty free list)
+    */
+    uint32_t volatile head;
+
+    /*! maximum block size (in bytes) */
+    QMPoolSize blockSize;
+
+    /*! total number of blocks */
+    QMPoolCtr nTot;
+
+    /*! number of free blocks remaining */
+    QMPoolCtr volatile nFree;
+
+    /*! minimum number of free blocks ever present in this pool */
+    QMPoolCtr volatile nMin;
+} QLfPool;
+
+/*! initialize the lock-free memory pool
+* @public @memberof QLfPool
+*
+* @param[in,out] me   pointer (see @ref oop)
+* @param[in]  poolSto pointer to the storage for the pool (aligned at
+*                     the pointer boundary)
+* @param[in]  poolSize size of the storage [bytes]
+* @param[in]  blockSize size of the blocks [bytes] (rounded up to the
+*                     multiple of the pointer size)
+*
+* @note
+* The pool can hold at most 0xFFFE blocks.
+*/
+void QLfPool_init(QLfPool * const me,
+    void * const poolSto,
+    uint_fast32_t const poolSize,
+    uint_fast16_t const blockSize);
+
+/*! obtain a memory block from the pool (task or ISR context)
+* @public @memberof QLfPool
+*
+* @param[in,out] me   pointer (see @ref oop)
+* @param[in]  margin  minimum number of free blocks that must remain
+*                     in the pool after the allocation
+* @param[in]  qs_id   QS-id of this pool (unused, see NOTE4 in qf_port.h)
+*
+* @returns a pointer to the block or NULL if the pool has no more than
+* @p margin free blocks.
+*/
+void *QLfPool_get(QLfPool * const me,
+    uint_fast16_t const margin,
+    uint_fast8_t const qs_id);
+
+/*! recycle a memory block back to the pool (task or ISR context)
+* @public @memberof QLfPool
+*
+* @param[in,out] me   pointer (see @ref oop)
+* @param[in]  b       pointer to the block obtained from this pool
+* @param[in]  qs_id   QS-id of this pool (unused, see NOTE4 in qf_port.h)
+*/
+void QLfPool_put(QLfPool * const me,
+    void * const b,
+    uint_fast8_t const qs_id);
+
+#endif /* QLFPOOL_H_ */
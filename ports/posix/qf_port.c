@@ -32,6 +32,9 @@
 
 /* expose features from the 2008 POSIX standard (IEEE Standard 1003.1-2008) */
 #define _POSIX_C_SOURCE 200809L
+#if (defined QF_AO_TELEM) && (!defined _DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE   /* for MAP_ANONYMOUS and mincore(), see NOTE07 */
+#endif
 
 #define QP_IMPL           /* this is QP implementation */
 #include "qf_port.h"      /* QF port */
@@ -54,6 +57,7 @@
 #include <termios.h>
 #include <unistd.h>
 #include <signal.h>
+#include <sched.h>        /* for sched_yield() */
 
 Q_DEFINE_THIS_MODULE("qf_port")
 
@@ -66,11 +70,30 @@ static bool l_isRunning;       /* flag indicating when QF is running */
 static struct termios l_tsav;  /* structure with saved terminal attributes */
 static struct timespec l_tick; /* structure for the clock tick */
 static int_t l_tickPrio;       /* priority of the ticker thread */
+static uint16_t l_drainMax[QF_MAX_ACTIVE + 1U]; /* see QActive_setDrain() */
+#ifdef Q_SPY
+static char const *l_replayFile; /* QS file to replay, see NOTE05 */
+#endif
+#ifdef QF_AO_TELEM
+static struct {
+    uint8_t *base;    /* lowest address of the AO stack above the guard page */
+    size_t   size;    /* size of the AO stack [bytes] */
+    pthread_t thread; /* the (joinable) AO thread running on the stack */
+    bool     exited;  /* the AO thread has returned */
+} l_stack[QF_MAX_ACTIVE + 1U]; /* indexed by AO priority, see NOTE07 */
+static uint_fast8_t l_stackExited; /* # AO threads returned, not joined */
+
+static void stackFree(uint_fast8_t const prio);
+static void stacksReap(void);
+#endif
 
 #define NSEC_PER_SEC           1000000000L
 #define DEFAULT_TICKS_PER_SEC  100
 
 static void sigIntHandler(int dummy);
+#ifdef Q_SPY
+static int_t replayRun(void);
+#endif
 
 /* QF functions ============================================================*/
 void QF_init(void) {
@@ -108,6 +131,103 @@ void QF_enterCriticalSection_(void) {
 void QF_leaveCriticalSection_(void) {
     pthread_mutex_unlock(&QF_pThreadMutex_);
 }
+#ifdef QF_RTC_TIME
+/*..........................................................................*/
+QRtcTime QF_rtcTime_(void) { /* see NOTE3 in qf_port.h */
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (QRtcTime)((uint32_t)t.tv_sec * (uint32_t)NSEC_PER_SEC
+                      + (uint32_t)t.tv_nsec);
+}
+#endif /* QF_RTC_TIME */
+
+/*..........................................................................*/
+uint32_t QF_evtTrackTime_(void) { /* [ms] */
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint32_t)t.tv_sec * 1000U
+           + (uint32_t)(t.tv_nsec / (NSEC_PER_SEC / 1000));
+}
+
+#ifdef QF_EVT_TRACK
+/*..........................................................................*/
+static void leakReport(void) {
+    QEvtTrackInfo info[16];
+    uint_fast16_t const nLive =
+        QF_getLiveEvts(info, sizeof(info) / sizeof(info[0]));
+    uint_fast16_t const n = (nLive < sizeof(info) / sizeof(info[0]))
+        ? nLive : sizeof(info) / sizeof(info[0]);
+    uint_fast16_t i;
+    uint_fast16_t j;
+
+    if (nLive != 0U) {
+        fprintf(stderr, "<TARGET> LEAK    %u live event(s)\n",
+                (unsigned)nLive);
+    }
+    for (i = 0U; i < n; ++i) {
+        for (j = 0U; (j < i) && (info[j].sig != info[i].sig); ++j) {
+        }
+        if (j < i) {
+            continue; /* the signal already reported */
+        }
+        for (j = i; j < n; ++j) {
+            if (info[j].sig == info[i].sig) {
+                uint_fast8_t p;
+                fprintf(stderr, "<TARGET> LEAK    sig=%u evt=%p pool=%u "
+                        "ref=%u age=%ums sender=%p held-by:",
+                        (unsigned)info[j].sig, (void const *)info[j].e,
+                        (unsigned)info[j].poolId, (unsigned)info[j].refCtr,
+                        (unsigned)info[j].age, info[j].sender);
+                for (p = 1U; p <= QF_MAX_ACTIVE; ++p) {
+                    if (QPSet_hasElement(&info[j].holders, p)) {
+                        fprintf(stderr, " %u", (unsigned)p);
+                    }
+                }
+                fprintf(stderr, "\n");
+            }
+        }
+    }
+}
+#endif /* QF_EVT_TRACK */
+
+#ifdef QF_POOL_STATS
+/*..........................................................................*/
+static void poolReport(void) {
+    uint_fast8_t i;
+    for (i = 1U; i <= QF_maxPool_; ++i) {
+        QPoolStat stat;
+        QF_getPoolStat(i, &stat);
+        fprintf(stderr, "<TARGET> POOL    %u: block=%u tot=%u peak=%u "
+                "alloc=%u fail=%u near-miss=%u waste=%u%%\n",
+                (unsigned)i, (unsigned)stat.blockSize, (unsigned)stat.nTot,
+                (unsigned)stat.peak, (unsigned)stat.nAlloc,
+                (unsigned)stat.nFail, (unsigned)stat.nNearMiss,
+                (unsigned)stat.wastePct);
+    }
+
+    QPoolSizeStat sizes[QF_POOL_STAT_SIZES];
+    uint_fast8_t const nSizes = QF_getSizeStat(sizes, QF_POOL_STAT_SIZES);
+    for (i = 0U; i < nSizes; ++i) {
+        fprintf(stderr, "<TARGET> POOL    evtSize=%u peak=%u alloc=%u\n",
+                (unsigned)sizes[i].evtSize, (unsigned)sizes[i].peak,
+                (unsigned)sizes[i].nAlloc);
+    }
+
+    QPoolAdvice advice[QF_MAX_EPOOL];
+    uint_fast8_t const nPools = QF_poolAdvise(advice, QF_MAX_EPOOL,
+                                              QF_POOL_HEADROOM);
+    uint32_t total = 0U;
+    for (i = 0U; i < nPools; ++i) {
+        fprintf(stderr, "<TARGET> ADVICE  QF_poolInit(sto%u, %u, %u); "
+                "/* %u blocks */\n",
+                (unsigned)(i + 1U), (unsigned)advice[i].poolSize,
+                (unsigned)advice[i].evtSize, (unsigned)advice[i].nBlocks);
+        total += advice[i].poolSize;
+    }
+    fprintf(stderr, "<TARGET> ADVICE  %u bytes of event pools "
+            "(headroom %u%%)\n", (unsigned)total, (unsigned)QF_POOL_HEADROOM);
+}
+#endif /* QF_POOL_STATS */
 
 /*..........................................................................*/
 int_t QF_run(void) {
@@ -117,6 +237,14 @@ int_t QF_run(void) {
     QS_BEGIN_NOCRIT_PRE_(QS_QF_RUN, 0U)
     QS_END_NOCRIT_PRE_()
 
+#ifdef Q_SPY
+    if (l_replayFile != (char const *)0) { /* replay mode? */
+        int_t const nEvt = replayRun();
+        QF_onCleanup(); /* invoke cleanup callback */
+        return nEvt;
+    }
+#endif
+
     /* try to set the priority of the ticker thread, see NOTE01 */
     struct sched_param sparam;
     sparam.sched_priority = l_tickPrio;
@@ -135,6 +263,10 @@ int_t QF_run(void) {
     /* system clock tick must be configured */
     Q_ASSERT_ID(200, l_tick.tv_nsec != 0);
 
+#ifdef Q_SPY
+    QS_thrBufInit_(0U); /* QS-TX ring of the ticker thread */
+#endif
+
     /* get the absolute monotonic time for no-drift sleeping */
     static struct timespec next_tick;
     clock_gettime(CLOCK_MONOTONIC, &next_tick);
@@ -159,7 +291,16 @@ int_t QF_run(void) {
             /* clock tick callback (must call QTIMEEVT_TICK_X()) */
             QF_onClockTick();
         }
+#ifdef QF_AO_TELEM
+        stacksReap(); /* unmap the stacks of the stopped AOs, see NOTE07 */
+#endif
     }
+#ifdef QF_POOL_STATS
+    poolReport(); /* recommended event pools for this run */
+#endif
+#ifdef QF_EVT_TRACK
+    leakReport(); /* events still live at the end of the run */
+#endif
     QF_onCleanup(); /* invoke cleanup callback */
     pthread_mutex_destroy(&l_startupMutex);
     pthread_mutex_destroy(&QF_pThreadMutex_);
@@ -173,6 +314,14 @@ void QF_setTickRate(uint32_t ticksPerSec, int_t tickPrio) {
     l_tickPrio = tickPrio;
 }
 /*..........................................................................*/
+#ifdef Q_SPY
+void QF_setReplay(char const * const fileName) {
+    /* must be called before starting the AOs */
+    Q_REQUIRE_ID(400, fileName != (char const *)0);
+    l_replayFile = fileName;
+}
+#endif
+/*..........................................................................*/
 void QF_stop(void) {
     l_isRunning = false; /* stop the loop in QF_run() */
 }
@@ -206,7 +355,34 @@ int QF_consoleWaitForKey(void) {
     return getchar();
 }
 
+uint32_t volatile QF_lifoCtr_[QF_MAX_ACTIVE + 1U];
+
 /****************************************************************************/
+static void dispatchEvt(QActive * const act, QEvt const * const e) {
+    QS_REPLAY_REC(e, act->prio); /* record the event for replay */
+    QF_RTC_DISPATCH_(act, e, act->prio); /* dispatch to the HSM */
+    QF_gc(e); /* check if the event is garbage, and collect it if so */
+}
+/*..........................................................................*/
+static void drainBatch(QActive * const act, uint_fast16_t const nMax) {
+    QEvt const *evts[QF_DRAIN_MAX];
+    uint_fast16_t const n = QActive_getN_(act, evts, nMax);
+    uint32_t lifo = QF_lifoCtr_[act->prio]; /* see NOTE06 */
+
+    for (uint_fast16_t i = 0U; i < n; ++i) {
+        dispatchEvt(act, evts[i]);
+
+        /* the events posted LIFO during the batch go first */
+        while (lifo != QF_lifoCtr_[act->prio]) {
+            ++lifo;
+            dispatchEvt(act, QActive_get_(act));
+        }
+    }
+    if (n == nMax) { /* full batch? */
+        sched_yield(); /* let other threads of the same priority run */
+    }
+}
+/*..........................................................................*/
 static void *thread_routine(void *arg) { /* the expected POSIX signature */
     QActive *act = (QActive *)arg;
 
@@ -214,6 +390,10 @@ static void *thread_routine(void *arg) { /* the expected POSIX signature */
     pthread_mutex_lock(&l_startupMutex);
     pthread_mutex_unlock(&l_startupMutex);
 
+#ifdef Q_SPY
+    QS_thrBufInit_(act->prio); /* QS-TX ring of this AO thread */
+#endif
+
 #ifdef QF_ACTIVE_STOP
     act->thread = true;
     while (act->thread)
@@ -221,11 +401,25 @@ static void *thread_routine(void *arg) { /* the expected POSIX signature */
     for (;;) /* for-ever */
 #endif
     {
-        QEvt const *e = QActive_get_(act); /* wait for the event */
-        QHSM_DISPATCH(&act->super, e, act->prio); /* dispatch to the HSM */
-        QF_gc(e); /* check if the event is garbage, and collect it if so */
+        uint_fast16_t const nMax = l_drainMax[act->prio];
+        if (nMax <= 1U) { /* one event at a time? */
+            dispatchEvt(act, QActive_get_(act)); /* wait for the event */
+        }
+        else {
+            drainBatch(act, nMax); /* wait for and drain the events */
+        }
     }
 #ifdef QF_ACTIVE_STOP
+#ifdef QF_AO_TELEM
+    {
+        /* the stack is unmapped after joining this thread, see NOTE07 */
+        QF_CRIT_STAT_
+        QF_CRIT_E_();
+        l_stack[act->prio].exited = true;
+        ++l_stackExited;
+        QF_CRIT_X_();
+    }
+#endif
     QActive_unregister_(act); /* un-register this active object */
 #endif
     return (void *)0; /* return success */
@@ -256,6 +450,12 @@ void QActive_start_(QActive * const me, QPrioSpec const prioSpec,
     QHSM_INIT(&me->super, par, me->prio);
     QS_FLUSH(); /* flush the trace buffer to the host */
 
+#ifdef Q_SPY
+    if (l_replayFile != (char const *)0) { /* replay mode? */
+        return; /* no AO thread, QF_run() dispatches the events */
+    }
+#endif
+
     pthread_attr_init(&attr);
 
     /* SCHED_FIFO corresponds to real-time preemptive priority-based scheduler
@@ -263,7 +463,9 @@ void QActive_start_(QActive * const me, QPrioSpec const prioSpec,
     */
     pthread_attr_setschedpolicy (&attr, SCHED_FIFO);
     pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+#ifndef QF_AO_TELEM
     pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_DETACHED);
+#endif
 
     /* priority of the p-thread, see NOTE04 */
     param.sched_priority = me->prio
@@ -271,9 +473,30 @@ void QActive_start_(QActive * const me, QPrioSpec const prioSpec,
                               - QF_MAX_ACTIVE - 3U);
     pthread_attr_setschedparam(&attr, &param);
 
+#ifdef QF_AO_TELEM
+    /* map the AO stack with a guard page below it, see NOTE07 */
+    if (l_stack[me->prio].base != (uint8_t *)0) { /* AO restarted? */
+        stackFree(me->prio); /* join the previous thread and unmap */
+    }
+    {
+        size_t const page = (size_t)sysconf(_SC_PAGESIZE);
+        size_t const size = ((((stkSize < PTHREAD_STACK_MIN)
+                               ? PTHREAD_STACK_MIN
+                               : stkSize) + page - 1U) / page) * page;
+        uint8_t * const map = (uint8_t *)mmap(NULL, size + page,
+            PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        Q_ASSERT_ID(620, map != (uint8_t *)MAP_FAILED);
+        mprotect(map, page, PROT_NONE); /* the guard page */
+        l_stack[me->prio].base = map + page;
+        l_stack[me->prio].size = size;
+        pthread_attr_setstack(&attr, map + page, size);
+    }
+#else
     pthread_attr_setstacksize(&attr, (stkSize < PTHREAD_STACK_MIN
                                       ? PTHREAD_STACK_MIN
                                       : stkSize));
+#endif
 
     err = pthread_create(&thread, &attr, &thread_routine, me);
     if (err != 0) {
@@ -287,6 +510,9 @@ void QActive_start_(QActive * const me, QPrioSpec const prioSpec,
         err = pthread_create(&thread, &attr, &thread_routine, me);
     }
     Q_ASSERT_ID(610, err == 0); /* AO thread must be created */
+#ifdef QF_AO_TELEM
+    l_stack[me->prio].thread = thread;
+#endif
 
     //pthread_attr_getschedparam(&attr, &param);
     //printf("param.sched_priority==%d\n", param.sched_priority);
@@ -301,6 +527,14 @@ void QActive_stop(QActive * const me) {
 }
 #endif
 /*..........................................................................*/
+void QActive_setDrain(QActive * const me, uint_fast16_t const nMax) {
+    /*! @pre the AO must be started and the batch must fit QF_DRAIN_MAX */
+    Q_REQUIRE_ID(800, (0U < me->prio) && (me->prio <= QF_MAX_ACTIVE)
+                      && (nMax <= QF_DRAIN_MAX));
+
+    l_drainMax[me->prio] = (uint16_t)nMax;
+}
+/*..........................................................................*/
 void QActive_setAttr(QActive *const me, uint32_t attr1, void const *attr2) {
     (void)me;    /* unused parameter */
     (void)attr1; /* unused parameter */
@@ -308,6 +542,83 @@ void QActive_setAttr(QActive *const me, uint32_t attr1, void const *attr2) {
     Q_ERROR_ID(900); /* this function should not be called in this QP port */
 }
 
+#ifdef QF_AO_TELEM
+/*..........................................................................*/
+void QActive_getPortTelem_(QActive const * const me,
+                           QActiveTelem * const telem)
+{
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+    telem->queueSize = (uint16_t)(me->eQueue.end + 1U);
+    telem->queueMax  = (uint16_t)(me->eQueue.end + 1U - me->eQueue.nMin);
+    uint8_t * const base = l_stack[me->prio].base;
+    size_t const size = l_stack[me->prio].size;
+    QF_CRIT_X_();
+
+    /* probe the pages of the stack from the guard page up, see NOTE07 */
+    if (base != (uint8_t *)0) {
+        size_t const page = (size_t)sysconf(_SC_PAGESIZE);
+        size_t const nPages = size / page;
+        size_t n = 0U; /* pages never touched */
+        unsigned char vec[64];
+        while (n < nPages) {
+            size_t const chunk = ((nPages - n) < sizeof(vec))
+                                 ? (nPages - n) : sizeof(vec);
+            if (mincore(base + (n * page), chunk * page, vec) != 0) {
+                break;
+            }
+            size_t i = 0U;
+            while ((i < chunk) && ((vec[i] & 1U) == 0U)) {
+                ++i;
+            }
+            n += i;
+            if (i < chunk) { /* found the lowest touched page? */
+                break;
+            }
+        }
+        telem->stackSize = (uint32_t)size;
+        telem->stackUsed = (uint32_t)(size - (n * page));
+    }
+}
+/*..........................................................................*/
+/* join the AO thread and unmap its stack with the guard page */
+static void stackFree(uint_fast8_t const prio) {
+    pthread_join(l_stack[prio].thread, NULL);
+
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+    uint8_t * const base = l_stack[prio].base;
+    size_t const size = l_stack[prio].size;
+    if (l_stack[prio].exited) {
+        --l_stackExited;
+    }
+    l_stack[prio].base   = (uint8_t *)0;
+    l_stack[prio].size   = 0U;
+    l_stack[prio].exited = false;
+    QF_CRIT_X_();
+
+    size_t const page = (size_t)sysconf(_SC_PAGESIZE);
+    munmap(base - page, size + page);
+}
+/*..........................................................................*/
+/* free the stacks of the AO threads that have returned */
+static void stacksReap(void) {
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+    uint_fast8_t const n = l_stackExited;
+    QF_CRIT_X_();
+
+    for (uint_fast8_t p = 1U; (n != 0U) && (p <= QF_MAX_ACTIVE); ++p) {
+        QF_CRIT_E_();
+        bool const exited = l_stack[p].exited;
+        QF_CRIT_X_();
+        if (exited) {
+            stackFree(p);
+        }
+    }
+}
+#endif /* QF_AO_TELEM */
+
 /****************************************************************************/
 static void sigIntHandler(int dummy) {
     (void)dummy; /* unused parameter */
@@ -315,6 +626,160 @@ static void sigIntHandler(int dummy) {
     exit(-1);
 }
 
+/****************************************************************************/
+#ifdef Q_SPY
+
+#define REPLAY_FRAME_MAX  (64U * 1024U)
+
+static uint8_t l_replayFrame[REPLAY_FRAME_MAX]; /* un-escaped QS record */
+static uint32_t l_replayImmutable; /* # immutable events replayed bare */
+
+/* dispatch the event recorded in the QS_REPLAY_EVT record 'd' of 'len'
+* bytes and discard all events posted in the RTC step
+*/
+static bool replayEvt(uint8_t const *d, uint32_t len,
+                      uint8_t timeSize, uint8_t sigSize)
+{
+    if (len < (uint32_t)timeSize + 1U + sigSize + 2U) {
+        return false; /* record too short */
+    }
+    d = &d[timeSize]; /* skip the time-stamp */
+    uint8_t const prio = d[0];
+    QSignal sig = 0U;
+    for (uint8_t i = 0U; i < sigSize; ++i) {
+        sig |= (QSignal)((uint32_t)d[1U + i] << (8U * i));
+    }
+    d = &d[1U + sigSize];
+    uint16_t parLen = (uint16_t)(d[0] | ((uint16_t)d[1] << 8U));
+    d = &d[2];
+    bool const immutable = (parLen == (uint16_t)QS_REPLAY_IMMUTABLE);
+    if (immutable) { /* parameters not recorded, see QS_replayEvt_() */
+        parLen = 0U;
+    }
+    if ((len != (uint32_t)timeSize + 1U + sigSize + 2U + parLen)
+        || (prio == 0U) || (prio > QF_MAX_ACTIVE)
+        || (QActive_registry_[prio] == (QActive *)0))
+    {
+        return false; /* corrupted record or unknown AO */
+    }
+
+    static QEvt staticEvt; /* immutable events and events w/o pools */
+    QEvt *e;
+    if (immutable) {
+        ++l_replayImmutable;
+        staticEvt.sig = sig;
+        e = &staticEvt;
+    }
+    else if (QF_maxPool_ != 0U) {
+        e = QF_newX_((uint_fast16_t)parLen + sizeof(QEvt), QF_NO_MARGIN,
+                     (enum_t)sig);
+        memcpy(&((uint8_t *)e)[sizeof(QEvt)], d, parLen);
+    }
+    else {
+        Q_ASSERT_ID(720, parLen == 0U); /* parameters need event pools */
+        staticEvt.sig = sig;
+        e = &staticEvt;
+    }
+
+    QActive * const act = QActive_registry_[prio];
+    QF_RTC_DISPATCH_(act, e, act->prio); /* dispatch to the HSM */
+    QF_gc(e);
+
+    /* the events posted in the RTC step are also in the recording */
+    for (uint_fast8_t p = 1U; p <= QF_MAX_ACTIVE; ++p) {
+        QActive * const a = QActive_registry_[p];
+        if (a != (QActive *)0) {
+            while (a->eQueue.frontEvt != (QEvt *)0) {
+                QF_gc(QEQueue_get(&a->eQueue, p));
+            }
+        }
+    }
+    return true;
+}
+/*..........................................................................*/
+static int_t replayRun(void) {
+    FILE *f = fopen(l_replayFile, "rb");
+    if (f == (FILE *)0) {
+        fprintf(stderr, "<TARGET> ERROR   cannot open replay file %s\n",
+                l_replayFile);
+        return -1;
+    }
+
+    /* sizes of the recorded target (updated from QS_TARGET_INFO) */
+    uint8_t timeSize = QS_TIME_SIZE;
+    uint8_t sigSize  = Q_SIGNAL_SIZE;
+    uint32_t n = 0U;  /* # bytes of the current record */
+    uint8_t chksum = 0U;
+    bool esc = false;
+    uint8_t seq = 0U;     /* sequence number of the previous record */
+    uint32_t nGap = 0U;   /* # gaps in the sequence numbers */
+    int_t nEvt = 0;
+    int c;
+    while ((c = getc(f)) != EOF) {
+        uint8_t b = (uint8_t)c;
+        if (b == QS_FRAME) { /* end of a record? */
+            if ((n >= 3U) && (n <= REPLAY_FRAME_MAX)
+                && (chksum == QS_GOOD_CHKSUM))
+            {
+                uint8_t const *d = &l_replayFrame[2];
+                uint32_t const len = n - 3U; /* w/o seq, rec and chksum */
+                if ((l_replayFrame[0] != (uint8_t)(seq + 1U))
+                    && (nEvt > 0))
+                {
+                    /* records lost while recording. NOTE: the 8-bit
+                    * sequence misses the losses of a multiple of 256
+                    */
+                    ++nGap;
+                }
+                seq = l_replayFrame[0];
+                if (l_replayFrame[1] == (uint8_t)QS_TARGET_INFO) {
+                    if (len >= 8U) {
+                        sigSize  = (uint8_t)(d[3] & 0x0FU);
+                        timeSize = d[7];
+                    }
+                }
+                else if (l_replayFrame[1] == (uint8_t)QS_REPLAY_EVT) {
+                    if (replayEvt(d, len, timeSize, sigSize)) {
+                        ++nEvt;
+                    }
+                }
+                else {
+                    /* other records are ignored */
+                }
+            }
+            n = 0U;
+            chksum = 0U;
+            esc = false;
+        }
+        else if (b == QS_ESC) {
+            esc = true;
+        }
+        else {
+            if (esc) {
+                b ^= QS_ESC_XOR;
+                esc = false;
+            }
+            chksum = (uint8_t)(chksum + b);
+            if (n < REPLAY_FRAME_MAX) {
+                l_replayFrame[n] = b;
+            }
+            ++n;
+        }
+    }
+    fclose(f);
+    if (nGap != 0U) {
+        fprintf(stderr, "<TARGET> WARN    %u gap(s) in the replay file %s\n",
+                (unsigned)nGap, l_replayFile);
+    }
+    if (l_replayImmutable != 0U) {
+        fprintf(stderr, "<TARGET> INFO    %u immutable event(s) replayed "
+                "without parameters\n", (unsigned)l_replayImmutable);
+    }
+    return nEvt;
+}
+
+#endif /* Q_SPY */
+
 /*==========================================================================*/
 /* NOTE01:
 * In Linux, the scheduler policy closest to real-time is the SCHED_FIFO
@@ -344,5 +809,32 @@ static void sigIntHandler(int dummy) {
 * Assuming that a QF application will be real-time, this port reserves the
 * three highest p-thread priorities for the ISR-like threads (e.g., I/O),
 * and the rest highest-priorities for the active objects.
+*
+* NOTE05:
+* In the replay mode (see QF_setReplay() and NOTE2 in qf_port.h), QF_run()
+* dispatches the recorded events in the calling thread and the AO threads
+* are not created, so the replay is single-threaded and deterministic.
+*
+* NOTE06:
+* The events posted LIFO to the AO while it dispatches a drained batch
+* are detected with the counter QF_lifoCtr_[], which is read outside of
+* the critical section. The LIFO posts of the AO to itself (recalling of
+* the deferred events) happen in the AO thread and are always detected
+* in time. A LIFO post from another thread racing with the end of the
+* batch might be dispatched after the batch, which is indistinguishable
+* from the LIFO post arriving a moment later.
+*
+* NOTE07:
+* With QF_AO_TELEM, the AO stacks are mapped by the port with a guard
+* page (PROT_NONE) below them, so that a stack overflow faults instead of
+* corrupting memory. The pages of an anonymous mapping become resident
+* only when touched, so the stack high-water mark is the distance from
+* the top of the stack to the lowest resident page, probed with mincore()
+* at the page granularity. It includes the thread descriptor and the TLS,
+* which the p-threads library places at the top of the stack. Because of
+* them, the stack can be unmapped only after joining the AO thread, so the
+* AO threads are joinable in this configuration. The stacks of the AOs
+* stopped with QActive_stop() are unmapped by the ticker thread in QF_run()
+* (or by QActive_start_() restarting the AO at the same priority).
 */
 
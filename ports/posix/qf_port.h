@@ -58,18 +58,61 @@
 #define QF_CRIT_ENTRY(dummy) QF_enterCriticalSection_()
 #define QF_CRIT_EXIT(dummy)  QF_leaveCriticalSection_()
 
+/* capacity of the batch-drain mode of the AO threads, see NOTE4 */
+#ifndef QF_DRAIN_MAX
+    #define QF_DRAIN_MAX     16U
+#endif
+
+/* define QF_POOL_STATS to collect the event-pool statistics and to print
+* the recommended pool layout at the end of QF_run() (see QF_poolAdvise())
+* with QF_POOL_HEADROOM percent more blocks than the observed peaks
+*/
+/*#define QF_POOL_STATS*/
+#ifndef QF_POOL_HEADROOM
+    #define QF_POOL_HEADROOM 20U
+#endif
+
+/* define QF_EVT_TRACK to track the lifetime of the dynamic events and to
+* print the events still live at the end of QF_run() (see QF_getLiveEvts())
+* with the allocation time in milliseconds
+*/
+/*#define QF_EVT_TRACK*/
+#define QF_EVT_TRACK_TIME()  QF_evtTrackTime_()
+
+/* define QF_AO_TELEM for the queue, RTC and stack telemetry of the AOs
+* (see QActive_getTelem() and NOTE07 in qf_port.c)
+*/
+/*#define QF_AO_TELEM*/
+
+/* define QF_RTC_TIME() to measure the RTC steps of the AOs against their
+* budgets [ns] (see QActive_setRtcBudget() and NOTE3)
+*/
+/*#define QF_RTC_TIME()        QF_rtcTime_()*/
+
 #include <pthread.h>   /* POSIX-thread API */
 #include "qep_port.h"  /* QEP port */
 #include "qequeue.h"   /* POSIX needs event-queue */
 #include "qmpool.h"    /* POSIX needs memory-pool */
 #include "qf.h"        /* QF platform-independent public interface */
 
+uint32_t QF_evtTrackTime_(void);
 void QF_enterCriticalSection_(void);
 void QF_leaveCriticalSection_(void);
+#ifdef QF_RTC_TIME
+QRtcTime QF_rtcTime_(void);
+#endif
 
 /* set clock tick rate and p-thread priority */
 void QF_setTickRate(uint32_t ticksPerSec, int_t tickPrio);
 
+/* batch-drain mode of a started AO (nMax <= QF_DRAIN_MAX), see NOTE4 */
+void QActive_setDrain(QActive * const me, uint_fast16_t const nMax);
+
+#ifdef Q_SPY
+/* re-run the events recorded in a binary QS file in QF_run(), see NOTE2 */
+void QF_setReplay(char const * const fileName);
+#endif
+
 /* clock tick callback (NOTE not called when "ticker thread" is not running) */
 void QF_onClockTick(void); /* clock tick callback (provided in the app) */
 
@@ -95,6 +138,11 @@ int QF_consoleWaitForKey(void);
     #define QACTIVE_EQUEUE_SIGNAL_(me_) \
         Q_ASSERT_ID(410, QActive_registry_[(me_)->prio] != (QActive *)0); \
         pthread_cond_signal(&(me_)->osObject)
+    #define QACTIVE_EQUEUE_LIFO_(me_) \
+        (++QF_lifoCtr_[(me_)->prio])
+
+    /* number of the LIFO posts to every AO, see NOTE4 */
+    extern uint32_t volatile QF_lifoCtr_[QF_MAX_ACTIVE + 1U];
 
     /* native QF event pool operations */
     #define QF_EPOOL_TYPE_            QMPool
@@ -140,6 +188,44 @@ int QF_consoleWaitForKey(void);
 * also subject to priority inversions. However, the p-thread mutex
 * implementation, such as POSIX threads, should support the priority-
 * inheritance protocol.
+*
+* NOTE2:
+* The QF ports record every event consumed by an AO in the QS_REPLAY_EVT
+* record (QS_REPLAY_REC()), when this record is enabled in the QS filters.
+* QF_setReplay(), called before starting the AOs, switches this port into
+* the replay mode: QACTIVE_START() only initializes the AOs without
+* creating their threads and QF_run() reads the QS_REPLAY_EVT records from
+* the given binary QS file (e.g., saved by QSPY or produced by the "file:"
+* QS sink) and dispatches the recorded events to the same state machines,
+* one at a time, in the recorded order. The events posted and published
+* during the replay are discarded, because the file contains them as well,
+* and the clock tick does not run. QF_run() returns the number of the
+* replayed events, or -1 when the file cannot be opened. Records lost
+* while recording (e.g., overruns of the per-thread QS rings, see
+* QS_THR_BUF_SIZE in qs_port.h) make the replay diverge, so QF_run() warns
+* about the gaps in the QS sequence numbers of the replayed file. The
+* parameters of the immutable events are not recorded (their size is
+* unknown), so they are replayed as bare events with the recorded signal
+* and QF_run() reports how many were replayed so.
+*
+* NOTE3:
+* The RTC budgets are opt-in, because measuring every RTC step costs two
+* clock_gettime() calls per dispatched event. When QF_RTC_TIME() is
+* defined, this port measures the RTC steps of the AOs with CLOCK_MONOTONIC
+* in nanoseconds (modulo 2^32), so QActive_setRtcBudget() takes the budget
+* in nanoseconds and QActive_getRtcStat() reports the RTC steps in
+* nanoseconds as well.
+*
+* NOTE4:
+* By default an AO thread removes one event from its queue per RTC step.
+* QActive_setDrain() switches the AO into the batch-drain mode, in which
+* the thread removes up to 'nMax' queued events in one critical section
+* (QActive_getN_()) and dispatches them back-to-back, which amortizes the
+* locking and the condition-variable checks under load. The events posted
+* LIFO (e.g., recalled deferred events) during the batch are dispatched
+* before the rest of the batch, as they would be without draining. After
+* a full batch the thread yields the CPU, so 'nMax' also caps how long
+* the AO keeps the CPU from the other threads of the same priority.
 */
 
 #endif /* QF_PORT_H */
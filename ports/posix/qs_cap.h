@@ -0,0 +1,101 @@
+/*============================================================================
+* QP/C Real-Time Embedded Framework (RTEF)
+* Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+*
+* SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+*
+* This software is dual-licensed under the terms of the open source GNU
+* General Public License version 3 (or any later version), or alternatively,
+* under the terms of one of the closed source Quantum Leaps commercial
+* licenses.
+*
+* The terms of the open source GNU General Public License version 3
+* can be found at: <www.gnu.org/licenses/gpl-3.0>
+*
+* The terms of the closed source Quantum Leaps commercial licenses
+* can be found at: <www.state-machine.com/licensing>
+*
+* Redistributions in source code must retain this top-level comment block.
+* Plagiarizing this software to sidestep the license obligations is illegal.
+*
+* Contact information:
+* <www.state-machine.com>
+* <info@state-machine.com>
+============================================================================*/
+/*!
+* @date Last updated on: 2026-10-18
+* @version Last updated for: @ref qpc_7_2_2
+*
+* @file
+* @brief QS binary capture format (POSIX "cap:" QS sink and qscap tool)
+*
+* @details
+* The capture is a directory of segment files "qs-NNNNNNNN.qsc" of
+* #QS_CAP_SEG_SIZE bytes each, plus the segment "dict.qsc" with the
+* dictionary and target-info records. The target rewrites "dict.qsc"
+* with the latest record of every dictionary entry whenever it rotates
+* the data segments, replacing the file atomically. Every
+* segment starts with the ::QSCapSegHdr, followed by the un-escaped QS
+* records, each with the fixed ::QSCapRec header and aligned at 8 bytes.
+* The segment header is updated after every record, so a segment is
+* readable up to QSCapSegHdr::dataEnd even after the target crashed.
+*
+* This header is shared with the host and depends only on <stdint.h>.
+*/
+#ifndef QS_CAP_H
+#define QS_CAP_H
+
+#include <stdint.h>
+
+#define QS_CAP_MAGIC    0x50414351U /*!< "QCAP" in little-endian */
+#define QS_CAP_VERSION  1U
+
+#define QS_CAP_IDX_MAX  1024U /*!< # time-index entries per segment */
+#define QS_CAP_OBJ_MAX  64U   /*!< # distinct objects tracked per segment */
+#define QS_CAP_NO_OBJ   0U    /*!< QSCapRec::obj of records without object */
+
+/*! header of a captured QS record (followed by the record data) */
+typedef struct {
+    uint64_t time;  /*!< time-stamp [0.1us], extended to 64 bits */
+    uint64_t obj;   /*!< primary object of the record or #QS_CAP_NO_OBJ */
+    uint16_t len;   /*!< # data bytes following this header */
+    uint8_t  seq;   /*!< QS sequence number */
+    uint8_t  rec;   /*!< QS record type */
+    uint32_t reserved;
+} QSCapRec;
+
+/*! entry of the sparse time-index of a segment */
+typedef struct {
+    uint64_t time;  /*!< time-stamp of the indexed record */
+    uint32_t offs;  /*!< offset of the indexed record in the segment */
+    uint32_t reserved;
+} QSCapIdx;
+
+/*! header of a capture segment */
+typedef struct {
+    uint32_t magic;    /*!< #QS_CAP_MAGIC */
+    uint16_t version;  /*!< #QS_CAP_VERSION */
+    uint16_t hdrSize;  /*!< sizeof(QSCapSegHdr), offset of the 1st record */
+    uint32_t segNo;    /*!< segment number (UINT32_MAX for "dict.qsc") */
+    uint32_t segSize;  /*!< size of the segment file while capturing */
+    uint32_t dataEnd;  /*!< offset past the last complete record */
+    uint32_t nRec;     /*!< number of records in the segment */
+    uint64_t tFirst;   /*!< time-stamp of the first record */
+    uint64_t tLast;    /*!< largest time-stamp in the segment */
+    uint32_t recMask[8]; /*!< bitmask of the record types in the segment */
+    uint32_t idxStep;  /*!< number of records between the idx[] entries */
+    uint32_t nIdx;     /*!< number of the idx[] entries */
+    uint32_t nObj;     /*!< # obj[] entries, > #QS_CAP_OBJ_MAX on overflow */
+    uint8_t  timeSize;   /*!< QS_TIME_SIZE of the target */
+    uint8_t  objPtrSize; /*!< QS_OBJ_PTR_SIZE of the target */
+    uint8_t  funPtrSize; /*!< QS_FUN_PTR_SIZE of the target */
+    uint8_t  sigSize;    /*!< Q_SIGNAL_SIZE of the target */
+    uint64_t obj[QS_CAP_OBJ_MAX];  /*!< distinct objects in the segment */
+    QSCapIdx idx[QS_CAP_IDX_MAX];  /*!< sparse time-index */
+} QSCapSegHdr;
+
+/*! size of the captured record 'len_' data bytes long, with the header */
+#define QS_CAP_REC_SIZE(len_) \
+    (((uint32_t)sizeof(QSCapRec) + (uint32_t)(len_) + 7U) & ~7U)
+
+#endif /* QS_CAP_H */
@@ -42,54 +42,406 @@
 #include "qs_port.h"  /* QS port */
 #include "qs_pkg.h"   /* QS package-scope interface */
 
+#include "qs_cap.h"  /* QS binary capture format */
+
 #include "safe_std.h" /* portable "safe" <stdio.h>/<string.h> facilities */
 #include <stdlib.h>
 #include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <netinet/in.h>
 #include <netdb.h>
+#include <poll.h>
 #include <errno.h>
 #include <time.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <dirent.h>
 
-/*Q_DEFINE_THIS_MODULE("qs_port")*/
+Q_DEFINE_THIS_MODULE("qs_port")
 
 #define QS_TX_SIZE     (8*1024)
 #define QS_RX_SIZE     (2*1024)
-#define QS_TX_CHUNK    QS_TX_SIZE
 #define QS_TIMEOUT_MS  10
 
+/* QS_priv_ level above which QS_TX_DROP_OLDEST drops records, see NOTE2 */
+#ifndef QS_TX_HIGH_WATER
+    #define QS_TX_HIGH_WATER ((QS_TX_SIZE * 3) / 4)
+#endif
+
+/* size of the "cap:" sink segments and # segments kept, see NOTE3 */
+#ifndef QS_CAP_SEG_SIZE
+    #define QS_CAP_SEG_SIZE  (16U * 1024U * 1024U)
+#endif
+#ifndef QS_CAP_SEG_MAX
+    #define QS_CAP_SEG_MAX   16U
+#endif
+#ifndef QS_CAP_DICT_SIZE
+    #define QS_CAP_DICT_SIZE (1024U * 1024U)
+#endif
+
 #define INVALID_SOCKET -1
 #define SOCKET_ERROR   -1
 
+/* number of sink waits in txSend(): none, unlimited, or on cleanup */
+#define TX_NO_WAIT       0
+#define TX_WAIT_FOREVER  (-1)
+#define TX_WAIT_CLEANUP  100
+
+/* kinds of the QS sink */
+enum {
+    SINK_SOCK, /* TCP or UNIX-domain socket */
+    SINK_FILE, /* binary QS file */
+    SINK_CAP   /* indexed binary capture, see NOTE3 */
+};
+
+/* layout of the predefined QS records for the capture index: the record
+* starts with a time-stamp (CAP_T) and/or has the primary object at the
+* given offset in the record data (CAP_OBJ())
+*/
+#define CAP_T          0x80U
+#define CAP_OBJ(offs_) ((uint8_t)((offs_) + 1U))
+#define CAP_T_         QS_TIME_SIZE
+#define CAP_S_         Q_SIGNAL_SIZE
+#define CAP_O_         QS_OBJ_PTR_SIZE
+
+/* per-thread QS-TX ring buffer, see NOTE1 in qs_port.h */
+typedef struct {
+    QS_tx tx;              /* the ring (only the ring members are used) */
+    pthread_mutex_t mutex; /* mutex protecting the ring */
+    uint32_t lost;         /* records lost in this ring (lower bound) */
+    uint8_t  lastSeq;      /* sequence number of the last merged record */
+    bool     isActive;     /* is the ring attached to a thread? */
+} QSThrBuf;
+
+/* per-thread records copied out of a ring and waiting for the merge */
+typedef struct {
+    uint8_t buf[QS_THR_BUF_SIZE];
+    uint32_t len; /* number of bytes in the buf[] */
+    uint32_t pos; /* position of the next record in the buf[] */
+} QSThrStage;
+
+/* state of the "cap:" QS sink, see NOTE3 in qs_port.h */
+typedef struct {
+    QSCapSegHdr *seg;  /* the current segment (mapped) */
+    QSCapSegHdr *dict; /* the dictionary segment (mapped) */
+    uint32_t segNo;    /* number of the current segment */
+    uint64_t time;     /* time-stamp of the last record, extended */
+    bool     hasTime;  /* is the time valid? */
+} QSCap;
+
+/* global variables ........................................................*/
+__thread QS_tx *QS_thrTx_ = &QS_priv_;
+
 /* local variables .........................................................*/
-static int l_sock = INVALID_SOCKET;
-static struct timespec const c_timeout = { 0, QS_TIMEOUT_MS*1000000L };
+static int  l_sock = INVALID_SOCKET; /* the QS sink (socket or file) */
+static uint8_t l_sinkKind;           /* SINK_SOCK, SINK_FILE, SINK_CAP */
+
+static int  l_epfd = -1;             /* epoll instance of the QS-TX thread */
+static int  l_evfd = -1;             /* eventfd to wake up the QS-TX thread */
+static pthread_t l_txThread;
+static bool volatile l_txRunning;    /* is the QS-TX thread running? */
+static bool volatile l_sinkFailed;   /* has the sink failed? see NOTE2 */
+static pthread_mutex_t l_txMutex = PTHREAD_MUTEX_INITIALIZER;
+static QSTxStats l_txStats;
+static QSCap l_cap;
+static uint8_t l_capRec[QS_TX_SIZE]; /* un-escaped record being captured */
+
+static uint8_t const l_capLayout[QS_PRE_MAX] = {
+    [QS_QEP_STATE_ENTRY]        = CAP_OBJ(0U),
+    [QS_QEP_STATE_EXIT]         = CAP_OBJ(0U),
+    [QS_QEP_STATE_INIT]         = CAP_OBJ(0U),
+    [QS_QEP_INIT_TRAN]          = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_QEP_INTERN_TRAN]        = CAP_T | CAP_OBJ(CAP_T_ + CAP_S_),
+    [QS_QEP_TRAN]               = CAP_T | CAP_OBJ(CAP_T_ + CAP_S_),
+    [QS_QEP_IGNORED]            = CAP_T | CAP_OBJ(CAP_T_ + CAP_S_),
+    [QS_QEP_DISPATCH]           = CAP_T | CAP_OBJ(CAP_T_ + CAP_S_),
+    [QS_QEP_UNHANDLED]          = CAP_OBJ(CAP_S_),
+    [QS_QF_ACTIVE_DEFER]        = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_QF_ACTIVE_RECALL]       = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_QF_ACTIVE_SUBSCRIBE]    = CAP_T | CAP_OBJ(CAP_T_ + CAP_S_),
+    [QS_QF_ACTIVE_UNSUBSCRIBE]  = CAP_T | CAP_OBJ(CAP_T_ + CAP_S_),
+    [QS_QF_ACTIVE_POST]         = CAP_T | CAP_OBJ(CAP_T_ + CAP_O_ + CAP_S_),
+    [QS_QF_ACTIVE_POST_LIFO]    = CAP_T | CAP_OBJ(CAP_T_ + CAP_S_),
+    [QS_QF_ACTIVE_GET]          = CAP_T | CAP_OBJ(CAP_T_ + CAP_S_),
+    [QS_QF_ACTIVE_GET_LAST]     = CAP_T | CAP_OBJ(CAP_T_ + CAP_S_),
+    [QS_QF_ACTIVE_RECALL_ATTEMPT] = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_QF_EQUEUE_POST]         = CAP_T | CAP_OBJ(CAP_T_ + CAP_S_),
+    [QS_QF_EQUEUE_POST_LIFO]    = CAP_T | CAP_OBJ(CAP_T_ + CAP_S_),
+    [QS_QF_EQUEUE_GET]          = CAP_T | CAP_OBJ(CAP_T_ + CAP_S_),
+    [QS_QF_EQUEUE_GET_LAST]     = CAP_T | CAP_OBJ(CAP_T_ + CAP_S_),
+    [QS_QF_NEW_ATTEMPT]         = CAP_T,
+    [QS_QF_MPOOL_GET]           = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_QF_MPOOL_PUT]           = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_QF_PUBLISH]             = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_QF_NEW_REF]             = CAP_T,
+    [QS_QF_NEW]                 = CAP_T,
+    [QS_QF_GC_ATTEMPT]          = CAP_T,
+    [QS_QF_GC]                  = CAP_T,
+    [QS_QF_TIMEEVT_ARM]         = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_QF_TIMEEVT_AUTO_DISARM] = CAP_OBJ(0U),
+    [QS_QF_TIMEEVT_DISARM_ATTEMPT] = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_QF_TIMEEVT_DISARM]      = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_QF_TIMEEVT_REARM]       = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_QF_TIMEEVT_POST]        = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_QF_DELETE_REF]          = CAP_T,
+    [QS_QF_CRIT_ENTRY]          = CAP_T,
+    [QS_QF_CRIT_EXIT]           = CAP_T,
+    [QS_QF_ISR_ENTRY]           = CAP_T,
+    [QS_QF_ISR_EXIT]            = CAP_T,
+    [QS_QF_INT_DISABLE]         = CAP_T,
+    [QS_QF_INT_ENABLE]          = CAP_T,
+    [QS_QF_ACTIVE_POST_ATTEMPT] = CAP_T | CAP_OBJ(CAP_T_ + CAP_O_ + CAP_S_),
+    [QS_QF_EQUEUE_POST_ATTEMPT] = CAP_T | CAP_OBJ(CAP_T_ + CAP_S_),
+    [QS_QF_MPOOL_GET_ATTEMPT]   = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_SCHED_PREEMPT]          = CAP_T,
+    [QS_SCHED_RESTORE]          = CAP_T,
+    [QS_SCHED_LOCK]             = CAP_T,
+    [QS_SCHED_UNLOCK]           = CAP_T,
+    [QS_SCHED_NEXT]             = CAP_T,
+    [QS_SCHED_IDLE]             = CAP_T,
+    [QS_QEP_TRAN_HIST]          = CAP_OBJ(0U),
+    [QS_QEP_TRAN_EP]            = CAP_OBJ(0U),
+    [QS_QEP_TRAN_XP]            = CAP_OBJ(0U),
+    [QS_TEST_PROBE_GET]         = CAP_T,
+    [QS_TARGET_DONE]            = CAP_T,
+    [QS_QUERY_DATA]             = CAP_T | CAP_OBJ(CAP_T_ + 1U),
+    [QS_PEEK_DATA]              = CAP_T,
+    [QS_ASSERT_FAIL]            = CAP_T,
+    [QS_SEM_TAKE]               = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_SEM_BLOCK]              = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_SEM_SIGNAL]             = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_SEM_BLOCK_ATTEMPT]      = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_MTX_LOCK]               = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_MTX_BLOCK]              = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_MTX_UNLOCK]             = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_MTX_LOCK_ATTEMPT]       = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_MTX_BLOCK_ATTEMPT]      = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_MTX_UNLOCK_ATTEMPT]     = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_RATE_SUPPRESSED]        = CAP_T,
+    [QS_AGG_DISPATCH]           = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_AGG_RTC]                = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_REPLAY_EVT]             = CAP_T,
+    [QS_RTC_OVERRUN]            = CAP_T | CAP_OBJ(CAP_T_),
+    [QS_AO_TELEM]               = CAP_T | CAP_OBJ(CAP_T_),
+};
+
+static QSThrBuf   l_thrBuf[QF_MAX_ACTIVE + 1U];
+static QSThrStage l_thrStage[QF_MAX_ACTIVE + 1U];
+static uint8_t    l_thrSto[QF_MAX_ACTIVE + 1U][QS_THR_BUF_SIZE];
+static uint8_t    l_mergeRec[QS_THR_BUF_SIZE]; /* un-escaped record */
+static pthread_mutex_t l_mergeMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t l_glbMutex = PTHREAD_MUTEX_INITIALIZER;
+static __thread QSThrBuf *l_myThrBuf; /* ring of the calling thread */
+
+static bool mergeThrBufs(void);
+static int  sinkOpenTcp(char const *arg);
+static int  sinkOpenUnix(char const *path);
+static bool txFlush(int const nWaits);
+static bool txSend(int const nWaits);
+static void txDropOldest(void);
+static void txWake(void);
+static void txSinkFail(int const err);
+static bool txStart(void);
+static void *txThread(void *arg);
+static int  capOpen(char const *dir);
+static void capClose(void);
+static void capSend(void);
 
 /*..........................................................................*/
 uint8_t QS_onStartup(void const *arg) {
     static uint8_t qsBuf[QS_TX_SIZE];   /* buffer for QS-TX channel */
     static uint8_t qsRxBuf[QS_RX_SIZE]; /* buffer for QS-RX channel */
+    char const *src;
+    int status;
+
+    /* initialize the QS transmit and receive buffers */
+    QS_initBuf(qsBuf, sizeof(qsBuf));
+    QS_rxInitBuf(qsRxBuf, sizeof(qsRxBuf));
+    l_sinkFailed = false;
+
+    /* select the QS sink from 'arg', see NOTE2 */
+    src = (arg != (void *)0)
+          ? (char const *)arg
+          : "localhost"; /* default QSPY host */
+    if (strncmp(src, "file:", 5U) == 0) {
+        l_sock = open(&src[5], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (l_sock == INVALID_SOCKET) {
+            FPRINTF_S(stderr, "<TARGET> ERROR   cannot open QS file=%s,"
+                "errno=%d\n", &src[5], errno);
+            goto error;
+        }
+        l_sinkKind = SINK_FILE;
+    }
+    else if (strncmp(src, "cap:", 4U) == 0) {
+        l_sock = capOpen(&src[4]); /* the capture directory */
+        if (l_sock == INVALID_SOCKET) {
+            goto error;
+        }
+        l_sinkKind = SINK_CAP;
+    }
+    else {
+        l_sock = (strncmp(src, "unix:", 5U) == 0)
+                 ? sinkOpenUnix(&src[5])
+                 : sinkOpenTcp(src);
+        if (l_sock == INVALID_SOCKET) {
+            goto error;
+        }
+        l_sinkKind = SINK_SOCK;
+
+        /* set the socket to non-blocking mode */
+        status = fcntl(l_sock, F_GETFL, 0);
+        if (status == -1) {
+            FPRINTF_S(stderr,
+                "<TARGET> ERROR   Socket configuration failed errno=%d\n",
+                errno);
+            QS_EXIT();
+            goto error;
+        }
+        if (fcntl(l_sock, F_SETFL, status | O_NONBLOCK) != 0) {
+            FPRINTF_S(stderr, "<TARGET> ERROR   Failed to set non-blocking "
+                "socket errno=%d\n", errno);
+            QS_EXIT();
+            goto error;
+        }
+    }
+    QS_onFlush();
+
+    /* without the QS-TX thread QS_output() sends from the caller's thread */
+    if (!txStart()) {
+        FPRINTF_S(stderr, "<TARGET> WARN    QS-TX thread not started,"
+            "errno=%d\n", errno);
+    }
+
+    return 1U; /* success */
+
+error:
+    return 0U; /* failure */
+}
+/*..........................................................................*/
+void QS_onCleanup(void) {
+    if (l_txRunning) { /* QS-TX thread running? */
+        l_txRunning = false;
+        txWake();
+        if (!pthread_equal(pthread_self(), l_txThread)) {
+            pthread_join(l_txThread, NULL);
+        }
+    }
+    if (l_sock != INVALID_SOCKET) {
+        pthread_mutex_lock(&l_txMutex);
+        (void)txFlush(TX_WAIT_CLEANUP); /* the records still buffered */
+        if (l_sinkKind == SINK_CAP) {
+            capClose();
+        }
+        close(l_sock);
+        l_sock = INVALID_SOCKET;
+        pthread_mutex_unlock(&l_txMutex);
+    }
+    if (l_epfd != -1) {
+        close(l_epfd);
+        l_epfd = -1;
+    }
+    if (l_evfd != -1) {
+        close(l_evfd);
+        l_evfd = -1;
+    }
+    /*PRINTF_S("<TARGET> Disconnected from QSPY\n");*/
+}
+/*..........................................................................*/
+void QS_onReset(void) {
+    QS_onCleanup();
+    exit(0);
+}
+/*..........................................................................*/
+void QS_onFlush(void) {
+    if (l_sock == INVALID_SOCKET) { /* sink NOT initialized? */
+        FPRINTF_S(stderr, "<TARGET> ERROR   %s\n", "invalid QS sink");
+        return;
+    }
+
+    /* the threads with own QS-TX rings never wait for the sink, see NOTE2 */
+    if (l_txRunning && (l_myThrBuf != (QSThrBuf *)0)) {
+        txWake();
+        return;
+    }
+
+    pthread_mutex_lock(&l_txMutex);
+    (void)txFlush(TX_WAIT_FOREVER);
+    pthread_mutex_unlock(&l_txMutex);
+}
+/*..........................................................................*/
+QSTimeCtr QS_onGetTime(void) {
+    struct timespec tspec;
+    QSTimeCtr time;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &tspec);
+
+    /* convert to units of 0.1 microsecond */
+    time = (QSTimeCtr)(tspec.tv_sec * 10000000 + tspec.tv_nsec / 100);
+    return time;
+}
+
+/*..........................................................................*/
+void QS_output(void) {
+    if (l_sock == INVALID_SOCKET) { /* sink NOT initialized? */
+        FPRINTF_S(stderr, "<TARGET> ERROR   %s\n", "invalid QS sink");
+        return;
+    }
+
+    if (l_txRunning) { /* QS-TX thread running? */
+        txWake();
+    }
+    else {
+        pthread_mutex_lock(&l_txMutex);
+        (void)txFlush(TX_NO_WAIT);
+        pthread_mutex_unlock(&l_txMutex);
+    }
+}
+/*..........................................................................*/
+void QS_rx_input(void) {
+    if ((l_sinkKind != SINK_SOCK) /* no QS-RX channel without socket */
+        || l_sinkFailed)          /* or after the socket failed */
+    {
+        return;
+    }
+    /* receive straight into the QS-RX buffer, which QS_rxParse() parses
+    * in place. The buffer is empty here, because QS_rxParse() parses all
+    * the data, so the whole buffer (less one byte) is available.
+    */
+    QS_rxPriv_.head = 0U;
+    QS_rxPriv_.tail = 0U;
+    int status = recv(l_sock, (char *)QS_rxPriv_.buf,
+                      (size_t)QS_rxPriv_.end - 1U, 0);
+    if (status > 0) { /* any data received? */
+        QS_rxPriv_.head = (QSCtr)status; /* # bytes received */
+        QS_rxParse(); /* parse all received bytes */
+    }
+}
+/*..........................................................................*/
+QSTxStats const *QS_getTxStats(void) {
+    return &l_txStats;
+}
+
+/*..........................................................................*/
+static int sinkOpenTcp(char const *arg) {
     char hostName[128];
     char const *serviceName = "6601";  /* default QSPY server port */
     char const *src;
     char *dst;
     int status;
+    int sock = INVALID_SOCKET;
 
     struct addrinfo *result = NULL;
     struct addrinfo *rp = NULL;
     struct addrinfo hints;
     int sockopt_bool;
 
-    /* initialize the QS transmit and receive buffers */
-    QS_initBuf(qsBuf, sizeof(qsBuf));
-    QS_rxInitBuf(qsRxBuf, sizeof(qsRxBuf));
-
     /* extract hostName from 'arg' (hostName:port_remote)... */
-    src = (arg != (void *)0)
-          ? (char const *)arg
-          : "localhost"; /* default QSPY host */
+    src = arg;
     dst = hostName;
     while ((*src != '\0')
            && (*src != ':')
@@ -113,17 +465,17 @@ uint8_t QS_onStartup(void const *arg) {
         FPRINTF_S(stderr,
             "<TARGET> ERROR   cannot resolve host Name=%s:%s,Err=%d\n",
                     hostName, serviceName, status);
-        goto error;
+        return INVALID_SOCKET;
     }
 
     for (rp = result; rp != NULL; rp = rp->ai_next) {
-        l_sock = socket(rp->ai_family, rp->ai_socktype, rp->ai_protocol);
-        if (l_sock != INVALID_SOCKET) {
-            if (connect(l_sock, rp->ai_addr, rp->ai_addrlen)
+        sock = socket(rp->ai_family, rp->ai_socktype, rp->ai_protocol);
+        if (sock != INVALID_SOCKET) {
+            if (connect(sock, rp->ai_addr, rp->ai_addrlen)
                 == SOCKET_ERROR)
             {
-                close(l_sock);
-                l_sock = INVALID_SOCKET;
+                close(sock);
+                sock = INVALID_SOCKET;
             }
             break;
         }
@@ -132,166 +484,854 @@ uint8_t QS_onStartup(void const *arg) {
     freeaddrinfo(result);
 
     /* socket could not be opened & connected? */
-    if (l_sock == INVALID_SOCKET) {
+    if (sock == INVALID_SOCKET) {
         FPRINTF_S(stderr, "<TARGET> ERROR   cannot connect to QSPY at "
             "host=%s:%s\n",
             hostName, serviceName);
-        goto error;
-    }
-
-    /* set the socket to non-blocking mode */
-    status = fcntl(l_sock, F_GETFL, 0);
-    if (status == -1) {
-        FPRINTF_S(stderr,
-            "<TARGET> ERROR   Socket configuration failed errno=%d\n",
-            errno);
-        QS_EXIT();
-        goto error;
-    }
-    if (fcntl(l_sock, F_SETFL, status | O_NONBLOCK) != 0) {
-        FPRINTF_S(stderr, "<TARGET> ERROR   Failed to set non-blocking socket "
-            "errno=%d\n", errno);
-        QS_EXIT();
-        goto error;
+        return INVALID_SOCKET;
     }
 
     /* configure the socket to reuse the address and not to linger */
     sockopt_bool = 1;
-    setsockopt(l_sock, SOL_SOCKET, SO_REUSEADDR,
+    setsockopt(sock, SOL_SOCKET, SO_REUSEADDR,
                &sockopt_bool, sizeof(sockopt_bool));
     sockopt_bool = 0; /* negative option */
-    setsockopt(l_sock, SOL_SOCKET, SO_LINGER,
+    setsockopt(sock, SOL_SOCKET, SO_LINGER,
                &sockopt_bool, sizeof(sockopt_bool));
-    QS_onFlush();
 
-    return 1U; /* success */
-
-error:
-    return 0U; /* failure */
+    return sock;
 }
 /*..........................................................................*/
-void QS_onCleanup(void) {
-    if (l_sock != INVALID_SOCKET) {
-        close(l_sock);
-        l_sock = INVALID_SOCKET;
+static int sinkOpenUnix(char const *path) {
+    struct sockaddr_un addr;
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock == INVALID_SOCKET) {
+        FPRINTF_S(stderr, "<TARGET> ERROR   cannot create UNIX socket,"
+            "errno=%d\n", errno);
+        return INVALID_SOCKET;
     }
-    /*PRINTF_S("<TARGET> Disconnected from QSPY\n");*/
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    STRNCPY_S(addr.sun_path, sizeof(addr.sun_path), path);
+    if (connect(sock, (struct sockaddr const *)&addr, sizeof(addr))
+        == SOCKET_ERROR)
+    {
+        FPRINTF_S(stderr, "<TARGET> ERROR   cannot connect to QSPY at "
+            "unix:%s,errno=%d\n", path, errno);
+        close(sock);
+        return INVALID_SOCKET;
+    }
+    return sock;
 }
+
 /*..........................................................................*/
-void QS_onReset(void) {
-    QS_onCleanup();
-    exit(0);
+/* merge the per-thread rings into QS_priv_ and send it, in portions when
+* the merged records do not fit into QS_priv_ at once. Returns false on
+* a sink error.
+*
+* NOTE: must be called with the l_txMutex locked (single consumer).
+*/
+static bool txFlush(int const nWaits) {
+    bool isDone;
+    do {
+        isDone = mergeThrBufs();
+        if (!txSend(nWaits)) {
+            return false;
+        }
+    } while ((!isDone) && (QS_priv_.used == 0U)); /* sink not blocked? */
+    return true;
 }
 /*..........................................................................*/
-void QS_onFlush(void) {
-    uint16_t nBytes;
-    uint8_t const *data;
-    QS_CRIT_STAT_
-
-    if (l_sock == INVALID_SOCKET) { /* socket NOT initialized? */
-        FPRINTF_S(stderr, "<TARGET> ERROR   %s\n", "invalid TCP socket");
-        return;
+/* send the data from QS_priv_ to the sink without copying it, both parts
+* of a wrapped-around ring in one writev()/sendmsg() call. The ring is
+* consumed only by the bytes actually sent. When the sink would block,
+* txSend() waits for it at most 'nWaits' times (TX_WAIT_FOREVER without
+* a limit). Returns false on a sink error, now or earlier.
+*
+* NOTE: must be called with the l_txMutex locked (single consumer).
+*/
+static bool txSend(int const nWaits) {
+    int waits = 0;
+    if (l_sinkFailed) { /* discard the data without retrying, see NOTE2 */
+        QF_CRIT_ENTRY(dummy);
+        QS_priv_.tail = QS_priv_.head;
+        QS_priv_.used = 0U;
+        QF_CRIT_EXIT(dummy);
+        return false;
+    }
+    if (l_sinkKind == SINK_CAP) {
+        capSend(); /* the capture never blocks */
+        return true;
     }
+    for (;;) { /* for-ever until all data sent or return */
+        QF_CRIT_ENTRY(dummy);
+        QSCtr const tail = QS_priv_.tail;
+        QSCtr const used = QS_priv_.used;
+        QSCtr const n1 = ((QS_priv_.end - tail) < used)
+                         ? (QS_priv_.end - tail)
+                         : used;
+        QF_CRIT_EXIT(dummy);
 
-    nBytes = QS_TX_CHUNK;
-    QS_CRIT_E_();
-    while ((data = QS_getBlock(&nBytes)) != (uint8_t *)0) {
-        QS_CRIT_X_();
-        for (;;) { /* for-ever until break or return */
-            int nSent = send(l_sock, (char const *)data, (int)nBytes, 0);
-            if (nSent == SOCKET_ERROR) { /* sending failed? */
-                if ((errno == EWOULDBLOCK) || (errno == EAGAIN)) {
-                    /* sleep for the timeout and then loop back
-                    * to send() the SAME data again
-                    */
-                    nanosleep(&c_timeout, NULL);
+        if (used == 0U) { /* nothing (more) to send? */
+            return true;
+        }
+
+        struct iovec iov[2];
+        iov[0].iov_base = &QS_priv_.buf[tail];
+        iov[0].iov_len  = n1;
+        iov[1].iov_base = &QS_priv_.buf[0];
+        iov[1].iov_len  = used - n1;
+        int const iovcnt = (used > n1) ? 2 : 1;
+
+        ssize_t nSent;
+        if (l_sinkKind == SINK_FILE) {
+            nSent = writev(l_sock, iov, iovcnt);
+        }
+        else {
+            struct msghdr msg;
+            memset(&msg, 0, sizeof(msg));
+            msg.msg_iov    = iov;
+            msg.msg_iovlen = (size_t)iovcnt;
+            nSent = sendmsg(l_sock, &msg, MSG_NOSIGNAL);
+        }
+
+        if (nSent == SOCKET_ERROR) { /* sending failed? */
+            if ((errno == EWOULDBLOCK) || (errno == EAGAIN)) {
+                ++l_txStats.stalls;
+                if ((nWaits != TX_WAIT_FOREVER) && (waits >= nWaits)) {
+                    txDropOldest();
+                    return true;
                 }
-                else { /* some other socket error... */
-                    FPRINTF_S(stderr, "<TARGET> ERROR   sending data over TCP,"
-                           "errno=%d\n", errno);
-                    return;
+                ++waits;
+
+                /* wait for the sink to drain, instead of sleeping */
+                struct pollfd pfd;
+                pfd.fd      = l_sock;
+                pfd.events  = POLLOUT;
+                pfd.revents = 0;
+                (void)poll(&pfd, 1U, QS_TIMEOUT_MS);
+            }
+            else if (errno != EINTR) { /* some other sink error... */
+                txSinkFail(errno);
+                return false;
+            }
+        }
+        else {
+            QF_CRIT_ENTRY(dummy);
+            /* the tail moves under the sender only on an overrun of
+            * QS_priv_, in which case the sent data is already discarded
+            */
+            if (QS_priv_.tail == tail) {
+                QSCtr newTail = tail + (QSCtr)nSent;
+                if (newTail >= QS_priv_.end) {
+                    newTail -= QS_priv_.end;
                 }
+                QS_priv_.tail = newTail;
+                QS_priv_.used -= (QSCtr)nSent;
             }
-            else if (nSent < (int)nBytes) { /* sent fewer than requested? */
-                nanosleep(&c_timeout, NULL); /* sleep for the timeout */
-                /* adjust the data and loop back to send() the rest */
-                data   += nSent;
-                nBytes -= (uint16_t)nSent;
+            QF_CRIT_EXIT(dummy);
+            l_txStats.bytesSent += (uint32_t)nSent;
+        }
+    }
+}
+/*..........................................................................*/
+/* discard the oldest records from a backed-up QS_priv_, see NOTE2 */
+static void txDropOldest(void) {
+#ifdef QS_TX_DROP_OLDEST
+    QF_CRIT_ENTRY(dummy);
+    while (QS_priv_.used > (QSCtr)QS_TX_HIGH_WATER) {
+        QSCtr tail = QS_priv_.tail;
+        QSCtr n = 0U;
+        uint8_t b;
+        do { /* up to and including the QS_FRAME of the oldest record */
+            b = QS_priv_.buf[tail];
+            ++tail;
+            if (tail == QS_priv_.end) {
+                tail = 0U;
             }
-            else {
-                break;
+            ++n;
+        } while ((b != QS_FRAME) && (n < QS_priv_.used));
+        QS_priv_.tail  = tail;
+        QS_priv_.used -= n;
+        ++l_txStats.recDropped;
+        l_txStats.bytesDropped += (uint32_t)n;
+    }
+    QF_CRIT_EXIT(dummy);
+#endif /* QS_TX_DROP_OLDEST */
+}
+/*..........................................................................*/
+static void txWake(void) {
+    uint64_t const one = 1U;
+    ssize_t const n = write(l_evfd, &one, sizeof(one));
+    (void)n; /* the QS-TX thread wakes up on the timeout anyway */
+}
+/*..........................................................................*/
+/* report the first sink error and stop using the sink, see NOTE2 */
+static void txSinkFail(int const err) {
+    if (!l_sinkFailed) {
+        l_sinkFailed = true;
+        if (err == 0) {
+            FPRINTF_S(stderr, "<TARGET> ERROR   %s\n",
+                "QS sink disconnected");
+        }
+        else {
+            FPRINTF_S(stderr, "<TARGET> ERROR   sending QS data,"
+                   "errno=%d\n", err);
+        }
+        if ((l_sinkKind == SINK_SOCK) && (l_epfd != -1)) {
+            /* no more EPOLLHUP/EPOLLERR wake-ups for the dead socket */
+            (void)epoll_ctl(l_epfd, EPOLL_CTL_DEL, l_sock, NULL);
+        }
+    }
+}
+/*..........................................................................*/
+static bool txStart(void) {
+    struct epoll_event ev;
+
+    l_epfd = epoll_create1(0);
+    l_evfd = eventfd(0U, EFD_NONBLOCK);
+    if ((l_epfd == -1) || (l_evfd == -1)) {
+        return false;
+    }
+
+    ev.events  = EPOLLIN;
+    ev.data.fd = l_evfd;
+    if (epoll_ctl(l_epfd, EPOLL_CTL_ADD, l_evfd, &ev) != 0) {
+        return false;
+    }
+    if (l_sinkKind == SINK_SOCK) { /* EPOLLOUT only when the sink blocks */
+        ev.events  = 0U;
+        ev.data.fd = l_sock;
+        if (epoll_ctl(l_epfd, EPOLL_CTL_ADD, l_sock, &ev) != 0) {
+            return false;
+        }
+    }
+
+    l_txRunning = true;
+    if (pthread_create(&l_txThread, NULL, &txThread, NULL) != 0) {
+        l_txRunning = false;
+        return false;
+    }
+    return true;
+}
+/*..........................................................................*/
+static void *txThread(void *arg) {
+    bool isOutArmed = false; /* is EPOLLOUT enabled for the sink? */
+    (void)arg;
+
+    while (l_txRunning) {
+        struct epoll_event ev[2];
+        int const n = epoll_wait(l_epfd, ev, 2, QS_TIMEOUT_MS);
+        for (int i = 0; i < n; ++i) {
+            if (ev[i].data.fd == l_evfd) {
+                uint64_t cnt;
+                ssize_t const nRead = read(l_evfd, &cnt, sizeof(cnt));
+                (void)nRead; /* only resets the eventfd */
+            }
+            else if ((ev[i].events & (EPOLLERR | EPOLLHUP)) != 0U) {
+                txSinkFail(0);
+                l_txRunning = false;
             }
         }
-        /* set nBytes for the next call to QS_getBlock() */
-        nBytes = QS_TX_CHUNK;
-        QS_CRIT_E_();
+
+        pthread_mutex_lock(&l_txMutex);
+        bool ok = l_txRunning; /* not stopped in the meantime? */
+        bool isPending = false;
+        if (ok) {
+            ok = txFlush(TX_NO_WAIT);
+            isPending = (QS_priv_.used != 0U); /* sink blocked? */
+        }
+        pthread_mutex_unlock(&l_txMutex);
+
+        if (!ok) {
+            l_txRunning = false;
+        }
+        else if ((l_sinkKind == SINK_SOCK) && (isPending != isOutArmed)) {
+            struct epoll_event out;
+            out.events  = isPending ? EPOLLOUT : 0U;
+            out.data.fd = l_sock;
+            (void)epoll_ctl(l_epfd, EPOLL_CTL_MOD, l_sock, &out);
+            isOutArmed = isPending;
+        }
     }
-    QS_CRIT_X_();
+    return NULL;
 }
+
 /*..........................................................................*/
-QSTimeCtr QS_onGetTime(void) {
-    struct timespec tspec;
-    QSTimeCtr time;
-    clock_gettime(CLOCK_MONOTONIC_RAW, &tspec);
+/* map a new capture segment 'fname' in the capture directory 'l_sock' */
+static QSCapSegHdr *capSegOpen(char const *fname, uint32_t const segNo,
+                               uint32_t const segSize)
+{
+    int const fd = openat(l_sock, fname, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+        FPRINTF_S(stderr, "<TARGET> ERROR   cannot create QS capture "
+            "segment=%s,errno=%d\n", fname, errno);
+        return (QSCapSegHdr *)0;
+    }
+    void *seg = MAP_FAILED;
+    if (ftruncate(fd, (off_t)segSize) == 0) {
+        seg = mmap(NULL, segSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd); /* the mapping stays valid */
+    if (seg == MAP_FAILED) {
+        FPRINTF_S(stderr, "<TARGET> ERROR   cannot map QS capture "
+            "segment=%s,errno=%d\n", fname, errno);
+        return (QSCapSegHdr *)0;
+    }
 
-    /* convert to units of 0.1 microsecond */
-    time = (QSTimeCtr)(tspec.tv_sec * 10000000 + tspec.tv_nsec / 100);
-    return time;
+    QSCapSegHdr * const hdr = (QSCapSegHdr *)seg;
+    hdr->magic   = QS_CAP_MAGIC;
+    hdr->version = QS_CAP_VERSION;
+    hdr->hdrSize = (uint16_t)sizeof(QSCapSegHdr);
+    hdr->segNo   = segNo;
+    hdr->segSize = segSize;
+    hdr->dataEnd = (uint32_t)sizeof(QSCapSegHdr);
+    hdr->idxStep = 1U;
+    hdr->timeSize   = QS_TIME_SIZE;
+    hdr->objPtrSize = QS_OBJ_PTR_SIZE;
+    hdr->funPtrSize = QS_FUN_PTR_SIZE;
+    hdr->sigSize    = Q_SIGNAL_SIZE;
+    return hdr; /* the rest of the file is zero-filled by ftruncate() */
 }
+/*..........................................................................*/
+/* unmap the capture segment 'hdr' and trim the file to its data */
+static void capSegClose(QSCapSegHdr * const hdr, char const *fname) {
+    uint32_t const dataEnd = hdr->dataEnd;
+    munmap(hdr, hdr->segSize);
+    int const fd = openat(l_sock, fname, O_RDWR);
+    if (fd != -1) {
+        (void)ftruncate(fd, (off_t)dataEnd);
+        close(fd);
+    }
+}
+/*..........................................................................*/
+static void capSegName(char *fname, size_t const size, uint32_t const segNo) {
+    SNPRINTF_S(fname, size, "qs-%08u.qsc", (unsigned)segNo);
+}
+/*..........................................................................*/
+static int capOpen(char const *dir) {
+    (void)mkdir(dir, 0755); /* might exist already */
+    l_sock = open(dir, O_RDONLY | O_DIRECTORY);
+    if (l_sock == INVALID_SOCKET) {
+        FPRINTF_S(stderr, "<TARGET> ERROR   cannot open QS capture "
+            "directory=%s,errno=%d\n", dir, errno);
+        return INVALID_SOCKET;
+    }
+
+    /* remove the segments of a previous capture */
+    int const fd = dup(l_sock);
+    DIR * const d = (fd != -1) ? fdopendir(fd) : (DIR *)0;
+    if (d != (DIR *)0) {
+        struct dirent const *ent;
+        while ((ent = readdir(d)) != NULL) {
+            size_t const len = strlen(ent->d_name);
+            if ((strncmp(ent->d_name, "qs-", 3U) == 0)
+                && (len > 4U)
+                && (strcmp(&ent->d_name[len - 4U], ".qsc") == 0))
+            {
+                (void)unlinkat(l_sock, ent->d_name, 0);
+            }
+        }
+        closedir(d);
+    }
 
+    char fname[32];
+    capSegName(fname, sizeof(fname), 0U);
+    memset(&l_cap, 0, sizeof(l_cap));
+    l_cap.dict = capSegOpen("dict.qsc", UINT32_MAX, QS_CAP_DICT_SIZE);
+    l_cap.seg  = capSegOpen(fname, 0U, QS_CAP_SEG_SIZE);
+    if ((l_cap.dict == (QSCapSegHdr *)0) || (l_cap.seg == (QSCapSegHdr *)0)) {
+        close(l_sock);
+        l_sock = INVALID_SOCKET;
+    }
+    return l_sock;
+}
 /*..........................................................................*/
-void QS_output(void) {
-    uint16_t nBytes;
-    uint8_t const *data;
-    QS_CRIT_STAT_
+static void capClose(void) {
+    char fname[32];
+    if (l_cap.seg != (QSCapSegHdr *)0) {
+        capSegName(fname, sizeof(fname), l_cap.segNo);
+        capSegClose(l_cap.seg, fname);
+        l_cap.seg = (QSCapSegHdr *)0;
+    }
+    if (l_cap.dict != (QSCapSegHdr *)0) {
+        capSegClose(l_cap.dict, "dict.qsc");
+        l_cap.dict = (QSCapSegHdr *)0;
+    }
+}
+/*..........................................................................*/
+/* append the record with the given header fields and data to the segment
+* 'hdr', which must have room for it, and update the segment index
+*/
+static void capSegAppend(QSCapSegHdr * const hdr,
+                         uint64_t const time, uint64_t const obj,
+                         uint8_t const seq, uint8_t const rec,
+                         uint8_t const * const data, uint32_t const dataLen)
+{
+    uint32_t const offs = hdr->dataEnd;
+    QSCapRec * const cr = (QSCapRec *)((uint8_t *)hdr + offs);
+    cr->time = time;
+    cr->obj  = obj;
+    cr->len  = (uint16_t)dataLen;
+    cr->seq  = seq;
+    cr->rec  = rec;
+    memcpy(&cr[1], data, dataLen);
+
+    /* sparse time-index, thinned out when full */
+    if ((hdr->nRec % hdr->idxStep) == 0U) {
+        if (hdr->nIdx == QS_CAP_IDX_MAX) {
+            for (uint32_t i = 0U; i < (QS_CAP_IDX_MAX / 2U); ++i) {
+                hdr->idx[i] = hdr->idx[2U * i];
+            }
+            hdr->nIdx = QS_CAP_IDX_MAX / 2U;
+            hdr->idxStep *= 2U;
+        }
+        if ((hdr->nRec % hdr->idxStep) == 0U) {
+            hdr->idx[hdr->nIdx].time = time;
+            hdr->idx[hdr->nIdx].offs = offs;
+            ++hdr->nIdx;
+        }
+    }
+    if (obj != QS_CAP_NO_OBJ) {
+        uint32_t i = 0U;
+        while ((i < hdr->nObj) && (i < QS_CAP_OBJ_MAX)
+               && (hdr->obj[i] != obj))
+        {
+            ++i;
+        }
+        if (i == hdr->nObj) { /* new object? */
+            if (i < QS_CAP_OBJ_MAX) {
+                hdr->obj[i] = obj;
+            }
+            hdr->nObj = i + 1U; /* > QS_CAP_OBJ_MAX on overflow */
+        }
+    }
+    if (hdr->nRec == 0U) {
+        hdr->tFirst = time;
+    }
+    if (time > hdr->tLast) {
+        hdr->tLast = time;
+    }
+    hdr->recMask[rec >> 5U] |= (1U << (rec & 0x1FU));
+    ++hdr->nRec;
 
-    if (l_sock == INVALID_SOCKET) { /* socket NOT initialized? */
-        FPRINTF_S(stderr, "<TARGET> ERROR   %s\n", "invalid TCP socket");
+    /* publish the record only after it is complete */
+    __atomic_store_n(&hdr->dataEnd, offs + QS_CAP_REC_SIZE(dataLen),
+                     __ATOMIC_RELEASE);
+}
+/*..........................................................................*/
+/* number of the leading data bytes identifying the entry of a dictionary
+* record, e.g., the object pointer of QS_OBJ_DICT (0 for QS_TARGET_INFO)
+*/
+static uint32_t capDictKeyLen(uint8_t const rec) {
+    uint32_t len;
+    switch (rec) {
+        case QS_SIG_DICT: {
+            len = Q_SIGNAL_SIZE + QS_OBJ_PTR_SIZE; /* signal and object */
+            break;
+        }
+        case QS_OBJ_DICT: {
+            len = QS_OBJ_PTR_SIZE;
+            break;
+        }
+        case QS_FUN_DICT: {
+            len = QS_FUN_PTR_SIZE;
+            break;
+        }
+        case QS_USR_DICT: {
+            len = 1U; /* the user record */
+            break;
+        }
+        case QS_ENUM_DICT: {
+            len = 2U; /* the value and the group */
+            break;
+        }
+        default: { /* QS_TARGET_INFO */
+            len = 0U;
+            break;
+        }
+    }
+    return len;
+}
+/*..........................................................................*/
+/* rewrite the dictionary segment with only the last record of every
+* dictionary entry (e.g., without the dictionaries sent again after a
+* reset of the target), see NOTE3 in qs_port.h
+*/
+static void capDictRotate(void) {
+    QSCapSegHdr * const old = l_cap.dict;
+    if (old == (QSCapSegHdr *)0) {
         return;
     }
+    QSCapSegHdr * const hdr = capSegOpen("dict.tmp", UINT32_MAX,
+                                         QS_CAP_DICT_SIZE);
+    if (hdr == (QSCapSegHdr *)0) {
+        return; /* keep the old dictionary segment */
+    }
 
-    nBytes = QS_TX_CHUNK;
-    QS_CRIT_E_();
-    if ((data = QS_getBlock(&nBytes)) != (uint8_t *)0) {
-        QS_CRIT_X_();
-        for (;;) { /* for-ever until break or return */
-            int nSent = send(l_sock, (char const *)data, (int)nBytes, 0);
-            if (nSent == SOCKET_ERROR) { /* sending failed? */
-                if ((errno == EWOULDBLOCK) || (errno == EAGAIN)) {
-                    /* sleep for the timeout and then loop back
-                    * to send() the SAME data again
-                    */
-                    nanosleep(&c_timeout, NULL);
-                }
-                else { /* some other socket error... */
-                    FPRINTF_S(stderr, "<TARGET> ERROR   sending data over TCP,"
-                           "errno=%d\n", errno);
-                    return;
-                }
+    uint8_t const *base = (uint8_t const *)old;
+    uint32_t offs = old->hdrSize;
+    while (offs < old->dataEnd) {
+        QSCapRec const * const cr = (QSCapRec const *)&base[offs];
+        uint32_t const keyLen = capDictKeyLen(cr->rec);
+        offs += QS_CAP_REC_SIZE(cr->len);
+
+        /* is the entry repeated later in the dictionary segment? */
+        bool isStale = false;
+        uint32_t o = offs;
+        while ((o < old->dataEnd) && (!isStale)) {
+            QSCapRec const * const later = (QSCapRec const *)&base[o];
+            isStale = (later->rec == cr->rec)
+                      && (later->len >= keyLen) && (cr->len >= keyLen)
+                      && (memcmp(&later[1], &cr[1], keyLen) == 0);
+            o += QS_CAP_REC_SIZE(later->len);
+        }
+        if (!isStale) {
+            capSegAppend(hdr, cr->time, cr->obj, cr->seq, cr->rec,
+                         (uint8_t const *)&cr[1], cr->len);
+        }
+    }
+    munmap(old, old->segSize);
+    (void)renameat(l_sock, "dict.tmp", l_sock, "dict.qsc");
+    l_cap.dict = hdr;
+}
+/*..........................................................................*/
+/* close the full current segment, open the next one and delete the oldest
+* segment beyond QS_CAP_SEG_MAX. The dictionary segment is rotated
+* together with the data segments.
+*/
+static bool capRotate(void) {
+    char fname[32];
+    capSegName(fname, sizeof(fname), l_cap.segNo);
+    capSegClose(l_cap.seg, fname);
+    ++l_cap.segNo;
+    if (l_cap.segNo >= QS_CAP_SEG_MAX) {
+        capSegName(fname, sizeof(fname), l_cap.segNo - QS_CAP_SEG_MAX);
+        (void)unlinkat(l_sock, fname, 0);
+    }
+    capSegName(fname, sizeof(fname), l_cap.segNo);
+    l_cap.seg = capSegOpen(fname, l_cap.segNo, QS_CAP_SEG_SIZE);
+    capDictRotate();
+    return (l_cap.seg != (QSCapSegHdr *)0);
+}
+/*..........................................................................*/
+/* append the un-escaped record in l_capRec[] (seq, rec, data) to the
+* capture
+*/
+static void capWriteRec(uint32_t const len) {
+    uint8_t const rec = l_capRec[1];
+    uint8_t const * const data = &l_capRec[2];
+    uint32_t const dataLen = len - 2U;
+    uint8_t const layout = (rec < QS_PRE_MAX) ? l_capLayout[rec]
+                           : ((rec >= QS_USER) ? CAP_T : 0U);
+
+    /* extend the QS_TIME_SIZE-byte record time-stamp to 64 bits; records
+    * without time inherit the time of the preceding record
+    */
+    if (((layout & CAP_T) != 0U) && (dataLen >= QS_TIME_SIZE)) {
+#if (QS_TIME_SIZE < 8U)
+        uint64_t const mask = ((uint64_t)1U << (8U * QS_TIME_SIZE)) - 1U;
+#else
+        uint64_t const mask = ~(uint64_t)0U;
+#endif
+        uint64_t t = 0U;
+        for (uint_fast8_t i = 0U; i < QS_TIME_SIZE; ++i) {
+            t |= (uint64_t)data[i] << (8U * i);
+        }
+        /* the difference from the last time-stamp, sign-extended from
+        * QS_TIME_SIZE bytes (the merged records might step back)
+        */
+        uint64_t dt = (t - l_cap.time) & mask;
+        if (dt > (mask >> 1U)) {
+            dt |= ~mask;
+        }
+        l_cap.time = l_cap.hasTime ? (l_cap.time + dt) : t;
+        l_cap.hasTime = true;
+    }
+
+    uint64_t obj = QS_CAP_NO_OBJ;
+    uint_fast8_t const objOffs = (uint_fast8_t)(layout & ~CAP_T);
+    if ((objOffs != 0U) && ((objOffs - 1U + QS_OBJ_PTR_SIZE) <= dataLen)) {
+        for (uint_fast8_t i = 0U; i < QS_OBJ_PTR_SIZE; ++i) {
+            obj |= (uint64_t)data[objOffs - 1U + i] << (8U * i);
+        }
+    }
+
+    /* dictionaries and target info go to the dictionary segment */
+    bool const isDict = ((QS_SIG_DICT <= rec) && (rec <= QS_TARGET_INFO))
+                        || (rec == QS_ENUM_DICT);
+    QSCapSegHdr *hdr = isDict ? l_cap.dict : l_cap.seg;
+    uint32_t const size = QS_CAP_REC_SIZE(dataLen);
+    if ((hdr == (QSCapSegHdr *)0) /* rotation failed before? */
+        || ((hdr->dataEnd + size) > hdr->segSize)) /* segment full? */
+    {
+        if ((l_cap.seg == (QSCapSegHdr *)0) || (!capRotate())) {
+            hdr = (QSCapSegHdr *)0;
+        }
+        else {
+            hdr = isDict ? l_cap.dict : l_cap.seg;
+        }
+        if ((hdr == (QSCapSegHdr *)0) /* still no segment? */
+            || ((hdr->dataEnd + size) > hdr->segSize)) /* dict full? */
+        {
+            ++l_txStats.recDropped;
+            l_txStats.bytesDropped += len;
+            return;
+        }
+    }
+    capSegAppend(hdr, l_cap.time, obj, l_capRec[0], rec, data, dataLen);
+}
+/*..........................................................................*/
+/* capture all complete QS frames from QS_priv_ */
+static void capSend(void) {
+    QF_CRIT_ENTRY(dummy);
+    QSCtr const tail = QS_priv_.tail;
+    QSCtr const used = QS_priv_.used;
+    QF_CRIT_EXIT(dummy);
+
+    QSCtr pos = tail;
+    QSCtr done = 0U; /* bytes of the complete frames */
+    QSCtr n = 0U;
+    uint32_t len = 0U;
+    uint8_t chksum = 0U;
+    bool isEsc = false;
+    for (; n < used; ++n) {
+        uint8_t b = QS_priv_.buf[pos];
+        ++pos;
+        if (pos == QS_priv_.end) {
+            pos = 0U;
+        }
+        if (b == QS_FRAME) {
+            if ((len >= 3U) && (len <= sizeof(l_capRec))
+                && (chksum == 0xFFU))
+            {
+                capWriteRec(len - 1U); /* without the checksum */
+                l_txStats.bytesSent += (uint32_t)(n + 1U - done);
             }
-            else if (nSent < (int)nBytes) { /* sent fewer than requested? */
-                nanosleep(&c_timeout, NULL); /* sleep for the timeout */
-                /* adjust the data and loop back to send() the rest */
-                data   += nSent;
-                nBytes -= (uint16_t)nSent;
+            else if (len != 0U) { /* corrupted or oversized frame */
+                ++l_txStats.recDropped;
+                l_txStats.bytesDropped += (uint32_t)(n + 1U - done);
             }
-            else {
-                break;
+            done = n + 1U;
+            len = 0U;
+            chksum = 0U;
+        }
+        else if (b == QS_ESC) {
+            isEsc = true;
+        }
+        else {
+            if (isEsc) {
+                b ^= QS_ESC_XOR;
+                isEsc = false;
             }
+            chksum = (uint8_t)(chksum + b);
+            if (len < sizeof(l_capRec)) {
+                l_capRec[len] = b;
+            }
+            ++len;
         }
     }
+
+    QF_CRIT_ENTRY(dummy);
+    if (QS_priv_.tail == tail) { /* no overrun in the meantime? */
+        QSCtr newTail = tail + done;
+        if (newTail >= QS_priv_.end) {
+            newTail -= QS_priv_.end;
+        }
+        QS_priv_.tail  = newTail;
+        QS_priv_.used -= done;
+    }
+    QF_CRIT_EXIT(dummy);
+}
+
+/*..........................................................................*/
+void QS_enterCriticalSection_(void) {
+    if (l_myThrBuf != (QSThrBuf *)0) { /* thread with its own ring? */
+        pthread_mutex_lock(&l_myThrBuf->mutex);
+    }
     else {
-        QS_CRIT_X_();
+        QF_enterCriticalSection_();
     }
 }
 /*..........................................................................*/
-void QS_rx_input(void) {
-    int status = recv(l_sock,
-                      (char *)QS_rxPriv_.buf, (int)QS_rxPriv_.end, 0);
-    if (status > 0) { /* any data received? */
-        QS_rxPriv_.tail = 0U;
-        QS_rxPriv_.head = status; /* # bytes received */
-        QS_rxParse(); /* parse all received bytes */
+void QS_leaveCriticalSection_(void) {
+    if (l_myThrBuf != (QSThrBuf *)0) { /* thread with its own ring? */
+        pthread_mutex_unlock(&l_myThrBuf->mutex);
+    }
+    else {
+        QF_leaveCriticalSection_();
     }
 }
+/*..........................................................................*/
+void QS_enterGlbCriticalSection_(void) { /* see NOTE1 in qs_port.h */
+    pthread_mutex_lock(&l_glbMutex);
+}
+/*..........................................................................*/
+void QS_leaveGlbCriticalSection_(void) {
+    pthread_mutex_unlock(&l_glbMutex);
+}
+/*..........................................................................*/
+void QS_thrBufInit_(uint_fast8_t const idx) {
+    Q_REQUIRE_ID(100, idx <= QF_MAX_ACTIVE);
+
+    QSThrBuf * const tb = &l_thrBuf[idx];
+
+    pthread_mutex_lock(&l_mergeMutex); /* not while merging this ring */
+    if (!tb->isActive) {
+        pthread_mutex_init(&tb->mutex, NULL);
+    }
+    tb->tx.buf    = &l_thrSto[idx][0];
+    tb->tx.end    = (QSCtr)QS_THR_BUF_SIZE;
+    tb->tx.head   = 0U;
+    tb->tx.tail   = 0U;
+    tb->tx.used   = 0U;
+    tb->tx.seq    = 0U;
+    tb->tx.chksum = 0U;
+    tb->tx.flags  = QS_TX_MERGE_FLAG; /* time-stamped records */
+    tb->lost      = 0U;
+    tb->lastSeq   = 0U;
+    l_thrStage[idx].len = 0U;
+    l_thrStage[idx].pos = 0U;
+    tb->isActive  = true;
+    pthread_mutex_unlock(&l_mergeMutex);
+
+    l_myThrBuf = tb;
+    QS_thrTx_  = &tb->tx;
+}
+/*..........................................................................*/
+uint32_t QS_getThrLost(uint_fast8_t const idx) {
+    Q_REQUIRE_ID(200, idx <= QF_MAX_ACTIVE);
+    return l_thrBuf[idx].lost;
+}
+
+/*..........................................................................*/
+static uint8_t stageGetByte(QSThrStage * const st) {
+    uint8_t b = st->buf[st->pos];
+    ++st->pos;
+    if (b == QS_ESC) {
+        b = (uint8_t)(st->buf[st->pos] ^ QS_ESC_XOR);
+        ++st->pos;
+    }
+    return b;
+}
+/*..........................................................................*/
+static QSTimeCtr stagePeekTime(QSThrStage const * const st) {
+    uint32_t pos = st->pos;
+    QSTimeCtr t = 0U;
+    for (uint_fast8_t i = 0U; i < QS_TIME_SIZE; ++i) {
+        uint8_t b = st->buf[pos];
+        ++pos;
+        if (b == QS_ESC) {
+            b = (uint8_t)(st->buf[pos] ^ QS_ESC_XOR);
+            ++pos;
+        }
+        t |= (QSTimeCtr)b << (8U * i);
+    }
+    return t;
+}
+/*..........................................................................*/
+static bool mergeThrBufs(void) {
+    bool isDone = true;
+    pthread_mutex_lock(&l_mergeMutex);
+
+    /* copy the complete records out of every active per-thread ring... */
+    for (uint_fast8_t idx = 0U; idx <= QF_MAX_ACTIVE; ++idx) {
+        QSThrBuf * const tb = &l_thrBuf[idx];
+        QSThrStage * const st = &l_thrStage[idx];
+        if ((!tb->isActive) || (st->pos < st->len)) { /* not merged yet? */
+            continue;
+        }
+        st->len = 0U;
+        st->pos = 0U;
 
+        /* the ring is written inside the QS critical section of its thread
+        * and also inside the QF critical sections (QS_BEGIN_NOCRIT_PRE_())
+        */
+        QF_CRIT_ENTRY(dummy);
+        pthread_mutex_lock(&tb->mutex);
+        QSCtr tail = tb->tx.tail;
+        QSCtr n = tb->tx.used;
+        if (n != 0U) {
+            QSCtr const n1 = (tb->tx.end - tail < n) ? (tb->tx.end - tail) : n;
+            memcpy(&st->buf[0], &tb->tx.buf[tail], n1);
+            memcpy(&st->buf[n1], &tb->tx.buf[0], n - n1);
+            st->len = (uint32_t)n;
+            tb->tx.tail = tb->tx.head;
+            tb->tx.used = 0U;
+        }
+        pthread_mutex_unlock(&tb->mutex);
+        QF_CRIT_EXIT(dummy);
+    }
+
+    /* ...and merge them into QS_priv_ in the order of their time-stamps */
+    QS_tx * const thrTx = QS_thrTx_;
+    QS_thrTx_ = &QS_priv_; /* QS_beginRec_() etc. to insert into QS_priv_ */
+    for (;;) {
+        QSThrStage *st = (QSThrStage *)0;
+        uint_fast8_t idx = 0U;
+        QSTimeCtr tMin = 0U;
+        for (uint_fast8_t i = 0U; i <= QF_MAX_ACTIVE; ++i) {
+            if (l_thrStage[i].pos < l_thrStage[i].len) {
+                QSTimeCtr const t = stagePeekTime(&l_thrStage[i]);
+                if ((st == (QSThrStage *)0) || ((int32_t)(t - tMin) < 0)) {
+                    st   = &l_thrStage[i];
+                    idx  = i;
+                    tMin = t;
+                }
+            }
+        }
+        if (st == (QSThrStage *)0) { /* all stages merged? */
+            break;
+        }
+
+        /* un-escape the next record: seq, rec, data, checksum */
+        uint32_t const pos = st->pos;
+        for (uint_fast8_t i = 0U; i < QS_TIME_SIZE; ++i) {
+            (void)stageGetByte(st); /* skip the time-stamp */
+        }
+        uint32_t len = 0U;
+        while ((st->pos < st->len) && (st->buf[st->pos] != QS_FRAME)) {
+            uint8_t const b = stageGetByte(st);
+            if (len < sizeof(l_mergeRec)) {
+                l_mergeRec[len] = b;
+            }
+            ++len;
+        }
+        if ((len < sizeof(l_mergeRec))
+            && ((QS_priv_.end - QS_priv_.used) < (2U * len) + 1U))
+        {
+            /* QS_priv_ full, leave the rest for after sending, see NOTE2 */
+            st->pos = pos;
+            isDone = false;
+            break;
+        }
+        ++st->pos; /* skip the QS_FRAME */
+        if ((len < 3U) || (len > sizeof(l_mergeRec))) {
+            ++l_thrBuf[idx].lost; /* malformed record */
+            continue;
+        }
+
+        /* records missing from the thread-local sequence were lost.
+        * NOTE: the 8-bit sequence number wraps around, so a gap of more
+        * than 255 records is counted modulo 256, see NOTE1 in qs_port.h
+        */
+        uint8_t const lost = (uint8_t)(l_mergeRec[0]
+                                       - l_thrBuf[idx].lastSeq - 1U);
+        l_thrBuf[idx].lastSeq = l_mergeRec[0];
+        l_thrBuf[idx].lost += lost;
+
+        QF_CRIT_ENTRY(dummy);
+        QS_priv_.seq = (uint8_t)(QS_priv_.seq + lost); /* gap for QSPY */
+        QS_beginRec_((uint_fast8_t)l_mergeRec[1]);
+        for (uint32_t i = 2U; i < (len - 1U); ++i) { /* skip the checksum */
+            QS_u8_raw_(l_mergeRec[i]);
+        }
+        QS_endRec_();
+        QF_CRIT_EXIT(dummy);
+    }
+    QS_thrTx_ = thrTx;
+
+    pthread_mutex_unlock(&l_mergeMutex);
+    return isDone;
+}
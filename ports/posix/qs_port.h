@@ -43,6 +43,33 @@
     #define QS_FUN_PTR_SIZE 4U
 #endif
 
+/* size [bytes] of the per-thread QS-TX ring buffers, see NOTE1 */
+#ifndef QS_THR_BUF_SIZE
+    #define QS_THR_BUF_SIZE 4096U
+#endif
+
+/* number of the QS rate filters, see QS_REC_RATE() and QS_ID_RATE() */
+#ifndef QS_RATE_MAX
+    #define QS_RATE_MAX     8U
+#endif
+
+/* number of the QS aggregation counters, see QS_AGG_MODE() */
+#ifndef QS_AGG_MAX
+    #define QS_AGG_MAX      64U
+#endif
+
+/* define QS_TX_DROP_OLDEST to drop the oldest QS records when the QS sink
+* cannot keep up, instead of letting the QS-TX buffer overrun, see NOTE2
+*/
+/*#define QS_TX_DROP_OLDEST*/
+
+/* per-thread QS-TX ring buffers and QS critical section, see NOTE1 */
+#define QS_TX_                (*QS_thrTx_)
+#define QS_CRIT_ENTRY(dummy)  QS_enterCriticalSection_()
+#define QS_CRIT_EXIT(dummy)   QS_leaveCriticalSection_()
+#define QS_GLB_CRIT_ENTRY()   QS_enterGlbCriticalSection_()
+#define QS_GLB_CRIT_EXIT()    QS_leaveGlbCriticalSection_()
+
 void QS_output(void);    /* handle the QS output */
 void QS_rx_input(void);  /* handle the QS-RX input */
 
@@ -59,5 +86,95 @@ void QS_rx_input(void);  /* handle the QS-RX input */
 
 #include "qs.h"      /* QS platform-independent public interface */
 
+/* QS-TX ring of the calling thread (QS_priv_ for threads without a ring) */
+extern __thread QS_tx *QS_thrTx_;
+
+void QS_enterCriticalSection_(void);
+void QS_leaveCriticalSection_(void);
+void QS_enterGlbCriticalSection_(void);
+void QS_leaveGlbCriticalSection_(void);
+
+/* attach a QS-TX ring to the calling thread (called from the QF port) */
+void QS_thrBufInit_(uint_fast8_t const idx);
+
+/* lower bound of the records lost in the per-thread ring with the given
+* index, see NOTE1
+*/
+uint32_t QS_getThrLost(uint_fast8_t const idx);
+
+/* statistics of the QS-TX output, see NOTE2 */
+typedef struct {
+    uint32_t bytesSent;    /* number of bytes sent to the QS sink */
+    uint32_t bytesDropped; /* number of bytes dropped (QS_TX_DROP_OLDEST) */
+    uint32_t recDropped;   /* number of records dropped (QS_TX_DROP_OLDEST) */
+    uint32_t stalls;       /* number of times the QS sink would block */
+} QSTxStats;
+
+QSTxStats const *QS_getTxStats(void);
+
+/*==========================================================================*/
+/* NOTE1:
+* Every thread started by the QF port (AO threads and the ticker thread
+* in QF_run()) produces QS records into its own ring buffer, protected by
+* a per-thread mutex instead of the global QF critical section. Each
+* record in such a ring is preceded by a QS_onGetTime() time-stamp and
+* carries a thread-local sequence number. The QS-TX thread (see NOTE2)
+* merges the per-thread rings into the QS_priv_ ring in the time-stamp
+* order, re-numbering the records for QSPY. Records lost to an overrun
+* of a per-thread ring are counted per thread (see QS_getThrLost()) and
+* show up in QSPY as gaps in the sequence numbers. The losses are derived
+* from the gaps of the 8-bit thread-local sequence numbers, so a single
+* overrun of more than 255 records is counted modulo 256, and the count is
+* only a lower bound of the records actually lost. The QS rate filters
+* (QS_RATE_MAX) are shared by all threads, so they are additionally
+* protected by a global mutex (QS_GLB_CRIT_ENTRY()), always locked inside
+* the QS critical section.
+*
+* NOTE2:
+* The QS output is sent by a dedicated QS-TX thread started in
+* QS_onStartup(). QS_output() and QS_onFlush() called from the AO threads
+* and from the ticker thread only wake up the QS-TX thread, so a slow QS
+* consumer never blocks the QF threads. QS_onFlush() called from other
+* threads (e.g., from main() while producing the dictionaries) still sends
+* all the data before returning. The QS-TX thread sends the data straight
+* from the QS_priv_ ring (writev()/sendmsg() over both parts of a wrapped
+* ring) and waits for the sink in epoll_wait() when it would block.
+*
+* The first sink error (e.g., QSPY disconnected, EPOLLHUP/EPOLLERR) is
+* reported once and stops the QS-TX thread. The socket is removed from
+* the epoll set, and from then on QS_output() and QS_onFlush() discard the
+* QS data, and QS_rx_input() no longer reads the socket, instead of
+* repeating the same error on every call.
+*
+* When QS_TX_DROP_OLDEST is defined and the sink blocks, the QS-TX thread
+* discards the oldest whole records above the QS_TX_HIGH_WATER level, so
+* that the QS_priv_ ring does not overrun in the middle of a record. The
+* dropped records are counted in QS_getTxStats() and show up in QSPY as
+* gaps in the sequence numbers.
+*
+* The QS sink is selected by the QS_INIT() argument:
+* "host[:port]" TCP connection to QSPY (default "localhost:6601"),
+* "unix:path"   UNIX-domain stream socket, and
+* "file:path"   binary QS file (no QS-RX channel), which can be fed
+*               to QSPY off-line, and
+* "cap:dir"     indexed binary capture (no QS-RX channel), see NOTE3.
+*
+* NOTE3:
+* The "cap:" QS sink writes the un-escaped QS records with a fixed header
+* (see qs_cap.h) into memory-mapped segment files of QS_CAP_SEG_SIZE
+* bytes in the given directory, keeping the last QS_CAP_SEG_MAX segments.
+* The header carries the record time-stamp extended to 64 bits and the
+* primary object of the predefined records (e.g., the recipient AO of
+* QS_QF_ACTIVE_POST). Every segment indexes its time range, the record
+* types and objects it contains and a sparse time-index. The dictionary
+* and target-info records go to the separate "dict.qsc" segment of
+* QS_CAP_DICT_SIZE bytes. It is rotated together with the data segments
+* (or when it is full): it is rewritten with only the last record of
+* every dictionary entry, so the dictionaries sent again after a target
+* reset don't fill it up. The time-stamps of QS_TIME_SIZE bytes are
+* extended to 64 bits. The host tool in ports/posix/qscap queries the
+* capture and decodes it back into the QS format for QSPY.
+*/
+
 #endif /* QS_PORT_H  */
 
@@ -0,0 +1,533 @@
+/*============================================================================
+* QP/C Real-Time Embedded Framework (RTEF)
+* Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+*
+* SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+*
+* This software is dual-licensed under the terms of the open source GNU
+* General Public License version 3 (or any later version), or alternatively,
+* under the terms of one of the closed source Quantum Leaps commercial
+* licenses.
+*
+* The terms of the open source GNU General Public License version 3
+* can be found at: <www.gnu.org/licenses/gpl-3.0>
+*
+* The terms of the closed source Quantum Leaps commercial licenses
+* can be found at: <www.state-machine.com/licensing>
+*
+* Redistributions in source code must retain this top-level comment block.
+* Plagiarizing this software to sidestep the license obligations is illegal.
+*
+* Contact information:
+* <www.state-machine.com>
+* <info@state-machine.com>
+============================================================================*/
+/*!
+* @date Last updated on: 2026-10-18
+* @version Last updated for: @ref qpc_7_2_2
+*
+* @file
+* @brief qscap: host tool for the QS binary capture (see qs_cap.h)
+*
+* @details
+* Usage:
+* qscap info   <dir>
+* qscap query  <dir> [-r rec]... [-o obj] [-t t1:t2]
+* qscap decode <dir> [-r rec]... [-o obj] [-t t1:t2] [-w file]
+*
+* "query" lists the matching records as text, "decode" writes them in the
+* standard (framed and escaped) QS format, which QSPY reads with its "-f"
+* option. The dictionary records are always decoded first. The record
+* type 'rec' is a number or a predefined name (e.g., QS_QF_ACTIVE_POST),
+* the object 'obj' is an address or a name from the object dictionary,
+* and the times are in the QS time-stamp units (0.1us in the POSIX port).
+* The segment index skips the segments without the matching time range,
+* record types or objects, without reading their records.
+*/
+#define _POSIX_C_SOURCE 200809L
+
+#include "qs_cap.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define SEG_MAX   4096
+#define DICT_MAX  1024
+
+#define QS_FRAME   0x7EU
+#define QS_ESC     0x7DU
+#define QS_ESC_XOR 0x20U
+
+/* names of the predefined QS records (enum QSpyPre in qs.h) */
+static char const * const l_recName[] = {
+    "EMPTY", "QEP_STATE_ENTRY", "QEP_STATE_EXIT",
+    "QEP_STATE_INIT", "QEP_INIT_TRAN", "QEP_INTERN_TRAN",
+    "QEP_TRAN", "QEP_IGNORED", "QEP_DISPATCH",
+    "QEP_UNHANDLED", "QF_ACTIVE_DEFER", "QF_ACTIVE_RECALL",
+    "QF_ACTIVE_SUBSCRIBE", "QF_ACTIVE_UNSUBSCRIBE", "QF_ACTIVE_POST",
+    "QF_ACTIVE_POST_LIFO", "QF_ACTIVE_GET", "QF_ACTIVE_GET_LAST",
+    "QF_ACTIVE_RECALL_ATTEMPT", "QF_EQUEUE_POST", "QF_EQUEUE_POST_LIFO",
+    "QF_EQUEUE_GET", "QF_EQUEUE_GET_LAST", "QF_NEW_ATTEMPT",
+    "QF_MPOOL_GET", "QF_MPOOL_PUT", "QF_PUBLISH",
+    "QF_NEW_REF", "QF_NEW", "QF_GC_ATTEMPT",
+    "QF_GC", "QF_TICK", "QF_TIMEEVT_ARM",
+    "QF_TIMEEVT_AUTO_DISARM", "QF_TIMEEVT_DISARM_ATTEMPT", "QF_TIMEEVT_DISARM",
+    "QF_TIMEEVT_REARM", "QF_TIMEEVT_POST", "QF_DELETE_REF",
+    "QF_CRIT_ENTRY", "QF_CRIT_EXIT", "QF_ISR_ENTRY",
+    "QF_ISR_EXIT", "QF_INT_DISABLE", "QF_INT_ENABLE",
+    "QF_ACTIVE_POST_ATTEMPT", "QF_EQUEUE_POST_ATTEMPT", "QF_MPOOL_GET_ATTEMPT",
+    "SCHED_PREEMPT", "SCHED_RESTORE", "SCHED_LOCK",
+    "SCHED_UNLOCK", "SCHED_NEXT", "SCHED_IDLE",
+    "ENUM_DICT", "QEP_TRAN_HIST", "QEP_TRAN_EP",
+    "QEP_TRAN_XP", "TEST_PAUSED", "TEST_PROBE_GET",
+    "SIG_DICT", "OBJ_DICT", "FUN_DICT",
+    "USR_DICT", "TARGET_INFO", "TARGET_DONE",
+    "RX_STATUS", "QUERY_DATA", "PEEK_DATA",
+    "ASSERT_FAIL", "QF_RUN", "SEM_TAKE",
+    "SEM_BLOCK", "SEM_SIGNAL", "SEM_BLOCK_ATTEMPT",
+    "MTX_LOCK", "MTX_BLOCK", "MTX_UNLOCK",
+    "MTX_LOCK_ATTEMPT", "MTX_BLOCK_ATTEMPT", "MTX_UNLOCK_ATTEMPT",
+    "RATE_SUPPRESSED", "AGG_DISPATCH", "AGG_RTC",
+    "REPLAY_EVT", "RTC_OVERRUN", "AO_TELEM",
+};
+#define REC_PRE_MAX (sizeof(l_recName) / sizeof(l_recName[0]))
+#define REC_USER    100U
+
+typedef struct {
+    QSCapSegHdr const *hdr;
+    size_t size;
+} Seg;
+
+typedef struct {
+    uint64_t obj;
+    char name[64];
+} ObjDict;
+
+static Seg     l_dict;
+static Seg     l_seg[SEG_MAX];
+static int     l_nSeg;
+static ObjDict l_objDict[DICT_MAX];
+static int     l_nObjDict;
+
+/* query filters */
+static uint32_t l_recMask[8];
+static bool     l_anyRec = true;
+static uint64_t l_obj;
+static bool     l_anyObj = true;
+static uint64_t l_t1 = 0U;
+static uint64_t l_t2 = UINT64_MAX;
+
+static FILE *l_out;
+
+/*..........................................................................*/
+static bool segMap(char const *path, Seg * const seg) {
+    int const fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+    struct stat st;
+    void *p = MAP_FAILED;
+    if ((fstat(fd, &st) == 0) && ((size_t)st.st_size >= sizeof(QSCapSegHdr))) {
+        p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (p == MAP_FAILED) {
+        return false;
+    }
+    QSCapSegHdr const * const hdr = (QSCapSegHdr const *)p;
+    if ((hdr->magic != QS_CAP_MAGIC) || (hdr->version != QS_CAP_VERSION)
+        || (hdr->hdrSize != sizeof(QSCapSegHdr)))
+    {
+        fprintf(stderr, "qscap: %s is not a QS capture segment\n", path);
+        munmap(p, (size_t)st.st_size);
+        return false;
+    }
+    seg->hdr  = hdr;
+    seg->size = (hdr->dataEnd <= (uint32_t)st.st_size)
+                ? hdr->dataEnd
+                : (size_t)st.st_size;
+    return true;
+}
+/*..........................................................................*/
+static int segCmp(void const *a, void const *b) {
+    uint32_t const na = ((Seg const *)a)->hdr->segNo;
+    uint32_t const nb = ((Seg const *)b)->hdr->segNo;
+    return (na < nb) ? -1 : ((na > nb) ? 1 : 0);
+}
+/*..........................................................................*/
+static bool capLoad(char const *dir) {
+    char path[1024];
+    DIR * const d = opendir(dir);
+    if (d == (DIR *)0) {
+        fprintf(stderr, "qscap: cannot open directory %s\n", dir);
+        return false;
+    }
+    struct dirent const *ent;
+    while (((ent = readdir(d)) != NULL) && (l_nSeg < SEG_MAX)) {
+        size_t const len = strlen(ent->d_name);
+        if ((strncmp(ent->d_name, "qs-", 3U) == 0) && (len > 4U)
+            && (strcmp(&ent->d_name[len - 4U], ".qsc") == 0))
+        {
+            snprintf(path, sizeof(path), "%s/%s", dir, ent->d_name);
+            if (segMap(path, &l_seg[l_nSeg])) {
+                ++l_nSeg;
+            }
+        }
+    }
+    closedir(d);
+    qsort(l_seg, (size_t)l_nSeg, sizeof(l_seg[0]), &segCmp);
+
+    snprintf(path, sizeof(path), "%s/dict.qsc", dir);
+    if (!segMap(path, &l_dict)) {
+        l_dict.hdr = (QSCapSegHdr const *)0;
+    }
+    return true;
+}
+
+/*..........................................................................*/
+/* iterate over the records of a segment starting at the offset 'offs' */
+static QSCapRec const *recNext(Seg const * const seg, uint32_t * const offs) {
+    if ((*offs + sizeof(QSCapRec)) > seg->size) {
+        return (QSCapRec const *)0;
+    }
+    QSCapRec const * const cr =
+        (QSCapRec const *)((uint8_t const *)seg->hdr + *offs);
+    uint32_t const size = QS_CAP_REC_SIZE(cr->len);
+    if ((*offs + size) > seg->size) {
+        return (QSCapRec const *)0;
+    }
+    *offs += size;
+    return cr;
+}
+/*..........................................................................*/
+static int recByName(char const *name) {
+    if (strncmp(name, "QS_", 3U) == 0) {
+        name += 3;
+    }
+    for (unsigned i = 0U; i < REC_PRE_MAX; ++i) {
+        if (strcmp(name, l_recName[i]) == 0) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+/*..........................................................................*/
+static uint64_t getLE(uint8_t const *p, unsigned const n) {
+    uint64_t x = 0U;
+    for (unsigned i = 0U; i < n; ++i) {
+        x |= (uint64_t)p[i] << (8U * i);
+    }
+    return x;
+}
+/*..........................................................................*/
+static void dictLoad(void) {
+    int const objDict = recByName("OBJ_DICT");
+    uint32_t offs;
+    QSCapRec const *cr;
+    if (l_dict.hdr == (QSCapSegHdr const *)0) {
+        return;
+    }
+    unsigned const ptrSize = l_dict.hdr->objPtrSize;
+    offs = l_dict.hdr->hdrSize;
+    while (((cr = recNext(&l_dict, &offs)) != (QSCapRec const *)0)
+           && (l_nObjDict < DICT_MAX))
+    {
+        if ((cr->rec == (uint8_t)objDict) && (cr->len > ptrSize)) {
+            uint8_t const * const data = (uint8_t const *)&cr[1];
+            ObjDict * const od = &l_objDict[l_nObjDict];
+            size_t n = cr->len - ptrSize;
+            if (n > sizeof(od->name) - 1U) {
+                n = sizeof(od->name) - 1U;
+            }
+            od->obj = getLE(data, ptrSize);
+            memcpy(od->name, &data[ptrSize], n);
+            od->name[n] = '\0';
+            ++l_nObjDict;
+        }
+    }
+}
+/*..........................................................................*/
+static char const *objName(uint64_t const obj) {
+    for (int i = 0; i < l_nObjDict; ++i) {
+        if (l_objDict[i].obj == obj) {
+            return l_objDict[i].name;
+        }
+    }
+    return "";
+}
+/*..........................................................................*/
+static void recName(uint8_t const rec, char * const buf, size_t const size) {
+    if (rec < REC_PRE_MAX) {
+        snprintf(buf, size, "%s", l_recName[rec]);
+    }
+    else if (rec >= REC_USER) {
+        snprintf(buf, size, "USER+%u", (unsigned)(rec - REC_USER));
+    }
+    else {
+        snprintf(buf, size, "REC%u", (unsigned)rec);
+    }
+}
+
+/*..........................................................................*/
+static bool segMatches(QSCapSegHdr const * const hdr) {
+    if ((hdr->nRec == 0U) || (hdr->tLast < l_t1) || (hdr->tFirst > l_t2)) {
+        return false;
+    }
+    if (!l_anyRec) {
+        bool any = false;
+        for (unsigned i = 0U; i < 8U; ++i) {
+            any = any || ((hdr->recMask[i] & l_recMask[i]) != 0U);
+        }
+        if (!any) {
+            return false;
+        }
+    }
+    if ((!l_anyObj) && (hdr->nObj <= QS_CAP_OBJ_MAX)) {
+        for (uint32_t i = 0U; i < hdr->nObj; ++i) {
+            if (hdr->obj[i] == l_obj) {
+                return true;
+            }
+        }
+        return false;
+    }
+    return true;
+}
+/*..........................................................................*/
+static bool recMatches(QSCapRec const * const cr) {
+    return (cr->time >= l_t1) && (cr->time <= l_t2)
+           && (l_anyRec
+               || ((l_recMask[cr->rec >> 5U] & (1U << (cr->rec & 0x1FU)))
+                   != 0U))
+           && (l_anyObj || (cr->obj == l_obj));
+}
+/*..........................................................................*/
+/* offset of the first record to examine for the time 'l_t1': the time
+* index is only nearly monotonic (records merged from several threads),
+* so the scan starts one index entry before the first later entry
+*/
+static uint32_t segStart(QSCapSegHdr const * const hdr) {
+    uint32_t lo = 0U;
+    uint32_t hi = hdr->nIdx;
+    while (lo < hi) { /* first idx[] entry with time >= l_t1 */
+        uint32_t const mid = (lo + hi) / 2U;
+        if (hdr->idx[mid].time < l_t1) {
+            lo = mid + 1U;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return (lo > 1U) ? hdr->idx[lo - 2U].offs : hdr->hdrSize;
+}
+
+/*..........................................................................*/
+static void putByte(uint8_t const b, uint8_t * const chksum) {
+    if (chksum != (uint8_t *)0) {
+        *chksum = (uint8_t)(*chksum + b);
+    }
+    if ((b == QS_FRAME) || (b == QS_ESC)) {
+        fputc(QS_ESC, l_out);
+        fputc(b ^ QS_ESC_XOR, l_out);
+    }
+    else {
+        fputc(b, l_out);
+    }
+}
+/*..........................................................................*/
+static void recDecode(QSCapRec const * const cr) {
+    uint8_t const * const data = (uint8_t const *)&cr[1];
+    uint8_t chksum = 0U;
+    putByte(cr->seq, &chksum);
+    putByte(cr->rec, &chksum);
+    for (uint32_t i = 0U; i < cr->len; ++i) {
+        putByte(data[i], &chksum);
+    }
+    putByte((uint8_t)~chksum, (uint8_t *)0);
+    fputc(QS_FRAME, l_out);
+}
+/*..........................................................................*/
+static void recPrint(QSCapRec const * const cr) {
+    uint8_t const * const data = (uint8_t const *)&cr[1];
+    char name[32];
+    recName(cr->rec, name, sizeof(name));
+    fprintf(l_out, "%012llu %03u %-26s",
+            (unsigned long long)cr->time, (unsigned)cr->seq, name);
+    if (cr->obj != QS_CAP_NO_OBJ) {
+        fprintf(l_out, " obj=0x%llX %s",
+                (unsigned long long)cr->obj, objName(cr->obj));
+    }
+    fprintf(l_out, " :");
+    for (uint32_t i = 0U; i < cr->len; ++i) {
+        fprintf(l_out, " %02X", data[i]);
+    }
+    fputc('\n', l_out);
+}
+
+/*..........................................................................*/
+static void cmdInfo(void) {
+    if (l_dict.hdr != (QSCapSegHdr const *)0) {
+        printf("dict.qsc: %u records (time=%u,obj=%u,fun=%u,sig=%u bytes)\n",
+               l_dict.hdr->nRec, l_dict.hdr->timeSize,
+               l_dict.hdr->objPtrSize, l_dict.hdr->funPtrSize,
+               l_dict.hdr->sigSize);
+    }
+    for (int i = 0; i < l_nSeg; ++i) {
+        QSCapSegHdr const * const hdr = l_seg[i].hdr;
+        printf("qs-%08u.qsc: %u records, time %llu..%llu, %u bytes, "
+               "%u objects%s, %u index entries\n",
+               hdr->segNo, hdr->nRec,
+               (unsigned long long)hdr->tFirst,
+               (unsigned long long)hdr->tLast,
+               hdr->dataEnd,
+               (hdr->nObj <= QS_CAP_OBJ_MAX) ? hdr->nObj : QS_CAP_OBJ_MAX,
+               (hdr->nObj <= QS_CAP_OBJ_MAX) ? "" : "+",
+               hdr->nIdx);
+    }
+}
+/*..........................................................................*/
+static void cmdScan(bool const decode) {
+    uint32_t offs;
+    QSCapRec const *cr;
+    unsigned long nRec = 0U;
+
+    if (decode && (l_dict.hdr != (QSCapSegHdr const *)0)) {
+        offs = l_dict.hdr->hdrSize;
+        while ((cr = recNext(&l_dict, &offs)) != (QSCapRec const *)0) {
+            recDecode(cr);
+        }
+    }
+    for (int i = 0; i < l_nSeg; ++i) {
+        if (!segMatches(l_seg[i].hdr)) {
+            continue;
+        }
+        offs = segStart(l_seg[i].hdr);
+        while ((cr = recNext(&l_seg[i], &offs)) != (QSCapRec const *)0) {
+            if (recMatches(cr)) {
+                if (decode) {
+                    recDecode(cr);
+                }
+                else {
+                    recPrint(cr);
+                }
+                ++nRec;
+            }
+        }
+    }
+    fprintf(stderr, "qscap: %lu records\n", nRec);
+}
+
+/*..........................................................................*/
+static int usage(void) {
+    fprintf(stderr,
+        "usage: qscap info   <dir>\n"
+        "       qscap query  <dir> [-r rec]... [-o obj] [-t t1:t2]\n"
+        "       qscap decode <dir> [-r rec]... [-o obj] [-t t1:t2]"
+        " [-w file]\n");
+    return 2;
+}
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        return usage();
+    }
+    char const * const cmd = argv[1];
+    char const *objArg = (char const *)0;
+    char const *outFile = (char const *)0;
+
+    l_out = stdout;
+    for (int i = 3; i < argc; ++i) {
+        if ((i + 1) >= argc) {
+            return usage();
+        }
+        char const * const opt = argv[i];
+        char const *val = argv[++i];
+        if (strcmp(opt, "-r") == 0) {
+            char *end;
+            long rec = strtol(val, &end, 0);
+            if (*end != '\0') {
+                rec = recByName(val);
+            }
+            if ((rec < 0) || (rec > 255)) {
+                fprintf(stderr, "qscap: unknown record %s\n", val);
+                return 2;
+            }
+            l_recMask[rec >> 5] |= (1U << (rec & 0x1F));
+            l_anyRec = false;
+        }
+        else if (strcmp(opt, "-o") == 0) {
+            objArg = val;
+        }
+        else if (strcmp(opt, "-t") == 0) {
+            char *end;
+            if (*val != ':') {
+                l_t1 = strtoull(val, &end, 0);
+                val = end;
+            }
+            if (*val == ':') {
+                ++val;
+                if (*val != '\0') {
+                    l_t2 = strtoull(val, &end, 0);
+                }
+            }
+        }
+        else if (strcmp(opt, "-w") == 0) {
+            outFile = val;
+        }
+        else {
+            return usage();
+        }
+    }
+
+    if (!capLoad(argv[2])) {
+        return 1;
+    }
+    dictLoad();
+
+    if (objArg != (char const *)0) {
+        char *end;
+        l_obj = strtoull(objArg, &end, 0);
+        if (*end != '\0') { /* not a number, look up the dictionary */
+            int i = 0;
+            while ((i < l_nObjDict)
+                   && (strcmp(objArg, l_objDict[i].name) != 0))
+            {
+                ++i;
+            }
+            if (i == l_nObjDict) {
+                fprintf(stderr, "qscap: unknown object %s\n", objArg);
+                return 2;
+            }
+            l_obj = l_objDict[i].obj;
+        }
+        l_anyObj = false;
+    }
+
+    if (strcmp(cmd, "info") == 0) {
+        cmdInfo();
+    }
+    else if ((strcmp(cmd, "query") == 0) || (strcmp(cmd, "decode") == 0)) {
+        bool const decode = (cmd[0] == 'd');
+        if (outFile != (char const *)0) {
+            l_out = fopen(outFile, decode ? "wb" : "w");
+            if (l_out == (FILE *)0) {
+                fprintf(stderr, "qscap: cannot open %s\n", outFile);
+                return 1;
+            }
+        }
+        cmdScan(decode);
+        if (l_out != stdout) {
+            fclose(l_out);
+        }
+    }
+    else {
+        return usage();
+    }
+    return 0;
+}
@@ -9,6 +9,7 @@
 #include "qf_port.h"
 #include "qf_opt_layer.h"
 #include <finsh.h>
+#include <stdlib.h>
 #include "qpc.h"
 
 /**
@@ -56,8 +57,8 @@ static void QF_printAOStatus(void)
             struct rt_thread *thread = &ao->thread;
             if (thread == RT_NULL || thread->entry == RT_NULL) continue;
             const char *name = (thread->name[0] != '\0') ? thread->name : "N/A";
-            uint32_t queueDepth = (ao->eQueue.size > 0) ? ao->eQueue.entry : 0;
-            uint32_t queueSize  = (ao->eQueue.size > 0) ? ao->eQueue.size  : 0;
+            uint32_t queueDepth = QACTIVE_QUEUE_USED(ao);
+            uint32_t queueSize  = QACTIVE_QUEUE_SIZE(ao);
             const char *stateStr = "Other";
             switch (thread->stat) {
                 case RT_THREAD_READY:   stateStr = "Ready"; break;
@@ -149,6 +150,204 @@ static void QF_enableDisableOpt(int argc, char **argv)
     }
 }
 
+#ifdef QF_POOL_STATS
+/**
+ * @brief Print the event-pool statistics and the recommended pool layout
+ * @param argc Argument count
+ * @param argv Argument vector: [headroom%] or "reset"
+ */
+static void QF_printPools(int argc, char **argv)
+{
+    uint_fast8_t headroom = 20U;
+    uint_fast8_t i;
+
+    if (argc > 1)
+    {
+        if (rt_strcmp(argv[1], "reset") == 0)
+        {
+            QF_resetPoolStat();
+            rt_kprintf("Event-pool statistics reset.\n");
+            return;
+        }
+        headroom = (uint_fast8_t)atoi(argv[1]);
+    }
+
+    extern uint_fast8_t QF_maxPool_;
+    rt_kprintf("\n==== QF Event Pools ====\n");
+    rt_kprintf("| Pool | Block | Total | Peak  | Allocs     | Fails  | Near   | Waste |\n");
+    rt_kprintf("|------|-------|-------|-------|------------|--------|--------|-------|\n");
+    for (i = 1U; i <= QF_maxPool_; ++i)
+    {
+        QPoolStat stat;
+        QF_getPoolStat(i, &stat);
+        rt_kprintf("| %4u | %5u | %5u | %5u | %10lu | %6lu | %6lu | %4u%% |\n",
+                   (unsigned)i, (unsigned)stat.blockSize, (unsigned)stat.nTot,
+                   (unsigned)stat.peak, (unsigned long)stat.nAlloc,
+                   (unsigned long)stat.nFail, (unsigned long)stat.nNearMiss,
+                   (unsigned)stat.wastePct);
+    }
+
+    QPoolSizeStat sizes[QF_POOL_STAT_SIZES];
+    uint_fast8_t const nSizes = QF_getSizeStat(sizes, QF_POOL_STAT_SIZES);
+    rt_kprintf("\n| Event Size | Peak  | Allocs     |\n");
+    rt_kprintf("|------------|-------|------------|\n");
+    for (i = 0U; i < nSizes; ++i)
+    {
+        rt_kprintf("| %10u | %5u | %10lu |\n",
+                   (unsigned)sizes[i].evtSize, (unsigned)sizes[i].peak,
+                   (unsigned long)sizes[i].nAlloc);
+    }
+
+    rt_kprintf("\nPeak events in flight per signal:");
+    for (i = 0U; i < QF_POOL_STAT_SIGS; ++i)
+    {
+        uint_fast16_t const peak = QF_getSigPeak((enum_t)i);
+        if (peak != 0U)
+        {
+            rt_kprintf(" %u:%u", (unsigned)i, (unsigned)peak);
+        }
+    }
+    rt_kprintf("\n");
+
+    QPoolAdvice advice[QF_MAX_EPOOL];
+    uint_fast8_t const nPools = QF_poolAdvise(advice, QF_MAX_EPOOL, headroom);
+    uint32_t total = 0U;
+    rt_kprintf("\nRecommended pools (headroom %u%%):\n", (unsigned)headroom);
+    for (i = 0U; i < nPools; ++i)
+    {
+        rt_kprintf("  QF_poolInit(sto%u, %lu, %u); /* %u blocks */\n",
+                   (unsigned)(i + 1U), (unsigned long)advice[i].poolSize,
+                   (unsigned)advice[i].evtSize, (unsigned)advice[i].nBlocks);
+        total += advice[i].poolSize;
+    }
+    rt_kprintf("  total %lu bytes\n", (unsigned long)total);
+    rt_kprintf("========================\n");
+}
+#endif /* QF_POOL_STATS */
+
+#ifdef QF_EVT_TRACK
+/**
+ * @brief Print the oldest live dynamic events grouped by signal
+ * @param argc Argument count
+ * @param argv Argument vector: [number of events]
+ */
+static void QF_printLeaks(int argc, char **argv)
+{
+    extern QActive *QActive_registry_[QF_MAX_ACTIVE + 1U];
+    static QEvtTrackInfo info[32];
+    uint_fast16_t max = 16U;
+    uint_fast16_t i;
+    uint_fast16_t j;
+    uint_fast8_t p;
+
+    if (argc > 1)
+    {
+        max = (uint_fast16_t)atoi(argv[1]);
+        if ((max == 0U) || (max > sizeof(info) / sizeof(info[0])))
+        {
+            max = sizeof(info) / sizeof(info[0]);
+        }
+    }
+
+    uint_fast16_t const nLive = QF_getLiveEvts(info, max);
+    uint_fast16_t const n = (nLive < max) ? nLive : max;
+
+    rt_kprintf("\n==== QF Live Events: %u (oldest %u) ====\n",
+               (unsigned)nLive, (unsigned)n);
+    for (i = 0U; i < n; ++i)
+    {
+        uint_fast16_t cnt = 0U;
+        for (j = 0U; j < i; ++j)
+        {
+            if (info[j].sig == info[i].sig)
+            {
+                break;
+            }
+        }
+        if (j < i)
+        {
+            continue; /* the signal already printed */
+        }
+        for (j = i; j < n; ++j)
+        {
+            if (info[j].sig == info[i].sig)
+            {
+                ++cnt;
+            }
+        }
+        rt_kprintf("sig %u: %u event(s), oldest %lu ticks\n",
+                   (unsigned)info[i].sig, (unsigned)cnt,
+                   (unsigned long)info[i].age);
+        for (j = i; j < n; ++j)
+        {
+            if (info[j].sig != info[i].sig)
+            {
+                continue;
+            }
+            rt_kprintf("  %p pool %u ref %u age %lu sender %p held by:",
+                       info[j].e, (unsigned)info[j].poolId,
+                       (unsigned)info[j].refCtr, (unsigned long)info[j].age,
+                       info[j].sender);
+            for (p = 1U; p <= QF_MAX_ACTIVE; ++p)
+            {
+                if (QPSet_hasElement(&info[j].holders, p))
+                {
+                    QActive const *ao = QActive_registry_[p];
+                    rt_kprintf(" %u(%s)", (unsigned)p,
+                               (ao != (QActive *)0) ? ao->thread.name : "?");
+                }
+            }
+            if (QPSet_isEmpty(&info[j].holders))
+            {
+                rt_kprintf(" none");
+            }
+            rt_kprintf("\n");
+        }
+    }
+    rt_kprintf("========================\n");
+}
+#endif /* QF_EVT_TRACK */
+
+#ifdef QF_AO_TELEM
+/**
+ * @brief Print the telemetry of all active objects (see QActive_getTelem())
+ * @param argc Argument count
+ * @param argv Argument vector: "trace" produces the QS_AO_TELEM records
+ */
+static void QF_printTelem(int argc, char **argv)
+{
+    extern QActive *QActive_registry_[QF_MAX_ACTIVE + 1U];
+
+    if ((argc > 1) && (rt_strcmp(argv[1], "trace") == 0))
+    {
+        QF_telemTrace();
+        return;
+    }
+
+    rt_kprintf("\n==== Active Object Telemetry ====\n");
+    rt_kprintf("| Prio | Name     | Queue HWM | Dispatched | RTC avg  | RTC max  | Stack HWM     |\n");
+    rt_kprintf("|------|----------|-----------|------------|----------|----------|---------------|\n");
+    for (uint8_t prio = 1U; prio <= QF_MAX_ACTIVE; ++prio)
+    {
+        QActive const *const ao = QActive_registry_[prio];
+        if (ao != (QActive *)0)
+        {
+            QActiveTelem telem;
+            QActive_getTelem(ao, &telem);
+            rt_kprintf("| %4u | %-8.8s | %4u/%-4u | %10lu | %8lu | %8lu | %6lu/%-6lu |\n",
+                       (unsigned)prio, ao->thread.name,
+                       (unsigned)telem.queueMax, (unsigned)telem.queueSize,
+                       (unsigned long)telem.nDispatch,
+                       (unsigned long)telem.rtcAvg,
+                       (unsigned long)telem.rtcMax,
+                       (unsigned long)telem.stackUsed,
+                       (unsigned long)telem.stackSize);
+        }
+    }
+    rt_kprintf("=================================\n");
+}
+#endif /* QF_AO_TELEM */
+
 /**
  * @brief Print help information for QF dispatcher shell commands
  */
@@ -160,6 +359,15 @@ static void QF_dispatcherHelp(void)
     rt_kprintf("qf_strategy     - Set dispatcher strategy\n");
     rt_kprintf("qf_reset        - Reset dispatcher metrics\n");
     rt_kprintf("qf_opt          - Enable/disable optimization layer\n");
+#ifdef QF_POOL_STATS
+    rt_kprintf("qf_pools        - Event-pool statistics and sizing advice\n");
+#endif
+#ifdef QF_EVT_TRACK
+    rt_kprintf("qf_leaks        - Oldest live events grouped by signal\n");
+#endif
+#ifdef QF_AO_TELEM
+    rt_kprintf("qf_telem        - Queue, RTC and stack telemetry of the AOs\n");
+#endif
     rt_kprintf("qf_help         - Display this help\n");
     rt_kprintf("=================================\n");
 }
@@ -170,4 +378,13 @@ MSH_CMD_EXPORT_ALIAS(QF_printAOStatus, qf_aos, Display Active Object status);
 MSH_CMD_EXPORT_ALIAS(QF_setStrategy, qf_strategy, Set dispatcher strategy);
 MSH_CMD_EXPORT_ALIAS(QF_resetMetrics, qf_reset, Reset dispatcher metrics);
 MSH_CMD_EXPORT_ALIAS(QF_enableDisableOpt, qf_opt, Enable / disable optimization layer);
+#ifdef QF_POOL_STATS
+MSH_CMD_EXPORT_ALIAS(QF_printPools, qf_pools, Event-pool statistics and sizing advice);
+#endif
+#ifdef QF_EVT_TRACK
+MSH_CMD_EXPORT_ALIAS(QF_printLeaks, qf_leaks, Oldest live events grouped by signal);
+#endif
+#ifdef QF_AO_TELEM
+MSH_CMD_EXPORT_ALIAS(QF_printTelem, qf_telem, Queue RTC and stack telemetry of the AOs);
+#endif
 MSH_CMD_EXPORT_ALIAS(QF_dispatcherHelp, qf_help, Display QF dispatcher help);
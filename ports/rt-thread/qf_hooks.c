@@ -3,6 +3,19 @@
 
 static rt_timer_t qpc_tick_timer;
 
+/* With the native QF event queues the QF critical section only locks the
+* scheduler, so the clock tick (which posts the time events) must run in
+* a thread, i.e., from the RT-Thread soft timer (see NOTE1 in qf_port.h)
+*/
+#ifdef QPC_USING_NATIVE_EQUEUE
+#ifndef RT_USING_TIMER_SOFT
+#error "QPC_USING_NATIVE_EQUEUE requires RT_USING_TIMER_SOFT"
+#endif
+#define QPC_TICK_TIMER_FLAGS  (RT_TIMER_FLAG_PERIODIC | RT_TIMER_FLAG_SOFT_TIMER)
+#else
+#define QPC_TICK_TIMER_FLAGS  RT_TIMER_FLAG_PERIODIC
+#endif
+
 void QF_onClockTick(void *parameter) {
     QF_TICK_X(0U, (void *)0);  /* perform the QF clock tick processing */
 }
@@ -10,7 +23,7 @@ void QF_onClockTick(void *parameter) {
 void QF_onStartup(void) {
     qpc_tick_timer = rt_timer_create("qpc_tick", QF_onClockTick,
                                             RT_NULL, 10,
-                                            RT_TIMER_FLAG_PERIODIC);
+                                            QPC_TICK_TIMER_FLAGS);
     rt_timer_start(qpc_tick_timer);
 }
 
@@ -286,9 +286,7 @@ static void QF_processEventBatch(QEvt const **eventBatch,
         if (!merged)
         {
             /* Try to post the event */
-            rt_err_t result = rt_mb_send(&target->eQueue, (rt_ubase_t)evt);
-
-            if (result != RT_EOK)
+            if (!QActive_postStaged_(target, evt))
             {
                 /* Post failed - apply backpressure strategy */
                 if (QF_retryEvent(evt, target))
@@ -644,8 +642,8 @@ static bool highPerfShouldDrop(QEvt const *evt, QActive const *targetAO)
     if ((evtEx->super.sig != 0U) && ((evtEx->flags & QF_EVT_FLAG_CRITICAL) == 0U))
     {
         /* Check target queue depth */
-        uint32_t queueDepth = targetAO->eQueue.entry;
-        uint32_t queueSize = targetAO->eQueue.size;
+        uint32_t queueDepth = QACTIVE_QUEUE_USED(targetAO);
+        uint32_t queueSize = QACTIVE_QUEUE_SIZE(targetAO);
 
         /* Drop if queue is more than 80% full */
         if (queueDepth > (queueSize * 4U / 5U))
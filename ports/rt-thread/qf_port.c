@@ -43,6 +43,12 @@
 
 Q_DEFINE_THIS_MODULE("qf_port")
 
+static rt_uint16_t l_drainMax[QF_MAX_ACTIVE + 1U]; /* see QActive_setDrain() */
+rt_uint32_t volatile QF_lifoCtr_[QF_MAX_ACTIVE + 1U]; /* # LIFO posts per AO */
+static QActiveGroup *l_group[QF_MAX_ACTIVE + 1U];  /* group of the AO or NULL */
+#if (defined QF_AO_TELEM) && (!defined QPC_USING_NATIVE_EQUEUE)
+static rt_uint16_t l_queueMax[QF_MAX_ACTIVE + 1U]; /* mailbox high-water */
+#endif
 
 /**
  * @brief Initialize the QF framework (RT-Thread port)
@@ -79,6 +85,42 @@ void QF_stop(void)
     QF_onCleanup(); /* cleanup callback */
 }
 
+/**
+ * @brief Dispatch one event to the AO and garbage-collect it
+ * @details When the AO has a preemption-threshold above its priority
+ * (see Q_PRIO()), the RT-Thread priority of the AO thread is raised for
+ * the RTC step to the priority of the AO just above the threshold, so
+ * that the AOs with priorities up to the threshold cannot preempt it,
+ * not even by the round-robin time slicing among the threads of equal
+ * RT-Thread priority. The priority is restored afterwards and the AOs
+ * that became ready in the meantime are scheduled.
+ * @param act Pointer to QActive object
+ * @param e Event pointer
+ */
+static void dispatchEvt(QActive *const act, QEvt const *const e)
+{
+    QS_REPLAY_REC(e, act->prio); /* record the event for replay */
+    if (act->pthre > act->prio)
+    { /* non-preemptive band above the AO priority? */
+        rt_uint8_t rtPrio = (rt_uint8_t)(QF_MAX_ACTIVE - act->pthre - 1U);
+        rt_thread_control(&act->thread, RT_THREAD_CTRL_CHANGE_PRIORITY,
+                          &rtPrio);
+
+        QF_RTC_DISPATCH_(act, e, act->prio);
+        QF_gc(e); /* check if the event is garbage, and collect it if so */
+
+        rtPrio = (rt_uint8_t)(QF_MAX_ACTIVE - act->prio);
+        rt_thread_control(&act->thread, RT_THREAD_CTRL_CHANGE_PRIORITY,
+                          &rtPrio);
+        rt_schedule(); /* let the AOs in the band run, if ready */
+    }
+    else
+    {
+        QF_RTC_DISPATCH_(act, e, act->prio);
+        QF_gc(e); /* check if the event is garbage, and collect it if so */
+    }
+}
+
 /**
  * @brief RT-Thread AO thread entry function, event loop dispatcher
  * @param parameter Pointer to QActive object
@@ -93,9 +135,223 @@ static void thread_function(void *parameter)
     /* event-loop */
     for (;;)
     { /* for-ever */
-        QEvt const *e = QActive_get_(act);
-        QHSM_DISPATCH(&act->super, e, act->prio);
-        QF_gc(e); /* check if the event is garbage, and collect it if so */
+        uint_fast16_t const nMax = l_drainMax[act->prio];
+        if (nMax <= 1U)
+        { /* one event at a time */
+            dispatchEvt(act, QActive_get_(act));
+        }
+        else
+        { /* batch-drain mode */
+            QEvt const *evts[QF_DRAIN_MAX];
+            uint_fast16_t const n = QActive_getN_(act, evts, nMax);
+            rt_uint32_t lifo = QF_lifoCtr_[act->prio];
+
+            for (uint_fast16_t i = 0U; i < n; ++i)
+            {
+                dispatchEvt(act, evts[i]);
+
+                /* the events posted LIFO during the batch go first */
+                while (lifo != QF_lifoCtr_[act->prio])
+                {
+                    ++lifo;
+                    dispatchEvt(act, QActive_get_(act));
+                }
+            }
+            if (n == nMax)
+            { /* full batch, let other threads of the same priority run */
+                rt_thread_yield();
+            }
+        }
+    }
+}
+
+/**
+ * @brief Set the batch-drain mode of a started AO
+ * @param me Pointer to QActive object
+ * @param nMax Maximum number of events per batch, 0 or 1 to disable
+ */
+void QActive_setDrain(QActive *const me, uint_fast16_t const nMax)
+{
+    Q_REQUIRE_ID(800, (0U < me->prio) && (me->prio <= QF_MAX_ACTIVE)
+                      && (nMax <= QF_DRAIN_MAX)
+                      && (l_group[me->prio] == (QActiveGroup *)0));
+
+    l_drainMax[me->prio] = (rt_uint16_t)nMax;
+}
+
+/**
+ * @brief Initialize the event queue of an AO (see NOTE1 in qf_port.h)
+ * @param me Pointer to QActive object
+ * @param name Name of the RT-Thread IPC object of the queue
+ * @param qSto Event queue storage
+ * @param qLen Event queue length
+ */
+static void initQueue(QActive *const me, char const *const name,
+                      QEvt const **const qSto, uint_fast16_t const qLen)
+{
+#ifdef QPC_USING_NATIVE_EQUEUE
+    QEQueue_init(&me->eQueue, qSto, qLen);
+    Q_ALLEGE_ID(210,
+                rt_event_init(&me->osObject,
+                              name,
+                              RT_IPC_FLAG_PRIO) == RT_EOK);
+#else
+    /* allege that the RT-Thread queue is created successfully */
+    Q_ALLEGE_ID(210,
+                rt_mb_init(&me->eQueue,
+                           name,
+                           (void *)qSto,
+                           (qLen),
+                           RT_IPC_FLAG_FIFO) == RT_EOK);
+#endif
+}
+
+/**
+ * @brief RT-Thread AO group thread entry function, cooperative scheduler
+ * @param parameter Pointer to QActiveGroup object
+ */
+static void group_function(void *parameter)
+{ /* RT-Thread signature */
+    QActiveGroup *const grp = (QActiveGroup *)parameter;
+
+    for (;;)
+    { /* for-ever */
+        rt_sem_take(&grp->sem, RT_WAITING_FOREVER);
+
+        rt_base_t level = rt_hw_interrupt_disable();
+        while (QPSet_notEmpty(&grp->readySet))
+        {
+            uint_fast8_t const p = QPSet_findMax(&grp->readySet);
+            rt_hw_interrupt_enable(level);
+
+            /* only this thread receives from the member queues,
+             * so the queue of a ready member cannot be empty
+             */
+            QActive *const a = QActive_registry_[p];
+            dispatchEvt(a, QActive_get_(a));
+
+            level = rt_hw_interrupt_disable();
+            if (QACTIVE_QUEUE_USED(a) == 0U)
+            { /* no more events for this member? */
+                QPSet_remove(&grp->readySet, p);
+            }
+        }
+        rt_hw_interrupt_enable(level);
+    }
+}
+
+/**
+ * @brief Initialize an AO group (the thread starts with the 1st member)
+ * @param me Pointer to QActiveGroup object
+ * @param name Name of the group thread
+ * @param stkSto Stack storage of the group thread
+ * @param stkSize Stack size in bytes
+ */
+void QActiveGroup_init(QActiveGroup *const me, char const *const name,
+                       void *const stkSto, rt_uint32_t const stkSize)
+{
+    Q_REQUIRE_ID(900, (stkSto != (void *)0) && (stkSize > 0U));
+
+    QPSet_setEmpty(&me->readySet);
+    me->minPrio = 0U; /* no members yet */
+    me->maxPrio = 0U;
+    Q_ALLEGE_ID(910,
+                rt_sem_init(&me->sem, name, 0U, RT_IPC_FLAG_FIFO) == RT_EOK);
+    Q_ALLEGE_ID(920,
+                rt_thread_init(&me->thread, name, &group_function, me,
+                               stkSto, stkSize,
+                               RT_THREAD_PRIORITY_MAX - 1U, /* see _add() */
+                               5) == RT_EOK);
+}
+
+/**
+ * @brief Start an AO as a member of the group (instead of QACTIVE_START())
+ * @param me Pointer to QActiveGroup object
+ * @param ao Pointer to the member QActive object
+ * @param prioSpec Priority specification of the AO
+ * @param qSto Event queue storage of the AO
+ * @param qLen Event queue length of the AO
+ * @param par Initialization parameter
+ */
+void QActiveGroup_add(QActiveGroup *const me, QActive *const ao,
+                      QPrioSpec const prioSpec,
+                      QEvt const **const qSto, uint_fast16_t const qLen,
+                      void const *const par)
+{
+    /* the member AO has no thread of its own, so the RT-Thread IPC object
+     * of its queue is named after the group thread
+     */
+    initQueue(ao, me->thread.name, qSto, qLen);
+
+    ao->prio = (uint8_t)(prioSpec & 0xFFU); /* QF-priority */
+    ao->pthre = 0U;                          /* preemption-threshold NOT used */
+
+    /* the members must occupy a contiguous range of QF-priorities,
+     * because the group thread runs at the priority of the highest member
+     * and would starve any other AO with a priority within the range
+     */
+    {
+        uint_fast8_t const lo = ((me->minPrio == 0U)
+                                 || (ao->prio < me->minPrio))
+                                    ? ao->prio : me->minPrio;
+        uint_fast8_t const hi = (ao->prio > me->maxPrio)
+                                    ? ao->prio : me->maxPrio;
+        for (uint_fast8_t p = lo + 1U; p < hi; ++p)
+        {
+            Q_REQUIRE_ID(930, (QActive_registry_[p] == (QActive *)0)
+                              || (l_group[p] == me));
+        }
+        me->minPrio = (uint8_t)lo;
+    }
+    QActive_register_(ao);                   /* register this AO */
+    QHSM_INIT(&ao->super, par, ao->prio);    /* initial tran. (virtual) */
+    QS_FLUSH();                              /* flush the trace buffer to the host */
+
+    /* join the group only now, so that the group thread cannot dispatch
+     * the events posted to the AO before its initial transition is done
+     */
+    l_group[ao->prio] = me;
+    if (QACTIVE_QUEUE_USED(ao) > 0U)
+    { /* events posted during the initial transition? */
+        QActive_groupReady_(ao);
+    }
+
+    if (me->maxPrio < ao->prio)
+    { /* the group thread runs at the priority of the highest member */
+        bool const isStarted = (me->maxPrio != 0U);
+        rt_uint8_t rtPrio = (rt_uint8_t)(QF_MAX_ACTIVE - ao->prio);
+
+        me->maxPrio = ao->prio;
+        rt_thread_control(&me->thread, RT_THREAD_CTRL_CHANGE_PRIORITY,
+                          &rtPrio);
+        if (!isStarted)
+        {
+            Q_ALLEGE_ID(940, rt_thread_startup(&me->thread) == RT_EOK);
+        }
+    }
+}
+
+/**
+ * @brief Mark the group member AO as ready to run (no-op for other AOs)
+ * @details The group thread is woken up only when the ready-set of the
+ * group becomes non-empty, because it empties the whole ready-set before
+ * waiting on the semaphore again.
+ * @param me Pointer to QActive object
+ */
+void QActive_groupReady_(QActive *const me)
+{
+    QActiveGroup *const grp = l_group[me->prio];
+    if (grp != (QActiveGroup *)0)
+    {
+        rt_base_t const level = rt_hw_interrupt_disable();
+        bool const wasIdle = !QPSet_notEmpty(&grp->readySet);
+        QPSet_insert(&grp->readySet, me->prio);
+        rt_hw_interrupt_enable(level);
+
+        if (wasIdle)
+        {
+            rt_sem_release(&grp->sem);
+        }
     }
 }
 
@@ -114,16 +370,24 @@ void QActive_start_(QActive *const me, QPrioSpec const prioSpec,
                     void *const stkSto, uint_fast16_t const stkSize,
                     void const *const par)
 {
-    /* allege that the RT-Thread queue is created successfully */
-    Q_ALLEGE_ID(210,
-                rt_mb_init(&me->eQueue,
-                           me->thread.name,
-                           (void *)qSto,
-                           (qLen),
-                           RT_IPC_FLAG_FIFO) == RT_EOK);
+    initQueue(me, me->thread.name, qSto, qLen);
 
     me->prio = (uint8_t)(prioSpec & 0xFFU); /* QF-priority */
     me->pthre = (uint8_t)(prioSpec >> 8U);  /* preemption-threshold */
+
+    /* a preemption-threshold needs a priority level above it */
+    Q_REQUIRE_ID(230, (me->pthre <= me->prio)
+                      || (me->pthre < QF_MAX_ACTIVE));
+
+    /* the AO must not fall between the members of an AO group,
+     * which run at the priority of their highest member
+     */
+    for (uint_fast8_t p = me->prio + 1U; p <= QF_MAX_ACTIVE; ++p)
+    {
+        Q_REQUIRE_ID(240, (l_group[p] == (QActiveGroup *)0)
+                          || (me->prio < l_group[p]->minPrio));
+    }
+
     QActive_register_(me);                  /* register this AO */
     QHSM_INIT(&me->super, par, me->prio);   /* initial tran. (virtual) */
     QS_FLUSH();                             /* flush the trace buffer to the host */
@@ -175,6 +439,61 @@ void QActive_setAttr(QActive *const me, uint32_t attr1, void const *attr2)
     }
 }
 
+/**
+ * @brief Post an event already referenced by the optimization layer
+ * @details Unlike QActive_post_(), the event is not recycled when it
+ * cannot be posted, so that the caller can retry or drop it.
+ * @param me Pointer to QActive object
+ * @param e Event pointer
+ * @return true if posted, false if the queue is full
+ */
+bool QActive_postStaged_(QActive *const me, QEvt const *const e)
+{
+#ifdef QPC_USING_NATIVE_EQUEUE
+    /* QActive_post_() adds a reference only if the event was posted */
+    bool const status = QActive_post_(me, e, 0U, (void *)0);
+    if (status)
+    {
+        QF_gc(e); /* the queue took over the optimization-layer reference */
+    }
+#else
+    bool const status = (rt_mb_send(&me->eQueue, (rt_ubase_t)e) == RT_EOK);
+    if (status)
+    {
+#ifdef QF_AO_TELEM
+        if (l_queueMax[me->prio] < me->eQueue.entry)
+        {
+            l_queueMax[me->prio] = me->eQueue.entry;
+        }
+#endif
+        QActive_groupReady_(me); /* in case of an AO group */
+    }
+#endif
+    return status;
+}
+
+#ifdef QPC_USING_NATIVE_EQUEUE
+
+/**
+ * @brief Wake up the thread (or the group) of the AO (QACTIVE_EQUEUE_SIGNAL_)
+ * @details Called in the QF critical section when an event is posted to
+ * the empty queue of the AO.
+ * @param me Pointer to QActive object
+ */
+void QActive_signal_(QActive *const me)
+{
+    if (l_group[me->prio] != (QActiveGroup *)0)
+    {
+        QActive_groupReady_(me);
+    }
+    else
+    {
+        rt_event_send(&me->osObject, 1U);
+    }
+}
+
+#else /* RT-Thread mailbox as the AO queue */
+
 /**
  * @brief Post an event to the AO's event queue (FIFO)
  * @param me Pointer to QActive object
@@ -239,12 +558,20 @@ bool QActive_post_(QActive *const me, QEvt const *const e,
         {                        /* is it a pool event? */
             QEvt_refCtr_inc_(e); /* increment the reference counter */
         }
+        QF_EVT_TRACK_POST_(e, me->prio, sender); /* the AO holds e */
+#ifdef QF_AO_TELEM
+        if (l_queueMax[me->prio] < me->eQueue.size - nFree + 1U)
+        {
+            l_queueMax[me->prio] = (rt_uint16_t)(me->eQueue.size - nFree + 1U);
+        }
+#endif
 
         QF_CRIT_X_();
 
         /* posting to the RT-Thread message queue must succeed */
         Q_ALLEGE_ID(520,
                     rt_mb_send(&me->eQueue, (rt_ubase_t)e) == RT_EOK);
+        QActive_groupReady_(me); /* in case of an AO group */
     }
     else
     {
@@ -291,12 +618,21 @@ void QActive_postLIFO_(QActive *const me, QEvt const *const e)
     {                        /* is it a pool event? */
         QEvt_refCtr_inc_(e); /* increment the reference counter */
     }
+    QF_EVT_TRACK_POST_(e, me->prio, (void *)0); /* the AO holds e */
+    ++QF_lifoCtr_[me->prio]; /* for the batch-drain mode */
+#ifdef QF_AO_TELEM
+    if (l_queueMax[me->prio] < me->eQueue.entry + 1U)
+    {
+        l_queueMax[me->prio] = (rt_uint16_t)(me->eQueue.entry + 1U);
+    }
+#endif
 
     QF_CRIT_X_();
 
     /* LIFO posting must succeed */
     Q_ALLEGE_ID(610,
                 rt_mb_urgent(&me->eQueue, (rt_ubase_t)e) == RT_EOK);
+    QActive_groupReady_(me); /* in case of an AO group */
 }
 
 /**
@@ -322,3 +658,106 @@ QEvt const *QActive_get_(QActive *const me)
 
     return e;
 }
+
+/**
+ * @brief Get up to nMax events from the AO's event queue at once
+ * @details Waits for the first event with QActive_get_() and then takes
+ * the other queued events with the non-blocking rt_mb_recv(), all with the
+ * scheduler locked, so that the batch and its QS records are consistent.
+ * @param me Pointer to QActive object
+ * @param evts Array receiving the events
+ * @param nMax Capacity of the array evts
+ * @return Number of the received events (at least 1)
+ */
+uint_fast16_t QActive_getN_(QActive *const me, QEvt const *evts[],
+                            uint_fast16_t const nMax)
+{
+    Q_REQUIRE_ID(720, nMax > 0U);
+
+    evts[0] = QActive_get_(me); /* wait for the first event */
+    uint_fast16_t n = 1U;
+
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+    while (n < nMax)
+    {
+        QEvt const *e;
+        if (rt_mb_recv(&me->eQueue, (rt_ubase_t *)&e, 0) != RT_EOK)
+        { /* no more events queued? */
+            break;
+        }
+        evts[n] = e;
+        ++n;
+
+        if (me->eQueue.entry != 0U)
+        { /* any events left in the queue? */
+            QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_GET, me->prio)
+            QS_TIME_PRE_();                      /* timestamp */
+            QS_SIG_PRE_(e->sig);                 /* the signal of this event */
+            QS_OBJ_PRE_(me);                     /* this active object */
+            QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+            QS_EQC_PRE_(me->eQueue.size - me->eQueue.entry); /* # free */
+            QS_END_NOCRIT_PRE_()
+        }
+        else
+        {
+            QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_GET_LAST, me->prio)
+            QS_TIME_PRE_();                      /* timestamp */
+            QS_SIG_PRE_(e->sig);                 /* the signal of this event */
+            QS_OBJ_PRE_(me);                     /* this active object */
+            QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+            QS_END_NOCRIT_PRE_()
+        }
+    }
+    QF_CRIT_X_();
+
+    return n;
+}
+
+#endif /* QPC_USING_NATIVE_EQUEUE */
+
+#ifdef QF_AO_TELEM
+/**
+ * @brief Queue and stack telemetry of the AO (see QActive_getTelem())
+ * @details The stack high-water mark is found by scanning the stack of
+ * the AO thread (or of its AO group) for the '#' fill pattern, with which
+ * rt_thread_init() paints the stacks.
+ * @param me Pointer to QActive object
+ * @param telem Telemetry filled with the queue and stack data
+ */
+void QActive_getPortTelem_(QActive const *const me,
+                           QActiveTelem *const telem)
+{
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+#ifdef QPC_USING_NATIVE_EQUEUE
+    telem->queueSize = (uint16_t)(me->eQueue.end + 1U);
+    telem->queueMax = (uint16_t)(me->eQueue.end + 1U - me->eQueue.nMin);
+#else
+    telem->queueSize = (uint16_t)me->eQueue.size;
+    telem->queueMax = (uint16_t)l_queueMax[me->prio];
+#endif
+    QF_CRIT_X_();
+
+    struct rt_thread const *const thread =
+        (l_group[me->prio] != (QActiveGroup *)0)
+            ? &l_group[me->prio]->thread
+            : &me->thread;
+    rt_uint8_t const *const stk = (rt_uint8_t const *)thread->stack_addr;
+    rt_uint32_t const size = (rt_uint32_t)thread->stack_size;
+    rt_uint32_t unused = 0U;
+#ifdef ARCH_CPU_STACK_GROWS_UPWARD
+    while ((unused < size) && (stk[size - 1U - unused] == '#'))
+    {
+        ++unused;
+    }
+#else
+    while ((unused < size) && (stk[unused] == '#'))
+    {
+        ++unused;
+    }
+#endif
+    telem->stackSize = size;
+    telem->stackUsed = size - unused;
+}
+#endif /* QF_AO_TELEM */
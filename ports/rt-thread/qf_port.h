@@ -32,17 +32,62 @@
 #ifndef QF_PORT_H
 #define QF_PORT_H
 
-/* RT-Thread event queue and thread types */
+#include <rtthread.h>   /* RT-Thread API (and the rtconfig.h options) */
+
+/* RT-Thread event queue and thread types, see NOTE1 */
+#ifdef QPC_USING_NATIVE_EQUEUE
+#define QF_EQUEUE_TYPE      QEQueue
+#define QF_OS_OBJECT_TYPE   struct rt_event
+#else
 #define QF_EQUEUE_TYPE      struct rt_mailbox
+#endif
 #define QF_THREAD_TYPE      struct rt_thread
 
 /* The maximum number of active objects in the application, see NOTE2 */
 #define QF_MAX_ACTIVE       (RT_THREAD_PRIORITY_MAX)
 
+/* Preemption-threshold: an AO started with Q_PRIO(prio, pthre), where
+* prio < pthre < QF_MAX_ACTIVE, runs its RTC steps at the RT-Thread
+* priority corresponding to pthre + 1, so it cannot be preempted by the
+* AOs with priorities up to pthre, not even by the time slicing among the
+* threads of equal RT-Thread priority. (The AO with the priority pthre + 1
+* shares the raised RT-Thread priority, so it runs at the end of the step
+* or of the time slice.) The AOs sharing the same threshold form
+* a non-preemptive band, which saves context switches and stack space.
+* Do not use RT-Thread mutexes with priority inheritance inside such RTC
+* steps, because the port restores the AO priority unconditionally at the
+* end of the step.
+*/
+
 /* QF critical section for RT-Thread, see NOTE3 */
 #define QF_CRIT_ENTRY(stat_)  (rt_enter_critical())
 #define QF_CRIT_EXIT(stat_)   (rt_exit_critical())
 
+/* define a free-running high-resolution counter as QF_RTC_TIME() to measure
+* the RTC steps of the AOs against their budgets (see QActive_setRtcBudget()),
+* e.g., the DWT cycle counter on ARM Cortex-M:
+* #define QF_RTC_TIME()       (DWT->CYCCNT)
+*/
+
+/* define QF_POOL_STATS to collect the event-pool statistics, which the
+* "qf_pools [headroom%]" shell command prints with the recommended pool
+* layout for the workload observed so far (see QF_poolAdvise())
+*/
+/*#define QF_POOL_STATS*/
+
+/* define QF_EVT_TRACK to track the lifetime of the dynamic events, which
+* the "qf_leaks [n]" shell command lists, the oldest first, grouped by
+* signal (see QF_getLiveEvts()), with the allocation time in system ticks
+*/
+/*#define QF_EVT_TRACK*/
+
+/* define QF_AO_TELEM for the queue, RTC and stack telemetry of the AOs,
+* which the "qf_telem [trace]" shell command prints or traces as the
+* QS_AO_TELEM records (see QActive_getTelem())
+*/
+/*#define QF_AO_TELEM*/
+#define QF_EVT_TRACK_TIME()   ((uint32_t)rt_tick_get())
+
 /* QF optimization layer configuration */
 #ifndef QF_STAGING_BUFFER_SIZE
 #define QF_STAGING_BUFFER_SIZE 32U  /*!< Configurable staging buffer size */
@@ -56,23 +101,122 @@
 #define QF_DISPATCHER_PRIORITY 0U  /*!< Highest priority for dispatcher */
 #endif
 
+#ifndef QF_DRAIN_MAX
+#define QF_DRAIN_MAX 16U  /*!< Capacity of the AO batch-drain mode */
+#endif
+
 enum RT_Thread_ThreadAttrs {
     THREAD_NAME_ATTR
 };
 
-#include <rtthread.h>   /* RT-Thread API */
-
 #include "qep_port.h" /* QEP port */
 #include "qequeue.h"  /* native QF event queue for deferring events */
 #include "qmpool.h"   /* native QF event pool */
 #include "qf.h"       /* QF platform-independent public interface */
 #include "qf_opt_layer.h" /* QF optimization layer */
 
+/* number of events in the AO queue and the capacity of the AO queue */
+#ifdef QPC_USING_NATIVE_EQUEUE
+#define QACTIVE_QUEUE_USED(me_) \
+    ((uint_fast16_t)((me_)->eQueue.end + 1U - (me_)->eQueue.nFree))
+#define QACTIVE_QUEUE_SIZE(me_) ((uint_fast16_t)((me_)->eQueue.end + 1U))
+#else
+#define QACTIVE_QUEUE_USED(me_) ((uint_fast16_t)(me_)->eQueue.entry)
+#define QACTIVE_QUEUE_SIZE(me_) ((uint_fast16_t)(me_)->eQueue.size)
+#endif
+
+/**
+ * @brief Set the batch-drain mode of a started AO
+ * @details The AO thread receives up to nMax (<= QF_DRAIN_MAX) queued
+ * events at once and dispatches them back-to-back. Events posted LIFO
+ * during the batch are dispatched before the rest of the batch. After a
+ * full batch the thread yields to the other threads of its priority.
+ * @param me Pointer to QActive object
+ * @param nMax Maximum number of events per batch, 0 or 1 to disable
+ */
+void QActive_setDrain(QActive *const me, uint_fast16_t const nMax);
+
+/**
+ * @brief Cooperative group of AOs sharing one RT-Thread thread
+ * @details The member AOs keep their own event queues and state machines,
+ * but have no threads or stacks of their own. The group thread runs the
+ * RTC steps of the members QV-style: always for the highest-priority
+ * member with events, one event at a time. The group thread runs at the
+ * RT-Thread priority of its highest-priority member, so a member can
+ * delay the higher-priority members of its group by one RTC step.
+ * For the same reason, the group would starve any other AO with a
+ * priority between its members. The members must therefore occupy a
+ * contiguous range of QF-priorities, which QActiveGroup_add() and
+ * QActive_start_() assert.
+ */
+typedef struct
+{
+    struct rt_thread thread; /**< thread shared by the member AOs */
+    struct rt_semaphore sem; /**< wakes up the group thread */
+    QPSet readySet;          /**< members with non-empty event queues */
+    uint8_t minPrio;         /**< lowest QF-priority of the members */
+    uint8_t maxPrio;         /**< highest QF-priority of the members */
+} QActiveGroup;
+
+/**
+ * @brief Initialize an AO group (the thread starts with the 1st member)
+ * @param me Pointer to QActiveGroup object
+ * @param name Name of the group thread
+ * @param stkSto Stack storage of the group thread
+ * @param stkSize Stack size in bytes
+ */
+void QActiveGroup_init(QActiveGroup *const me, char const *const name,
+                       void *const stkSto, rt_uint32_t const stkSize);
+
+/**
+ * @brief Start an AO as a member of the group (instead of QACTIVE_START())
+ * @details The preemption-threshold in prioSpec is ignored and the AO
+ * cannot use the batch-drain mode (see QActive_setDrain()). No AO outside
+ * the group may have a priority between the members of the group. The
+ * event queue of the AO is named after the group thread.
+ * @param me Pointer to QActiveGroup object
+ * @param ao Pointer to the member QActive object
+ * @param prioSpec Priority specification of the AO
+ * @param qSto Event queue storage of the AO
+ * @param qLen Event queue length of the AO
+ * @param par Initialization parameter
+ */
+void QActiveGroup_add(QActiveGroup *const me, QActive *const ao,
+                      QPrioSpec const prioSpec,
+                      QEvt const **const qSto, uint_fast16_t const qLen,
+                      void const *const par);
+
 /*****************************************************************************
 * interface used only inside QF, but not in applications
 */
 #ifdef QP_IMPL
 
+    /* mark the group member AO as ready to run (no-op for other AOs) */
+    void QActive_groupReady_(QActive *const me);
+
+    /* post an event already referenced by the optimization layer */
+    bool QActive_postStaged_(QActive *const me, QEvt const *const e);
+
+    /* number of LIFO posts per AO, see QActive_setDrain() */
+    extern rt_uint32_t volatile QF_lifoCtr_[QF_MAX_ACTIVE + 1U];
+
+#ifdef QPC_USING_NATIVE_EQUEUE
+    /* native QF event queue operations, see NOTE1 */
+    #define QACTIVE_EQUEUE_WAIT_(me_) \
+        while ((me_)->eQueue.frontEvt == (QEvt *)0) { \
+            QF_CRIT_X_(); \
+            rt_event_recv(&(me_)->osObject, 1U, \
+                          RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR, \
+                          RT_WAITING_FOREVER, (rt_uint32_t *)0); \
+            QF_CRIT_E_(); \
+        }
+    #define QACTIVE_EQUEUE_SIGNAL_(me_) (QActive_signal_(me_))
+    #define QACTIVE_EQUEUE_LIFO_(me_)   (++QF_lifoCtr_[(me_)->prio])
+
+    /* wake up the thread (or the group) of the AO */
+    void QActive_signal_(QActive *const me);
+#endif /* QPC_USING_NATIVE_EQUEUE */
+
     #define QF_SCHED_STAT_
     #define QF_SCHED_LOCK_(prio_)   rt_enter_critical()
     #define QF_SCHED_UNLOCK_()      rt_exit_critical()
@@ -89,5 +233,22 @@ enum RT_Thread_ThreadAttrs {
 
 #endif /* ifdef QP_IMPL */
 
+/*****************************************************************************
+* NOTE1:
+* By default the AO event queues are RT-Thread mailboxes. Defining
+* QPC_USING_NATIVE_EQUEUE (e.g., in rtconfig.h) selects the native QF event
+* queues (QEQueue) instead, with an RT-Thread event object per AO to block
+* the AO thread on an empty queue, as the POSIX port does with a condition
+* variable. Posting then costs a QF critical section plus a kernel call only
+* when the queue was empty, QF_getQueueMin() reports the true low-watermarks
+* and the QS records carry the real nMin. This configuration needs
+* RT_USING_EVENT and compiles src/qf/qf_actq.c instead of the mailbox
+* variants of QActive_post_()/QActive_postLIFO_()/QActive_get_() in this port.
+* As the QF critical section only locks the scheduler, ISRs must post
+* through QF_postFromISR() in this configuration, and the QF clock tick
+* runs from an RT-Thread soft timer (in the timer thread), which requires
+* RT_USING_TIMER_SOFT (see qf_hooks.c).
+*/
+
 #endif /* QF_PORT_H */
 
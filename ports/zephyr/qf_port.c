@@ -45,6 +45,40 @@ Q_DEFINE_THIS_MODULE("qf_port")
 /*..........................................................................*/
 struct k_spinlock QF_spinlock;
 
+#ifdef QF_AO_TELEM
+static uint16_t l_queueMax[QF_MAX_ACTIVE + 1U]; /* queue high-water marks */
+
+/* update the queue high-water mark of the AO before posting an event
+* (in a critical section)
+*/
+#define ZEPHYR_QUEUE_HWM_(me_, n_) do { \
+    uint16_t const used_ = \
+        (uint16_t)(k_msgq_num_used_get(&(me_)->eQueue) + (n_)); \
+    if (l_queueMax[(me_)->prio] < used_) { \
+        l_queueMax[(me_)->prio] = used_; \
+    } \
+} while (false)
+#else
+#define ZEPHYR_QUEUE_HWM_(me_, n_) ((void)0)
+#endif /* QF_AO_TELEM */
+
+/* QF critical section in the event posting: with CONFIG_QPC_OBJ_LOCKS only
+* for the trace records, event tracking and the queue high-water marks,
+* see NOTE3 in qf_port.h
+*/
+#if (!defined CONFIG_QPC_OBJ_LOCKS) || (defined Q_SPY) \
+    || (defined QF_EVT_TRACK) || (defined QF_AO_TELEM)
+#define ZEPHYR_POST_CRIT_STAT_ QF_CRIT_STAT_
+#define ZEPHYR_POST_CRIT_E_()  QF_CRIT_E_()
+#define ZEPHYR_POST_CRIT_X_()  QF_CRIT_X_()
+#else
+#define ZEPHYR_POST_CRIT_STAT_
+#define ZEPHYR_POST_CRIT_E_()  ((void)0)
+#define ZEPHYR_POST_CRIT_X_()  ((void)0)
+#endif
+
+static void post_undo(QActive * const me, QEvt const * const e);
+
 /*..........................................................................*/
 void QF_init(void) {
     QF_spinlock = (struct k_spinlock){};
@@ -83,7 +117,8 @@ static void thread_entry(void *p1, void *p2, void *p3) {
     /* event-loop */
     for (;;) {  /* for-ever */
         QEvt const *e = QActive_get_(act);
-        QHSM_DISPATCH(&act->super, e, act->prio);
+        QS_REPLAY_REC(e, act->prio); /* record the event for replay */
+        QF_RTC_DISPATCH_(act, e, act->prio);
         QF_gc(e); /* check if the event is garbage, and collect it if so */
     }
 }
@@ -96,7 +131,9 @@ static void thread_entry(void *p1, void *p2, void *p3) {
 *
 * In this Zephyr port the attributes will be used as follows (see also
 * Active_start_()):
-* - attr1 - will be used for thread options in k_thread_create()
+* - attr1 - will be used for thread options in k_thread_create() (lower
+*           16 bits) and the CPU mask of the thread (upper 16 bits, see
+*           QF_CPU_MASK_ATTR() and NOTE4 in qf_port.h)
 * - attr2 - will be used for thread name in k_thread_name_set()
 */
 void QActive_setAttr(QActive *const me, uint32_t attr1, void const *attr2) {
@@ -123,7 +160,8 @@ void QActive_start_(QActive * const me, QPrioSpec const prioSpec,
     int zprio = (int)QF_MAX_ACTIVE - (int)me->prio;
 
     /* extract data temporarily saved in me->thread by QActive_setAttr() */
-    uint32_t opt = me->thread.base.order_key;
+    uint32_t const opt = me->thread.base.order_key & 0xFFFFU;
+    uint32_t const cpuMask = me->thread.base.order_key >> 16U;
 #ifdef CONFIG_THREAD_NAME
     char const *name = (char const *)me->thread.init_data;
 #endif
@@ -131,7 +169,7 @@ void QActive_start_(QActive * const me, QPrioSpec const prioSpec,
     /* clear the Zephyr thread structure before creating the thread */
     me->thread = (struct k_thread){};
 
-    /* create a Zephyr thread for the AO... */
+    /* create a Zephyr thread for the AO (a pinned thread starts below)... */
     k_thread_create(&me->thread,
                     (k_thread_stack_t *)stkSto,
                     (size_t)stkSize,
@@ -141,19 +179,38 @@ void QActive_start_(QActive * const me, QPrioSpec const prioSpec,
                     (void *)0,  /* p3 */
                     zprio,      /* Zephyr priority */
                     opt,        /* thread options */
-                    K_NO_WAIT); /* start immediately */
+                    (cpuMask != 0U) ? K_FOREVER : K_NO_WAIT);
 
 #ifdef CONFIG_THREAD_NAME
     /* set the Zephyr thread name, if initialized, or the default name "AO" */
     k_thread_name_set(&me->thread, (name != (char *)0) ? name : "AO");
 #endif
+
+    if (cpuMask != 0U) { /* pin the AO thread to the CPUs, see NOTE4 */
+#ifdef CONFIG_SCHED_CPU_MASK
+        /* the CPU mask must not contain nonexistent CPUs */
+        Q_ASSERT_ID(310, (cpuMask >> CONFIG_MP_NUM_CPUS) == 0U);
+
+        /* the CPU mask can be changed only before the thread starts */
+        Q_ALLEGE_ID(320, k_thread_cpu_mask_clear(&me->thread) == 0);
+        for (int cpu = 0; cpu < CONFIG_MP_NUM_CPUS; ++cpu) {
+            if ((cpuMask & (1U << cpu)) != 0U) {
+                Q_ALLEGE_ID(330,
+                    k_thread_cpu_mask_enable(&me->thread, cpu) == 0);
+            }
+        }
+        k_thread_start(&me->thread);
+#else
+        Q_ERROR_ID(300); /* CPU mask requires CONFIG_SCHED_CPU_MASK */
+#endif
+    }
 }
 /*..........................................................................*/
 bool QActive_post_(QActive * const me, QEvt const * const e,
                    uint_fast16_t const margin, void const * const sender)
 {
-    QF_CRIT_STAT_
-    QF_CRIT_E_();
+    ZEPHYR_POST_CRIT_STAT_
+    ZEPHYR_POST_CRIT_E_();
     uint_fast16_t nFree = (uint_fast16_t)k_msgq_num_free_get(&me->eQueue);
 
     bool status;
@@ -188,13 +245,19 @@ bool QActive_post_(QActive * const me, QEvt const * const e,
         if (e->poolId_ != 0U) { /* is it a pool event? */
             QEvt_refCtr_inc_(e); /* increment the reference counter */
         }
+        QF_EVT_TRACK_POST_(e, me->prio, sender); /* the AO holds e */
+        ZEPHYR_QUEUE_HWM_(me, 1U);
 
-        QF_CRIT_X_();
+        ZEPHYR_POST_CRIT_X_();
 
-        /* posting to the Zephyr message queue must succeed, see NOTE1 */
-        Q_ALLEGE_ID(520,
-                    k_msgq_put(&me->eQueue, (void const *)&e, K_NO_WAIT)
-                     == 0);
+        /* posting to the Zephyr message queue can fail only when the queue
+        * was filled concurrently (on SMP), see NOTE1
+        */
+        if (k_msgq_put(&me->eQueue, (void const *)&e, K_NO_WAIT) != 0) {
+            Q_ASSERT_ID(520, margin != QF_NO_MARGIN);
+            post_undo(me, e);
+            status = false;
+        }
     }
     else {
 
@@ -208,15 +271,15 @@ bool QActive_post_(QActive * const me, QEvt const * const e,
             QS_EQC_PRE_(0U);      /* min # free entries (unknown) */
         QS_END_NOCRIT_PRE_()
 
-        QF_CRIT_X_();
+        ZEPHYR_POST_CRIT_X_();
     }
 
     return status;
 }
 /*..........................................................................*/
 void QActive_postLIFO_(QActive * const me, QEvt const * const e) {
-    QF_CRIT_STAT_
-    QF_CRIT_E_();
+    ZEPHYR_POST_CRIT_STAT_
+    ZEPHYR_POST_CRIT_E_();
 
     QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_POST_LIFO, me->prio)
         QS_TIME_PRE_();       /* timestamp */
@@ -230,8 +293,10 @@ void QActive_postLIFO_(QActive * const me, QEvt const * const e) {
     if (e->poolId_ != 0U) { /* is it a pool event? */
         QEvt_refCtr_inc_(e); /* increment the reference counter */
     }
+    QF_EVT_TRACK_POST_(e, me->prio, (void *)0); /* the AO holds e */
+    ZEPHYR_QUEUE_HWM_(me, 1U);
 
-    QF_CRIT_X_();
+    ZEPHYR_POST_CRIT_X_();
 
     /* NOTE: Zephyr message queue does not currently support LIFO posting
     * so normal FIFO posting is used instead.
@@ -239,6 +304,132 @@ void QActive_postLIFO_(QActive * const me, QEvt const * const e) {
     Q_ALLEGE_ID(610, k_msgq_put(&me->eQueue, (void *)&e, K_NO_WAIT) == 0);
 }
 /*..........................................................................*/
+/*
+* QActive_postN_() posts the batch of events @p e[] to the AO @p me in
+* the FIFO order. The batch is posted either as a whole or not at all,
+* with a single check of the margin and a single QF critical section
+* (if any, see NOTE3 in qf_port.h) for all the events in the batch.
+*
+* NOTE: Zephyr message queue does not support putting several messages
+* at once, so the events are put one by one after the margin check.
+*/
+bool QActive_postN_(QActive * const me, QEvt const * const e[],
+                    uint_fast16_t const n, uint_fast16_t const margin,
+                    void const * const sender)
+{
+    /** @pre the batch must not be empty and must fit in the queue */
+    Q_REQUIRE_ID(800, (n > 0U) && (n <= (uint_fast16_t)me->eQueue.max_msgs));
+
+    ZEPHYR_POST_CRIT_STAT_
+    ZEPHYR_POST_CRIT_E_();
+    uint_fast16_t nFree = (uint_fast16_t)k_msgq_num_free_get(&me->eQueue);
+
+    bool status;
+    if (margin == QF_NO_MARGIN) {
+        if (nFree >= n) {
+            status = true; /* can post */
+        }
+        else {
+            status = false; /* cannot post */
+            Q_ERROR_ID(810); /* must be able to post the events */
+        }
+    }
+    else if (nFree >= (uint_fast16_t)(margin + n)) {
+        status = true; /* can post */
+    }
+    else {
+        status = false; /* cannot post */
+    }
+
+    for (uint_fast16_t i = 0U; i < n; ++i) {
+        if (status) { /* can post the events? */
+
+            QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_POST, me->prio)
+                QS_TIME_PRE_();      /* timestamp */
+                QS_OBJ_PRE_(sender); /* the sender object */
+                QS_SIG_PRE_(e[i]->sig); /* the signal of the event */
+                QS_OBJ_PRE_(me);     /* this active object (recipient) */
+                QS_2U8_PRE_(e[i]->poolId_, e[i]->refCtr_);
+                QS_EQC_PRE_(nFree - i); /* # free entries available */
+                QS_EQC_PRE_(0U);     /* min # free entries (unknown) */
+            QS_END_NOCRIT_PRE_()
+
+            if (e[i]->poolId_ != 0U) { /* is it a pool event? */
+                QEvt_refCtr_inc_(e[i]); /* increment the reference counter */
+            }
+            QF_EVT_TRACK_POST_(e[i], me->prio, sender); /* the AO holds e */
+        }
+        else {
+
+            QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_POST_ATTEMPT, me->prio)
+                QS_TIME_PRE_();      /* timestamp */
+                QS_OBJ_PRE_(sender); /* the sender object */
+                QS_SIG_PRE_(e[i]->sig); /* the signal of the event */
+                QS_OBJ_PRE_(me);     /* this active object (recipient) */
+                QS_2U8_PRE_(e[i]->poolId_, e[i]->refCtr_);
+                QS_EQC_PRE_(nFree);  /* # free entries available */
+                QS_EQC_PRE_(0U);     /* min # free entries (unknown) */
+            QS_END_NOCRIT_PRE_()
+        }
+    }
+    if (status) {
+        ZEPHYR_QUEUE_HWM_(me, n);
+    }
+
+    ZEPHYR_POST_CRIT_X_();
+
+    for (uint_fast16_t i = 0U; status && (i < n); ++i) {
+        /* posting to the Zephyr message queue can fail only when the queue
+        * was filled concurrently (on SMP), see NOTE1
+        */
+        if (k_msgq_put(&me->eQueue, (void const *)&e[i], K_NO_WAIT) != 0) {
+            Q_ASSERT_ID(820, margin != QF_NO_MARGIN);
+            for (; i < n; ++i) { /* the rest of the batch is not posted */
+                post_undo(me, e[i]);
+            }
+            status = false;
+        }
+    }
+
+    return status;
+}
+/*..........................................................................*/
+/* undo the posting of the event @p e that did not fit in the queue */
+static void post_undo(QActive * const me, QEvt const * const e) {
+    if (e->poolId_ != 0U) { /* is it a pool event? */
+        QEvt_refCtr_dec_(e); /* the AO does not hold the event */
+    }
+#ifdef QF_EVT_TRACK
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+    QF_evtTrackRelease_(e, me->prio);
+    QF_CRIT_X_();
+#else
+    Q_UNUSED_PAR(me);
+#endif
+}
+#ifdef QF_AO_TELEM
+/*..........................................................................*/
+void QActive_getPortTelem_(QActive const * const me,
+                           QActiveTelem * const telem)
+{
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+    telem->queueSize = (uint16_t)me->eQueue.max_msgs;
+    telem->queueMax  = l_queueMax[me->prio];
+    QF_CRIT_X_();
+
+#if defined(CONFIG_THREAD_STACK_INFO) && defined(CONFIG_INIT_STACKS)
+    /* Zephyr scans the stack painted at the thread creation */
+    size_t unused;
+    if (k_thread_stack_space_get(&me->thread, &unused) == 0) {
+        telem->stackSize = (uint32_t)me->thread.stack_info.size;
+        telem->stackUsed = (uint32_t)(me->thread.stack_info.size - unused);
+    }
+#endif
+}
+#endif /* QF_AO_TELEM */
+/*..........................................................................*/
 QEvt const *QActive_get_(QActive * const me) {
     QEvt const *e;
     QS_CRIT_STAT_
@@ -256,3 +447,122 @@ QEvt const *QActive_get_(QActive * const me) {
 
     return e;
 }
+
+#ifdef CONFIG_QPC_OBJ_LOCKS
+/*==========================================================================*/
+/* QF event pools on Zephyr memory slabs, see NOTE3 in qf_port.h
+*
+* The number of free blocks is reserved with an atomic compare-and-swap
+* *before* the block is allocated from the slab (and released only *after*
+* the block is freed), so the allocation within the reservation cannot
+* fail and the margin is checked exactly, without any additional lock.
+*/
+void QSlabPool_init(QSlabPool * const me, void * const poolSto,
+                    uint_fast32_t const poolSize,
+                    uint_fast16_t const blockSize)
+{
+    /** @pre the pool storage must be provided and aligned at the pointer
+    * boundary and the block size must not overflow when rounded up
+    */
+    Q_REQUIRE_ID(900, (poolSto != (void *)0)
+        && (((uintptr_t)poolSto & (sizeof(void *) - 1U)) == 0U)
+        && ((uint_fast16_t)(blockSize + sizeof(void *)) > blockSize));
+
+    /* round up the blockSize to the multiple of the pointer size */
+    uint_fast16_t size = (uint_fast16_t)sizeof(void *);
+    while (size < blockSize) {
+        size += (uint_fast16_t)sizeof(void *);
+    }
+    uint_fast32_t const n = poolSize / size;
+
+    /* the storage must fit at least one block and the block size and
+    * count must fit the pool counters
+    */
+    Q_ASSERT_ID(910, (n > 0U)
+        && ((uint_fast32_t)(QMPoolCtr)n == n)
+        && ((uint_fast16_t)(QMPoolSize)size == size));
+
+    Q_ALLEGE_ID(920, k_mem_slab_init(&me->slab, poolSto,
+                                     (size_t)size, (uint32_t)n) == 0);
+
+    me->start     = poolSto;
+    me->end       = (uint8_t *)poolSto + ((n - 1U) * size);
+    me->blockSize = (QMPoolSize)size;
+    me->nTot      = (QMPoolCtr)n;
+    me->nFree     = (QMPoolCtr)n;
+    me->nMin      = (QMPoolCtr)n;
+}
+/*..........................................................................*/
+void *QSlabPool_get(QSlabPool * const me, uint_fast16_t const margin,
+                    uint_fast8_t const qs_id)
+{
+    QS_CRIT_STAT_
+    Q_UNUSED_PAR(qs_id);
+
+    /* reserve one of the free blocks above the margin... */
+    QMPoolCtr nFree = __atomic_load_n(&me->nFree, __ATOMIC_RELAXED);
+    bool reserved = false;
+    while ((!reserved) && (nFree > (QMPoolCtr)margin)) {
+        reserved = __atomic_compare_exchange_n(&me->nFree, &nFree,
+            (QMPoolCtr)(nFree - 1U), false,
+            __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+    }
+
+    void *b = (void *)0;
+    if (reserved) {
+        /* is the number of free blocks the new minimum so far? */
+        QMPoolCtr const n = (QMPoolCtr)(nFree - 1U);
+        QMPoolCtr nMin = __atomic_load_n(&me->nMin, __ATOMIC_RELAXED);
+        while ((n < nMin)
+               && (!__atomic_compare_exchange_n(&me->nMin, &nMin, n, false,
+                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)))
+        {
+        }
+
+        /* a block was reserved, so the slab cannot be empty */
+        Q_ALLEGE_ID(930, k_mem_slab_alloc(&me->slab, &b, K_NO_WAIT) == 0);
+
+        QS_BEGIN_PRE_(QS_QF_MPOOL_GET, qs_id)
+            QS_TIME_PRE_();         /* timestamp */
+            QS_OBJ_PRE_(me);        /* this memory pool */
+            QS_MPC_PRE_(n);         /* # of free blocks in the pool */
+            QS_MPC_PRE_(me->nMin);  /* min # free blocks ever in the pool */
+        QS_END_PRE_()
+    }
+    else {
+        QS_BEGIN_PRE_(QS_QF_MPOOL_GET_ATTEMPT, qs_id)
+            QS_TIME_PRE_();         /* timestamp */
+            QS_OBJ_PRE_(me);        /* this memory pool */
+            QS_MPC_PRE_(nFree);     /* # of free blocks in the pool */
+            QS_MPC_PRE_(margin);    /* the requested margin */
+        QS_END_PRE_()
+    }
+    return b; /* return the pointer to memory block or NULL to the caller */
+}
+/*..........................................................................*/
+void QSlabPool_put(QSlabPool * const me, void * const b,
+                   uint_fast8_t const qs_id)
+{
+    QS_CRIT_STAT_
+    Q_UNUSED_PAR(qs_id);
+
+    /** @pre # free blocks cannot exceed the total # blocks and
+    * the block pointer must be from this pool.
+    */
+    Q_REQUIRE_ID(1000, (__atomic_load_n(&me->nFree, __ATOMIC_RELAXED)
+                        < me->nTot)
+                       && (me->start <= b) && (b <= me->end));
+
+    void *blk = b;
+    k_mem_slab_free(&me->slab, &blk); /* Zephyr 3.2 API */
+
+    /* ...and only then make the block available for reservation */
+    (void)__atomic_add_fetch(&me->nFree, 1U, __ATOMIC_RELEASE);
+
+    QS_BEGIN_PRE_(QS_QF_MPOOL_PUT, qs_id)
+        QS_TIME_PRE_();         /* timestamp */
+        QS_OBJ_PRE_(me);        /* this memory pool */
+        QS_MPC_PRE_(me->nFree); /* the number of free blocks in the pool */
+    QS_END_PRE_()
+}
+#endif /* CONFIG_QPC_OBJ_LOCKS */
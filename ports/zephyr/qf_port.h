@@ -47,6 +47,11 @@
 #define QF_CRIT_ENTRY(key_)  ((key_) = k_spin_lock(&QF_spinlock))
 #define QF_CRIT_EXIT(key_)   (k_spin_unlock(&QF_spinlock, (key_)))
 
+#ifdef CONFIG_QPC_OBJ_LOCKS
+/* event refCtr adjusted also outside the QF critical section, see NOTE3 */
+#define QF_EVT_REFCTR_ATOMIC
+#endif
+
 #include <zephyr/kernel.h>   /* Zephyr kernel API */
 #include "qep_port.h"        /* QEP port */
 #include "qequeue.h"         /* used for event deferral */
@@ -56,6 +61,53 @@
 /* Zephyr spinlock for QF critical section */
 extern struct k_spinlock QF_spinlock;
 
+/* Zephyr thread options (attr1 of QActive_setAttr()) extended with the
+* mask of CPUs the AO thread can run on (bit n for CPU n), see NOTE4
+*/
+#define QF_CPU_MASK_ATTR(mask_)  ((uint32_t)(mask_) << 16U)
+
+/* post a batch of events to the AO @p me_ with one margin check,
+* see QActive_postN_()
+*/
+#ifdef Q_SPY
+    #define QACTIVE_POST_N(me_, e_, n_, margin_, sender_) \
+        (QActive_postN_((me_), (e_), (n_), (margin_), (sender_)))
+#else
+    #define QACTIVE_POST_N(me_, e_, n_, margin_, dummy) \
+        (QActive_postN_((me_), (e_), (n_), (margin_), (void *)0))
+#endif
+
+/* this function only to be used through the macro QACTIVE_POST_N() */
+bool QActive_postN_(QActive * const me, QEvt const * const e[],
+                    uint_fast16_t const n, uint_fast16_t const margin,
+                    void const * const sender);
+
+#ifdef CONFIG_QPC_OBJ_LOCKS
+/*! QF event pool on a Zephyr memory slab (object-scoped lock, NOTE3)
+*
+* @details
+* The members other than @c slab have the same meaning as in ::QMPool,
+* so the pool statistics and the event tracker in QF work unchanged.
+*/
+typedef struct {
+    struct k_mem_slab slab;   /*!< Zephyr memory slab (with its own lock) */
+    void *start;              /*!< start of the pool storage */
+    void *end;                /*!< last block in the pool storage */
+    QMPoolSize blockSize;     /*!< block size [bytes] */
+    QMPoolCtr nTot;           /*!< total number of blocks */
+    QMPoolCtr volatile nFree; /*!< number of free blocks (not reserved) */
+    QMPoolCtr volatile nMin;  /*!< minimum number of free blocks */
+} QSlabPool;
+
+void QSlabPool_init(QSlabPool * const me, void * const poolSto,
+                    uint_fast32_t const poolSize,
+                    uint_fast16_t const blockSize);
+void *QSlabPool_get(QSlabPool * const me, uint_fast16_t const margin,
+                    uint_fast8_t const qs_id);
+void QSlabPool_put(QSlabPool * const me, void * const b,
+                   uint_fast8_t const qs_id);
+#endif /* CONFIG_QPC_OBJ_LOCKS */
+
 /* Q_PRINTK() macro to avoid conflicts with Zephyr's printk()
 * when Q_SPY configuation is used
 */
@@ -74,6 +126,7 @@ extern struct k_spinlock QF_spinlock;
     #define QF_SCHED_LOCK_(dummy) (k_sched_lock())
     #define QF_SCHED_UNLOCK_()    (k_sched_unlock())
 
+#ifndef CONFIG_QPC_OBJ_LOCKS
     /* native QF event-pool customization... */
     #define QF_EPOOL_TYPE_            QMPool
     #define QF_EPOOL_INIT_(p_, poolSto_, poolSize_, evtSize_) \
@@ -83,6 +136,17 @@ extern struct k_spinlock QF_spinlock;
         ((e_) = (QEvt *)QMPool_get(&(p_), (m_), (qs_id_)))
     #define QF_EPOOL_PUT_(p_, e_, qs_id_) \
         (QMPool_put(&(p_), (e_), (qs_id_)))
+#else
+    /* QF event pools on Zephyr memory slabs, see NOTE3 */
+    #define QF_EPOOL_TYPE_            QSlabPool
+    #define QF_EPOOL_INIT_(p_, poolSto_, poolSize_, evtSize_) \
+        (QSlabPool_init(&(p_), (poolSto_), (poolSize_), (evtSize_)))
+    #define QF_EPOOL_EVENT_SIZE_(p_)  ((uint_fast16_t)(p_).blockSize)
+    #define QF_EPOOL_GET_(p_, e_, m_, qs_id_) \
+        ((e_) = (QEvt *)QSlabPool_get(&(p_), (m_), (qs_id_)))
+    #define QF_EPOOL_PUT_(p_, e_, qs_id_) \
+        (QSlabPool_put(&(p_), (e_), (qs_id_)))
+#endif /* CONFIG_QPC_OBJ_LOCKS */
 
 #endif /* QP_IMPL */
 
@@ -97,6 +161,25 @@ extern struct k_spinlock QF_spinlock;
 * NOTE2:
 * Zephyr does not support selective scheduler locking up to a given
 * priority ceiling. Therefore, this port uses global Zephyr scheduler lock.
+*
+* NOTE3:
+* With CONFIG_QPC_OBJ_LOCKS (default on SMP), event posting relies only on
+* the lock of the Zephyr message queue of the recipient, and the QF event
+* pools are Zephyr memory slabs (::QSlabPool), each with its own lock.
+* The event reference counters are then adjusted atomically everywhere
+* (QF_EVT_REFCTR_ATOMIC). The global QF spinlock is still taken in the
+* posting for the optional QS trace records, the event tracker
+* (QF_EVT_TRACK) and the queue high-water marks (QF_AO_TELEM), and it
+* still protects the time events, the subscriber lists and the recycling
+* of events in QF_gc().
+*
+* NOTE4:
+* The CPU mask in the upper 16 bits of attr1 of QActive_setAttr() pins
+* the AO thread to the given CPUs with the k_thread_cpu_mask_*() API,
+* which requires CONFIG_SCHED_CPU_MASK. The mask 0 (default) lets the
+* thread run on any CPU. For example, to pin an AO to CPU 1:
+*
+* QActive_setAttr(&ao, QF_CPU_MASK_ATTR(1U << 1U) | K_FP_REGS, "AO");
 */
 
 #endif /* QF_PORT_H */
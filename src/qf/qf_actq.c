@@ -119,6 +119,7 @@ bool QActive_post_(QActive * const me,
         if (me->eQueue.nMin > nFree) {
             me->eQueue.nMin = nFree; /* increase minimum so far */
         }
+        QF_EVT_TRACK_POST_(e, me->prio, sender); /* the AO holds e */
 
         QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_POST, me->prio)
             QS_TIME_PRE_();               /* timestamp */
@@ -214,6 +215,7 @@ void QActive_postLIFO_(QActive * const me,
     if (e->poolId_ != 0U) {
         QEvt_refCtr_inc_(e); /* increment the reference counter */
     }
+    QF_EVT_TRACK_POST_(e, me->prio, (void *)0); /* the AO holds e */
 
     --nFree; /* one free entry just used up */
     me->eQueue.nFree = nFree; /* update the original */
@@ -257,6 +259,10 @@ void QActive_postLIFO_(QActive * const me,
 
         me->eQueue.ring[me->eQueue.tail] = frontEvt;
     }
+
+    #ifdef QACTIVE_EQUEUE_LIFO_
+    QACTIVE_EQUEUE_LIFO_(me); /* let the port account for the LIFO post */
+    #endif
     QF_CRIT_X_();
 }
 /*$enddef${QF::QActive::postLIFO_} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
@@ -309,6 +315,67 @@ QEvt const * QActive_get_(QActive * const me) {
     return e;
 }
 /*$enddef${QF::QActive::get_} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+/*$define${QF::QActive::getN_} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+
+/*${QF::QActive::getN_} ....................................................*/
+/*! @private @memberof QActive */
+uint_fast16_t QActive_getN_(QActive * const me,
+    QEvt const * evts[],
+    uint_fast16_t const nMax)
+{
+    Q_REQUIRE_ID(350, nMax > 0U);
+
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+    QACTIVE_EQUEUE_WAIT_(me);  /* wait for event to arrive directly */
+
+    uint_fast16_t n = 0U;
+    QEQueueCtr nFree = me->eQueue.nFree; /* get volatile into tmp */
+    do {
+        /* always remove event from the front */
+        QEvt const * const e = me->eQueue.frontEvt;
+        evts[n] = e;
+        ++n;
+        ++nFree;
+
+        /* any events in the ring buffer? */
+        if (nFree <= me->eQueue.end) {
+
+            /* remove event from the tail */
+            me->eQueue.frontEvt = me->eQueue.ring[me->eQueue.tail];
+            if (me->eQueue.tail == 0U) { /* need to wrap the tail? */
+                me->eQueue.tail = me->eQueue.end;   /* wrap around */
+            }
+            --me->eQueue.tail;
+
+            QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_GET, me->prio)
+                QS_TIME_PRE_();      /* timestamp */
+                QS_SIG_PRE_(e->sig); /* the signal of this event */
+                QS_OBJ_PRE_(me);     /* this active object */
+                QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+                QS_EQC_PRE_(nFree);  /* # free entries */
+            QS_END_NOCRIT_PRE_()
+        }
+        else {
+            me->eQueue.frontEvt = (QEvt *)0; /* queue becomes empty */
+
+            /* all entries in the queue must be free (+1 for fronEvt) */
+            Q_ASSERT_CRIT_(360, nFree == (me->eQueue.end + 1U));
+
+            QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_GET_LAST, me->prio)
+                QS_TIME_PRE_();      /* timestamp */
+                QS_SIG_PRE_(e->sig); /* the signal of this event */
+                QS_OBJ_PRE_(me);     /* this active object */
+                QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+            QS_END_NOCRIT_PRE_()
+        }
+    } while ((n < nMax) && (me->eQueue.frontEvt != (QEvt *)0));
+    me->eQueue.nFree = nFree; /* update the number of free */
+    QF_CRIT_X_();
+
+    return n;
+}
+/*$enddef${QF::QActive::getN_} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 
 /*$define${QF::QF-base::getQueueMin} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 
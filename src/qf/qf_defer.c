@@ -37,7 +37,8 @@
 */
 /*$endhead${src::qf::qf_defer.c} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 /*! @file
-* @brief QActive_defer() and QActive_recall() implementation.
+* @brief QActive_defer() and QActive_recall() implementation,
+* priority-ordered deferred queues (::QDeferQueue).
 */
 #define QP_IMPL           /* this is QP implementation */
 #include "qf_port.h"      /* QF port */
@@ -70,6 +71,15 @@ bool QActive_defer(QActive const * const me,
     bool const status = QEQueue_post(eq, e, 0U, me->prio);
     QS_CRIT_STAT_
 
+    #ifdef QF_EVT_TRACK
+    if (status) {
+        QF_CRIT_STAT_
+        QF_CRIT_E_();
+        QF_evtTrackPost_(e, me->prio, (void *)0); /* the AO holds e */
+        QF_CRIT_X_();
+    }
+    #endif
+
     QS_BEGIN_PRE_(QS_QF_ACTIVE_DEFER, me->prio)
         QS_TIME_PRE_();      /* time stamp */
         QS_OBJ_PRE_(me);     /* this active object */
@@ -160,3 +170,533 @@ uint_fast16_t QActive_flushDeferred(QActive const * const me,
     return n;
 }
 /*$enddef${QF::QActive::flushDeferred} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+
+/*==========================================================================*/
+Q_ASSERT_STATIC(QF_DEFER_BUCKETS <= (8U * sizeof(QPSetBits)));
+
+/*..........................................................................*/
+/*! @public @memberof QDeferQueue */
+void QDeferQueue_init(QDeferQueue * const me,
+    QDeferSlot * const slots,
+    uint_fast16_t const nSlots,
+    uint_fast8_t const nBuckets)
+{
+    Q_REQUIRE_ID(300, (slots != (QDeferSlot *)0)
+                      && (nSlots > 0U) && (nSlots <= 0xFFFFU)
+                      && (nBuckets > 0U) && (nBuckets <= QF_DEFER_BUCKETS));
+
+    for (uint_fast8_t b = 0U; b < QF_DEFER_BUCKETS; ++b) {
+        me->head[b] = (QDeferSlot *)0;
+        me->tail[b] = (QDeferSlot *)0;
+        me->nUsed[b] = 0U;
+    }
+    me->freeList = (QDeferSlot *)0;
+    for (uint_fast16_t i = nSlots; i > 0U; --i) { /* chain the free slots */
+        slots[i - 1U].e    = (QEvt *)0;
+        slots[i - 1U].next = me->freeList;
+        slots[i - 1U].ttl  = false;
+        me->freeList = &slots[i - 1U];
+    }
+    me->bits     = 0U;
+    me->nFree    = (uint16_t)nSlots;
+    me->nMin     = (uint16_t)nSlots;
+    me->nBuckets = (uint8_t)nBuckets;
+    me->tickRate = 0U;
+    me->expSig   = 0;
+    me->nExpired = 0U;
+}
+/*..........................................................................*/
+/*! @public @memberof QDeferQueue */
+void QDeferQueue_setExpiry(QDeferQueue * const me,
+    uint_fast8_t const tickRate,
+    enum_t const expSig)
+{
+    Q_REQUIRE_ID(350, tickRate < (uint_fast8_t)QF_MAX_TICK_RATE);
+
+    me->tickRate = (uint8_t)tickRate;
+    me->expSig   = expSig;
+}
+/*..........................................................................*/
+/*! @public @memberof QDeferQueue */
+uint_fast16_t QDeferQueue_getCount(QDeferQueue const * const me,
+    uint_fast8_t const bucket)
+{
+    Q_REQUIRE_ID(400, bucket < (uint_fast8_t)me->nBuckets);
+
+    return (uint_fast16_t)me->nUsed[bucket];
+}
+
+/*..........................................................................*/
+/* unlink the oldest slot from the given non-empty bucket */
+static QDeferSlot *QDeferQueue_take_(QDeferQueue * const me,
+    uint_fast8_t const bucket)
+{
+    QDeferSlot * const s = me->head[bucket];
+    me->head[bucket] = s->next;
+    --me->nUsed[bucket];
+    if (s->next == (QDeferSlot *)0) { /* bucket became empty? */
+        me->tail[bucket] = (QDeferSlot *)0;
+        me->bits &= (QPSetBits)~((QPSetBits)1U << bucket);
+    }
+    return s;
+}
+/*..........................................................................*/
+/* return the slot to the free list */
+static void QDeferQueue_free_(QDeferQueue * const me, QDeferSlot * const s) {
+    s->e    = (QEvt *)0;
+    s->ttl  = false;
+    s->next = me->freeList;
+    me->freeList = s;
+    ++me->nFree;
+}
+/*..........................................................................*/
+/* current tick counter of the time-to-live of the deferred events */
+static QTimeEvtCtr QDeferQueue_now_(QDeferQueue const * const me) {
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+    QTimeEvtCtr const now = QTimeEvt_timeEvtHead_[me->tickRate].ctr;
+    QF_CRIT_X_();
+    return now;
+}
+/*..........................................................................*/
+/* has the deferred event in the slot 's' expired at the tick 'now'? */
+static bool QDeferSlot_isExpired_(QDeferSlot const * const s,
+    QTimeEvtCtr const now)
+{
+    return s->ttl
+        && ((QTimeEvtCtr)(now - s->deadline)
+            <= (QTimeEvtCtr)((QTimeEvtCtr)~0U >> 1U));
+}
+/*..........................................................................*/
+/* expire the event 'e' taken from 'dq', returns the notification with the
+* 'expSig' signal to be recalled instead, or NULL
+*/
+static QEvt const *QDeferQueue_expire_(QDeferQueue * const me,
+    QEvt const * const e)
+{
+    QEvt const *x = (QEvt *)0;
+
+    ++me->nExpired;
+
+#if (QF_MAX_EPOOL > 0U)
+    if (me->expSig != 0) {
+        if (e->poolId_ != 0U) { /* dynamic event? */
+            uint_fast16_t const size =
+                QF_EPOOL_EVENT_SIZE_(QF_ePool_[e->poolId_ - 1U]);
+            QEvt * const c = QF_newX_(size, 0U, me->expSig); /* may fail */
+            if (c != (QEvt *)0) { /* copy the parameters of the event */
+                uint8_t const *src = (uint8_t const *)e + sizeof(QEvt);
+                uint8_t *dst = (uint8_t *)c + sizeof(QEvt);
+                for (uint_fast16_t n = size - sizeof(QEvt); n > 0U; --n) {
+                    *dst = *src;
+                    ++dst;
+                    ++src;
+                }
+                x = c;
+            }
+        }
+        else { /* the size of an immutable event is unknown, see NOTE3 */
+            x = QF_newX_(sizeof(QEvt), 0U, me->expSig); /* may fail */
+        }
+    }
+    QF_gc(e); /* release the reference held by the deferred queue */
+#else
+    Q_UNUSED_PAR(e);
+#endif
+
+    return x;
+}
+/*..........................................................................*/
+/* post the events chained from 'rev' to the front of the AO's queue, the
+* last recalled one first, so that the AO processes them in the order of
+* recalling, and hand over the references held by the deferred queue
+*/
+static void QActive_recallPost_(QActive * const me,
+    QDeferQueue const * const dq,
+    QDeferSlot const * const rev)
+{
+    Q_UNUSED_PAR(dq); /* used only in the QS trace records */
+
+    QF_CRIT_STAT_
+
+#ifdef QACTIVE_EQUEUE_SIGNAL_ /* native QF event queue? see NOTE2 */
+    QF_CRIT_E_();
+    QEQueueCtr nFree = me->eQueue.nFree; /* get volatile into temporary */
+    QEvt const *frontEvt = me->eQueue.frontEvt;
+    bool const wasEmpty = (frontEvt == (QEvt *)0);
+    for (QDeferSlot const *s = rev; s != (QDeferSlot *)0; s = s->next) {
+        QEvt const * const e = s->e;
+
+        /* the AO's event queue must accept all the recalled events */
+        Q_REQUIRE_CRIT_(700, nFree != 0U);
+
+        /* is it a dynamic event? */
+        if (e->poolId_ != 0U) {
+            /* the reference of the deferred queue becomes the reference
+            * of the AO's event queue, so the counter stays as it is
+            */
+            Q_ASSERT_CRIT_(710, e->refCtr_ != 0U);
+        }
+        QF_EVT_TRACK_POST_(e, me->prio, (void *)0); /* the AO holds e */
+
+        --nFree; /* one free entry just used up */
+        if (me->eQueue.nMin > nFree) {
+            me->eQueue.nMin = nFree; /* update minimum so far */
+        }
+
+        QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_POST_LIFO, me->prio)
+            QS_TIME_PRE_();      /* timestamp */
+            QS_SIG_PRE_(e->sig); /* the signal of this event */
+            QS_OBJ_PRE_(me);     /* this active object */
+            QS_2U8_PRE_(e->poolId_, e->refCtr_);/* pool Id & ref Count */
+            QS_EQC_PRE_(nFree);  /* # free entries */
+            QS_EQC_PRE_(me->eQueue.nMin); /* min number of free entries */
+        QS_END_NOCRIT_PRE_()
+
+    #ifdef Q_UTEST
+        if (QS_LOC_CHECK_(me->prio)) {
+            QS_onTestPost((QActive *)0, me, e, true);
+        }
+    #endif
+
+        /* the previous front event goes to the ring-buffer */
+        if (frontEvt != (QEvt *)0) {
+            ++me->eQueue.tail;
+            /* need to wrap the tail? */
+            if (me->eQueue.tail == me->eQueue.end) {
+                me->eQueue.tail = 0U; /* wrap around */
+            }
+            me->eQueue.ring[me->eQueue.tail] = frontEvt;
+        }
+        frontEvt = e; /* deliver the event directly to the front */
+
+    #ifdef QACTIVE_EQUEUE_LIFO_
+        QACTIVE_EQUEUE_LIFO_(me); /* let the port account for the LIFO post */
+    #endif
+
+        QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_RECALL, me->prio)
+            QS_TIME_PRE_();      /* time stamp */
+            QS_OBJ_PRE_(me);     /* this active object */
+            QS_OBJ_PRE_(dq);     /* the deferred queue */
+            QS_SIG_PRE_(e->sig); /* the signal of the event */
+            QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+        QS_END_NOCRIT_PRE_()
+    }
+    me->eQueue.frontEvt = frontEvt;
+    me->eQueue.nFree = nFree; /* update the original */
+
+    /* was the queue empty? */
+    if (wasEmpty && (frontEvt != (QEvt *)0)) {
+        QACTIVE_EQUEUE_SIGNAL_(me); /* signal the event queue */
+    }
+    QF_CRIT_X_();
+
+#else /* the AO's event queue is provided by the port */
+
+    for (QDeferSlot const *s = rev; s != (QDeferSlot *)0; s = s->next) {
+        QACTIVE_POST_LIFO(me, s->e);
+    }
+
+    QF_CRIT_E_();
+    for (QDeferSlot const *s = rev; s != (QDeferSlot *)0; s = s->next) {
+        QEvt const * const e = s->e;
+
+        /* is it a dynamic event? */
+        if (e->poolId_ != 0U) {
+
+            /* after posting to the AO's queue the event must be referenced
+            * at least twice: once in the deferred queue and once in the
+            * AO's event queue.
+            */
+            Q_ASSERT_CRIT_(720, e->refCtr_ >= 2U);
+
+            /* hand over the reference of the deferred queue */
+            QEvt_refCtr_dec_(e);
+        }
+
+        QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_RECALL, me->prio)
+            QS_TIME_PRE_();      /* time stamp */
+            QS_OBJ_PRE_(me);     /* this active object */
+            QS_OBJ_PRE_(dq);     /* the deferred queue */
+            QS_SIG_PRE_(e->sig); /* the signal of the event */
+            QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+        QS_END_NOCRIT_PRE_()
+    }
+    QF_CRIT_X_();
+#endif /* QACTIVE_EQUEUE_SIGNAL_ */
+}
+/*..........................................................................*/
+/* recall up to 'nMax' events from the 'bucket' of 'dq', or from the highest
+* non-empty buckets when 'bucket' is QF_DEFER_BUCKETS
+*/
+static uint_fast16_t QActive_recallBatch_(QActive * const me,
+    QDeferQueue * const dq,
+    uint_fast8_t const bucket,
+    uint_fast16_t const nMax)
+{
+    /* unlink the events, chaining them in the reverse order */
+    QDeferSlot *rev = (QDeferSlot *)0;
+    uint_fast16_t n = 0U;
+    QTimeEvtCtr now = 0U;
+    bool haveNow = false;
+    while (n < nMax) {
+        uint_fast8_t b = bucket;
+        if (b == QF_DEFER_BUCKETS) { /* the highest non-empty bucket? */
+            if (dq->bits == 0U) {
+                break;
+            }
+            b = (uint_fast8_t)(QF_LOG2(dq->bits) - 1U);
+        }
+        else if (dq->head[b] == (QDeferSlot *)0) {
+            break;
+        }
+        else {
+            /* take from the given bucket */
+        }
+        QDeferSlot * const s = QDeferQueue_take_(dq, b);
+        if (s->ttl) {
+            if (!haveNow) {
+                now = QDeferQueue_now_(dq);
+                haveNow = true;
+            }
+            if (QDeferSlot_isExpired_(s, now)) {
+                s->e = QDeferQueue_expire_(dq, s->e);
+                if (s->e == (QEvt *)0) { /* expired event discarded? */
+                    QDeferQueue_free_(dq, s);
+                    continue;
+                }
+                /* the fresh copy is referenced as if it was deferred */
+                QEvt_refCtr_inc_(s->e);
+            }
+        }
+        s->next = rev;
+        rev = s;
+        ++n;
+    }
+
+    QActive_recallPost_(me, dq, rev);
+
+    while (rev != (QDeferSlot *)0) { /* free the slots */
+        QDeferSlot * const next = rev->next;
+        QDeferQueue_free_(dq, rev);
+        rev = next;
+    }
+    return n;
+}
+
+/*..........................................................................*/
+/*! @protected @memberof QActive */
+uint_fast16_t QActive_expireDeferred(QActive * const me,
+    QDeferQueue * const dq)
+{
+    QTimeEvtCtr const now = QDeferQueue_now_(dq);
+    uint_fast16_t n = 0U;
+    for (uint_fast8_t b = 0U; b < (uint_fast8_t)dq->nBuckets; ++b) {
+        QDeferSlot *prev = (QDeferSlot *)0;
+        QDeferSlot *s = dq->head[b];
+        while (s != (QDeferSlot *)0) {
+            QDeferSlot * const next = s->next;
+            if (QDeferSlot_isExpired_(s, now)) {
+                /* unlink the expired slot from the bucket */
+                if (prev == (QDeferSlot *)0) {
+                    (void)QDeferQueue_take_(dq, b);
+                }
+                else {
+                    prev->next = next;
+                    if (next == (QDeferSlot *)0) { /* was the tail? */
+                        dq->tail[b] = prev;
+                    }
+                    --dq->nUsed[b];
+                }
+                QEvt const * const c = QDeferQueue_expire_(dq, s->e);
+                QDeferQueue_free_(dq, s);
+                if (c != (QEvt *)0) {
+                    QACTIVE_POST_LIFO(me, c); /* recall the notification */
+                }
+                ++n;
+            }
+            else {
+                prev = s;
+            }
+            s = next;
+        }
+    }
+    return n;
+}
+/*..........................................................................*/
+/*! @protected @memberof QActive */
+bool QActive_deferKey(QActive * const me,
+    QDeferQueue * const dq,
+    QEvt const * const e,
+    uint_fast8_t const bucket)
+{
+    return QActive_deferTTL(me, dq, e, bucket, 0U);
+}
+/*..........................................................................*/
+/*! @protected @memberof QActive */
+bool QActive_deferTTL(QActive * const me,
+    QDeferQueue * const dq,
+    QEvt const * const e,
+    uint_fast8_t const bucket,
+    QTimeEvtCtr const ttl)
+{
+    Q_REQUIRE_ID(500, (bucket < (uint_fast8_t)dq->nBuckets)
+        && (ttl <= (QTimeEvtCtr)((QTimeEvtCtr)~0U >> 1U)));
+
+    QTimeEvtCtr const now = (ttl != 0U) ? QDeferQueue_now_(dq) : 0U;
+
+    if (dq->freeList == (QDeferSlot *)0) { /* no free slots? */
+        /* make room by expiring the stale events, see NOTE1 */
+        (void)QActive_expireDeferred(me, dq);
+    }
+
+    QDeferSlot * const s = dq->freeList;
+    if (s == (QDeferSlot *)0) { /* still no free slots? */
+        return false;
+    }
+    dq->freeList = s->next;
+    --dq->nFree;
+    if (dq->nMin > dq->nFree) {
+        dq->nMin = dq->nFree; /* update the low-watermark */
+    }
+
+    s->e    = e;
+    s->next = (QDeferSlot *)0;
+    s->ttl  = (ttl != 0U);
+    s->deadline = (QTimeEvtCtr)(now + ttl);
+    if (dq->tail[bucket] == (QDeferSlot *)0) { /* empty bucket? */
+        dq->head[bucket] = s;
+        dq->bits |= (QPSetBits)((QPSetBits)1U << bucket);
+    }
+    else {
+        dq->tail[bucket]->next = s;
+    }
+    dq->tail[bucket] = s;
+    ++dq->nUsed[bucket];
+
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+
+    /* is it a dynamic event? */
+    if (e->poolId_ != 0U) {
+        QEvt_refCtr_inc_(e); /* the deferred queue holds a reference */
+    }
+    QF_EVT_TRACK_POST_(e, me->prio, (void *)0); /* the AO holds e */
+
+    QS_BEGIN_NOCRIT_PRE_(QS_QF_ACTIVE_DEFER, me->prio)
+        QS_TIME_PRE_();      /* time stamp */
+        QS_OBJ_PRE_(me);     /* this active object */
+        QS_OBJ_PRE_(dq);     /* the deferred queue */
+        QS_SIG_PRE_(e->sig); /* the signal of the event */
+        QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
+    QS_END_NOCRIT_PRE_()
+
+    QF_CRIT_X_();
+
+    return true;
+}
+/*..........................................................................*/
+/*! @protected @memberof QActive */
+bool QActive_recallKey(QActive * const me,
+    QDeferQueue * const dq,
+    uint_fast8_t const bucket)
+{
+    Q_REQUIRE_ID(600, bucket < (uint_fast8_t)dq->nBuckets);
+
+    bool recalled;
+    if (dq->head[bucket] != (QDeferSlot *)0) {
+        recalled = (QActive_recallBatch_(me, dq, bucket, 1U) != 0U);
+    }
+    else {
+        QS_CRIT_STAT_
+
+        QS_BEGIN_PRE_(QS_QF_ACTIVE_RECALL_ATTEMPT, me->prio)
+            QS_TIME_PRE_();      /* time stamp */
+            QS_OBJ_PRE_(me);     /* this active object */
+            QS_OBJ_PRE_(dq);     /* the deferred queue */
+        QS_END_PRE_()
+
+        recalled = false;
+    }
+    return recalled;
+}
+/*..........................................................................*/
+/*! @protected @memberof QActive */
+bool QActive_recallTop(QActive * const me,
+    QDeferQueue * const dq)
+{
+    bool recalled;
+    if (dq->bits != 0U) {
+        recalled = (QActive_recallBatch_(me, dq, QF_DEFER_BUCKETS, 1U) != 0U);
+    }
+    else {
+        QS_CRIT_STAT_
+
+        QS_BEGIN_PRE_(QS_QF_ACTIVE_RECALL_ATTEMPT, me->prio)
+            QS_TIME_PRE_();      /* time stamp */
+            QS_OBJ_PRE_(me);     /* this active object */
+            QS_OBJ_PRE_(dq);     /* the deferred queue */
+        QS_END_PRE_()
+
+        recalled = false;
+    }
+    return recalled;
+}
+/*..........................................................................*/
+/*! @protected @memberof QActive */
+uint_fast16_t QActive_recallBatch(QActive * const me,
+    QDeferQueue * const dq,
+    uint_fast16_t const nMax)
+{
+    return QActive_recallBatch_(me, dq, QF_DEFER_BUCKETS, nMax);
+}
+/*..........................................................................*/
+/*! @protected @memberof QActive */
+uint_fast16_t QActive_flushDeferQueue(QActive const * const me,
+    QDeferQueue * const dq)
+{
+    Q_UNUSED_PAR(me);
+
+    uint_fast16_t n = 0U;
+    while (dq->bits != 0U) {
+        uint_fast8_t const b = (uint_fast8_t)(QF_LOG2(dq->bits) - 1U);
+        QDeferSlot * const s = QDeferQueue_take_(dq, b);
+        QEvt const * const e = s->e;
+        QDeferQueue_free_(dq, s);
+        ++n; /* count the flushed event */
+    #if (QF_MAX_EPOOL > 0U)
+        QF_gc(e); /* garbage collect */
+    #else
+        Q_UNUSED_PAR(e);
+    #endif
+    }
+    return n;
+}
+
+/*==========================================================================*/
+/* NOTE1:
+* The events in a bucket are deferred in the order of their arrival, so
+* with a similar time-to-live the stale events accumulate at the head of
+* the bucket. Therefore only the heads of the buckets are checked for
+* expiration when recalling, which keeps the cost of the expiration
+* amortized O(1) per deferred event. An event expired behind a live one
+* would keep its slot (and its event-pool block) until it reaches the head,
+* so all the buckets are swept by QActive_expireDeferred() when deferring
+* into a full queue. The AO can also call QActive_expireDeferred() itself,
+* e.g., periodically, to release the expired events sooner.
+*
+* NOTE2:
+* With the native QF event queue (::QEQueue, used when the port defines
+* QACTIVE_EQUEUE_SIGNAL_()), the recalled events are linked directly into
+* the front of the AO's queue, and the references held by the deferred
+* queue are handed over to the AO's queue, all in one critical section for
+* the whole batch. When the port provides its own event queue, every event
+* is posted with QACTIVE_POST_LIFO() and the references are released in
+* one additional critical section afterwards.
+*
+* NOTE3:
+* An immutable (static) event cannot be copied, because its size is
+* unknown. Therefore, the notification of an expired immutable event is
+* a bare ::QEvt with the signal `expSig`, so that the AO still learns
+* that a stale request has been dropped.
+*/
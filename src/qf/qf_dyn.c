@@ -80,6 +80,299 @@ QF_EPOOL_TYPE_ QF_ePool_[QF_MAX_EPOOL];
 /*${QEP::QEvt} .............................................................*/
 /*$enddef${QEP::QEvt} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 //============================================================================
+#ifdef QF_POOL_STATS
+
+/* number of the ranges of the tracked event sizes */
+#define QF_POOL_RANGES_  ((QF_POOL_STAT_SIZES * (QF_POOL_STAT_SIZES + 1U)) / 2U)
+
+/* index of the range of the tracked sizes a..b (a <= b) in l_poolStat.peak */
+#define QF_POOL_RANGE_(a_, b_)  ((((b_) * ((b_) + 1U)) / 2U) + (a_))
+
+/* event-pool statistics, see QF_poolAdvise() */
+static struct {
+    uint16_t size[QF_POOL_STAT_SIZES];   /* tracked event sizes, ascending */
+    uint16_t inUse[QF_POOL_STAT_SIZES];  /* events of the size in flight */
+    uint32_t nAlloc[QF_POOL_STAT_SIZES]; /* allocations of the size */
+    uint16_t peak[QF_POOL_RANGES_];      /* peak in flight per size range */
+    uint16_t sigInUse[QF_POOL_STAT_SIGS];/* events of the signal in flight */
+    uint16_t sigPeak[QF_POOL_STAT_SIGS]; /* peak events of the signal */
+    uint8_t  sigSize[QF_POOL_STAT_SIGS]; /* tracked size index + 1 (0: none) */
+    uint32_t poolAlloc[QF_MAX_EPOOL];    /* allocations per pool */
+    uint32_t poolFail[QF_MAX_EPOOL];     /* failed allocations per pool */
+    uint32_t poolNear[QF_MAX_EPOOL];     /* near-misses per pool */
+    uint_fast8_t nSizes;                 /* number of the tracked sizes */
+} l_poolStat;
+
+/* signal slot of the pool statistics */
+static uint_fast16_t QF_poolStatSig_(enum_t const sig) {
+    return ((0 <= sig) && ((uint_fast16_t)sig < QF_POOL_STAT_SIGS))
+           ? (uint_fast16_t)sig
+           : (QF_POOL_STAT_SIGS - 1U);
+}
+
+/* add delta to the events of the tracked size idx in flight and update
+* the peaks of all size ranges containing idx (in a critical section)
+*/
+static void QF_poolStatAdd_(uint_fast8_t const idx,
+    int_fast32_t const delta)
+{
+    int_fast32_t n = (int_fast32_t)l_poolStat.inUse[idx] + delta;
+    if (n < 0) {
+        n = 0; /* the event was allocated before QF_resetPoolStat() */
+    }
+    l_poolStat.inUse[idx] = (uint16_t)n;
+
+    if (delta > 0) {
+        uint_fast32_t sum[QF_POOL_STAT_SIZES + 1U]; /* prefix sums */
+        uint_fast8_t a;
+        uint_fast8_t b;
+        sum[0] = 0U;
+        for (a = 0U; a < l_poolStat.nSizes; ++a) {
+            sum[a + 1U] = sum[a] + l_poolStat.inUse[a];
+        }
+        for (a = 0U; a <= idx; ++a) {
+            for (b = idx; b < l_poolStat.nSizes; ++b) {
+                uint_fast32_t const inUse = sum[b + 1U] - sum[a];
+                uint_fast16_t const r = QF_POOL_RANGE_(a, b);
+                if (l_poolStat.peak[r] < inUse) {
+                    l_poolStat.peak[r] = (uint16_t)inUse;
+                }
+            }
+        }
+    }
+}
+
+/* index of the tracked size for the event size, which is inserted into
+* the tracked sizes when there is still room (in a critical section)
+*/
+static uint_fast8_t QF_poolStatSize_(uint_fast16_t const evtSize) {
+    uint_fast8_t const n = l_poolStat.nSizes;
+    uint_fast8_t k;
+
+    for (k = 0U; (k < n) && (l_poolStat.size[k] < evtSize); ++k) {
+    }
+    if ((k < n) && (l_poolStat.size[k] == evtSize)) {
+        return k; /* already tracked */
+    }
+    if (n == QF_POOL_STAT_SIZES) { /* no more room? */
+        if (k == n) { /* larger than all tracked sizes? */
+            k = n - 1U;
+            l_poolStat.size[k] = (uint16_t)evtSize; /* enlarge the largest */
+        }
+        return k; /* merge with the next larger tracked size */
+    }
+
+    /* insert the new size at k... */
+    uint_fast8_t i;
+    for (i = n; i > k; --i) {
+        l_poolStat.size[i]   = l_poolStat.size[i - 1U];
+        l_poolStat.inUse[i]  = l_poolStat.inUse[i - 1U];
+        l_poolStat.nAlloc[i] = l_poolStat.nAlloc[i - 1U];
+    }
+    l_poolStat.size[k]   = (uint16_t)evtSize;
+    l_poolStat.inUse[k]  = 0U;
+    l_poolStat.nAlloc[k] = 0U;
+
+    /* ...and re-map the range peaks in place, from the last range down,
+    * because the old index of every range is never above the new index.
+    * The new size has no events in flight, so the peaks remain exact.
+    */
+    uint_fast8_t b = n + 1U;
+    while (b > 0U) {
+        --b;
+        uint_fast8_t a = b + 1U;
+        while (a > 0U) {
+            --a;
+            uint16_t pk;
+            if (b < k) {
+                pk = l_poolStat.peak[QF_POOL_RANGE_(a, b)];
+            }
+            else if (a > k) {
+                pk = l_poolStat.peak[QF_POOL_RANGE_(a - 1U, b - 1U)];
+            }
+            else if (a == b) { /* the new size alone */
+                pk = 0U;
+            }
+            else { /* the range spans the new size */
+                pk = l_poolStat.peak[QF_POOL_RANGE_(a, b - 1U)];
+            }
+            l_poolStat.peak[QF_POOL_RANGE_(a, b)] = pk;
+        }
+    }
+    for (i = 0U; i < QF_POOL_STAT_SIGS; ++i) {
+        if (l_poolStat.sigSize[i] > k) {
+            ++l_poolStat.sigSize[i];
+        }
+    }
+    l_poolStat.nSizes = n + 1U;
+    return k;
+}
+
+/* RAM of a pool for the events up to evtSize with the peak in flight */
+static uint32_t QF_poolCost_(uint_fast16_t const evtSize,
+    uint_fast16_t const peak,
+    uint_fast8_t const headroom,
+    uint16_t * const nBlocks)
+{
+    /* the block size as rounded up by QMPool_init() */
+    uint_fast32_t const blockSize =
+        ((evtSize + sizeof(QFreeBlock) - 1U) / sizeof(QFreeBlock))
+        * sizeof(QFreeBlock);
+    uint_fast32_t extra = ((peak * headroom) + 99U) / 100U;
+    if (extra == 0U) {
+        extra = 1U; /* at least one more block */
+    }
+    uint_fast32_t n = peak + extra;
+    if (n > 0xFFFFU) {
+        n = 0xFFFFU;
+    }
+    if (nBlocks != (uint16_t *)0) {
+        *nBlocks = (uint16_t)n;
+    }
+    return (uint32_t)(blockSize * n);
+}
+
+/* account for the allocation of an event from the pool idx */
+static void QF_poolStatNew_(uint_fast8_t const idx,
+    uint_fast16_t const evtSize,
+    enum_t const sig)
+{
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+
+    uint_fast16_t const s = QF_poolStatSig_(sig);
+    uint_fast8_t const k = QF_poolStatSize_(evtSize);
+    uint_fast8_t cls = k;
+
+    ++l_poolStat.nAlloc[k];
+
+    /* the events of a signal are counted in flight under the largest
+    * size allocated for the signal, because QF_gc() knows only the signal
+    */
+    if (l_poolStat.sigSize[s] > (uint8_t)(k + 1U)) {
+        cls = (uint_fast8_t)l_poolStat.sigSize[s] - 1U;
+    }
+    else if (l_poolStat.sigSize[s] != 0U) {
+        uint_fast8_t const old = (uint_fast8_t)l_poolStat.sigSize[s] - 1U;
+        if (old != k) { /* move the events of the signal to the new size */
+            QF_poolStatAdd_(old, -(int_fast32_t)l_poolStat.sigInUse[s]);
+            QF_poolStatAdd_(k, (int_fast32_t)l_poolStat.sigInUse[s]);
+        }
+    }
+    else {
+        /* first allocation of the signal */
+    }
+    l_poolStat.sigSize[s] = (uint8_t)(cls + 1U);
+    QF_poolStatAdd_(cls, 1);
+
+    ++l_poolStat.sigInUse[s];
+    if (l_poolStat.sigPeak[s] < l_poolStat.sigInUse[s]) {
+        l_poolStat.sigPeak[s] = l_poolStat.sigInUse[s];
+    }
+
+    ++l_poolStat.poolAlloc[idx];
+    if (QF_ePool_[idx].nFree <= QF_POOL_NEAR_MISS) {
+        ++l_poolStat.poolNear[idx];
+    }
+
+    QF_CRIT_X_();
+}
+
+/* account for the recycling of an event (in a critical section) */
+static void QF_poolStatGc_(enum_t const sig) {
+    uint_fast16_t const s = QF_poolStatSig_(sig);
+    if (l_poolStat.sigSize[s] != 0U) {
+        QF_poolStatAdd_((uint_fast8_t)l_poolStat.sigSize[s] - 1U, -1);
+    }
+    if (l_poolStat.sigInUse[s] != 0U) {
+        --l_poolStat.sigInUse[s];
+    }
+}
+
+#endif /* QF_POOL_STATS */
+//============================================================================
+#ifdef QF_EVT_TRACK
+
+/* side-table entry of an event-pool block */
+typedef struct {
+    void const *sender;  /* the sender of the first post */
+    uint32_t time;       /* QF_EVT_TRACK_TIME() of the allocation */
+    QPSet holders;       /* priorities of the AOs holding the event */
+    QSignal sig;         /* the signal of the event */
+    uint8_t live;        /* is the block allocated? */
+} QEvtTrack;
+
+static QEvtTrack l_evtTrack[QF_EVT_TRACK_MAX];
+
+/* first side-table entry of every pool (the last one is the end) */
+static uint_fast16_t l_evtTrackBase[QF_MAX_EPOOL + 1U];
+
+uint32_t QF_evtTrackSeq_;
+
+/* side-table entry of the dynamic event e or NULL if not tracked */
+static QEvtTrack *QF_evtTrack_(QEvt const * const e) {
+    uint_fast8_t const idx = (uint_fast8_t)e->poolId_ - 1U;
+    QF_EPOOL_TYPE_ const * const pool = &QF_ePool_[idx];
+    uint_fast16_t const n = l_evtTrackBase[idx]
+        + (uint_fast16_t)(((uint8_t const *)e - (uint8_t const *)pool->start)
+                          / pool->blockSize);
+    return (n < l_evtTrackBase[idx + 1U]) ? &l_evtTrack[n] : (QEvtTrack *)0;
+}
+
+/* assign the side-table entries to the blocks of the pool idx */
+static void QF_evtTrackInit_(uint_fast8_t const idx) {
+    uint_fast16_t const end = l_evtTrackBase[idx]
+        + (uint_fast16_t)QF_ePool_[idx].nTot;
+    l_evtTrackBase[idx + 1U] = (end < QF_EVT_TRACK_MAX)
+                               ? end : QF_EVT_TRACK_MAX;
+}
+
+/* start tracking the allocated event e (in a critical section) */
+static void QF_evtTrackNew_(QEvt const * const e) {
+    QEvtTrack * const t = QF_evtTrack_(e);
+    ++QF_evtTrackSeq_;
+    if (t != (QEvtTrack *)0) {
+        t->sender = (void *)0;
+        t->time   = (uint32_t)QF_EVT_TRACK_TIME();
+        QPSet_setEmpty(&t->holders);
+        t->sig    = e->sig;
+        t->live   = 1U;
+    }
+}
+
+/*..........................................................................*/
+/*! @static @private @memberof QF */
+void QF_evtTrackPost_(QEvt const * const e,
+    uint_fast8_t const prio,
+    void const * const sender)
+{
+    if (e->poolId_ != 0U) {
+        QEvtTrack * const t = QF_evtTrack_(e);
+        if (t != (QEvtTrack *)0) {
+            if (t->sender == (void *)0) {
+                t->sender = sender;
+            }
+            if ((0U < prio) && (prio <= QF_MAX_ACTIVE)) {
+                QPSet_insert(&t->holders, prio);
+            }
+        }
+    }
+}
+/*..........................................................................*/
+/*! @static @private @memberof QF */
+void QF_evtTrackRelease_(QEvt const * const e,
+    uint_fast8_t const prio)
+{
+    if (e->poolId_ != 0U) {
+        QEvtTrack * const t = QF_evtTrack_(e);
+        if ((t != (QEvtTrack *)0) && (0U < prio) && (prio <= QF_MAX_ACTIVE)) {
+            QPSet_remove(&t->holders, prio);
+        }
+    }
+}
+
+#endif /* QF_EVT_TRACK */
+//============================================================================
 /*$define${QF::QF-dyn} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 
 /*${QF::QF-dyn::poolInit} ..................................................*/
@@ -99,6 +392,9 @@ void QF_poolInit(
 
     /* perform the platform-dependent initialization of the pool */
     QF_EPOOL_INIT_(QF_ePool_[QF_maxPool_], poolSto, poolSize, evtSize);
+    #ifdef QF_EVT_TRACK
+    QF_evtTrackInit_(QF_maxPool_);
+    #endif
     ++QF_maxPool_; /* one more pool */
 
     #ifdef Q_SPY
@@ -174,6 +470,17 @@ QEvt * QF_newX_(
             QS_EVS_PRE_(evtSize);  /* the size of the event */
             QS_SIG_PRE_(sig);      /* the signal of the event */
         QS_END_PRE_()
+        #ifdef QF_POOL_STATS
+        QF_poolStatNew_(idx, evtSize, sig);
+        #endif
+        #ifdef QF_EVT_TRACK
+        {
+            QF_CRIT_STAT_
+            QF_CRIT_E_();
+            QF_evtTrackNew_(e);
+            QF_CRIT_X_();
+        }
+        #endif
     }
     /* event cannot be allocated */
     else {
@@ -183,6 +490,15 @@ QEvt * QF_newX_(
          */
         Q_ASSERT_ID(320, margin != QF_NO_MARGIN);
 
+        #ifdef QF_POOL_STATS
+        {
+            QF_CRIT_STAT_
+            QF_CRIT_E_();
+            ++l_poolStat.poolFail[idx];
+            QF_CRIT_X_();
+        }
+        #endif
+
         QS_BEGIN_PRE_(QS_QF_NEW_ATTEMPT, (uint_fast8_t)QS_EP_ID + idx + 1U)
             QS_TIME_PRE_();        /* timestamp */
             QS_EVS_PRE_(evtSize);  /* the size of the event */
@@ -225,6 +541,18 @@ void QF_gc(QEvt const * const e) {
                 QS_2U8_PRE_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
             QS_END_NOCRIT_PRE_()
 
+    #ifdef QF_POOL_STATS
+            QF_poolStatGc_((enum_t)e->sig);
+    #endif
+    #ifdef QF_EVT_TRACK
+            {
+                QEvtTrack * const t = QF_evtTrack_(e);
+                if (t != (QEvtTrack *)0) {
+                    t->live = 0U;
+                }
+            }
+    #endif
+
             QF_CRIT_X_();
 
             /* pool ID must be in range */
@@ -293,4 +621,242 @@ void QF_deleteRef_(void const * const evtRef) {
 }
 /*$enddef${QF::QF-dyn} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 
+/*==========================================================================*/
+#ifdef QF_POOL_STATS
+
+/*..........................................................................*/
+/*! @static @public @memberof QF */
+void QF_getPoolStat(uint_fast8_t const poolId,
+    QPoolStat * const stat)
+{
+    /*! @pre the poolId must be in range */
+    Q_REQUIRE_ID(600, (poolId <= QF_MAX_EPOOL)
+                      && (0U < poolId) && (poolId <= QF_maxPool_));
+
+    uint_fast8_t const idx = poolId - 1U;
+    uint_fast16_t const blockSize = QF_EPOOL_EVENT_SIZE_(QF_ePool_[idx]);
+    uint_fast16_t const prevSize = (idx > 0U)
+        ? QF_EPOOL_EVENT_SIZE_(QF_ePool_[idx - 1U])
+        : 0U;
+    uint64_t used  = 0U; /* bytes requested from the pool */
+    uint64_t total = 0U; /* bytes of the blocks allocated from the pool */
+    uint_fast8_t k;
+
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+    stat->nAlloc    = l_poolStat.poolAlloc[idx];
+    stat->nFail     = l_poolStat.poolFail[idx];
+    stat->nNearMiss = l_poolStat.poolNear[idx];
+    stat->blockSize = (uint16_t)blockSize;
+    stat->nTot      = (uint16_t)QF_ePool_[idx].nTot;
+    stat->peak      = (uint16_t)(QF_ePool_[idx].nTot - QF_ePool_[idx].nMin);
+    for (k = 0U; k < l_poolStat.nSizes; ++k) {
+        /* the sizes allocated from this pool (see QF_newX_()) */
+        if ((prevSize < l_poolStat.size[k])
+            && (l_poolStat.size[k] <= blockSize))
+        {
+            used  += (uint64_t)l_poolStat.nAlloc[k] * l_poolStat.size[k];
+            total += (uint64_t)l_poolStat.nAlloc[k] * blockSize;
+        }
+    }
+    QF_CRIT_X_();
+
+    stat->wastePct = (total != 0U)
+        ? (uint8_t)(((total - used) * 100U) / total)
+        : 0U;
+}
+/*..........................................................................*/
+/*! @static @public @memberof QF */
+uint_fast8_t QF_getSizeStat(QPoolSizeStat * const stat,
+    uint_fast8_t const max)
+{
+    uint_fast8_t k;
+
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+    for (k = 0U; (k < l_poolStat.nSizes) && (k < max); ++k) {
+        stat[k].evtSize = l_poolStat.size[k];
+        stat[k].peak    = l_poolStat.peak[QF_POOL_RANGE_(k, k)];
+        stat[k].nAlloc  = l_poolStat.nAlloc[k];
+    }
+    QF_CRIT_X_();
+
+    return k;
+}
+/*..........................................................................*/
+/*! @static @public @memberof QF */
+uint_fast16_t QF_getSigPeak(enum_t const sig) {
+    return l_poolStat.sigPeak[QF_poolStatSig_(sig)];
+}
+/*..........................................................................*/
+/*! @static @public @memberof QF */
+uint_fast8_t QF_poolAdvise(QPoolAdvice * const advice,
+    uint_fast8_t const maxPools,
+    uint_fast8_t const headroom)
+{
+    /*! @pre cannot recommend more pools than QF can use */
+    Q_REQUIRE_ID(610, (0U < maxPools) && (maxPools <= QF_MAX_EPOOL));
+
+    uint16_t size[QF_POOL_STAT_SIZES];
+    uint16_t peak[QF_POOL_RANGES_];
+    uint_fast8_t n;
+    uint_fast16_t r;
+
+    /* snapshot the statistics */
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+    n = l_poolStat.nSizes;
+    for (r = 0U; r < n; ++r) {
+        size[r] = l_poolStat.size[r];
+    }
+    for (r = 0U; r < QF_POOL_RANGES_; ++r) {
+        peak[r] = l_poolStat.peak[r];
+    }
+    QF_CRIT_X_();
+
+    if (n == 0U) {
+        return 0U; /* nothing allocated yet */
+    }
+
+    /* cost[j][i]: the least RAM for the first i sizes in j pools, where
+    * every pool holds a contiguous range of the sizes (QF_newX_() takes
+    * the first pool that fits) with the peak of the range plus headroom
+    */
+    uint32_t cost[QF_MAX_EPOOL + 1U][QF_POOL_STAT_SIZES + 1U];
+    uint8_t  from[QF_MAX_EPOOL + 1U][QF_POOL_STAT_SIZES + 1U];
+    uint_fast8_t i;
+    uint_fast8_t j;
+    uint_fast8_t a;
+
+    for (i = 0U; i <= n; ++i) {
+        cost[0][i] = (i == 0U) ? 0U : 0xFFFFFFFFU;
+    }
+    uint_fast8_t best = 0U;
+    for (j = 1U; j <= maxPools; ++j) {
+        for (i = 0U; i <= n; ++i) {
+            cost[j][i] = 0xFFFFFFFFU;
+            from[j][i] = 0U;
+            for (a = 0U; a < i; ++a) {
+                if (cost[j - 1U][a] != 0xFFFFFFFFU) {
+                    uint32_t const c = cost[j - 1U][a]
+                        + QF_poolCost_(size[i - 1U],
+                              peak[QF_POOL_RANGE_(a, i - 1U)], headroom,
+                              (uint16_t *)0);
+                    if (c < cost[j][i]) {
+                        cost[j][i] = c;
+                        from[j][i] = (uint8_t)a;
+                    }
+                }
+            }
+        }
+        /* prefer fewer pools for the same RAM */
+        if ((best == 0U) || (cost[j][n] < cost[best][n])) {
+            best = j;
+        }
+    }
+
+    /* trace the best layout back from the largest size */
+    i = n;
+    for (j = best; j > 0U; --j) {
+        a = from[j][i];
+        QPoolAdvice * const adv = &advice[j - 1U];
+        adv->evtSize  = size[i - 1U];
+        adv->poolSize = QF_poolCost_(size[i - 1U],
+                            peak[QF_POOL_RANGE_(a, i - 1U)], headroom,
+                            &adv->nBlocks);
+        i = a;
+    }
+    return best;
+}
+/*..........................................................................*/
+/*! @static @public @memberof QF */
+void QF_resetPoolStat(void) {
+    uint_fast16_t i;
+    uint_fast8_t a;
+    uint_fast8_t b;
+
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+    for (a = 0U; a < l_poolStat.nSizes; ++a) {
+        uint_fast32_t inUse = 0U;
+        l_poolStat.nAlloc[a] = 0U;
+        for (b = a; b < l_poolStat.nSizes; ++b) {
+            inUse += l_poolStat.inUse[b];
+            l_poolStat.peak[QF_POOL_RANGE_(a, b)] = (uint16_t)inUse;
+        }
+    }
+    for (i = 0U; i < QF_POOL_STAT_SIGS; ++i) {
+        l_poolStat.sigPeak[i] = l_poolStat.sigInUse[i];
+    }
+    for (i = 0U; i < QF_maxPool_; ++i) {
+        l_poolStat.poolAlloc[i] = 0U;
+        l_poolStat.poolFail[i]  = 0U;
+        l_poolStat.poolNear[i]  = 0U;
+        QF_ePool_[i].nMin = QF_ePool_[i].nFree;
+    }
+    QF_CRIT_X_();
+}
+
+#endif /* QF_POOL_STATS */
+
+/*==========================================================================*/
+#ifdef QF_EVT_TRACK
+
+/*..........................................................................*/
+/*! @static @public @memberof QF */
+uint_fast16_t QF_getLiveEvts(QEvtTrackInfo * const info,
+    uint_fast16_t const max)
+{
+    uint_fast16_t nLive = 0U;
+    uint_fast16_t nInfo = 0U;
+    uint_fast8_t p;
+
+    for (p = 0U; p < QF_maxPool_; ++p) {
+        QF_EPOOL_TYPE_ const * const pool = &QF_ePool_[p];
+        uint_fast16_t n;
+        for (n = l_evtTrackBase[p]; n < l_evtTrackBase[p + 1U]; ++n) {
+            QEvtTrackInfo ti;
+            bool live;
+
+            /* snapshot the entry... */
+            QF_CRIT_STAT_
+            QF_CRIT_E_();
+            QEvtTrack const * const t = &l_evtTrack[n];
+            live = (t->live != 0U);
+            if (live) {
+                ti.e = (QEvt const *)((uint8_t const *)pool->start
+                    + ((n - l_evtTrackBase[p]) * pool->blockSize));
+                ti.sender  = t->sender;
+                ti.age     = (uint32_t)QF_EVT_TRACK_TIME() - t->time;
+                ti.holders = t->holders;
+                ti.sig     = t->sig;
+                ti.poolId  = (uint8_t)(p + 1U);
+                ti.refCtr  = ti.e->refCtr_;
+            }
+            QF_CRIT_X_();
+
+            /* ...and insert it into the oldest events, the oldest first */
+            if (live) {
+                uint_fast16_t i = (nInfo < max) ? nInfo : max;
+                ++nLive;
+                while ((i > 0U) && (info[i - 1U].age < ti.age)) {
+                    if (i < max) {
+                        info[i] = info[i - 1U];
+                    }
+                    --i;
+                }
+                if (i < max) {
+                    info[i] = ti;
+                    if (nInfo < max) {
+                        ++nInfo;
+                    }
+                }
+            }
+        }
+    }
+    return nLive;
+}
+
+#endif /* QF_EVT_TRACK */
+
 #endif /* (QF_MAX_EPOOL > 0U) dynamic events configured */
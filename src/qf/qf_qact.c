@@ -50,6 +50,12 @@
 #include "qf_port.h"      /* QF port */
 #include "qf_pkg.h"       /* QF package-scope interface */
 #include "qassert.h"      /* QP embedded systems-friendly assertions */
+#ifdef Q_SPY              /* QS software tracing enabled? */
+    #include "qs_port.h"  /* QS port */
+    #include "qs_pkg.h"   /* QS facilities for pre-defined trace records */
+#else
+    #include "qs_dummy.h" /* disable the QS software tracing */
+#endif /* Q_SPY */
 
 Q_DEFINE_THIS_MODULE("qf_qact")
 
@@ -221,3 +227,183 @@ uint_fast8_t QF_LOG2(QPSetBits x) {
 }
 #endif /* ndef QF_LOG2 */
 /*$enddef${QF-types::QF_LOG2} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+
+/*==========================================================================*/
+#ifdef QF_RTC_TIME
+
+static QRtcStat l_rtcStat[QF_MAX_ACTIVE + 1U]; /* indexed by AO priority */
+static QRtcOverrunHandler l_rtcOverrun;        /* RTC overrun handler */
+
+/*..........................................................................*/
+/*! @public @memberof QActive */
+void QActive_setRtcBudget(QActive * const me,
+    QRtcTime const budget)
+{
+    /*! @pre the AO must be started */
+    Q_REQUIRE_ID(600, (0U < me->prio) && (me->prio <= QF_MAX_ACTIVE));
+
+    l_rtcStat[me->prio].budget = budget;
+}
+/*..........................................................................*/
+/*! @public @memberof QActive */
+QRtcStat const *QActive_getRtcStat(QActive const * const me) {
+    /*! @pre the AO must be started */
+    Q_REQUIRE_ID(610, (0U < me->prio) && (me->prio <= QF_MAX_ACTIVE));
+
+    return &l_rtcStat[me->prio];
+}
+/*..........................................................................*/
+/*! @public @memberof QActive */
+QRtcTime QActive_getRtcPercentile(QActive const * const me,
+    uint_fast8_t const pct)
+{
+    Q_REQUIRE_ID(620, (0U < me->prio) && (me->prio <= QF_MAX_ACTIVE)
+                      && (0U < pct) && (pct <= 100U));
+
+    QRtcStat const * const st = &l_rtcStat[me->prio];
+
+    /* number of the RTC steps up to the percentile (rounded up) */
+    uint32_t const n = ((st->nSteps / 100U) * pct)
+                       + ((((st->nSteps % 100U) * pct) + 99U) / 100U);
+    uint32_t sum = 0U;
+    for (uint_fast8_t b = 0U; b < QF_RTC_BUCKETS; ++b) {
+        sum += st->hist[b];
+        if ((sum >= n) && (sum != 0U)) {
+            return (b < (QF_RTC_BUCKETS - 1U))
+                   ? (QRtcTime)(((QRtcTime)1U << b) - 1U)
+                   : st->max;
+        }
+    }
+    return 0U;
+}
+/*..........................................................................*/
+/*! @public @memberof QActive */
+void QActive_resetRtcStat(QActive * const me) {
+    Q_REQUIRE_ID(630, (0U < me->prio) && (me->prio <= QF_MAX_ACTIVE));
+
+    QRtcStat * const st = &l_rtcStat[me->prio];
+    QRtcTime const budget = st->budget;
+    QF_bzero(st, sizeof(*st));
+    st->budget = budget;
+}
+/*..........................................................................*/
+/*! @static @public @memberof QF */
+void QF_setRtcOverrunHandler(QRtcOverrunHandler const handler) {
+    l_rtcOverrun = handler;
+}
+/*..........................................................................*/
+/*! @private @memberof QActive */
+void QActive_rtcDispatch_(QActive * const me,
+    QEvt const * const e,
+    uint_fast8_t const qs_id)
+{
+#ifdef Q_SPY
+    QStateHandler const s = (*me->super.vptr->getStateHandler)(&me->super);
+#else
+    Q_UNUSED_PAR(qs_id);
+    /* QMsm keeps the current state object, not the state handler */
+    QStateHandler const s = (me->super.vptr->dispatch == &QMsm_dispatch_)
+                            ? me->super.state.obj->stateHandler
+                            : me->super.state.fun;
+#endif
+    QSignal const sig = e->sig;
+    QRtcTime const t0 = QF_RTC_TIME();
+
+    QS_AGG_DISPATCH(&me->super, e, qs_id); /* the RTC step */
+
+    QRtcTime const dt = (QRtcTime)(QF_RTC_TIME() - t0);
+
+    /* only the thread of the AO updates the statistics of the AO */
+    QRtcStat * const st = &l_rtcStat[me->prio];
+    ++st->nSteps;
+    st->total += dt;
+    uint_fast8_t b = 0U; /* log2 bucket of dt */
+    for (QRtcTime d = dt; (d != 0U) && (b < (QF_RTC_BUCKETS - 1U));
+         d >>= 1U)
+    {
+        ++b;
+    }
+    ++st->hist[b];
+    if (st->max < dt) {
+        st->max      = dt;
+        st->maxSig   = sig;
+        st->maxState = s;
+    }
+
+    if ((st->budget != 0U) && (dt > st->budget)) { /* budget overrun? */
+        ++st->nOverruns;
+
+        QS_CRIT_STAT_
+        QS_BEGIN_PRE_(QS_RTC_OVERRUN, me->prio)
+            QS_TIME_PRE_();         /* timestamp */
+            QS_OBJ_PRE_(me);        /* this active object */
+            QS_FUN_PRE_(s);         /* the state that started the step */
+            QS_SIG_PRE_(sig);       /* the signal of the event */
+            QS_U32_PRE_(dt);        /* duration of the RTC step */
+            QS_U32_PRE_(st->budget);/* the RTC budget */
+        QS_END_PRE_()
+
+        QRtcOverrunHandler const handler = l_rtcOverrun;
+        if (handler != (QRtcOverrunHandler)0) {
+            (*handler)(me, e, s, dt);
+        }
+    }
+}
+
+#endif /* QF_RTC_TIME */
+
+/*==========================================================================*/
+#ifdef QF_AO_TELEM
+
+#ifndef QF_RTC_TIME
+uint32_t QActive_nDispatch_[QF_MAX_ACTIVE + 1U];
+#endif
+
+/*..........................................................................*/
+/*! @public @memberof QActive */
+void QActive_getTelem(QActive const * const me,
+    QActiveTelem * const telem)
+{
+    /*! @pre the AO must be started */
+    Q_REQUIRE_ID(700, (0U < me->prio) && (me->prio <= QF_MAX_ACTIVE));
+
+    QF_bzero(telem, sizeof(*telem));
+#ifdef QF_RTC_TIME
+    QRtcStat const * const st = &l_rtcStat[me->prio];
+    uint32_t const n = st->nSteps;
+    telem->nDispatch = n;
+    telem->rtcAvg = (n != 0U) ? (uint32_t)(st->total / n) : 0U;
+    telem->rtcMax = st->max;
+#else
+    telem->nDispatch = QActive_nDispatch_[me->prio];
+#endif
+    QActive_getPortTelem_(me, telem);
+}
+/*..........................................................................*/
+/*! @static @public @memberof QF */
+void QF_telemTrace(void) {
+#ifdef Q_SPY
+    for (uint_fast8_t p = 1U; p <= QF_MAX_ACTIVE; ++p) {
+        QActive const * const a = QActive_registry_[p];
+        if (a != (QActive *)0) {
+            QActiveTelem telem;
+            QActive_getTelem(a, &telem);
+
+            QS_CRIT_STAT_
+            QS_BEGIN_PRE_(QS_AO_TELEM, p)
+                QS_TIME_PRE_();                /* timestamp */
+                QS_OBJ_PRE_(a);                /* the active object */
+                QS_U16_PRE_(telem.queueSize);  /* queue capacity */
+                QS_U16_PRE_(telem.queueMax);   /* queue high-water mark */
+                QS_U32_PRE_(telem.nDispatch);  /* events dispatched */
+                QS_U32_PRE_(telem.rtcAvg);     /* average RTC step */
+                QS_U32_PRE_(telem.rtcMax);     /* longest RTC step */
+                QS_U32_PRE_(telem.stackSize);  /* stack size */
+                QS_U32_PRE_(telem.stackUsed);  /* stack high-water mark */
+            QS_END_PRE_()
+        }
+    }
+#endif /* Q_SPY */
+}
+
+#endif /* QF_AO_TELEM */
@@ -306,11 +306,14 @@ void QTimeEvt_tick_(
 
     QTimeEvt *prev = &QTimeEvt_timeEvtHead_[tickRate];
 
+    QTIMEEVT_TICK_HOOK_(tickRate); /* kernel-specific tick processing */
+
     QF_CRIT_STAT_
     QF_CRIT_E_();
 
+    ++prev->ctr; /* count the ticks, see QActive_deferTTL() */
+
     QS_BEGIN_NOCRIT_PRE_(QS_QF_TICK, 0U)
-        ++prev->ctr;
         QS_TEC_PRE_(prev->ctr); /* tick ctr */
         QS_U8_PRE_(tickRate);   /* tick rate */
     QS_END_NOCRIT_PRE_()
@@ -241,6 +241,21 @@ void QActive_start_(QActive * const me,
     QF_CRIT_X_();
 }
 /*$enddef${QK::QActive} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+
+#ifdef QF_AO_TELEM
+/*..........................................................................*/
+/*! @private @memberof QActive */
+void QActive_getPortTelem_(QActive const * const me,
+    QActiveTelem * const telem)
+{
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+    telem->queueSize = (uint16_t)(me->eQueue.end + 1U);
+    telem->queueMax  = (uint16_t)(me->eQueue.end + 1U - me->eQueue.nMin);
+    QF_CRIT_X_();
+    /* all AOs share the single stack of the QK kernel (no stack data) */
+}
+#endif /* QF_AO_TELEM */
 /*$define${QK::QK-extern-C} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 
 /*${QK::QK-extern-C::attr_} ................................................*/
@@ -326,7 +341,8 @@ void QK_activate_(void) {
         * 3. determine if event is garbage and collect it if so
         */
         QEvt const * const e = QActive_get_(a);
-        QHSM_DISPATCH(&a->super, e, p);
+        QS_REPLAY_REC(e, p); /* record the event for replay */
+        QF_RTC_DISPATCH_(a, e, p);
     #if (QF_MAX_EPOOL > 0U)
         QF_gc(e);
     #endif
@@ -44,6 +44,7 @@
 #include "qs_pkg.h"       /* QS package-scope interface */
 #include "qstamp.h"       /* QP time-stamp */
 #include "qassert.h"      /* QP embedded systems-friendly assertions */
+#include "qf_pkg.h"       /* QF package-scope interface (event pools) */
 
 Q_DEFINE_THIS_MODULE("qs")
 
@@ -52,6 +53,87 @@ Q_DEFINE_THIS_MODULE("qs")
 */
 Q_ASSERT_STATIC((enum_t)QS_PRE_MAX <= (enum_t)QS_USER);
 
+#if (QS_RATE_MAX > 0U)
+/*..........................................................................*/
+/* 1-in-n sampling followed by the token bucket of a single rate filter,
+* leaves the token to be consumed only when all the matching filters pass
+*/
+static bool QS_rateAllow_(QSRateFilter * const f) {
+    bool pass = true;
+    if (f->n > 1U) {
+        pass = (f->cnt == 0U);
+        ++f->cnt;
+        if (f->cnt >= f->n) {
+            f->cnt = 0U;
+        }
+    }
+    if (f->period != 0U) {
+        QSTimeCtr const now = QS_onGetTime();
+        QSTimeCtr const nTok = (QSTimeCtr)(now - f->last) / f->period;
+        if (nTok >= (QSTimeCtr)(f->burst - f->tokens)) { /* bucket full? */
+            f->tokens = f->burst;
+            f->last   = now;
+        }
+        else if (nTok != 0U) {
+            f->tokens += (uint16_t)nTok;
+            f->last   += nTok * f->period;
+        }
+        else {
+            /* no new tokens yet */
+        }
+        if (f->tokens == 0U) {
+            pass = false;
+        }
+    }
+    return pass;
+}
+#endif /* (QS_RATE_MAX > 0U) */
+
+#if (QS_AGG_MAX > 0U)
+/*..........................................................................*/
+/* find or allocate the aggregation counter for the AO, state and signal */
+static QSAggCtr *QS_aggCtr_(
+    void const * const obj,
+    QStateHandler const state,
+    QSignal const sig,
+    uint_fast8_t const qs_id)
+{
+    uint_fast16_t const start = (uint_fast16_t)(((uintptr_t)state >> 2U)
+        ^ ((uintptr_t)obj >> 3U) ^ ((uint_fast16_t)sig * 31U)) % QS_AGG_MAX;
+    uint_fast16_t i = start;
+    do { /* open addressing with linear probing */
+        QSAggCtr * const c = &QS_aggPriv_.ctr[i];
+        if (c->obj == (void *)0) { /* free counter? */
+            /* other AO threads might be claiming the same counter */
+            QSAggCtr *found = (QSAggCtr *)0;
+            QF_CRIT_STAT_
+            QF_CRIT_E_();
+            if (c->obj == (void *)0) {
+                c->state = state;
+                c->sig   = sig;
+                c->nDisp = 0U;
+                c->nTran = 0U;
+                c->qs_id = (uint8_t)qs_id;
+                c->obj   = obj; /* claim the counter */
+                found = c;
+            }
+            QF_CRIT_X_();
+            if (found != (QSAggCtr *)0) {
+                return found;
+            }
+        }
+        if ((c->obj == obj) && (c->state == state) && (c->sig == sig)) {
+            return c;
+        }
+        ++i;
+        if (i == QS_AGG_MAX) {
+            i = 0U;
+        }
+    } while (i != start);
+    return (QSAggCtr *)0; /* all QS_AGG_MAX counters used up */
+}
+#endif /* (QS_AGG_MAX > 0U) */
+
 /*==========================================================================*/
 /*$skip${QP_VERSION} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 /* Check for the minimum required QP version */
@@ -87,6 +169,21 @@ void QS_initBuf(
     QS_locFilter_((int_fast16_t)QS_ALL_IDS);      /* all local filters ON */
     QS_priv_.locFilter_AP = (void *)0;            /* deprecated "AP-filter" */
 
+    #if (QS_RATE_MAX > 0U)
+    /* no rate filters */
+    for (uint_fast8_t i = 0U; i < Q_DIM(QS_ratePriv_.recMask); ++i) {
+        QS_ratePriv_.recMask[i] = 0U;
+        QS_ratePriv_.idMask[i]  = 0U;
+    }
+    for (uint_fast8_t i = 0U; i < QS_RATE_MAX; ++i) {
+        QS_ratePriv_.filter[i].kind = 0U;
+    }
+    #endif /* (QS_RATE_MAX > 0U) */
+
+    #if (QS_AGG_MAX > 0U)
+    QS_aggPriv_.period = 0U; /* aggregation mode off */
+    #endif /* (QS_AGG_MAX > 0U) */
+
     /* produce an empty record to "flush" the QS trace buffer */
     QS_beginRec_((uint_fast8_t)QS_EMPTY);
     QS_endRec_();
@@ -180,6 +277,7 @@ void QS_glbFilter_(int_fast16_t const filter) {
                 QS_priv_.glbFilter[6] = 0x40U;
                 QS_priv_.glbFilter[7] = 0xFCU;
                 QS_priv_.glbFilter[8] = 0x7FU;
+                QS_priv_.glbFilter[10] = 0x0EU;
             }
             else {
                 /* never turn the last 3 records on (0x7D, 0x7E, 0x7F) */
@@ -206,11 +304,13 @@ void QS_glbFilter_(int_fast16_t const filter) {
                 QS_priv_.glbFilter[1] &= (uint8_t)(~0xFCU & 0xFFU);
                 QS_priv_.glbFilter[2] &= (uint8_t)(~0x07U & 0xFFU);
                 QS_priv_.glbFilter[5] &= (uint8_t)(~0x20U & 0xFFU);
+                QS_priv_.glbFilter[10] &= (uint8_t)(~0x60U & 0xFFU);
             }
             else {
                 QS_priv_.glbFilter[1] |= 0xFCU;
                 QS_priv_.glbFilter[2] |= 0x07U;
                 QS_priv_.glbFilter[5] |= 0x20U;
+                QS_priv_.glbFilter[10] |= 0x60U;
             }
             break;
         case (uint8_t)QS_EQ_RECORDS:
@@ -415,37 +515,363 @@ void QS_locFilter_(int_fast16_t const filter) {
     QS_priv_.locFilter[0] |= 0x01U; /* leave QS_ID == 0 always on */
 }
 
+/*${QS::QS-tx::ratePriv_} ..................................................*/
+#if (QS_RATE_MAX > 0U)
+QS_rate QS_ratePriv_;
+#endif /*  (QS_RATE_MAX > 0U) */
+
+/*${QS::QS-tx::rateSet_} ...................................................*/
+#if (QS_RATE_MAX > 0U)
+/*! @static @public @memberof QS_tx */
+void QS_rateSet_(
+    uint_fast8_t const kind,
+    uint_fast8_t const key,
+    uint_fast16_t const n,
+    QSTimeCtr const period,
+    uint_fast16_t const burst)
+{
+    /* known kind of the filter, valid record type or QS-ID and
+    * non-empty bucket for the rate limit
+    */
+    Q_REQUIRE_ID(500, ((kind == (uint_fast8_t)QS_RATE_REC)
+                       || (kind == (uint_fast8_t)QS_RATE_ID))
+                      && (key < 0x80U)
+                      && ((period == 0U) || (burst != 0U)));
+
+    uint8_t * const mask = (kind == (uint_fast8_t)QS_RATE_REC)
+                           ? &QS_ratePriv_.recMask[key >> 3U]
+                           : &QS_ratePriv_.idMask[key >> 3U];
+    QSRateFilter *f = (QSRateFilter *)0;
+    QS_CRIT_STAT_
+
+    QS_CRIT_E_();
+    QS_GLB_CRIT_ENTRY(); /* the filters are shared by all QS-TX buffers */
+    /* find the filter for the key or else a free filter */
+    for (uint_fast8_t i = 0U; i < QS_RATE_MAX; ++i) {
+        QSRateFilter * const fi = &QS_ratePriv_.filter[i];
+        if ((fi->kind == kind) && (fi->key == key)) {
+            f = fi;
+            break;
+        }
+        if ((fi->kind == 0U) && (f == (QSRateFilter *)0)) {
+            f = fi;
+        }
+    }
+
+    if ((n <= 1U) && (period == 0U)) { /* remove the filter? */
+        if ((f != (QSRateFilter *)0) && (f->kind == kind)) {
+            f->kind = 0U;
+        }
+        *mask &= (uint8_t)(~(1U << (key & 7U)) & 0xFFU);
+    }
+    else {
+        /* all QS_RATE_MAX rate filters must not be used up */
+        Q_ASSERT_ID(510, f != (QSRateFilter *)0);
+
+        f->kind       = (uint8_t)kind;
+        f->key        = (uint8_t)key;
+        f->n          = (uint16_t)n;
+        f->cnt        = 0U;
+        f->period     = period;
+        f->burst      = (uint16_t)burst;
+        f->tokens     = (uint16_t)burst;
+        f->last       = QS_onGetTime();
+        f->suppressed = 0U;
+        *mask |= (uint8_t)(1U << (key & 7U));
+    }
+    QS_GLB_CRIT_EXIT();
+    QS_CRIT_X_();
+}
+#endif /*  (QS_RATE_MAX > 0U) */
+
+/*${QS::QS-tx::rateCheck_} .................................................*/
+#if (QS_RATE_MAX > 0U)
+/*! @static @private @memberof QS_tx */
+bool QS_rateCheck_(
+    uint_fast8_t const rec,
+    uint_fast8_t const qs_id)
+{
+    QSRateFilter *match[2]; /* the filters of the record type and QS-ID */
+    bool allow[2];
+    uint_fast8_t nMatch = 0U;
+    bool pass = true;
+
+    QS_GLB_CRIT_ENTRY(); /* the filters are shared by all QS-TX buffers */
+
+    /* check all the matching filters before consuming any tokens */
+    for (uint_fast8_t i = 0U; (i < QS_RATE_MAX) && (nMatch < 2U); ++i) {
+        QSRateFilter * const f = &QS_ratePriv_.filter[i];
+        if (((f->kind == (uint8_t)QS_RATE_REC) && (f->key == rec))
+            || ((f->kind == (uint8_t)QS_RATE_ID) && (f->key == qs_id)))
+        {
+            match[nMatch] = f;
+            allow[nMatch] = QS_rateAllow_(f);
+            if (!allow[nMatch]) {
+                pass = false;
+            }
+            ++nMatch;
+        }
+    }
+
+    for (uint_fast8_t i = 0U; i < nMatch; ++i) {
+        QSRateFilter * const f = match[i];
+        if (!pass) {
+            if (!allow[i]) { /* suppressed by this filter? */
+                ++f->suppressed;
+            }
+        }
+        else {
+            if (f->period != 0U) {
+                --f->tokens; /* consume the token checked above */
+            }
+            if (f->suppressed != 0U) { /* report the suppressed records */
+                if (QS_GLB_CHECK_(QS_RATE_SUPPRESSED)) {
+                    QS_beginRec_((uint_fast8_t)QS_RATE_SUPPRESSED);
+                        QS_TIME_PRE_();      /* timestamp */
+                        QS_2U8_PRE_(f->kind, f->key); /* filter kind/key */
+                        QS_U32_PRE_(f->suppressed); /* # suppressed */
+                    QS_endRec_();
+                }
+                f->suppressed = 0U;
+            }
+        }
+    }
+
+    QS_GLB_CRIT_EXIT();
+
+    return pass;
+}
+#endif /*  (QS_RATE_MAX > 0U) */
+
+/*${QS::QS-tx::aggPriv_} ...................................................*/
+#if (QS_AGG_MAX > 0U)
+QS_agg QS_aggPriv_;
+#endif /*  (QS_AGG_MAX > 0U) */
+
+/*${QS::QS-tx::aggMode_} ...................................................*/
+#if (QS_AGG_MAX > 0U)
+/*! @static @public @memberof QS_tx */
+void QS_aggMode_(QSTimeCtr const period) {
+    if (period == 0U) { /* turn the aggregation mode off? */
+        if (QS_aggPriv_.period != 0U) {
+            QS_aggFlush();
+            QS_aggPriv_.period = 0U;
+            if ((QS_aggPriv_.glbSave & 0x01U) != 0U) {
+                QS_glbFilter_((int_fast16_t)QS_QEP_DISPATCH);
+            }
+            if ((QS_aggPriv_.glbSave & 0x02U) != 0U) {
+                QS_glbFilter_((int_fast16_t)QS_QEP_TRAN);
+            }
+        }
+    }
+    else if (QS_aggPriv_.period == 0U) { /* turn the mode on? */
+        for (uint_fast16_t i = 0U; i < QS_AGG_MAX; ++i) {
+            QS_aggPriv_.ctr[i].obj = (void *)0;
+        }
+        for (uint_fast8_t i = 0U; i < QS_AGG_AO_MAX; ++i) {
+            QSAggHist * const h = &QS_aggPriv_.rtc[i];
+            h->obj  = (void *)0;
+            h->max  = 0U;
+            h->lost = 0U;
+            for (uint_fast8_t b = 0U; b < QS_AGG_BUCKETS; ++b) {
+                h->hist[b] = 0U;
+            }
+        }
+
+        /* the aggregates replace the QS_QEP_DISPATCH/QS_QEP_TRAN records */
+        QS_aggPriv_.glbSave = (QS_GLB_CHECK_(QS_QEP_DISPATCH) ? 0x01U : 0U)
+                              | (QS_GLB_CHECK_(QS_QEP_TRAN) ? 0x02U : 0U);
+        QS_glbFilter_(-(int_fast16_t)QS_QEP_DISPATCH);
+        QS_glbFilter_(-(int_fast16_t)QS_QEP_TRAN);
+
+        QS_aggPriv_.last   = QS_onGetTime();
+        QS_aggPriv_.period = period;
+    }
+    else { /* the mode stays on, just change the period */
+        QS_aggPriv_.period = period;
+    }
+}
+#endif /*  (QS_AGG_MAX > 0U) */
+
+/*${QS::QS-tx::aggDispatch_} ...............................................*/
+#if (QS_AGG_MAX > 0U)
+/*! @static @private @memberof QS_tx */
+void QS_aggDispatch_(
+    QHsm * const me,
+    QEvt const * const e,
+    uint_fast8_t const qs_id)
+{
+    QStateHandler const s = (*me->vptr->getStateHandler)(me);
+    QSignal const sig = e->sig;
+    QSTimeCtr const t0 = QS_onGetTime();
+
+    QHSM_DISPATCH(me, e, qs_id); /* the RTC step */
+
+    QSTimeCtr const t1 = QS_onGetTime();
+    QSTimeCtr const dt = (QSTimeCtr)(t1 - t0);
+
+    /* only the thread of the AO updates the aggregates of the AO */
+    QSAggCtr * const c = QS_aggCtr_(me, s, sig, qs_id);
+    if (c != (QSAggCtr *)0) {
+        ++c->nDisp;
+        if ((*me->vptr->getStateHandler)(me) != s) {
+            ++c->nTran;
+        }
+    }
+    if (qs_id < QS_AGG_AO_MAX) {
+        QSAggHist * const h = &QS_aggPriv_.rtc[qs_id];
+        uint_fast8_t b = 0U; /* log2 bucket of dt */
+        for (QSTimeCtr d = dt; (d != 0U) && (b < (QS_AGG_BUCKETS - 1U));
+             d >>= 1U)
+        {
+            ++b;
+        }
+        ++h->hist[b];
+        if (h->max < dt) {
+            h->max = dt;
+        }
+        if (c == (QSAggCtr *)0) {
+            ++h->lost;
+        }
+        h->obj = me;
+    }
+
+    /* time for the periodic summary? (only one AO produces it) */
+    bool flush = false;
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+    if ((QS_aggPriv_.period != 0U)
+        && ((QSTimeCtr)(t1 - QS_aggPriv_.last) >= QS_aggPriv_.period))
+    {
+        QS_aggPriv_.last = t1;
+        flush = true;
+    }
+    QF_CRIT_X_();
+
+    if (flush) {
+        QS_aggFlush();
+    }
+}
+#endif /*  (QS_AGG_MAX > 0U) */
+
+/*${QS::QS-tx::aggFlush} ...................................................*/
+#if (QS_AGG_MAX > 0U)
+/*! @static @public @memberof QS_tx */
+void QS_aggFlush(void) {
+    QS_CRIT_STAT_
+
+    for (uint_fast16_t i = 0U; i < QS_AGG_MAX; ++i) {
+        QSAggCtr const * const c = &QS_aggPriv_.ctr[i];
+        if (c->obj != (void *)0) {
+            QS_BEGIN_PRE_(QS_AGG_DISPATCH, c->qs_id)
+                QS_TIME_PRE_();        /* time stamp */
+                QS_OBJ_PRE_(c->obj);   /* the AO */
+                QS_SIG_PRE_(c->sig);   /* the signal */
+                QS_FUN_PRE_(c->state); /* the state */
+                QS_U32_PRE_(c->nDisp); /* # dispatched events */
+                QS_U32_PRE_(c->nTran); /* # state changes */
+            QS_END_PRE_()
+        }
+    }
+
+    for (uint_fast8_t i = 0U; i < QS_AGG_AO_MAX; ++i) {
+        QSAggHist const * const h = &QS_aggPriv_.rtc[i];
+        if (h->obj != (void *)0) {
+            /* send the histogram only up to the last non-empty bucket */
+            uint_fast8_t n = QS_AGG_BUCKETS;
+            while ((n > 0U) && (h->hist[n - 1U] == 0U)) {
+                --n;
+            }
+            QS_BEGIN_PRE_(QS_AGG_RTC, i)
+                QS_TIME_PRE_();      /* time stamp */
+                QS_OBJ_PRE_(h->obj); /* the AO */
+                QS_U32_PRE_(h->max); /* the longest RTC step */
+                QS_U32_PRE_(h->lost); /* # dispatches without counter */
+                QS_U8_PRE_(n);       /* # buckets that follow */
+                for (uint_fast8_t b = 0U; b < n; ++b) {
+                    QS_U32_PRE_(h->hist[b]);
+                }
+            QS_END_PRE_()
+        }
+    }
+}
+#endif /*  (QS_AGG_MAX > 0U) */
+
+/*${QS::QS-tx::replayEvt_} .................................................*/
+/*! @static @private @memberof QS_tx */
+void QS_replayEvt_(
+    QEvt const * const e,
+    uint_fast8_t const prio)
+{
+    /* parameters of a dynamic event fill the rest of its pool block,
+    * the size of an immutable event is unknown
+    */
+    uint16_t len = (uint16_t)QS_REPLAY_IMMUTABLE;
+    uint16_t nPar = 0U;
+    #if (QF_MAX_EPOOL > 0U)
+    if (e->poolId_ != 0U) {
+        len = (uint16_t)(QF_EPOOL_EVENT_SIZE_(QF_ePool_[e->poolId_ - 1U])
+                         - sizeof(QEvt));
+        nPar = len;
+    }
+    #endif
+    uint8_t const *par = (uint8_t const *)e;
+    par = &par[sizeof(QEvt)];
+    QS_CRIT_STAT_
+
+    QS_BEGIN_PRE_(QS_REPLAY_EVT, prio)
+        QS_TIME_PRE_();      /* time stamp */
+        QS_U8_PRE_(prio);    /* priority of the AO */
+        QS_SIG_PRE_(e->sig); /* the signal of the event */
+        QS_U16_PRE_(len);    /* # bytes of the parameters or immutable */
+        for (uint16_t i = 0U; i < nPar; ++i) {
+            QS_u8_raw_(par[i]);
+        }
+    QS_END_PRE_()
+}
+
 /*${QS::QS-tx::beginRec_} ..................................................*/
 /*! @static @private @memberof QS_tx */
 void QS_beginRec_(uint_fast8_t const rec) {
-    uint8_t const b = (uint8_t)(QS_priv_.seq + 1U);
+    uint8_t const b = (uint8_t)(QS_TX_.seq + 1U);
     uint8_t chksum  = 0U;                /* reset the checksum */
-    uint8_t * const buf = QS_priv_.buf;  /* put in a temporary (register) */
-    QSCtr head          = QS_priv_.head; /* put in a temporary (register) */
-    QSCtr const end     = QS_priv_.end;  /* put in a temporary (register) */
+    uint8_t * const buf = QS_TX_.buf;  /* put in a temporary (register) */
+    QSCtr head          = QS_TX_.head; /* put in a temporary (register) */
+    QSCtr const end     = QS_TX_.end;  /* put in a temporary (register) */
+
+    if ((QS_TX_.flags & QS_TX_MERGE_FLAG) != 0U) {
+        /* precede the record with its time-stamp, see QS_TX_MERGE_FLAG */
+        QSTimeCtr t = QS_onGetTime();
+        QS_TX_.used += (QSCtr)QS_TIME_SIZE;
+        for (uint_fast8_t i = QS_TIME_SIZE; i != 0U; --i) {
+            QS_INSERT_ESC_BYTE_((uint8_t)t)
+            t >>= 8U;
+        }
+        chksum = 0U; /* the time-stamp is not part of the record */
+    }
 
-    QS_priv_.seq = b; /* store the incremented sequence num */
-    QS_priv_.used += 2U; /* 2 bytes about to be added */
+    QS_TX_.seq = b; /* store the incremented sequence num */
+    QS_TX_.used += 2U; /* 2 bytes about to be added */
 
     QS_INSERT_ESC_BYTE_(b)
 
     chksum = (uint8_t)(chksum + rec); /* update checksum */
     QS_INSERT_BYTE_((uint8_t)rec) /* rec byte does not need escaping */
 
-    QS_priv_.head   = head;   /* save the head */
-    QS_priv_.chksum = chksum; /* save the checksum */
+    QS_TX_.head   = head;   /* save the head */
+    QS_TX_.chksum = chksum; /* save the checksum */
 }
 
 /*${QS::QS-tx::endRec_} ....................................................*/
 /*! @static @private @memberof QS_tx */
 void QS_endRec_(void) {
-    uint8_t * const buf = QS_priv_.buf;  /* put in a temporary (register) */
-    QSCtr   head        = QS_priv_.head;
-    QSCtr const end     = QS_priv_.end;
-    uint8_t b = QS_priv_.chksum;
+    uint8_t * const buf = QS_TX_.buf;  /* put in a temporary (register) */
+    QSCtr   head        = QS_TX_.head;
+    QSCtr const end     = QS_TX_.end;
+    uint8_t b = QS_TX_.chksum;
     b ^= 0xFFU;   /* invert the bits in the checksum */
 
-    QS_priv_.used += 2U; /* 2 bytes about to be added */
+    QS_TX_.used += 2U; /* 2 bytes about to be added */
 
     if ((b != QS_FRAME) && (b != QS_ESC)) {
         QS_INSERT_BYTE_(b)
@@ -453,33 +879,52 @@ void QS_endRec_(void) {
     else {
         QS_INSERT_BYTE_(QS_ESC)
         QS_INSERT_BYTE_(b ^ QS_ESC_XOR)
-        ++QS_priv_.used; /* account for the ESC byte */
+        ++QS_TX_.used; /* account for the ESC byte */
     }
 
     QS_INSERT_BYTE_(QS_FRAME) /* do not escape this QS_FRAME */
 
-    QS_priv_.head = head; /* save the head */
+    QS_TX_.head = head; /* save the head */
 
     /* overrun over the old data? */
-    if (QS_priv_.used > end) {
-        QS_priv_.used = end;   /* the whole buffer is used */
-        QS_priv_.tail = head;  /* shift the tail to the old data */
+    if (QS_TX_.used > end) {
+        QS_TX_.used = end;   /* the whole buffer is used */
+        QS_TX_.tail = head;  /* shift the tail to the old data */
+
+        if ((QS_TX_.flags & QS_TX_MERGE_FLAG) != 0U) {
+            /* discard the partially overwritten record, so that the tail
+            * is left at the beginning of the next complete record
+            */
+            QSCtr tail = head;
+            QSCtr used = end;
+            uint8_t c;
+            do {
+                c = buf[tail];
+                ++tail;
+                if (tail == end) {
+                    tail = 0U;
+                }
+                --used;
+            } while ((c != QS_FRAME) && (used != 0U));
+            QS_TX_.tail = tail;
+            QS_TX_.used = used;
+        }
     }
 }
 
 /*${QS::QS-tx::u8_raw_} ....................................................*/
 /*! @static @private @memberof QS_tx */
 void QS_u8_raw_(uint8_t const d) {
-    uint8_t chksum = QS_priv_.chksum;    /* put in a temporary (register) */
-    uint8_t * const buf = QS_priv_.buf;  /* put in a temporary (register) */
-    QSCtr head          = QS_priv_.head; /* put in a temporary (register) */
-    QSCtr const end     = QS_priv_.end;  /* put in a temporary (register) */
+    uint8_t chksum = QS_TX_.chksum;    /* put in a temporary (register) */
+    uint8_t * const buf = QS_TX_.buf;  /* put in a temporary (register) */
+    QSCtr head          = QS_TX_.head; /* put in a temporary (register) */
+    QSCtr const end     = QS_TX_.end;  /* put in a temporary (register) */
 
-    QS_priv_.used += 1U; /* 1 byte about to be added */
+    QS_TX_.used += 1U; /* 1 byte about to be added */
     QS_INSERT_ESC_BYTE_(d)
 
-    QS_priv_.head   = head;    /* save the head */
-    QS_priv_.chksum = chksum;  /* save the checksum */
+    QS_TX_.head   = head;    /* save the head */
+    QS_TX_.chksum = chksum;  /* save the checksum */
 }
 
 /*${QS::QS-tx::2u8_raw_} ...................................................*/
@@ -488,55 +933,55 @@ void QS_2u8_raw_(
     uint8_t const d1,
     uint8_t const d2)
 {
-    uint8_t chksum = QS_priv_.chksum;    /* put in a temporary (register) */
-    uint8_t * const buf = QS_priv_.buf;  /* put in a temporary (register) */
-    QSCtr head          = QS_priv_.head; /* put in a temporary (register) */
-    QSCtr const end     = QS_priv_.end;  /* put in a temporary (register) */
+    uint8_t chksum = QS_TX_.chksum;    /* put in a temporary (register) */
+    uint8_t * const buf = QS_TX_.buf;  /* put in a temporary (register) */
+    QSCtr head          = QS_TX_.head; /* put in a temporary (register) */
+    QSCtr const end     = QS_TX_.end;  /* put in a temporary (register) */
 
-    QS_priv_.used += 2U; /* 2 bytes are about to be added */
+    QS_TX_.used += 2U; /* 2 bytes are about to be added */
     QS_INSERT_ESC_BYTE_(d1)
     QS_INSERT_ESC_BYTE_(d2)
 
-    QS_priv_.head   = head;    /* save the head */
-    QS_priv_.chksum = chksum;  /* save the checksum */
+    QS_TX_.head   = head;    /* save the head */
+    QS_TX_.chksum = chksum;  /* save the checksum */
 }
 
 /*${QS::QS-tx::u16_raw_} ...................................................*/
 /*! @static @private @memberof QS_tx */
 void QS_u16_raw_(uint16_t const d) {
-    uint8_t chksum = QS_priv_.chksum;    /* put in a temporary (register) */
-    uint8_t * const buf = QS_priv_.buf;  /* put in a temporary (register) */
-    QSCtr head          = QS_priv_.head; /* put in a temporary (register) */
-    QSCtr const end     = QS_priv_.end;  /* put in a temporary (register) */
+    uint8_t chksum = QS_TX_.chksum;    /* put in a temporary (register) */
+    uint8_t * const buf = QS_TX_.buf;  /* put in a temporary (register) */
+    QSCtr head          = QS_TX_.head; /* put in a temporary (register) */
+    QSCtr const end     = QS_TX_.end;  /* put in a temporary (register) */
     uint16_t x   = d;
 
-    QS_priv_.used += 2U; /* 2 bytes are about to be added */
+    QS_TX_.used += 2U; /* 2 bytes are about to be added */
 
     QS_INSERT_ESC_BYTE_((uint8_t)x)
     x >>= 8U;
     QS_INSERT_ESC_BYTE_((uint8_t)x)
 
-    QS_priv_.head   = head;    /* save the head */
-    QS_priv_.chksum = chksum;  /* save the checksum */
+    QS_TX_.head   = head;    /* save the head */
+    QS_TX_.chksum = chksum;  /* save the checksum */
 }
 
 /*${QS::QS-tx::u32_raw_} ...................................................*/
 /*! @static @private @memberof QS_tx */
 void QS_u32_raw_(uint32_t const d) {
-    uint8_t chksum = QS_priv_.chksum;    /* put in a temporary (register) */
-    uint8_t * const buf = QS_priv_.buf;  /* put in a temporary (register) */
-    QSCtr head          = QS_priv_.head; /* put in a temporary (register) */
-    QSCtr const end     = QS_priv_.end;  /* put in a temporary (register) */
+    uint8_t chksum = QS_TX_.chksum;    /* put in a temporary (register) */
+    uint8_t * const buf = QS_TX_.buf;  /* put in a temporary (register) */
+    QSCtr head          = QS_TX_.head; /* put in a temporary (register) */
+    QSCtr const end     = QS_TX_.end;  /* put in a temporary (register) */
     uint32_t x = d;
 
-    QS_priv_.used += 4U; /* 4 bytes are about to be added */
+    QS_TX_.used += 4U; /* 4 bytes are about to be added */
     for (uint_fast8_t i = 4U; i != 0U; --i) {
         QS_INSERT_ESC_BYTE_((uint8_t)x)
         x >>= 8U;
     }
 
-    QS_priv_.head   = head;    /* save the head */
-    QS_priv_.chksum = chksum;  /* save the checksum */
+    QS_TX_.head   = head;    /* save the head */
+    QS_TX_.chksum = chksum;  /* save the checksum */
 }
 
 /*${QS::QS-tx::obj_raw_} ...................................................*/
@@ -558,11 +1003,11 @@ void QS_obj_raw_(void const * const obj) {
 /*${QS::QS-tx::str_raw_} ...................................................*/
 /*! @static @private @memberof QS_tx */
 void QS_str_raw_(char const * const str) {
-    uint8_t chksum = QS_priv_.chksum;    /* put in a temporary (register) */
-    uint8_t * const buf = QS_priv_.buf;  /* put in a temporary (register) */
-    QSCtr head          = QS_priv_.head; /* put in a temporary (register) */
-    QSCtr const end     = QS_priv_.end;  /* put in a temporary (register) */
-    QSCtr used          = QS_priv_.used; /* put in a temporary (register) */
+    uint8_t chksum = QS_TX_.chksum;    /* put in a temporary (register) */
+    uint8_t * const buf = QS_TX_.buf;  /* put in a temporary (register) */
+    QSCtr head          = QS_TX_.head; /* put in a temporary (register) */
+    QSCtr const end     = QS_TX_.end;  /* put in a temporary (register) */
+    QSCtr used          = QS_TX_.used; /* put in a temporary (register) */
 
     for (char const *s = str; *s != '\0'; ++s) {
         chksum += (uint8_t)*s; /* update checksum */
@@ -572,9 +1017,9 @@ void QS_str_raw_(char const * const str) {
     QS_INSERT_BYTE_((uint8_t)'\0')  /* zero-terminate the string */
     ++used;
 
-    QS_priv_.head   = head;   /* save the head */
-    QS_priv_.chksum = chksum; /* save the checksum */
-    QS_priv_.used   = used;   /* save # of used buffer space */
+    QS_TX_.head   = head;   /* save the head */
+    QS_TX_.chksum = chksum; /* save the checksum */
+    QS_TX_.used   = used;   /* save # of used buffer space */
 }
 
 /*${QS::QS-tx::u8_fmt_} ....................................................*/
@@ -583,18 +1028,18 @@ void QS_u8_fmt_(
     uint8_t const format,
     uint8_t const d)
 {
-    uint8_t chksum = QS_priv_.chksum;    /* put in a temporary (register) */
-    uint8_t * const buf = QS_priv_.buf;  /* put in a temporary (register) */
-    QSCtr   head        = QS_priv_.head; /* put in a temporary (register) */
-    QSCtr const end     = QS_priv_.end;  /* put in a temporary (register) */
+    uint8_t chksum = QS_TX_.chksum;    /* put in a temporary (register) */
+    uint8_t * const buf = QS_TX_.buf;  /* put in a temporary (register) */
+    QSCtr   head        = QS_TX_.head; /* put in a temporary (register) */
+    QSCtr const end     = QS_TX_.end;  /* put in a temporary (register) */
 
-    QS_priv_.used += 2U; /* 2 bytes about to be added */
+    QS_TX_.used += 2U; /* 2 bytes about to be added */
 
     QS_INSERT_ESC_BYTE_(format)
     QS_INSERT_ESC_BYTE_(d)
 
-    QS_priv_.head   = head;   /* save the head */
-    QS_priv_.chksum = chksum; /* save the checksum */
+    QS_TX_.head   = head;   /* save the head */
+    QS_TX_.chksum = chksum; /* save the checksum */
 }
 
 /*${QS::QS-tx::u16_fmt_} ...................................................*/
@@ -603,21 +1048,21 @@ void QS_u16_fmt_(
     uint8_t const format,
     uint16_t const d)
 {
-    uint8_t chksum = QS_priv_.chksum;    /* put in a temporary (register) */
-    uint8_t * const buf = QS_priv_.buf;  /* put in a temporary (register) */
-    QSCtr head          = QS_priv_.head; /* put in a temporary (register) */
-    QSCtr const end     = QS_priv_.end;  /* put in a temporary (register) */
+    uint8_t chksum = QS_TX_.chksum;    /* put in a temporary (register) */
+    uint8_t * const buf = QS_TX_.buf;  /* put in a temporary (register) */
+    QSCtr head          = QS_TX_.head; /* put in a temporary (register) */
+    QSCtr const end     = QS_TX_.end;  /* put in a temporary (register) */
     uint8_t b = (uint8_t)d;
 
-    QS_priv_.used += 3U; /* 3 bytes about to be added */
+    QS_TX_.used += 3U; /* 3 bytes about to be added */
 
     QS_INSERT_ESC_BYTE_(format)
     QS_INSERT_ESC_BYTE_(b)
     b = (uint8_t)(d >> 8U);
     QS_INSERT_ESC_BYTE_(b)
 
-    QS_priv_.head   = head;   /* save the head */
-    QS_priv_.chksum = chksum; /* save the checksum */
+    QS_TX_.head   = head;   /* save the head */
+    QS_TX_.chksum = chksum; /* save the checksum */
 }
 
 /*${QS::QS-tx::u32_fmt_} ...................................................*/
@@ -626,13 +1071,13 @@ void QS_u32_fmt_(
     uint8_t const format,
     uint32_t const d)
 {
-    uint8_t chksum = QS_priv_.chksum;    /* put in a temporary (register) */
-    uint8_t * const buf = QS_priv_.buf;  /* put in a temporary (register) */
-    QSCtr head          = QS_priv_.head; /* put in a temporary (register) */
-    QSCtr const end     = QS_priv_.end;  /* put in a temporary (register) */
+    uint8_t chksum = QS_TX_.chksum;    /* put in a temporary (register) */
+    uint8_t * const buf = QS_TX_.buf;  /* put in a temporary (register) */
+    QSCtr head          = QS_TX_.head; /* put in a temporary (register) */
+    QSCtr const end     = QS_TX_.end;  /* put in a temporary (register) */
     uint32_t x = d;
 
-    QS_priv_.used += 5U; /* 5 bytes about to be added */
+    QS_TX_.used += 5U; /* 5 bytes about to be added */
     QS_INSERT_ESC_BYTE_(format) /* insert the format byte */
 
     /* insert 4 bytes... */
@@ -641,18 +1086,18 @@ void QS_u32_fmt_(
         x >>= 8U;
     }
 
-    QS_priv_.head   = head;   /* save the head */
-    QS_priv_.chksum = chksum; /* save the checksum */
+    QS_TX_.head   = head;   /* save the head */
+    QS_TX_.chksum = chksum; /* save the checksum */
 }
 
 /*${QS::QS-tx::str_fmt_} ...................................................*/
 /*! @static @private @memberof QS_tx */
 void QS_str_fmt_(char const * const str) {
-    uint8_t chksum = QS_priv_.chksum;
-    uint8_t * const buf = QS_priv_.buf;  /* put in a temporary (register) */
-    QSCtr head          = QS_priv_.head; /* put in a temporary (register) */
-    QSCtr const end     = QS_priv_.end;  /* put in a temporary (register) */
-    QSCtr used          = QS_priv_.used; /* put in a temporary (register) */
+    uint8_t chksum = QS_TX_.chksum;
+    uint8_t * const buf = QS_TX_.buf;  /* put in a temporary (register) */
+    QSCtr head          = QS_TX_.head; /* put in a temporary (register) */
+    QSCtr const end     = QS_TX_.end;  /* put in a temporary (register) */
+    QSCtr used          = QS_TX_.used; /* put in a temporary (register) */
 
     used += 2U; /* account for the format byte and the terminating-0 */
     QS_INSERT_BYTE_((uint8_t)QS_STR_T)
@@ -665,9 +1110,9 @@ void QS_str_fmt_(char const * const str) {
     }
     QS_INSERT_BYTE_(0U) /* zero-terminate the string */
 
-    QS_priv_.head   = head;    /* save the head */
-    QS_priv_.chksum = chksum;  /* save the checksum */
-    QS_priv_.used   = used;    /* save # of used buffer space */
+    QS_TX_.head   = head;    /* save the head */
+    QS_TX_.chksum = chksum;  /* save the checksum */
+    QS_TX_.used   = used;    /* save # of used buffer space */
 }
 
 /*${QS::QS-tx::mem_fmt_} ...................................................*/
@@ -676,13 +1121,13 @@ void QS_mem_fmt_(
     uint8_t const * const blk,
     uint8_t const size)
 {
-    uint8_t chksum = QS_priv_.chksum;
-    uint8_t * const buf = QS_priv_.buf;  /* put in a temporary (register) */
-    QSCtr head          = QS_priv_.head; /* put in a temporary (register) */
-    QSCtr const end     = QS_priv_.end;  /* put in a temporary (register) */
+    uint8_t chksum = QS_TX_.chksum;
+    uint8_t * const buf = QS_TX_.buf;  /* put in a temporary (register) */
+    QSCtr head          = QS_TX_.head; /* put in a temporary (register) */
+    QSCtr const end     = QS_TX_.end;  /* put in a temporary (register) */
     uint8_t const *pb   = blk;
 
-    QS_priv_.used += ((QSCtr)size + 2U); /* size+2 bytes to be added */
+    QS_TX_.used += ((QSCtr)size + 2U); /* size+2 bytes to be added */
 
     QS_INSERT_BYTE_((uint8_t)QS_MEM_T)
     chksum += (uint8_t)QS_MEM_T;
@@ -694,8 +1139,8 @@ void QS_mem_fmt_(
         ++pb;
     }
 
-    QS_priv_.head   = head;   /* save the head */
-    QS_priv_.chksum = chksum; /* save the checksum */
+    QS_TX_.head   = head;   /* save the head */
+    QS_TX_.chksum = chksum; /* save the checksum */
 }
 
 /*${QS::QS-tx::sig_dict_pre_} ..............................................*/
@@ -55,12 +55,12 @@
 /*${QS::QS-tx-64bit::u64_raw_} .............................................*/
 /*! @static @private @memberof QS_tx */
 void QS_u64_raw_(uint64_t d) {
-    uint8_t chksum      = QS_priv_.chksum;
-    uint8_t * const buf = QS_priv_.buf;
-    QSCtr head          = QS_priv_.head;
-    QSCtr const end     = QS_priv_.end;
+    uint8_t chksum      = QS_TX_.chksum;
+    uint8_t * const buf = QS_TX_.buf;
+    QSCtr head          = QS_TX_.head;
+    QSCtr const end     = QS_TX_.end;
 
-    QS_priv_.used += 8U; /* 8 bytes are about to be added */
+    QS_TX_.used += 8U; /* 8 bytes are about to be added */
     uint_fast8_t i;
     for (i = 8U; i != 0U; --i) {
         uint8_t const b = (uint8_t)d;
@@ -68,8 +68,8 @@ void QS_u64_raw_(uint64_t d) {
         d >>= 8U;
     }
 
-    QS_priv_.head   = head;   /* save the head */
-    QS_priv_.chksum = chksum; /* save the checksum */
+    QS_TX_.head   = head;   /* save the head */
+    QS_TX_.chksum = chksum; /* save the checksum */
 }
 
 /*${QS::QS-tx-64bit::u64_fmt_} .............................................*/
@@ -78,12 +78,12 @@ void QS_u64_fmt_(
     uint8_t format,
     uint64_t d)
 {
-    uint8_t chksum      = QS_priv_.chksum;
-    uint8_t * const buf = QS_priv_.buf;
-    QSCtr head          = QS_priv_.head;
-    QSCtr const end     = QS_priv_.end;
+    uint8_t chksum      = QS_TX_.chksum;
+    uint8_t * const buf = QS_TX_.buf;
+    QSCtr head          = QS_TX_.head;
+    QSCtr const end     = QS_TX_.end;
 
-    QS_priv_.used += 9U; /* 9 bytes are about to be added */
+    QS_TX_.used += 9U; /* 9 bytes are about to be added */
     QS_INSERT_ESC_BYTE_(format) /* insert the format byte */
 
     /* output 8 bytes of data... */
@@ -94,7 +94,7 @@ void QS_u64_fmt_(
         d >>= 8U;
     }
 
-    QS_priv_.head   = head;   /* save the head */
-    QS_priv_.chksum = chksum; /* save the checksum */
+    QS_TX_.head   = head;   /* save the head */
+    QS_TX_.chksum = chksum; /* save the checksum */
 }
 /*$enddef${QS::QS-tx-64bit} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
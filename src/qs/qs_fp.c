@@ -62,15 +62,15 @@ void QS_f32_fmt_(
         float32_t f;
         uint32_t  u;
     } fu32;  /* the internal binary representation */
-    uint8_t chksum      = QS_priv_.chksum; /* put in a temporary (register) */
-    uint8_t * const buf = QS_priv_.buf;
-    QSCtr head          = QS_priv_.head;
-    QSCtr const end     = QS_priv_.end;
+    uint8_t chksum      = QS_TX_.chksum; /* put in a temporary (register) */
+    uint8_t * const buf = QS_TX_.buf;
+    QSCtr head          = QS_TX_.head;
+    QSCtr const end     = QS_TX_.end;
     uint_fast8_t i;
 
     fu32.f = d; /* assign the binary representation */
 
-    QS_priv_.used += 5U; /* 5 bytes about to be added */
+    QS_TX_.used += 5U; /* 5 bytes about to be added */
     QS_INSERT_ESC_BYTE_(format) /* insert the format byte */
 
     /* insert 4 bytes... */
@@ -79,8 +79,8 @@ void QS_f32_fmt_(
         fu32.u >>= 8U;
     }
 
-    QS_priv_.head   = head;   /* save the head */
-    QS_priv_.chksum = chksum; /* save the checksum */
+    QS_TX_.head   = head;   /* save the head */
+    QS_TX_.chksum = chksum; /* save the checksum */
 }
 
 /*${QS::QS-tx-fp::f64_fmt_} ................................................*/
@@ -93,10 +93,10 @@ void QS_f64_fmt_(
         float64_t d;
         uint32_t  u[2];
     } fu64; /* the internal binary representation */
-    uint8_t chksum      = QS_priv_.chksum;
-    uint8_t * const buf = QS_priv_.buf;
-    QSCtr head          = QS_priv_.head;
-    QSCtr const end     = QS_priv_.end;
+    uint8_t chksum      = QS_TX_.chksum;
+    uint8_t * const buf = QS_TX_.buf;
+    QSCtr head          = QS_TX_.head;
+    QSCtr const end     = QS_TX_.end;
     uint32_t i;
 
     /* static constant untion to detect endianness of the machine */
@@ -115,7 +115,7 @@ void QS_f64_fmt_(
         fu64.u[1] = i;
     }
 
-    QS_priv_.used += 9U; /* 9 bytes about to be added */
+    QS_TX_.used += 9U; /* 9 bytes about to be added */
     QS_INSERT_ESC_BYTE_(format) /* insert the format byte */
 
     /* output 4 bytes from fu64.u[0]... */
@@ -130,7 +130,7 @@ void QS_f64_fmt_(
         fu64.u[1] >>= 8U;
     }
 
-    QS_priv_.head   = head;   /* save the head */
-    QS_priv_.chksum = chksum; /* save the checksum */
+    QS_TX_.head   = head;   /* save the head */
+    QS_TX_.chksum = chksum; /* save the checksum */
 }
 /*$enddef${QS::QS-tx-fp} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
@@ -107,6 +107,8 @@ typedef struct {
     uint8_t *p;
     QSignal  sig;
     uint16_t len;
+    uint16_t num;  /* # events in the batch (QS_RX_EVENT_BATCH) */
+    uint16_t n;    /* # events of the batch allocated so far */
     uint8_t  prio;
     uint8_t  idx;
 } EvtVar;
@@ -167,7 +169,13 @@ enum {
     WAIT4_EVT_SIG,
     WAIT4_EVT_LEN,
     WAIT4_EVT_PAR,
-    WAIT4_EVT_FRAME
+    WAIT4_EVT_FRAME,
+    WAIT4_BATCH_PRIO,
+    WAIT4_BATCH_NUM,
+    WAIT4_BATCH_SIG,
+    WAIT4_BATCH_LEN,
+    WAIT4_BATCH_PAR,
+    WAIT4_BATCH_FRAME
 
 #ifdef Q_UTEST
     ,
@@ -180,6 +188,14 @@ enum {
 #endif /* Q_UTEST */
 };
 
+#ifndef QS_RX_BATCH_MAX
+/* maximum number of events in the QS_RX_EVENT_BATCH record */
+#define QS_RX_BATCH_MAX 32U
+#endif
+
+/* events of the QS_RX_EVENT_BATCH record being received */
+static QEvt *l_batch[QS_RX_BATCH_MAX];
+
 /* static helper functions... */
 static void QS_rxParseData_(uint8_t const b);
 //static void QS_rxHandleGoodFrame_(uint8_t const state);
@@ -188,6 +204,11 @@ static void QS_rxReportAck_(int8_t const recId);
 static void QS_rxReportError_(int8_t const code);
 static void QS_rxReportDone_(int8_t const recId);
 static void QS_rxPoke_(void);
+static QSCtr QS_rxScan_(uint8_t const * const p, QSCtr const n);
+static uint8_t QS_rxInjectEvt_(QEvt * const e, uint8_t const prio);
+static void QS_rxBatchNext_(void);
+static void QS_rxBatchGc_(void);
+static void QS_rxParseFrame_(uint8_t const * const p, QSCtr const n);
 
 /*! Internal QS-RX macro to encapsulate transition in the QS-RX FSM */
 #define QS_RX_TRAN_(target_) (l_rx.state = (uint8_t)(target_))
@@ -325,45 +346,69 @@ void QS_queryCurrObj(uint8_t const obj_kind) {
 /*${QS::QS-rx::rxParse} ....................................................*/
 /*! @static @public @memberof QS_rx */
 void QS_rxParse(void) {
-    QSCtr tail = QS_rxPriv_.tail;
-    while (QS_rxPriv_.head != tail) { /* QS-RX buffer NOT empty? */
-        uint8_t b = QS_rxPriv_.buf[tail];
+    while (QS_rxPriv_.head != QS_rxPriv_.tail) { /* QS-RX buffer NOT empty? */
+        QSCtr tail = QS_rxPriv_.tail;
+        QSCtr const head = QS_rxPriv_.head;
+        QSCtr const n = (head > tail)
+                        ? (head - tail)
+                        : (QS_rxPriv_.end - tail); /* contiguous part */
+        uint8_t const * const p = &QS_rxPriv_.buf[tail];
 
-        ++tail;
-        if (tail == QS_rxPriv_.end) {
-            tail = 0U;
+        /* at the frame boundary, find the end of the frame */
+        QSCtr const len = ((l_rx.state == (uint8_t)WAIT4_SEQ)
+                           && (l_rx.esc == 0U))
+                          ? QS_rxScan_(p, n)
+                          : n;
+        if ((len < n) && (p[len] == QS_FRAME)) { /* frame w/o escapes? */
+            /* update the tail to a *valid* index past the frame,
+            * which is parsed directly from the QS-RX buffer
+            */
+            tail += len + 1U;
+            if (tail == QS_rxPriv_.end) {
+                tail = 0U;
+            }
+            QS_rxPriv_.tail = tail;
+            QS_rxParseFrame_(p, len);
         }
-        QS_rxPriv_.tail = tail; /* update the tail to a *valid* index */
+        else { /* escaped or incomplete frame, parse the next byte */
+            uint8_t b = *p;
 
-        if (l_rx.esc != 0U) {  /* escaped byte arrived? */
-            l_rx.esc = 0U;
-            b ^= QS_ESC_XOR;
+            ++tail;
+            if (tail == QS_rxPriv_.end) {
+                tail = 0U;
+            }
+            QS_rxPriv_.tail = tail; /* update the tail to a *valid* index */
 
-            l_rx.chksum += b;
-            QS_rxParseData_(b);
-        }
-        else if (b == QS_ESC) {
-            l_rx.esc = 1U;
-        }
-        else if (b == QS_FRAME) {
-            /* get ready for the next frame */
-            b = l_rx.state; /* save the current state in b */
-            l_rx.esc = 0U;
-            QS_RX_TRAN_(WAIT4_SEQ);
+            if (l_rx.esc != 0U) {  /* escaped byte arrived? */
+                l_rx.esc = 0U;
+                b ^= QS_ESC_XOR;
 
-            if (l_rx.chksum == QS_GOOD_CHKSUM) {
-                l_rx.chksum = 0U;
-                QS_rxHandleGoodFrame_(b);
+                l_rx.chksum += b;
+                QS_rxParseData_(b);
             }
-            else { /* bad checksum */
-                l_rx.chksum = 0U;
-                QS_rxReportError_(0x41);
-                QS_rxHandleBadFrame_(b);
+            else if (b == QS_ESC) {
+                l_rx.esc = 1U;
+            }
+            else if (b == QS_FRAME) {
+                /* get ready for the next frame */
+                b = l_rx.state; /* save the current state in b */
+                l_rx.esc = 0U;
+                QS_RX_TRAN_(WAIT4_SEQ);
+
+                if (l_rx.chksum == QS_GOOD_CHKSUM) {
+                    l_rx.chksum = 0U;
+                    QS_rxHandleGoodFrame_(b);
+                }
+                else { /* bad checksum */
+                    l_rx.chksum = 0U;
+                    QS_rxReportError_(0x41);
+                    QS_rxHandleBadFrame_(b);
+                }
+            }
+            else {
+                l_rx.chksum += b;
+                QS_rxParseData_(b);
             }
-        }
-        else {
-            l_rx.chksum += b;
-            QS_rxParseData_(b);
         }
     }
 }
@@ -556,84 +601,7 @@ void QS_rxHandleGoodFrame_(uint8_t const state) {
         }
         case WAIT4_EVT_FRAME: {
             /* NOTE: Ack was already reported in the WAIT4_EVT_LEN state */
-    #ifdef Q_UTEST
-            QS_onTestEvt(l_rx.var.evt.e); /* adjust the event, if needed */
-    #endif /* Q_UTEST */
-            i = 0U; /* use 'i' as status, 0 == success,no-recycle */
-
-            if (l_rx.var.evt.prio == 0U) { /* publish */
-                QActive_publish_(l_rx.var.evt.e, &QS_rxPriv_, 0U);
-            }
-            else if (l_rx.var.evt.prio < QF_MAX_ACTIVE) {
-                if (!QACTIVE_POST_X(QActive_registry_[l_rx.var.evt.prio],
-                               l_rx.var.evt.e,
-                               0U, /* margin */
-                               &QS_rxPriv_))
-                {
-                    /* failed QACTIVE_POST() recycles the event */
-                    i = 0x80U; /* failure status, no recycle */
-                }
-            }
-            else if (l_rx.var.evt.prio == 255U) { /* special prio */
-                /* dispatch to the current SM object */
-                if (QS_rxPriv_.currObj[SM_OBJ] != (void *)0) {
-                    /* increment the ref-ctr to simulate the situation
-                    * when the event is just retreived from a queue.
-                    * This is expected for the following QF_gc() call.
-                    */
-                    ++l_rx.var.evt.e->refCtr_;
-
-                    QHSM_DISPATCH((QHsm *)QS_rxPriv_.currObj[SM_OBJ],
-                                  l_rx.var.evt.e, 0U);
-                    i = 0x01U;  /* success status, recycle needed */
-                }
-                else {
-                    i = 0x81U;  /* failure status, recycle needed */
-                }
-            }
-            else if (l_rx.var.evt.prio == 254U) { /* special prio */
-                /* init the current SM object" */
-                if (QS_rxPriv_.currObj[SM_OBJ] != (void *)0) {
-                    /* increment the ref-ctr to simulate the situation
-                    * when the event is just retreived from a queue.
-                    * This is expected for the following QF_gc() call.
-                    */
-                    ++l_rx.var.evt.e->refCtr_;
-
-                    QHSM_INIT((QHsm *)QS_rxPriv_.currObj[SM_OBJ],
-                              l_rx.var.evt.e, 0U);
-                    i = 0x01U;  /* success status, recycle needed */
-                }
-                else {
-                    i = 0x81U;  /* failure status, recycle needed */
-                }
-            }
-            else if (l_rx.var.evt.prio == 253U) { /* special prio */
-                /* post to the current AO */
-                if (QS_rxPriv_.currObj[AO_OBJ] != (void *)0) {
-                    if (!QACTIVE_POST_X(
-                            (QActive *)QS_rxPriv_.currObj[AO_OBJ],
-                            l_rx.var.evt.e,
-                            0U, /* margin */
-                            &QS_rxPriv_))
-                    {
-                        /* failed QACTIVE_POST() recycles the event */
-                        i = 0x80U;  /* failure status, no recycle */
-                    }
-                }
-                else {
-                    i = 0x81U;  /* failure status, recycle needed */
-                }
-            }
-            else {
-                i = 0x81U;  /* failure status, recycle needed */
-            }
-
-    #if (QF_MAX_EPOOL > 0U)
-            if ((i & 0x01U) != 0U) { /* recycle needed? */
-                QF_gc(l_rx.var.evt.e);
-            }
-    #endif
+            i = QS_rxInjectEvt_(l_rx.var.evt.e, l_rx.var.evt.prio);
             if ((i & 0x80U) != 0U) { /* failure? */
                 QS_rxReportError_((int8_t)QS_RX_EVENT);
             }
@@ -647,6 +615,42 @@ void QS_rxHandleGoodFrame_(uint8_t const state) {
             }
             break;
         }
+        case WAIT4_BATCH_FRAME: {
+            /* NOTE: Ack was already reported in the WAIT4_BATCH_NUM state */
+            i = 0U;
+            for (uint_fast16_t k = 0U; k < l_rx.var.evt.n; ++k) {
+                if ((i & 0x80U) == 0U) { /* no failure so far? */
+                    i = QS_rxInjectEvt_(l_batch[k], l_rx.var.evt.prio);
+    #ifdef Q_UTEST
+    #if Q_UTEST != 0
+                    if ((i & 0x80U) == 0U) {
+                        QS_processTestEvts_(); /* process events produced */
+                    }
+    #endif  /* Q_UTEST != 0 */
+    #endif  /* Q_UTEST */
+                }
+    #if (QF_MAX_EPOOL > 0U)
+                else { /* don't leak the remaining events */
+                    QF_gc(l_batch[k]);
+                }
+    #endif
+            }
+            l_rx.var.evt.n = 0U;
+            if ((i & 0x80U) != 0U) { /* failure? */
+                QS_rxReportError_((int8_t)QS_RX_EVENT_BATCH);
+            }
+            else { /* Done once for the whole batch */
+                QS_rxReportDone_((int8_t)QS_RX_EVENT_BATCH);
+            }
+            break;
+        }
+        case WAIT4_BATCH_SIG:  /* intentionally fall-through */
+        case WAIT4_BATCH_LEN:  /* intentionally fall-through */
+        case WAIT4_BATCH_PAR: {
+            QS_rxBatchGc_(); /* truncated batch */
+            QS_rxReportError_((int8_t)QS_RX_EVENT_BATCH);
+            break;
+        }
 
     #ifdef Q_UTEST
         case WAIT4_TEST_SETUP_FRAME: {
@@ -708,6 +712,39 @@ bool QS_RX_PUT(uint8_t const b) {
         return false; /* byte NOT placed in the buffer */
     }
 }
+
+/*${QS::QS-rx::rxPutBuf} ...................................................*/
+/*! @static @public @memberof QS_rx */
+uint16_t QS_rxPutBuf(
+    uint8_t const * const buf,
+    uint16_t const len)
+{
+    QSCtr head = QS_rxPriv_.head;
+    QSCtr const tail = QS_rxPriv_.tail;
+    uint16_t n = 0U;
+    while (n < len) {
+        /* contiguous free space (one slot always stays empty) */
+        QSCtr nFree = (head >= tail)
+                      ? (QS_rxPriv_.end - head - ((tail == 0U) ? 1U : 0U))
+                      : (tail - head - 1U);
+        if (nFree == 0U) { /* buffer full? */
+            break;
+        }
+        if (nFree > (QSCtr)(len - n)) {
+            nFree = (QSCtr)(len - n);
+        }
+        for (QSCtr i = 0U; i < nFree; ++i) {
+            QS_rxPriv_.buf[head + i] = buf[n + i];
+        }
+        n    += (uint16_t)nFree;
+        head += nFree;
+        if (head == QS_rxPriv_.end) {
+            head = 0U;
+        }
+        QS_rxPriv_.head = head; /* update the head to a *valid* index */
+    }
+    return n; /* number of bytes placed in the buffer */
+}
 /*$enddef${QS::QS-rx} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
 
 /*==========================================================================*/
@@ -780,6 +817,9 @@ static void QS_rxParseData_(uint8_t const b) {
                 case (uint8_t)QS_RX_EVENT:
                     QS_RX_TRAN_(WAIT4_EVT_PRIO);
                     break;
+                case (uint8_t)QS_RX_EVENT_BATCH:
+                    QS_RX_TRAN_(WAIT4_BATCH_PRIO);
+                    break;
 
 #ifdef Q_UTEST
                 case (uint8_t)QS_RX_TEST_SETUP:
@@ -1100,6 +1140,88 @@ static void QS_rxParseData_(uint8_t const b) {
             /* keep ignoring the data until a frame is collected */
             break;
         }
+        case (uint8_t)WAIT4_BATCH_PRIO: {
+            l_rx.var.evt.prio = b;
+            l_rx.var.evt.num  = 0U;
+            l_rx.var.evt.n    = 0U;
+            l_rx.var.evt.idx  = 0U;
+            QS_RX_TRAN_(WAIT4_BATCH_NUM);
+            break;
+        }
+        case (uint8_t)WAIT4_BATCH_NUM: {
+            l_rx.var.evt.num |= (uint16_t)((uint32_t)b << l_rx.var.evt.idx);
+            l_rx.var.evt.idx += 8U;
+            if (l_rx.var.evt.idx == (8U * 2U)) {
+                if ((l_rx.var.evt.num > 0U)
+                    && (l_rx.var.evt.num <= QS_RX_BATCH_MAX))
+                {
+                    /* report Ack before generating any other QS records */
+                    QS_rxReportAck_((int8_t)QS_RX_EVENT_BATCH);
+                    QS_rxBatchNext_();
+                }
+                else {
+                    QS_rxReportError_((int8_t)QS_RX_EVENT_BATCH);
+                    QS_RX_TRAN_(ERROR_STATE);
+                }
+            }
+            break;
+        }
+        case (uint8_t)WAIT4_BATCH_SIG: {
+            l_rx.var.evt.sig |= (QSignal)((uint32_t)b << l_rx.var.evt.idx);
+            l_rx.var.evt.idx += 8U;
+            if (l_rx.var.evt.idx == (uint8_t)(8U * Q_SIGNAL_SIZE)) {
+                l_rx.var.evt.len = 0U;
+                l_rx.var.evt.idx = 0U;
+                QS_RX_TRAN_(WAIT4_BATCH_LEN);
+            }
+            break;
+        }
+        case (uint8_t)WAIT4_BATCH_LEN: {
+            l_rx.var.evt.len |= (uint16_t)((uint32_t)b << l_rx.var.evt.idx);
+            l_rx.var.evt.idx += 8U;
+            if (l_rx.var.evt.idx == (8U * 2U)) {
+                QEvt *e = (QEvt *)0;
+                if ((l_rx.var.evt.len + sizeof(QEvt)) <=
+                    QF_poolGetMaxBlockSize())
+                {
+                    e = QF_newX_(
+                        ((uint_fast16_t)l_rx.var.evt.len + sizeof(QEvt)),
+                        0U, /* margin */
+                        (enum_t)l_rx.var.evt.sig);
+                }
+                if (e != (QEvt *)0) { /* evt allocated? */
+                    l_batch[l_rx.var.evt.n] = e;
+                    ++l_rx.var.evt.n;
+                    l_rx.var.evt.p = (uint8_t *)e;
+                    l_rx.var.evt.p = &l_rx.var.evt.p[sizeof(QEvt)];
+                    if (l_rx.var.evt.len > 0U) {
+                        QS_RX_TRAN_(WAIT4_BATCH_PAR);
+                    }
+                    else {
+                        QS_rxBatchNext_();
+                    }
+                }
+                else {
+                    QS_rxBatchGc_();
+                    QS_rxReportError_((int8_t)QS_RX_EVENT_BATCH);
+                    QS_RX_TRAN_(ERROR_STATE);
+                }
+            }
+            break;
+        }
+        case (uint8_t)WAIT4_BATCH_PAR: {  /* event parameters */
+            *l_rx.var.evt.p = b;
+            ++l_rx.var.evt.p;
+            --l_rx.var.evt.len;
+            if (l_rx.var.evt.len == 0U) {
+                QS_rxBatchNext_();
+            }
+            break;
+        }
+        case (uint8_t)WAIT4_BATCH_FRAME: {
+            /* keep ignoring the data until a frame is collected */
+            break;
+        }
 
 #ifdef Q_UTEST
         case (uint8_t)WAIT4_TEST_SETUP_FRAME: {
@@ -1150,6 +1272,174 @@ static void QS_rxParseData_(uint8_t const b) {
     }
 }
 
+/*..........................................................................*/
+/* index of the first QS_FRAME or QS_ESC byte in p[0..n-1], or n if none */
+static QSCtr QS_rxScan_(uint8_t const * const p, QSCtr const n) {
+    QSCtr i = 0U;
+    while ((i < n) && (p[i] != QS_FRAME) && (p[i] != QS_ESC)) {
+        ++i;
+    }
+    return i;
+}
+
+/*..........................................................................*/
+/* parse a whole frame of n bytes (with checksum) without any escapes */
+static void QS_rxParseFrame_(uint8_t const * const p, QSCtr const n) {
+    uint8_t chksum = 0U;
+    for (QSCtr i = 0U; i < n; ++i) {
+        chksum += p[i];
+    }
+    if (chksum != QS_GOOD_CHKSUM) { /* bad checksum? */
+        /* nothing of the frame has been parsed yet */
+        QS_rxReportError_(0x41);
+        QS_rxHandleBadFrame_((uint8_t)WAIT4_SEQ);
+        return;
+    }
+
+    QSCtr i = 0U;
+    while (i < n) {
+        if ((l_rx.state == (uint8_t)WAIT4_EVT_PAR)
+            || (l_rx.state == (uint8_t)WAIT4_BATCH_PAR))
+        { /* copy the event parameters */
+            QSCtr k = n - i;
+            if (k > (QSCtr)l_rx.var.evt.len) {
+                k = (QSCtr)l_rx.var.evt.len;
+            }
+            for (QSCtr j = 0U; j < k; ++j) {
+                l_rx.var.evt.p[j] = p[i + j];
+            }
+            l_rx.var.evt.p   = &l_rx.var.evt.p[k];
+            l_rx.var.evt.len -= (uint16_t)k;
+            i += k;
+            if (l_rx.var.evt.len == 0U) {
+                if (l_rx.state == (uint8_t)WAIT4_EVT_PAR) {
+                    QS_RX_TRAN_(WAIT4_EVT_FRAME);
+                }
+                else {
+                    QS_rxBatchNext_();
+                }
+            }
+        }
+        else {
+            QS_rxParseData_(p[i]);
+            ++i;
+        }
+    }
+
+    uint8_t const state = l_rx.state;
+    QS_RX_TRAN_(WAIT4_SEQ); /* get ready for the next frame */
+    QS_rxHandleGoodFrame_(state);
+}
+
+/*..........................................................................*/
+/* post/publish/dispatch an injected event, returns the status: 0x80 bit set
+* for failure, 0x01 bit set when the event needs to be recycled (done here)
+*/
+static uint8_t QS_rxInjectEvt_(QEvt * const e, uint8_t const prio) {
+    uint8_t i = 0U; /* status, 0 == success,no-recycle */
+
+#ifdef Q_UTEST
+    QS_onTestEvt(e); /* adjust the event, if needed */
+#endif /* Q_UTEST */
+
+    if (prio == 0U) { /* publish */
+        QActive_publish_(e, &QS_rxPriv_, 0U);
+    }
+    else if (prio < QF_MAX_ACTIVE) {
+        if (!QACTIVE_POST_X(QActive_registry_[prio],
+                            e,
+                            0U, /* margin */
+                            &QS_rxPriv_))
+        {
+            /* failed QACTIVE_POST() recycles the event */
+            i = 0x80U; /* failure status, no recycle */
+        }
+    }
+    else if (prio == 255U) { /* special prio */
+        /* dispatch to the current SM object */
+        if (QS_rxPriv_.currObj[SM_OBJ] != (void *)0) {
+            /* increment the ref-ctr to simulate the situation
+            * when the event is just retreived from a queue.
+            * This is expected for the following QF_gc() call.
+            */
+            ++e->refCtr_;
+
+            QHSM_DISPATCH((QHsm *)QS_rxPriv_.currObj[SM_OBJ], e, 0U);
+            i = 0x01U;  /* success status, recycle needed */
+        }
+        else {
+            i = 0x81U;  /* failure status, recycle needed */
+        }
+    }
+    else if (prio == 254U) { /* special prio */
+        /* init the current SM object" */
+        if (QS_rxPriv_.currObj[SM_OBJ] != (void *)0) {
+            /* increment the ref-ctr to simulate the situation
+            * when the event is just retreived from a queue.
+            * This is expected for the following QF_gc() call.
+            */
+            ++e->refCtr_;
+
+            QHSM_INIT((QHsm *)QS_rxPriv_.currObj[SM_OBJ], e, 0U);
+            i = 0x01U;  /* success status, recycle needed */
+        }
+        else {
+            i = 0x81U;  /* failure status, recycle needed */
+        }
+    }
+    else if (prio == 253U) { /* special prio */
+        /* post to the current AO */
+        if (QS_rxPriv_.currObj[AO_OBJ] != (void *)0) {
+            if (!QACTIVE_POST_X(
+                    (QActive *)QS_rxPriv_.currObj[AO_OBJ],
+                    e,
+                    0U, /* margin */
+                    &QS_rxPriv_))
+            {
+                /* failed QACTIVE_POST() recycles the event */
+                i = 0x80U;  /* failure status, no recycle */
+            }
+        }
+        else {
+            i = 0x81U;  /* failure status, recycle needed */
+        }
+    }
+    else {
+        i = 0x81U;  /* failure status, recycle needed */
+    }
+
+#if (QF_MAX_EPOOL > 0U)
+    if ((i & 0x01U) != 0U) { /* recycle needed? */
+        QF_gc(e);
+    }
+#endif
+    return i;
+}
+
+/*..........................................................................*/
+/* receive the next event of the batch or wait for the end of the frame */
+static void QS_rxBatchNext_(void) {
+    if (l_rx.var.evt.n < l_rx.var.evt.num) {
+        l_rx.var.evt.sig = 0U;
+        l_rx.var.evt.idx = 0U;
+        QS_RX_TRAN_(WAIT4_BATCH_SIG);
+    }
+    else {
+        QS_RX_TRAN_(WAIT4_BATCH_FRAME);
+    }
+}
+
+/*..........................................................................*/
+/* recycle the events of an incomplete or corrupted batch */
+static void QS_rxBatchGc_(void) {
+#if (QF_MAX_EPOOL > 0U)
+    for (uint_fast16_t k = 0U; k < l_rx.var.evt.n; ++k) {
+        QF_gc(l_batch[k]);
+    }
+#endif
+    l_rx.var.evt.n = 0U;
+}
+
 /*..........................................................................*/
 static void QS_rxHandleBadFrame_(uint8_t const state) {
     QS_rxReportError_(0x50); /* report error for all bad frames */
@@ -1161,6 +1451,13 @@ static void QS_rxHandleBadFrame_(uint8_t const state) {
 #endif
             break;
         }
+        case WAIT4_BATCH_SIG:  /* intentionally fall-through */
+        case WAIT4_BATCH_LEN:  /* intentionally fall-through */
+        case WAIT4_BATCH_PAR:  /* intentionally fall-through */
+        case WAIT4_BATCH_FRAME: {
+            QS_rxBatchGc_(); /* don't leak the allocated events */
+            break;
+        }
         default: {
             /* intentionally empty */
             break;
@@ -247,8 +247,9 @@ void QTimeEvt_tick1_(
 
     QTimeEvt *prev = &QTimeEvt_timeEvtHead_[tickRate];
 
+    ++prev->ctr; /* count the ticks, see QActive_deferTTL() */
+
     QS_BEGIN_NOCRIT_PRE_(QS_QF_TICK, 0U)
-        ++prev->ctr;
         QS_TEC_PRE_(prev->ctr); /* tick ctr */
         QS_U8_PRE_(tickRate);   /* tick rate */
     QS_END_NOCRIT_PRE_()
@@ -147,7 +147,8 @@ int_t QF_run(void) {
             * 3. determine if event is garbage and collect it if so
             */
             QEvt const * const e = QActive_get_(a);
-            QHSM_DISPATCH(&a->super, e, a->prio);
+            QS_REPLAY_REC(e, a->prio); /* record the event for replay */
+            QF_RTC_DISPATCH_(a, e, a->prio);
     #if (QF_MAX_EPOOL > 0U)
             QF_gc(e);
     #endif
@@ -221,3 +222,18 @@ void QActive_start_(QActive * const me,
     QS_FLUSH(); /* flush the trace buffer to the host */
 }
 /*$enddef${QV::QActive} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+
+#ifdef QF_AO_TELEM
+/*..........................................................................*/
+/*! @private @memberof QActive */
+void QActive_getPortTelem_(QActive const * const me,
+    QActiveTelem * const telem)
+{
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+    telem->queueSize = (uint16_t)(me->eQueue.end + 1U);
+    telem->queueMax  = (uint16_t)(me->eQueue.end + 1U - me->eQueue.nMin);
+    QF_CRIT_X_();
+    /* all AOs share the single stack of the QV kernel (no stack data) */
+}
+#endif /* QF_AO_TELEM */
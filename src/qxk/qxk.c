@@ -147,6 +147,7 @@ void QF_init(void) {
     QF_bzero(&QActive_registry_[0],     sizeof(QActive_registry_));
     QF_bzero(&QF_readySet_,             sizeof(QF_readySet_));
     QF_bzero(&QXK_attr_,                sizeof(QXK_attr_));
+    QF_bzero(&QXK_deadlines_[0],        sizeof(QXK_deadlines_));
 
     /* setup the QXK scheduler as initially locked and not running */
     QXK_attr_.lockCeil = (QF_MAX_ACTIVE + 1U); /* scheduler locked */
@@ -250,6 +251,21 @@ void QActive_start_(QActive * const me,
     QF_CRIT_X_();
 }
 /*$enddef${QXK::QActive} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+
+#ifdef QF_AO_TELEM
+/*..........................................................................*/
+/*! @private @memberof QActive */
+void QActive_getPortTelem_(QActive const * const me,
+    QActiveTelem * const telem)
+{
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+    telem->queueSize = (uint16_t)(me->eQueue.end + 1U);
+    telem->queueMax  = (uint16_t)(me->eQueue.end + 1U - me->eQueue.nMin);
+    QF_CRIT_X_();
+    /* the basic threads (AOs) share the stack of the QXK kernel (no stack data) */
+}
+#endif /* QF_AO_TELEM */
 /*$define${QXK::QXK-extern-C} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 
 /*${QXK::QXK-extern-C::attr_} ..............................................*/
@@ -344,7 +360,8 @@ void QXK_activate_(void) {
         * 3. determine if event is garbage and collect it if so
         */
         QEvt const * const e = QActive_get_(next);
-        QHSM_DISPATCH(&next->super, e, next->prio);
+        QS_REPLAY_REC(e, next->prio); /* record the event for replay */
+        QF_RTC_DISPATCH_(next, e, next->prio);
     #if (QF_MAX_EPOOL > 0U)
         QF_gc(e);
     #endif
@@ -463,6 +480,65 @@ void QXK_contextSw(QActive * const next) {
 /*==========================================================================*/
 /*$define${QXK-impl} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
 
+/*${QXK-impl::QXK_deadlines_[QF_MAX_TICK_RATE]} ............................*/
+/*! @static @private @memberof QXK */
+QXK_Deadlines QXK_deadlines_[QF_MAX_TICK_RATE];
+
+/*${QXK-impl::QXK_tickDeadlines_} ..........................................*/
+/*! @static @private @memberof QXK */
+void QXK_tickDeadlines_(uint_fast8_t const tickRate) {
+    Q_REQUIRE_ID(950, tickRate < QF_MAX_TICK_RATE);
+
+    QXK_Deadlines * const dl = &QXK_deadlines_[tickRate];
+
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+
+    ++dl->now; /* count the ticks */
+
+    /* might any deadline have been reached? */
+    if (QPSet_notEmpty(&dl->waitSet)
+        && ((int32_t)(dl->now - dl->next) >= 0))
+    {
+        QPSet waiting = dl->waitSet; /* copy of the set to iterate over */
+        bool expired = false;
+        bool first = true;
+        do {
+            uint_fast8_t const p = QPSet_findMax(&waiting);
+            QPSet_remove(&waiting, p);
+
+            QXThread * const thr =
+                QXK_PTR_CAST_(QXThread*, QActive_registry_[p]);
+
+            /* the thread must be registered and blocked */
+            Q_ASSERT_CRIT_(960, (thr != (QXThread *)0)
+                && (thr->super.super.temp.obj != (QMState *)0));
+
+            if ((int32_t)(dl->now - thr->deadline) >= 0) { /* reached? */
+                QPSet_remove(&dl->waitSet, p);
+
+                /* the signal of 0 means that the timeout has expired */
+                thr->timeEvt.super.sig = 0U;
+                QPSet_insert(&QF_readySet_, p);
+                expired = true;
+            }
+            else if (first || ((int32_t)(thr->deadline - dl->next) < 0)) {
+                dl->next = thr->deadline; /* the new earliest deadline */
+                first = false;
+            }
+        } while (QPSet_notEmpty(&waiting));
+
+        /* make all the expired threads ready in a single scheduling */
+        if (expired
+            && (!QXK_ISR_CONTEXT_()) /* not inside ISR? */
+            && (QActive_registry_[0] != (QActive *)0)) /* kernel started? */
+        {
+            (void)QXK_sched_(); /* schedule other threads */
+        }
+    }
+    QF_CRIT_X_();
+}
+
 /*${QXK-impl::QXK_threadExit_} .............................................*/
 /*! @private @memberof QXThread */
 void QXK_threadExit_(void) {
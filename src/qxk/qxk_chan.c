@@ -0,0 +1,341 @@
+/*$file${src::qxk::qxk_chan.c} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+/*
+* Model: qpc.qm
+* File:  ${src::qxk::qxk_chan.c}
+*
+* This code has been generated by QM 5.2.5 <www.state-machine.com/qm>.
+* DO NOT EDIT THIS FILE MANUALLY. All your changes will be lost.
+*
+* This code is covered by the following QP license:
+* License #    : LicenseRef-QL-dual
+* Issued to    : Any user of the QP/C real-time embedded framework
+* Framework(s) : qpc
+* Support ends : 2023-12-31
+* License scope:
+*
+* Copyright (C) 2005 Quantum Leaps, LLC <state-machine.com>.
+*
+* SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+*
+* This software is dual-licensed under the terms of the open source GNU
+* General Public License version 3 (or any later version), or alternatively,
+* under the terms of one of the closed source Quantum Leaps commercial
+* licenses.
+*
+* The terms of the open source GNU General Public License version 3
+* can be found at: <www.gnu.org/licenses/gpl-3.0>
+*
+* The terms of the closed source Quantum Leaps commercial licenses
+* can be found at: <www.state-machine.com/licensing>
+*
+* Redistributions in source code must retain this top-level comment block.
+* Plagiarizing this software to sidestep the license obligations is illegal.
+*
+* Contact information:
+* <www.state-machine.com/licensing>
+* <info@state-machine.com>
+*/
+/*$endhead${src::qxk::qxk_chan.c} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+/*! @file
+* @brief ::QXChannel class definition.
+*/
+#define QP_IMPL           /* this is QP implementation */
+#include "qf_port.h"      /* QF port */
+#include "qf_pkg.h"       /* QF package-scope internal interface */
+#include "qassert.h"      /* QP embedded systems-friendly assertions */
+#ifdef Q_SPY              /* QS software tracing enabled? */
+    #include "qs_port.h"  /* QS port */
+    #include "qs_pkg.h"   /* QS facilities for pre-defined trace records */
+#else
+    #include "qs_dummy.h" /* disable the QS software tracing */
+#endif /* Q_SPY */
+
+/* protection against including this source file in a wrong project */
+#ifndef QXK_H_
+    #error "Source file included in a project NOT based on the QXK kernel"
+#endif /* QXK_H_ */
+
+Q_DEFINE_THIS_MODULE("qxk_chan")
+
+/* states of the QXChannel slots */
+enum {
+    QXCHANNEL_FREE,     /* the slot can be reserved */
+    QXCHANNEL_RESERVED, /* the slot is reserved by a producer */
+    QXCHANNEL_FULL,     /* the slot is committed and can be received */
+    QXCHANNEL_BORROWED  /* the slot is received by a consumer */
+};
+
+/*==========================================================================*/
+/*$skip${QP_VERSION} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+/* Check for the minimum required QP version */
+#if (QP_VERSION < 700U) || (QP_VERSION != ((QP_RELEASE^4294967295U) % 0x3E8U))
+#error qpc version 7.0.0 or higher required
+#endif
+/*$endskip${QP_VERSION} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+
+/*$define${QXK::QXChannel} vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv*/
+
+/*${QXK::QXChannel} ........................................................*/
+
+/*${QXK::QXChannel::init} ..................................................*/
+/*! @public @memberof QXChannel */
+void QXChannel_init(QXChannel * const me,
+    void * const sto,
+    uint_fast16_t const slotSize,
+    uint_fast8_t const nSlots)
+{
+    Q_REQUIRE_ID(100, (sto != (void *)0)
+        && (slotSize > 0U)
+        && (nSlots > 0U)
+        && (nSlots <= QXCHANNEL_MAX_SLOTS));
+
+    QPSet_setEmpty(&me->sendSet);
+    QPSet_setEmpty(&me->recvSet);
+    me->sto      = (uint8_t *)sto;
+    me->slotSize = (uint16_t)slotSize;
+    me->nSlots   = (uint8_t)nSlots;
+    me->head     = 0U;
+    me->tail     = 0U;
+    for (uint_fast8_t i = 0U; i < nSlots; ++i) {
+        me->state[i] = (uint8_t)QXCHANNEL_FREE;
+    }
+}
+
+/*${QXK::QXChannel::reserve} ...............................................*/
+/*! @public @memberof QXChannel */
+void * QXChannel_reserve(QXChannel * const me,
+    uint_fast16_t const size,
+    uint_fast16_t const nTicks)
+{
+    return QXChannel_wait_(me, true, size, nTicks);
+}
+
+/*${QXK::QXChannel::tryReserve} ............................................*/
+/*! @public @memberof QXChannel */
+void * QXChannel_tryReserve(QXChannel * const me,
+    uint_fast16_t const size)
+{
+    return QXChannel_tryTake_(me, true, size);
+}
+
+/*${QXK::QXChannel::commit} ................................................*/
+/*! @public @memberof QXChannel */
+void QXChannel_commit(QXChannel * const me,
+    void * const slot)
+{
+    QXChannel_give_(me, true, slot);
+}
+
+/*${QXK::QXChannel::receive} ...............................................*/
+/*! @public @memberof QXChannel */
+void const * QXChannel_receive(QXChannel * const me,
+    uint_fast16_t const size,
+    uint_fast16_t const nTicks)
+{
+    return QXChannel_wait_(me, false, size, nTicks);
+}
+
+/*${QXK::QXChannel::tryReceive} ............................................*/
+/*! @public @memberof QXChannel */
+void const * QXChannel_tryReceive(QXChannel * const me,
+    uint_fast16_t const size)
+{
+    return QXChannel_tryTake_(me, false, size);
+}
+
+/*${QXK::QXChannel::release} ...............................................*/
+/*! @public @memberof QXChannel */
+void QXChannel_release(QXChannel * const me,
+    void const * const slot)
+{
+    QXChannel_give_(me, false, slot);
+}
+
+/*${QXK::QXChannel::wakeOne_} ..............................................*/
+/*! @private @memberof QXChannel */
+void QXChannel_wakeOne_(QXChannel const * const me,
+    QPSet * const waitSet)
+{
+    uint_fast8_t const p = QPSet_findMax(waitSet);
+    QXThread * const thr = QXK_PTR_CAST_(QXThread*, QActive_registry_[p]);
+
+    /* the thread must be registered, extended and blocked on this channel */
+    Q_ASSERT_ID(810, (thr != (QXThread *)0)
+        && (thr->super.osObject != (struct QActive *)0)
+        && (thr->super.super.temp.obj == QXK_PTR_CAST_(QMState*, me)));
+
+    (void)QXThread_teDisarm_(thr); /* disarm the blocking timeout */
+
+    /* make the thread ready to run and remove from the wait-set */
+    QPSet_insert(&QF_readySet_, p);
+    QPSet_remove(waitSet, p);
+}
+
+/*${QXK::QXChannel::take_} .................................................*/
+/*! @private @memberof QXChannel */
+uint8_t * QXChannel_take_(QXChannel * const me,
+    bool const isSend,
+    bool * const woken)
+{
+    uint8_t * const idx = isSend ? &me->head : &me->tail;
+    uint8_t const avail = isSend ? (uint8_t)QXCHANNEL_FREE
+                                 : (uint8_t)QXCHANNEL_FULL;
+    QPSet * const waitSet = isSend ? &me->sendSet : &me->recvSet;
+
+    uint8_t *slot = (uint8_t *)0;
+    if (me->state[*idx] == avail) {
+        me->state[*idx] = isSend ? (uint8_t)QXCHANNEL_RESERVED
+                                 : (uint8_t)QXCHANNEL_BORROWED;
+        slot = &me->sto[(uint_fast16_t)*idx * me->slotSize];
+        ++(*idx);
+        if (*idx == me->nSlots) {
+            *idx = 0U; /* wrap around */
+        }
+
+        /* is the following slot available to another waiting thread? */
+        if ((me->state[*idx] == avail) && QPSet_notEmpty(waitSet)) {
+            QXChannel_wakeOne_(me, waitSet);
+            *woken = true;
+        }
+    }
+    return slot;
+}
+
+/*${QXK::QXChannel::wait_} .................................................*/
+/*! @private @memberof QXChannel */
+uint8_t * QXChannel_wait_(QXChannel * const me,
+    bool const isSend,
+    uint_fast16_t const size,
+    uint_fast16_t const nTicks)
+{
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+
+    QXThread * const curr = QXK_PTR_CAST_(QXThread*, QXK_attr_.curr);
+
+    Q_REQUIRE_ID(200, (!QXK_ISR_CONTEXT_()) /* can't wait inside an ISR */
+        && (me->nSlots > 0U) /* channel must be initialized */
+        && (size <= me->slotSize) /* message must fit the slot */
+        && (curr != (QXThread *)0) /* curr must be extended */
+        && (curr->super.super.temp.obj == (QMState *)0)); /* NOT blocked */
+    Q_REQUIRE_ID(201, QXK_attr_.lockHolder != curr->super.prio);
+
+    QPSet * const waitSet = isSend ? &me->sendSet : &me->recvSet;
+    uint_fast8_t const p = (uint_fast8_t)curr->super.prio;
+    uint_fast8_t const tickRate
+        = ((uint_fast8_t)curr->timeEvt.super.refCtr_ & QTE_TICK_RATE);
+    uint_fast16_t ticks = nTicks;
+    bool woken = false;
+    uint8_t *slot = QXChannel_take_(me, isSend, &woken);
+    bool waiting = (slot == (uint8_t *)0);
+    while (waiting) {
+        /* remove the curr prio from the ready set (will block)
+        * and insert to the waiting set on this channel
+        */
+        QPSet_remove(&QF_readySet_, p);
+        QPSet_insert(waitSet, p);
+
+        /* remember the blocking object (this channel) */
+        curr->super.super.temp.obj = QXK_PTR_CAST_(QMState*, me);
+        QXThread_teArm_(curr, (enum_t)QXK_TIMEOUT_SIG, ticks);
+
+        (void)QXK_sched_(); /* schedule other threads */
+        QF_CRIT_X_();
+        QF_CRIT_EXIT_NOP(); /* BLOCK here !!! */
+
+        QF_CRIT_E_();   /* AFTER unblocking... */
+        /* the blocking object must be this channel */
+        Q_ASSERT_ID(240, curr->super.super.temp.obj
+                         == QXK_PTR_CAST_(QMState*, me));
+        curr->super.super.temp.obj = (QMState *)0; /* clear blocking obj. */
+
+        slot = QXChannel_take_(me, isSend, &woken);
+
+        /* did the blocking time-out? (signal of zero means that it did) */
+        if (curr->timeEvt.super.sig == 0U) {
+            QPSet_remove(waitSet, p); /* might be still waiting */
+            waiting = false;
+        }
+        else if (slot != (uint8_t *)0) {
+            waiting = false;
+        }
+        /* the slot was taken by another thread in the meantime... */
+        else if (ticks != QXTHREAD_NO_TIMEOUT) {
+            /* ...so wait again for the rest of the timeout */
+            int32_t const rest = (int32_t)(curr->deadline
+                                     - QXK_deadlines_[tickRate].now);
+            if (rest > 0) {
+                ticks = (uint_fast16_t)rest;
+            }
+            else {
+                waiting = false;
+            }
+        }
+    }
+
+    if (woken) {
+        (void)QXK_sched_(); /* schedule other threads */
+    }
+    QF_CRIT_X_();
+
+    return slot;
+}
+
+/*${QXK::QXChannel::tryTake_} ..............................................*/
+/*! @private @memberof QXChannel */
+uint8_t * QXChannel_tryTake_(QXChannel * const me,
+    bool const isSend,
+    uint_fast16_t const size)
+{
+    Q_REQUIRE_ID(300, (me->nSlots > 0U) /* channel must be initialized */
+        && (size <= me->slotSize)); /* message must fit the slot */
+
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+
+    bool woken = false;
+    uint8_t * const slot = QXChannel_take_(me, isSend, &woken);
+    if (woken && (!QXK_ISR_CONTEXT_())) { /* not inside ISR? */
+        (void)QXK_sched_(); /* schedule other threads */
+    }
+    QF_CRIT_X_();
+
+    return slot;
+}
+
+/*${QXK::QXChannel::give_} .................................................*/
+/*! @private @memberof QXChannel */
+void QXChannel_give_(QXChannel * const me,
+    bool const isSend,
+    void const * const slot)
+{
+    uint_fast16_t const offset = (uint_fast16_t)
+        ((uint8_t const *)slot - (uint8_t const *)me->sto);
+    uint_fast8_t const i = (uint_fast8_t)(offset / me->slotSize);
+
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
+
+    /*! @pre the slot must be taken from this channel */
+    Q_REQUIRE_CRIT_(400, ((uint8_t const *)slot >= me->sto)
+        && (i < me->nSlots)
+        && ((offset % me->slotSize) == 0U)
+        && (me->state[i] == (isSend ? (uint8_t)QXCHANNEL_RESERVED
+                                    : (uint8_t)QXCHANNEL_BORROWED)));
+
+    /* committed slot becomes full, released slot becomes free */
+    me->state[i] = isSend ? (uint8_t)QXCHANNEL_FULL
+                          : (uint8_t)QXCHANNEL_FREE;
+
+    /* the threads waiting on the other side of the channel */
+    uint8_t const idx = isSend ? me->tail : me->head;
+    QPSet * const waitSet = isSend ? &me->recvSet : &me->sendSet;
+    if ((me->state[idx] == me->state[i]) && QPSet_notEmpty(waitSet)) {
+        QXChannel_wakeOne_(me, waitSet);
+        if (!QXK_ISR_CONTEXT_()) { /* not inside ISR? */
+            (void)QXK_sched_(); /* schedule other threads */
+        }
+    }
+    QF_CRIT_X_();
+}
+/*$enddef${QXK::QXChannel} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
@@ -206,18 +206,30 @@ bool QXSemaphore_tryWait(QXSemaphore * const me) {
 bool QXSemaphore_signal(QXSemaphore * const me) {
     Q_REQUIRE_ID(400, me->max_count > 0U);
 
-    QF_CRIT_STAT_
-    QF_CRIT_E_();
+    return QXSemaphore_signalN(me, 1U) != 0U;
+}
 
-    bool signaled = true; /* assume that the semaphore will be signaled */
-    if (me->count < me->max_count) {
+/*${QXK::QXSemaphore::signalN} .............................................*/
+/*! @public @memberof QXSemaphore */
+uint_fast8_t QXSemaphore_signalN(QXSemaphore * const me,
+    uint_fast8_t const n)
+{
+    Q_REQUIRE_ID(500, me->max_count > 0U);
 
-        ++me->count; /* increment the semaphore count */
+    QF_CRIT_STAT_
+    QF_CRIT_E_();
 
     #ifdef Q_SPY
-        QActive const * const curr = QXK_PTR_CAST_(QActive*, QXK_attr_.curr);
+    QActive const * const curr = QXK_PTR_CAST_(QActive*, QXK_attr_.curr);
     #endif /* Q_SPY */
 
+    uint_fast8_t nSignaled = 0U;
+    bool woken = false;
+    while ((nSignaled < n) && (me->count < me->max_count)) {
+
+        ++me->count; /* increment the semaphore count */
+        ++nSignaled;
+
         QS_BEGIN_NOCRIT_PRE_(QS_SEM_SIGNAL, curr->prio)
             QS_TIME_PRE_();  /* timestamp */
             QS_OBJ_PRE_(me); /* this semaphore */
@@ -241,12 +253,13 @@ bool QXSemaphore_signal(QXSemaphore * const me) {
                 && (thr->super.super.temp.obj
                     == QXK_PTR_CAST_(QMState*, me)));
 
-            /* disarm the internal time event */
+            /* disarm the blocking timeout */
             (void)QXThread_teDisarm_(thr);
 
             /* make the thread ready to run and remove from the wait-list */
             QPSet_insert(&QF_readySet_, p);
             QPSet_remove(&me->waitSet,  p);
+            woken = true;
 
             QS_BEGIN_NOCRIT_PRE_(QS_SEM_TAKE, thr->super.prio)
                 QS_TIME_PRE_();  /* timestamp */
@@ -254,17 +267,15 @@ bool QXSemaphore_signal(QXSemaphore * const me) {
                 QS_2U8_PRE_(thr->super.prio,
                             me->count);
             QS_END_NOCRIT_PRE_()
-
-            if (!QXK_ISR_CONTEXT_()) { /* not inside ISR? */
-                (void)QXK_sched_(); /* schedule other threads */
-            }
         }
     }
-    else {
-        signaled = false; /* semaphore NOT signaled */
+
+    /* schedule all the woken threads at once */
+    if (woken && (!QXK_ISR_CONTEXT_())) { /* not inside ISR? */
+        (void)QXK_sched_(); /* schedule other threads */
     }
     QF_CRIT_X_();
 
-    return signaled;
+    return nSignaled;
 }
 /*$enddef${QXK::QXSemaphore} ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
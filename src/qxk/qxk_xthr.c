@@ -324,23 +324,9 @@ bool QXThread_post_(
     QF_CRIT_STAT_
     QS_TEST_PROBE_DEF(&QXThread_post_)
 
-    /* is it the private time event? */
     bool status;
-    if (e == &QXTHREAD_CAST_(me)->timeEvt.super) {
-        QF_CRIT_E_();
-        /* the private time event is disarmed and not in any queue,
-        * so it is safe to change its signal. The signal of 0 means
-        * that the time event has expired.
-        */
-        QXTHREAD_CAST_(me)->timeEvt.super.sig = 0U;
-
-        QXThread_unblock_(QXTHREAD_CAST_(me));
-        QF_CRIT_X_();
-
-        status = true;
-    }
     /* is the event queue provided? */
-    else if (me->eQueue.end != 0U) {
+    if (me->eQueue.end != 0U) {
         QEQueueCtr nFree;
 
         /*! @pre event pointer must be valid */
@@ -490,51 +476,48 @@ void QXThread_teArm_(QXThread * const me,
     enum_t const sig,
     uint_fast16_t const nTicks)
 {
-    Q_REQUIRE_ID(700, me->timeEvt.ctr == 0U);
+    uint_fast8_t const tickRate
+        = ((uint_fast8_t)me->timeEvt.super.refCtr_ & QTE_TICK_RATE);
+    uint_fast8_t const p = (uint_fast8_t)me->super.prio;
+
+    Q_REQUIRE_ID(700, (tickRate < QF_MAX_TICK_RATE)
+        && (!QPSet_hasElement(&QXK_deadlines_[tickRate].waitSet, p)));
 
     me->timeEvt.super.sig = (QSignal)sig;
 
     if (nTicks != QXTHREAD_NO_TIMEOUT) {
-        me->timeEvt.ctr = (QTimeEvtCtr)nTicks;
-        me->timeEvt.interval = 0U;
+        QXK_Deadlines * const dl = &QXK_deadlines_[tickRate];
 
-        /* is the time event unlinked?
-        * NOTE: For the duration of a single clock tick of the specified tick
-        * rate a time event can be disarmed and yet still linked in the list,
-        * because un-linking is performed exclusively in QTimeEvt_tick_().
+        /* the deadline is reached in the nTicks-th QTimeEvt_tick_() */
+        me->deadline = dl->now + (uint32_t)nTicks;
+
+        /* is this the earliest armed deadline?
+        * NOTE: the comparison tolerates the wrap-around of the tick counter
         */
-        if ((me->timeEvt.super.refCtr_ & QTE_IS_LINKED) == 0U) {
-            uint_fast8_t const tickRate
-                 = ((uint_fast8_t)me->timeEvt.super.refCtr_ & QTE_TICK_RATE);
-            Q_ASSERT_ID(710, tickRate < QF_MAX_TICK_RATE);
-
-            me->timeEvt.super.refCtr_ |= QTE_IS_LINKED;
-
-            /* The time event is initially inserted into the separate
-            * "freshly armed" list based on QTimeEvt_timeEvtHead_[tickRate].act.
-            * Only later, inside the QTimeEvt_tick_() function, the "freshly
-            * armed" list is appended to the main list of armed time events
-            * based on QTimeEvt_timeEvtHead_[tickRate].next. Again, this is
-            * to keep any changes to the main list exclusively inside
-            * QTimeEvt_tick_().
-            */
-            me->timeEvt.next
-                = QXK_PTR_CAST_(QTimeEvt*, QTimeEvt_timeEvtHead_[tickRate].act);
-            QTimeEvt_timeEvtHead_[tickRate].act = &me->timeEvt;
+        if (QPSet_isEmpty(&dl->waitSet)
+            || ((int32_t)(me->deadline - dl->next) < 0))
+        {
+            dl->next = me->deadline;
         }
+        QPSet_insert(&dl->waitSet, p);
     }
 }
 
 /*${QXK::QXThread::teDisarm_} ..............................................*/
 /*! @private @memberof QXThread */
 bool QXThread_teDisarm_(QXThread * const me) {
+    uint_fast8_t const tickRate
+        = ((uint_fast8_t)me->timeEvt.super.refCtr_ & QTE_TICK_RATE);
+    uint_fast8_t const p = (uint_fast8_t)me->super.prio;
+
     bool wasArmed;
-    /* is the time evt running? */
-    if (me->timeEvt.ctr != 0U) {
+    /* is the deadline armed? */
+    if (QPSet_hasElement(&QXK_deadlines_[tickRate].waitSet, p)) {
         wasArmed = true;
-        me->timeEvt.ctr = 0U; /* schedule removal from list */
+        /* the earliest deadline QXK_deadlines_[].next is left as is */
+        QPSet_remove(&QXK_deadlines_[tickRate].waitSet, p);
     }
-    /* the time event was already automatically disarmed */
+    /* the deadline has already expired */
     else {
         wasArmed = false;
     }
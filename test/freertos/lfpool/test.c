@@ -0,0 +1,219 @@
+#define _POSIX_C_SOURCE 200809L /* for sigaction() and setitimer() */
+
+#include "et.h"       /* Embedded Test (ET) */
+
+/* includes for the CUT... */
+#include "qep_port.h" /* QEP port */
+#include "qmpool.h"   /* QF memory pool (for the pool data types) */
+#include "qlfpool.h"  /* lock-free memory pool */
+#include "qassert.h"  /* QP embedded systems-friendly assertions */
+
+#include <pthread.h>
+#include <signal.h>
+#include <sys/time.h>
+
+/* The concurrency tests use the POSIX emulation of the FreeRTOS contexts:
+* the pthreads play the role of tasks running truly in parallel (which is
+* more demanding than a single core), and a periodic timer signal plays the
+* role of an ISR preempting the main thread at random points, also in the
+* middle of QLfPool_get() and QLfPool_put(), like the "interrupts" in the
+* FreeRTOS POSIX port.
+*
+* Every allocated block is claimed by writing the owner ID into it with
+* CAS, so a block handed out twice (e.g., due to the ABA problem) is
+* detected as an error.
+*/
+typedef struct {
+    void *link_;    /* space for the free-list link */
+    uint32_t owner; /* 0 when free */
+    uint32_t seq;
+} Blk;
+
+enum {
+    N_BLOCKS  = 8,
+    N_THREADS = 4,
+    N_ITER    = 200000,
+    N_ISR     = 20000,
+    ISR_OWNER = 1000
+};
+
+static Blk l_sto[N_BLOCKS];
+static QLfPool l_pool;
+
+static uint32_t volatile l_errors;
+static uint32_t volatile l_nIsr;
+static Blk *l_isrHeld; /* block held by the "ISR" between interrupts */
+
+/* get a block and claim it for the owner */
+static Blk *getClaim(uint32_t const owner, uint_fast16_t const margin) {
+    Blk * const b = (Blk *)QLfPool_get(&l_pool, margin, 0U);
+    if (b != (Blk *)0) {
+        uint32_t exp = 0U;
+        if (!__atomic_compare_exchange_n(&b->owner, &exp, owner, false,
+                 __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+        {
+            __atomic_fetch_add(&l_errors, 1U, __ATOMIC_RELAXED);
+        }
+        ++b->seq;
+    }
+    return b;
+}
+
+/* check that the block is still owned by the owner and put it back */
+static void checkPut(Blk * const b, uint32_t const owner) {
+    if (b != (Blk *)0) {
+        if (__atomic_load_n(&b->owner, __ATOMIC_ACQUIRE) != owner) {
+            __atomic_fetch_add(&l_errors, 1U, __ATOMIC_RELAXED);
+        }
+        __atomic_store_n(&b->owner, 0U, __ATOMIC_RELEASE);
+        QLfPool_put(&l_pool, b, 0U);
+    }
+}
+
+/* get two blocks, recycle the block held since the previous step and the
+* first new block, and keep the second one until the next step (like an
+* event posted to an active object and recycled later). This leaves the
+* first block on top, but with a different link, which is the pattern
+* breaking an untagged Treiber stack (ABA problem).
+*/
+static void step(Blk ** const held, uint32_t const owner,
+                 uint_fast16_t const margin)
+{
+    Blk * const a = getClaim(owner, margin);
+    Blk * const b = getClaim(owner, margin);
+    checkPut(*held, owner);
+    checkPut(a, owner);
+    *held = b;
+}
+
+static void *task_thread(void *arg) {
+    uint32_t const owner = (uint32_t)(uintptr_t)arg;
+    Blk *held = (Blk *)0;
+    for (uint32_t i = 0U; i < N_ITER; ++i) {
+        step(&held, owner, 0U);
+    }
+    checkPut(held, owner);
+    return (void *)0;
+}
+
+static void isr_handler(int sig) {
+    (void)sig;
+    step(&l_isrHeld, ISR_OWNER, 1U); /* with a margin */
+    __atomic_fetch_add(&l_nIsr, 1U, __ATOMIC_RELAXED);
+}
+
+/* all blocks can be obtained exactly once */
+static bool drainAll(void) {
+    bool ok = true;
+    void *b[N_BLOCKS];
+    for (uint_fast8_t i = 0U; i < N_BLOCKS; ++i) {
+        b[i] = QLfPool_get(&l_pool, 0U, 0U);
+        ok = ok && (b[i] != (void *)0);
+        for (uint_fast8_t j = 0U; ok && (j < i); ++j) {
+            ok = (b[j] != b[i]);
+        }
+    }
+    return ok && (QLfPool_get(&l_pool, 0U, 0U) == (void *)0);
+}
+
+void setup(void) {
+    QLfPool_init(&l_pool, l_sto, sizeof(l_sto), sizeof(Blk));
+    l_errors  = 0U;
+    l_nIsr    = 0U;
+    l_isrHeld = (Blk *)0;
+}
+
+void teardown(void) {
+}
+
+/* test group --------------------------------------------------------------*/
+TEST_GROUP("QLfPool") {
+
+TEST("init chains all blocks") {
+    VERIFY(l_pool.blockSize == sizeof(Blk));
+    VERIFY(l_pool.nTot == N_BLOCKS);
+    VERIFY(l_pool.nFree == N_BLOCKS);
+    VERIFY(l_pool.end == &l_sto[N_BLOCKS - 1]);
+    VERIFY(drainAll());
+    VERIFY((l_pool.nFree == 0U) && (l_pool.nMin == 0U));
+}
+
+TEST("get honors the margin and put recycles in LIFO order") {
+    void * const a = QLfPool_get(&l_pool, N_BLOCKS - 1U, 0U);
+    VERIFY(a == &l_sto[0]);
+    VERIFY((void *)0 == QLfPool_get(&l_pool, N_BLOCKS - 1U, 0U));
+    void * const b = QLfPool_get(&l_pool, 0U, 0U);
+    VERIFY(b == &l_sto[1]);
+    VERIFY(l_pool.nMin == N_BLOCKS - 2U);
+    QLfPool_put(&l_pool, a, 0U);
+    QLfPool_put(&l_pool, b, 0U);
+    VERIFY(l_pool.nFree == N_BLOCKS);
+    VERIFY(b == QLfPool_get(&l_pool, 0U, 0U));
+    VERIFY(a == QLfPool_get(&l_pool, 0U, 0U));
+    VERIFY(l_pool.nMin == N_BLOCKS - 2U);
+}
+
+TEST("concurrent tasks never share a block") {
+    pthread_t thr[N_THREADS];
+    for (uintptr_t i = 0U; i < N_THREADS; ++i) {
+        VERIFY(0 == pthread_create(&thr[i], (pthread_attr_t *)0,
+                                   &task_thread, (void *)(i + 1U)));
+    }
+    for (uint_fast8_t i = 0U; i < N_THREADS; ++i) {
+        pthread_join(thr[i], (void **)0);
+    }
+    VERIFY(l_errors == 0U);
+    VERIFY(l_pool.nFree == N_BLOCKS);
+    VERIFY(drainAll());
+}
+
+TEST("ISRs preempting get/put never share a block") {
+    struct sigaction sa;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags   = 0;
+    sa.sa_handler = &isr_handler;
+    sigaction(SIGALRM, &sa, (struct sigaction *)0);
+
+    /* start the periodic "interrupt" */
+    struct itimerval tim;
+    tim.it_interval.tv_sec  = 0;
+    tim.it_interval.tv_usec = 20;
+    tim.it_value = tim.it_interval;
+    setitimer(ITIMER_REAL, &tim, (struct itimerval *)0);
+
+    Blk *held = (Blk *)0;
+    while (l_nIsr < N_ISR) {
+        step(&held, 1U, 0U);
+    }
+
+    /* stop the periodic "interrupt" */
+    tim.it_value.tv_usec = 0;
+    setitimer(ITIMER_REAL, &tim, (struct itimerval *)0);
+    sa.sa_handler = SIG_DFL;
+    sigaction(SIGALRM, &sa, (struct sigaction *)0);
+
+    checkPut(held, 1U);
+    checkPut(l_isrHeld, ISR_OWNER);
+    VERIFY(l_errors == 0U);
+    VERIFY(l_pool.nFree == N_BLOCKS);
+    VERIFY(drainAll());
+}
+
+TEST("put of a block from outside of the pool (expected assertion)") {
+    static Blk other;
+    (void)QLfPool_get(&l_pool, 0U, 0U);
+    ET_expect_assert("qf_lfpool", 300);
+    QLfPool_put(&l_pool, &other, 0U);
+}
+
+} /* TEST_GROUP() */
+
+/* =========================================================================*/
+/* dependencies for the CUT ... */
+
+/*..........................................................................*/
+Q_NORETURN Q_onAssert(char const * const module, int_t const location) {
+    VERIFY_ASSERT(module, location);
+    for (;;) { /* explicitly make it "noreturn" */
+    }
+}
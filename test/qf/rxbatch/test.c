@@ -0,0 +1,347 @@
+#include "et.h"       /* Embedded Test (ET) */
+
+/* includes for the CUT... */
+#define QP_IMPL       /* the test stands in for the QF port */
+#include "qf_port.h"
+#include "qassert.h"  /* QP embedded systems-friendly assertions */
+#include "qs_port.h"  /* QS/C port */
+#include "qs_pkg.h"   /* QS package-scope interface (QS-RX records) */
+
+Q_DEFINE_THIS_MODULE("test")
+
+/* The test sends QS_RX_EVENT_BATCH records the way QSPY does, to an active
+* object (prio 1) running on the real QF event pools and event queues.
+* The events of a batch are pre-allocated from the event pool while the
+* record arrives and are posted back-to-back when the frame is complete.
+* The test then dispatches the queued events to the AO and checks that
+* every event returns to the pool.
+*/
+enum {
+    AO_PRIO  = 1U,
+    POOL_LEN = 6U,  /* number of the event-pool blocks */
+    BATCH_SIG = Q_USER_SIG
+};
+
+typedef struct {
+    QEvt super;
+    uint8_t par[4];
+} TstEvt;
+
+typedef struct {
+    QActive super;
+    QSignal sig[16];  /* signals of the dispatched events */
+    uint8_t par[16];  /* 1st parameter byte of the dispatched events */
+    uint_fast8_t n;
+} Tst;
+
+static QState Tst_initial(Tst * const me, void const * const par);
+static QState Tst_active(Tst * const me, QEvt const * const e);
+
+static Tst l_tst;
+static QEvt const *l_tstQSto[3];      /* AO queue holds 3+1 events */
+static QF_MPOOL_EL(TstEvt) l_pool[POOL_LEN];
+
+static uint8_t qsBuf[2048];    /* buffer for QS-TX channel */
+static uint8_t qsRxBuf[256];   /* buffer for QS-RX channel */
+
+static uint8_t  l_seq;         /* sequence number of the last frame sent */
+static uint16_t l_status[8];   /* QS-RX status: error/ack code or 0x100|done */
+static uint_fast8_t l_nStatus;
+
+/* frame encoding ..........................................................*/
+static uint16_t putByte(uint8_t * const buf, uint16_t n, uint8_t const b) {
+    if ((b == QS_FRAME) || (b == QS_ESC)) {
+        buf[n] = QS_ESC;
+        ++n;
+        buf[n] = (uint8_t)(b ^ QS_ESC_XOR);
+    }
+    else {
+        buf[n] = b;
+    }
+    return (uint16_t)(n + 1U);
+}
+static uint16_t putU16(uint8_t * const buf, uint16_t n, uint16_t const x) {
+    buf[n] = (uint8_t)x;
+    buf[n + 1U] = (uint8_t)(x >> 8U);
+    return (uint16_t)(n + 2U);
+}
+/* encode the QS_RX_EVENT_BATCH record of 'num' events for the AO 'prio'
+* into 'buf' (without the closing QS_FRAME). Event k has the signal
+* BATCH_SIG + k and 'len' bytes of parameters starting with 'par' + k.
+*/
+static uint16_t batch(uint8_t * const buf, uint8_t const prio,
+                      uint16_t const num, uint16_t const len,
+                      uint8_t const par, bool const goodChksum)
+{
+    uint8_t data[128];
+    data[0] = prio;
+    uint16_t nd = putU16(data, 1U, num);
+    for (uint16_t k = 0U; k < num; ++k) {
+        nd = putU16(data, nd, (uint16_t)(BATCH_SIG + k)); /* Q_SIGNAL_SIZE 2 */
+        nd = putU16(data, nd, len);
+        for (uint16_t i = 0U; i < len; ++i) {
+            data[nd] = (uint8_t)(par + k + i);
+            ++nd;
+        }
+    }
+
+    ++l_seq;
+    uint8_t chksum = (uint8_t)(l_seq + (uint8_t)QS_RX_EVENT_BATCH);
+    uint16_t n = putByte(buf, 0U, l_seq);
+    n = putByte(buf, n, (uint8_t)QS_RX_EVENT_BATCH);
+    for (uint16_t i = 0U; i < nd; ++i) {
+        chksum = (uint8_t)(chksum + data[i]);
+        n = putByte(buf, n, data[i]);
+    }
+    chksum = (uint8_t)(QS_GOOD_CHKSUM - chksum);
+    if (!goodChksum) {
+        ++chksum;
+    }
+    return putByte(buf, n, chksum);
+}
+
+/* decode the QS-RX status records from the QS-TX buffer ...................*/
+static void rxStatus(void) {
+    uint8_t rec[32];
+    uint_fast8_t n = 0U;
+    bool esc = false;
+    for (uint16_t b = QS_getByte(); b != QS_EOD; b = QS_getByte()) {
+        if (b == QS_FRAME) { /* end of a record [seq|rec|data...|chksum]? */
+            if ((n >= 4U) && (rec[1] == (uint8_t)QS_RX_STATUS)) {
+                l_status[l_nStatus] = rec[2]; /* error or Ack */
+                ++l_nStatus;
+            }
+            else if ((n >= 3U + QS_TIME_SIZE + 1U)
+                     && (rec[1] == (uint8_t)QS_TARGET_DONE))
+            {
+                l_status[l_nStatus] = 0x100U | rec[2U + QS_TIME_SIZE];
+                ++l_nStatus;
+            }
+            else {
+                /* other records are ignored */
+            }
+            n = 0U;
+        }
+        else if (b == QS_ESC) {
+            esc = true;
+        }
+        else if (n < sizeof(rec)) {
+            rec[n] = esc ? (uint8_t)(b ^ QS_ESC_XOR) : (uint8_t)b;
+            esc = false;
+            ++n;
+        }
+        else {
+            /* record too long for the test */
+        }
+    }
+}
+/* feed 'n' bytes to QS-RX, parse them and collect the status */
+static void feed(uint8_t const * const buf, uint16_t const n) {
+    VERIFY(QS_rxPutBuf(buf, n) == n);
+    QS_rxParse();
+    rxStatus();
+}
+static void feedEnd(void) {
+    static uint8_t const frame = QS_FRAME;
+    feed(&frame, 1U);
+}
+/* dispatch all events queued to the AO, return the number dispatched */
+static uint_fast8_t run(void) {
+    uint_fast8_t n = 0U;
+    while (l_tst.super.eQueue.frontEvt != (QEvt *)0) {
+        QEvt const * const e = QActive_get_(&l_tst.super);
+        QHSM_DISPATCH(&l_tst.super.super, e, l_tst.super.prio);
+        QF_gc(e);
+        ++n;
+    }
+    return n;
+}
+static uint_fast16_t poolFree(void) {
+    return (uint_fast16_t)QF_ePool_[0].nFree;
+}
+
+void setup(void) {
+    QS_initBuf(qsBuf, sizeof(qsBuf));
+    QS_rxInitBuf(qsRxBuf, sizeof(qsRxBuf));
+
+    QF_maxPool_ = 0U;
+    QF_poolInit(l_pool, sizeof(l_pool), sizeof(l_pool[0]));
+
+    QActive_ctor(&l_tst.super, Q_STATE_CAST(&Tst_initial));
+    QActive_start_(&l_tst.super, AO_PRIO,
+                   l_tstQSto, Q_DIM(l_tstQSto),
+                   (void *)0, 0U, (void *)0);
+    l_tst.n = 0U;
+
+    while (QS_getByte() != QS_EOD) { /* discard the dictionary */
+    }
+    l_seq = 0U;
+    l_nStatus = 0U;
+}
+
+void teardown(void) {
+    QActive_unregister_(&l_tst.super);
+}
+
+/* test group --------------------------------------------------------------*/
+TEST_GROUP("QS-RX event batch") {
+
+TEST("batch is pre-allocated and posted back-to-back") {
+    uint8_t buf[128];
+    feed(buf, batch(buf, AO_PRIO, 4U, 2U, 0x20U, true));
+
+    /* the events are allocated while the record arrives... */
+    VERIFY(poolFree() == POOL_LEN - 4U);
+    VERIFY(l_tst.super.eQueue.frontEvt == (QEvt *)0); /* not posted yet */
+    VERIFY(l_nStatus == 1U);
+    VERIFY(l_status[0] == (uint16_t)QS_RX_EVENT_BATCH); /* Ack */
+
+    /* ...and are posted when the frame is complete */
+    feedEnd();
+    VERIFY(l_nStatus == 2U);
+    VERIFY(l_status[1] == (0x100U | (uint16_t)QS_RX_EVENT_BATCH)); /* Done */
+    VERIFY(QEQueue_getNFree(&l_tst.super.eQueue) == 0U);
+
+    VERIFY(run() == 4U);
+    for (uint_fast8_t k = 0U; k < 4U; ++k) {
+        VERIFY(l_tst.sig[k] == BATCH_SIG + k);
+        VERIFY(l_tst.par[k] == 0x20U + k);
+    }
+    VERIFY(poolFree() == POOL_LEN);
+}
+
+TEST("batch with escapes in the parameters") {
+    uint8_t buf[128];
+    feed(buf, batch(buf, AO_PRIO, 3U, 4U, 0x7BU, true));
+    feedEnd();
+    VERIFY(l_nStatus == 2U);
+    VERIFY(l_status[1] == (0x100U | (uint16_t)QS_RX_EVENT_BATCH));
+    VERIFY(run() == 3U);
+    VERIFY(l_tst.par[0] == 0x7BU);
+    VERIFY(l_tst.par[2] == 0x7DU);
+    VERIFY(poolFree() == POOL_LEN);
+}
+
+TEST("batch overflowing the AO queue recycles the rest") {
+    uint8_t buf[128];
+    feed(buf, batch(buf, AO_PRIO, 6U, 1U, 0x40U, true));
+    VERIFY(poolFree() == 0U);
+    feedEnd();
+    VERIFY(l_nStatus == 2U);
+    VERIFY(l_status[1] == (0x80U | (uint16_t)QS_RX_EVENT_BATCH));
+    VERIFY(run() == 4U); /* only what fit in the queue */
+    VERIFY(l_tst.sig[3] == BATCH_SIG + 3U);
+    VERIFY(poolFree() == POOL_LEN);
+}
+
+TEST("batch exceeding the event pool is rejected") {
+    uint8_t buf[128];
+    feed(buf, batch(buf, AO_PRIO, POOL_LEN + 1U, 1U, 0x40U, true));
+    feedEnd();
+    VERIFY(l_nStatus == 2U);
+    VERIFY(l_status[0] == (uint16_t)QS_RX_EVENT_BATCH); /* Ack */
+    VERIFY(l_status[1] == (0x80U | (uint16_t)QS_RX_EVENT_BATCH));
+    VERIFY(run() == 0U);
+    VERIFY(poolFree() == POOL_LEN);
+}
+
+TEST("batch with bad checksum recycles the pre-allocated events") {
+    uint8_t buf[128];
+    /* escapes force the byte-wise parser, which allocates as it goes */
+    feed(buf, batch(buf, AO_PRIO, 3U, 2U, 0x7DU, false));
+    VERIFY(poolFree() == POOL_LEN - 3U);
+    feedEnd();
+    VERIFY(l_status[l_nStatus - 1U] == (0x80U | 0x50U)); /* bad frame */
+    VERIFY(run() == 0U);
+    VERIFY(poolFree() == POOL_LEN);
+}
+
+TEST("truncated batch recycles the pre-allocated events") {
+    uint8_t buf[128];
+    uint16_t n = batch(buf, AO_PRIO, 3U, 2U, 0x20U, true);
+    /* cut the frame inside the parameters of the 3rd event,
+    * keeping the checksum of the whole frame valid
+    */
+    uint8_t chksum = 0U;
+    n = (uint16_t)(n - 3U);
+    for (uint16_t i = 0U; i < n; ++i) {
+        chksum = (uint8_t)(chksum + buf[i]);
+    }
+    buf[n] = (uint8_t)(QS_GOOD_CHKSUM - chksum);
+    feed(buf, (uint16_t)(n + 1U));
+    VERIFY(poolFree() == POOL_LEN - 3U);
+    feedEnd();
+    VERIFY(l_status[l_nStatus - 1U] == (0x80U | (uint16_t)QS_RX_EVENT_BATCH));
+    VERIFY(run() == 0U);
+    VERIFY(poolFree() == POOL_LEN);
+}
+
+} /* TEST_GROUP() */
+
+/* =========================================================================*/
+/* the AO under test ... */
+
+static QState Tst_initial(Tst * const me, void const * const par) {
+    (void)par;
+    return Q_TRAN(&Tst_active);
+}
+/*..........................................................................*/
+static QState Tst_active(Tst * const me, QEvt const * const e) {
+    QState status_;
+    if (e->sig >= BATCH_SIG) {
+        me->sig[me->n] = e->sig;
+        me->par[me->n] = Q_EVT_CAST(TstEvt)->par[0];
+        ++me->n;
+        status_ = Q_HANDLED();
+    }
+    else {
+        status_ = Q_SUPER(&QHsm_top);
+    }
+    return status_;
+}
+
+/* =========================================================================*/
+/* dependencies for the CUT ... */
+
+/*..........................................................................*/
+void QActive_start_(QActive * const me, QPrioSpec const prioSpec,
+    QEvt const * * const qSto, uint_fast16_t const qLen,
+    void * const stkSto, uint_fast16_t const stkSize,
+    void const * const par)
+{
+    (void)stkSto;
+    (void)stkSize;
+    me->prio = (uint8_t)(prioSpec & 0xFFU);
+    QActive_register_(me);
+    QEQueue_init(&me->eQueue, qSto, qLen);
+    QHSM_INIT(&me->super, par, me->prio);
+}
+/*..........................................................................*/
+Q_NORETURN Q_onAssert(char const * const module, int_t const location) {
+    ET_fail("Q_onAssert", module, location);
+    for (;;) { /* explicitly make it "noreturn" */
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+void QS_onCleanup(void) {
+}
+/*..........................................................................*/
+void QS_onReset(void) {
+}
+/*..........................................................................*/
+void QS_onFlush(void) {
+}
+/*..........................................................................*/
+QSTimeCtr QS_onGetTime(void) {
+    return (QSTimeCtr)0U;
+}
+/*..........................................................................*/
+void QS_onCommand(uint8_t cmdId, uint32_t param1,
+    uint32_t param2, uint32_t param3)
+{
+    (void)cmdId;
+    (void)param1;
+    (void)param2;
+    (void)param3;
+}
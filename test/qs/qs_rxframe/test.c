@@ -0,0 +1,435 @@
+#include "et.h"       /* Embedded Test (ET) */
+
+/* includes for the CUT... */
+#define QP_IMPL       /* the test stands in for the QF implementation */
+#include "qf_port.h"
+#include "qassert.h"  /* QP embedded systems-friendly assertions */
+#include "qs_port.h"  /* QS/C port */
+#include "qs_pkg.h"   /* QS package-scope interface (QS-RX records) */
+
+/* The test encodes QS-RX frames the way QSPY does and feeds them through
+* QS_rxPutBuf() and QS_rxParse(), both the unescaped frames (parsed whole by
+* QS_rxParseFrame_()) and the frames with escapes (parsed byte by byte).
+* The QS-RX status records are decoded from the QS-TX buffer. The events
+* of QS_RX_EVENT_BATCH are published (prio 0) to the QActive_publish_()
+* stub below, which records and recycles them.
+*/
+enum {
+    RX_SIZE  = 64,  /* QS-RX buffer size */
+    EVT_SIZE = 16,  /* size of the stub event-pool blocks */
+    EVT_NUM  = 8    /* number of the stub event-pool blocks */
+};
+
+static uint8_t qsBuf[256];       /* buffer for QS-TX channel */
+static uint8_t qsRxBuf[RX_SIZE]; /* buffer for QS-RX channel */
+
+static uint8_t  l_seq;        /* sequence number of the last frame sent */
+static uint16_t l_status[16]; /* QS-RX status: error/ack code or 0x100|done */
+static uint_fast8_t l_nStatus;
+
+static struct {
+    uint8_t  id;
+    uint32_t par[3];
+} l_cmd;                      /* the last command */
+static uint_fast8_t l_nCmd;
+
+static QEvt *l_pool[EVT_NUM]; /* stub event-pool blocks in use */
+static union {
+    QEvt    e;
+    uint8_t raw[EVT_SIZE];
+} l_blk[EVT_NUM];
+static uint_fast8_t l_nLive;  /* number of the live stub events */
+static uint_fast8_t l_nNewFail; /* number of allocations to fail */
+
+static QSignal  l_pubSig[EVT_NUM]; /* signals of the published events */
+static uint8_t  l_pubPar[EVT_NUM]; /* 1st parameter byte of the events */
+static uint_fast8_t l_nPub;
+
+/* frame encoding ..........................................................*/
+static uint16_t putByte(uint8_t * const buf, uint16_t n, uint8_t const b) {
+    if ((b == QS_FRAME) || (b == QS_ESC)) {
+        buf[n] = QS_ESC;
+        ++n;
+        buf[n] = (uint8_t)(b ^ QS_ESC_XOR);
+    }
+    else {
+        buf[n] = b;
+    }
+    return (uint16_t)(n + 1U);
+}
+/* encode the QS-RX record 'rec' with 'len' bytes of data into 'buf' */
+static uint16_t frame(uint8_t * const buf, uint8_t const rec,
+                      uint8_t const * const data, uint16_t const len,
+                      bool const goodChksum)
+{
+    ++l_seq;
+    uint8_t chksum = (uint8_t)(l_seq + rec);
+    uint16_t n = putByte(buf, 0U, l_seq);
+    n = putByte(buf, n, rec);
+    for (uint16_t i = 0U; i < len; ++i) {
+        chksum = (uint8_t)(chksum + data[i]);
+        n = putByte(buf, n, data[i]);
+    }
+    chksum = (uint8_t)(QS_GOOD_CHKSUM - chksum);
+    if (!goodChksum) {
+        ++chksum;
+    }
+    n = putByte(buf, n, chksum);
+    buf[n] = QS_FRAME;
+    return (uint16_t)(n + 1U);
+}
+static uint16_t putU16(uint8_t * const buf, uint16_t n, uint16_t const x) {
+    buf[n] = (uint8_t)x;
+    buf[n + 1U] = (uint8_t)(x >> 8U);
+    return (uint16_t)(n + 2U);
+}
+static uint16_t putU32(uint8_t * const buf, uint16_t n, uint32_t const x) {
+    n = putU16(buf, n, (uint16_t)x);
+    return putU16(buf, n, (uint16_t)(x >> 16U));
+}
+static uint16_t command(uint8_t * const buf, uint8_t const id,
+                        uint32_t const p1, uint32_t const p2,
+                        uint32_t const p3, bool const goodChksum)
+{
+    uint8_t data[13];
+    data[0] = id;
+    uint16_t n = putU32(data, 1U, p1);
+    n = putU32(data, n, p2);
+    n = putU32(data, n, p3);
+    return frame(buf, (uint8_t)QS_RX_COMMAND, data, n, goodChksum);
+}
+/* QS_RX_EVENT_BATCH data of 'num' events with the signals 'sig0'...,
+* each with 'len' bytes of parameters 'par'..., but only 'nEvt' events
+* actually encoded (truncated batch when nEvt < num)
+*/
+static uint16_t batch(uint8_t * const data, uint16_t const num,
+                      uint16_t const nEvt, QSignal const sig0,
+                      uint16_t const len, uint8_t const par)
+{
+    data[0] = 0U; /* prio 0: publish */
+    uint16_t n = putU16(data, 1U, num);
+    for (uint16_t k = 0U; k < nEvt; ++k) {
+        n = putU16(data, n, (uint16_t)(sig0 + k)); /* Q_SIGNAL_SIZE == 2 */
+        n = putU16(data, n, len);
+        for (uint16_t i = 0U; i < len; ++i) {
+            data[n] = (uint8_t)(par + k + i);
+            ++n;
+        }
+    }
+    return n;
+}
+
+/* decode the QS-RX status records from the QS-TX buffer ...................*/
+static void rxStatus(void) {
+    uint8_t rec[32];
+    uint_fast8_t n = 0U;
+    bool esc = false;
+    for (uint16_t b = QS_getByte(); b != QS_EOD; b = QS_getByte()) {
+        if (b == QS_FRAME) { /* end of a record [seq|rec|data...|chksum]? */
+            if ((n >= 4U) && (rec[1] == (uint8_t)QS_RX_STATUS)) {
+                l_status[l_nStatus] = rec[2]; /* error or Ack */
+                ++l_nStatus;
+            }
+            else if ((n >= 3U + QS_TIME_SIZE + 1U)
+                     && (rec[1] == (uint8_t)QS_TARGET_DONE))
+            {
+                l_status[l_nStatus] = 0x100U | rec[2U + QS_TIME_SIZE];
+                ++l_nStatus;
+            }
+            else {
+                /* other records are ignored */
+            }
+            n = 0U;
+        }
+        else if (b == QS_ESC) {
+            esc = true;
+        }
+        else if (n < sizeof(rec)) {
+            rec[n] = esc ? (uint8_t)(b ^ QS_ESC_XOR) : (uint8_t)b;
+            esc = false;
+            ++n;
+        }
+        else {
+            /* record too long for the test */
+        }
+    }
+}
+/* feed 'n' bytes to QS-RX, parse them and collect the status */
+static void feed(uint8_t const * const buf, uint16_t const n) {
+    VERIFY(QS_rxPutBuf(buf, n) == n);
+    QS_rxParse();
+    rxStatus();
+}
+
+void setup(void) {
+    QS_initBuf(qsBuf, sizeof(qsBuf));
+    QS_rxInitBuf(qsRxBuf, RX_SIZE);
+    while (QS_getByte() != QS_EOD) { /* discard the dictionary */
+    }
+    l_seq = 0U;
+    l_nStatus = 0U;
+    l_nCmd = 0U;
+    l_nLive = 0U;
+    l_nNewFail = 0U;
+    l_nPub = 0U;
+    for (uint_fast8_t i = 0U; i < EVT_NUM; ++i) {
+        l_pool[i] = (QEvt *)0;
+    }
+}
+
+void teardown(void) {
+}
+
+/* test group --------------------------------------------------------------*/
+TEST_GROUP("QS-RX frames") {
+
+TEST("good unescaped frame (parsed whole)") {
+    uint8_t buf[40];
+    feed(buf, command(buf, 5U, 0x04030201U, 2U, 3U, true));
+    VERIFY(l_nCmd == 1U);
+    VERIFY(l_cmd.id == 5U);
+    VERIFY(l_cmd.par[0] == 0x04030201U);
+    VERIFY(l_cmd.par[1] == 2U);
+    VERIFY(l_cmd.par[2] == 3U);
+    VERIFY(l_nStatus == 2U);
+    VERIFY(l_status[0] == (uint16_t)QS_RX_COMMAND);          /* Ack */
+    VERIFY(l_status[1] == (0x100U | (uint16_t)QS_RX_COMMAND)); /* Done */
+}
+
+TEST("good frame with escapes (parsed byte by byte)") {
+    uint8_t buf[40];
+    feed(buf, command(buf, 7U, 0x7D7E7D7EU, 0x7EU, 0U, true));
+    VERIFY(l_nCmd == 1U);
+    VERIFY(l_cmd.id == 7U);
+    VERIFY(l_cmd.par[0] == 0x7D7E7D7EU);
+    VERIFY(l_cmd.par[1] == 0x7EU);
+    VERIFY(l_nStatus == 2U);
+    VERIFY(l_status[0] == (uint16_t)QS_RX_COMMAND);
+}
+
+TEST("bad checksum of an unescaped frame") {
+    uint8_t buf[40];
+    feed(buf, command(buf, 5U, 1U, 2U, 3U, false));
+    VERIFY(l_nCmd == 0U);
+    VERIFY(l_nStatus == 2U);
+    VERIFY(l_status[0] == (0x80U | 0x41U)); /* bad checksum */
+    VERIFY(l_status[1] == (0x80U | 0x50U)); /* bad frame */
+
+    /* the next good frame is parsed normally */
+    l_nStatus = 0U;
+    feed(buf, command(buf, 6U, 1U, 2U, 3U, true));
+    VERIFY(l_nCmd == 1U);
+    VERIFY(l_cmd.id == 6U);
+}
+
+TEST("bad checksum of a frame with escapes") {
+    uint8_t buf[40];
+    feed(buf, command(buf, 5U, 0x7EU, 2U, 3U, false));
+    VERIFY(l_nCmd == 0U);
+    VERIFY(l_nStatus == 2U);
+    VERIFY(l_status[0] == (0x80U | 0x41U));
+    VERIFY(l_status[1] == (0x80U | 0x50U));
+}
+
+TEST("frames wrapping around the end of the QS-RX buffer") {
+    uint8_t buf[40];
+    for (uint8_t i = 1U; i <= 8U; ++i) { /* 8 x 19 bytes wraps twice */
+        uint16_t const n = command(buf, i, i, 0x7E0000U * (i & 1U), i, true);
+        feed(buf, n);
+        VERIFY(l_nCmd == i);
+        VERIFY(l_cmd.id == i);
+        VERIFY(l_cmd.par[0] == i);
+        VERIFY(l_cmd.par[1] == 0x7E0000U * (i & 1U));
+        VERIFY(l_cmd.par[2] == i);
+    }
+    VERIFY(l_nStatus == 16U);
+}
+
+TEST("QS_rxPutBuf() stops when the QS-RX buffer is full") {
+    uint8_t buf[RX_SIZE + 8];
+    for (uint16_t i = 0U; i < sizeof(buf); ++i) {
+        buf[i] = (uint8_t)i;
+    }
+    VERIFY(QS_rxPutBuf(buf, 10U) == 10U);
+    VERIFY(QS_rxGetNfree() == RX_SIZE - 1 - 10);
+    VERIFY(QS_rxPutBuf(buf, sizeof(buf)) == RX_SIZE - 1 - 10);
+    VERIFY(QS_rxGetNfree() == 0U);
+    VERIFY(QS_rxPutBuf(buf, 1U) == 0U);
+}
+
+TEST("event batch posts all events with one Ack and one Done") {
+    uint8_t data[40];
+    uint8_t buf[80];
+    uint16_t const n = batch(data, 3U, 3U, 10U, 2U, 0x20U);
+    feed(buf, frame(buf, (uint8_t)QS_RX_EVENT_BATCH, data, n, true));
+    VERIFY(l_nPub == 3U);
+    for (uint_fast8_t k = 0U; k < 3U; ++k) {
+        VERIFY(l_pubSig[k] == 10U + k);
+        VERIFY(l_pubPar[k] == 0x20U + k);
+    }
+    VERIFY(l_nLive == 0U);
+    VERIFY(l_nStatus == 2U);
+    VERIFY(l_status[0] == (uint16_t)QS_RX_EVENT_BATCH);
+    VERIFY(l_status[1] == (0x100U | (uint16_t)QS_RX_EVENT_BATCH));
+}
+
+TEST("event batch with escapes in the parameters") {
+    uint8_t data[40];
+    uint8_t buf[80];
+    uint16_t const n = batch(data, 2U, 2U, 10U, 3U, 0x7CU);
+    feed(buf, frame(buf, (uint8_t)QS_RX_EVENT_BATCH, data, n, true));
+    VERIFY(l_nPub == 2U);
+    VERIFY(l_pubPar[0] == 0x7CU);
+    VERIFY(l_pubPar[1] == 0x7DU);
+    VERIFY(l_nLive == 0U);
+}
+
+TEST("truncated event batch recycles the allocated events") {
+    uint8_t data[40];
+    uint8_t buf[80];
+    uint16_t n = batch(data, 3U, 2U, 10U, 2U, 0x20U); /* 2 of 3 events */
+    feed(buf, frame(buf, (uint8_t)QS_RX_EVENT_BATCH, data, n, true));
+    VERIFY(l_nPub == 0U);
+    VERIFY(l_nLive == 0U);
+    VERIFY(l_nStatus == 2U);
+    VERIFY(l_status[0] == (uint16_t)QS_RX_EVENT_BATCH); /* Ack */
+    VERIFY(l_status[1] == (0x80U | (uint16_t)QS_RX_EVENT_BATCH));
+
+    /* truncated inside the parameters of the 2nd event */
+    l_nStatus = 0U;
+    n = batch(data, 2U, 2U, 10U, 4U, 0x20U);
+    feed(buf, frame(buf, (uint8_t)QS_RX_EVENT_BATCH, data,
+                    (uint16_t)(n - 2U), true));
+    VERIFY(l_nPub == 0U);
+    VERIFY(l_nLive == 0U);
+    VERIFY(l_status[l_nStatus - 1U]
+           == (0x80U | (uint16_t)QS_RX_EVENT_BATCH));
+}
+
+TEST("event batch with bad checksum recycles the allocated events") {
+    uint8_t data[40];
+    uint8_t buf[80];
+    /* escapes: the events are allocated before the checksum is known */
+    uint16_t n = batch(data, 2U, 2U, 10U, 2U, 0x7EU);
+    feed(buf, frame(buf, (uint8_t)QS_RX_EVENT_BATCH, data, n, false));
+    VERIFY(l_nPub == 0U);
+    VERIFY(l_nLive == 0U);
+    VERIFY(l_status[l_nStatus - 1U] == (0x80U | 0x50U));
+
+    /* no escapes: nothing is allocated for a bad frame */
+    l_nStatus = 0U;
+    n = batch(data, 2U, 2U, 10U, 2U, 0x20U);
+    feed(buf, frame(buf, (uint8_t)QS_RX_EVENT_BATCH, data, n, false));
+    VERIFY(l_nPub == 0U);
+    VERIFY(l_nLive == 0U);
+    VERIFY(l_nStatus == 2U);
+    VERIFY(l_status[0] == (0x80U | 0x41U));
+}
+
+TEST("event batch with a failed allocation") {
+    uint8_t data[40];
+    uint8_t buf[80];
+    uint16_t const n = batch(data, 3U, 3U, 10U, 2U, 0x20U);
+    l_nNewFail = 1U; /* the pool runs out at the 3rd event */
+    l_nLive = EVT_NUM - 2U;
+    feed(buf, frame(buf, (uint8_t)QS_RX_EVENT_BATCH, data, n, true));
+    VERIFY(l_nPub == 0U);
+    VERIFY(l_nLive == EVT_NUM - 2U);
+    VERIFY(l_status[l_nStatus - 1U]
+           == (0x80U | (uint16_t)QS_RX_EVENT_BATCH));
+}
+
+} /* TEST_GROUP() */
+
+/* =========================================================================*/
+/* dependencies for the CUT ... */
+
+uint_fast8_t volatile QF_intLock_;
+QF_EPOOL_TYPE_ QF_ePool_[QF_MAX_EPOOL];
+QActive *QActive_registry_[QF_MAX_ACTIVE + 1U];
+
+/*..........................................................................*/
+uint_fast16_t QF_poolGetMaxBlockSize(void) {
+    return EVT_SIZE;
+}
+/*..........................................................................*/
+QEvt *QF_newX_(uint_fast16_t const evtSize,
+    uint_fast16_t const margin, enum_t const sig)
+{
+    (void)margin;
+    VERIFY(evtSize <= EVT_SIZE);
+    if ((l_nNewFail != 0U) && (l_nLive + l_nNewFail >= EVT_NUM)) {
+        return (QEvt *)0; /* the stub pool is exhausted */
+    }
+    for (uint_fast8_t i = 0U; i < EVT_NUM; ++i) {
+        if (l_pool[i] == (QEvt *)0) {
+            QEvt * const e = &l_blk[i].e;
+            e->sig     = (QSignal)sig;
+            e->poolId_ = 1U;
+            e->refCtr_ = 0U;
+            l_pool[i]  = e;
+            ++l_nLive;
+            return e;
+        }
+    }
+    return (QEvt *)0;
+}
+/*..........................................................................*/
+void QF_gc(QEvt const * const e) {
+    if (e->poolId_ != 0U) {
+        for (uint_fast8_t i = 0U; i < EVT_NUM; ++i) {
+            if (l_pool[i] == e) {
+                l_pool[i] = (QEvt *)0;
+                --l_nLive;
+                return;
+            }
+        }
+        FAIL("QF_gc() of an unknown event");
+    }
+}
+/*..........................................................................*/
+void QActive_publish_(QEvt const * const e,
+                      void const * const sender, uint_fast8_t const qs_id)
+{
+    (void)sender;
+    (void)qs_id;
+    l_pubSig[l_nPub] = e->sig;
+    l_pubPar[l_nPub] = ((uint8_t const *)e)[sizeof(QEvt)];
+    ++l_nPub;
+    QF_gc(e); /* no subscribers */
+}
+/*..........................................................................*/
+void QTimeEvt_tick_(uint_fast8_t const tickRate, void const * const sender) {
+    (void)tickRate;
+    (void)sender;
+}
+/*..........................................................................*/
+Q_NORETURN Q_onAssert(char const * const module, int_t const location) {
+    ET_fail("Q_onAssert", module, location);
+    for (;;) { /* explicitly make it "noreturn" */
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+void QS_onCleanup(void) {
+}
+/*..........................................................................*/
+void QS_onReset(void) {
+}
+/*..........................................................................*/
+void QS_onFlush(void) {
+}
+/*..........................................................................*/
+QSTimeCtr QS_onGetTime(void) {
+    return (QSTimeCtr)0U;
+}
+/*..........................................................................*/
+void QS_onCommand(uint8_t cmdId, uint32_t param1,
+    uint32_t param2, uint32_t param3)
+{
+    l_cmd.id = cmdId;
+    l_cmd.par[0] = param1;
+    l_cmd.par[1] = param2;
+    l_cmd.par[2] = param3;
+    ++l_nCmd;
+}
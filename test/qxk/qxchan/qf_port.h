@@ -0,0 +1,62 @@
+/*============================================================================
+* QP/C Real-Time Embedded Framework (RTEF)
+* Copyright (C) 2005 Quantum Leaps, LLC. All rights reserved.
+*
+* SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-QL-commercial
+*
+* This software is dual-licensed under the terms of the open source GNU
+* General Public License version 3 (or any later version), or alternatively,
+* under the terms of one of the closed source Quantum Leaps commercial
+* licenses.
+*
+* The terms of the open source GNU General Public License version 3
+* can be found at: <www.gnu.org/licenses/gpl-3.0>
+*
+* The terms of the closed source Quantum Leaps commercial licenses
+* can be found at: <www.state-machine.com/licensing>
+*
+* Redistributions in source code must retain this top-level comment block.
+* Plagiarizing this software to sidestep the license obligations is illegal.
+*
+* Contact information:
+* <www.state-machine.com>
+* <info@state-machine.com>
+============================================================================*/
+/*!
+* @date Last updated on: 2023-01-07
+* @version Last updated for: @ref qpc_7_2_0
+*
+* @file
+* @brief QF/C "port" for the QXK host test, GNU or VisualC++
+*/
+#ifndef QF_PORT_H
+#define QF_PORT_H
+
+/* The maximum number of active objects in the application */
+#define QF_MAX_ACTIVE        16U
+
+/* The number of system clock tick rates */
+#define QF_MAX_TICK_RATE     1U
+
+/* QF interrupt disable/enable */
+#define QF_INT_DISABLE()     (++QF_intLock_)
+#define QF_INT_ENABLE()      (--QF_intLock_)
+
+/* host-test critical section */
+/* QF_CRIT_STAT_TYPE not defined */
+#define QF_CRIT_ENTRY(dummy) QF_INT_DISABLE()
+#define QF_CRIT_EXIT(dummy)  QF_INT_ENABLE()
+
+/* QF_LOG2 not defined -- use the internal LOG2() implementation */
+
+/* no context switch on the host: the test supplies QXK_sched_() */
+#define QXK_CONTEXT_SWITCH_() ((void)0)
+
+#include "qep_port.h"  /* QEP port */
+#include "qxk.h"       /* QXK platform-independent public interface */
+
+#ifdef QP_IMPL
+    #include "qf_pkg.h" /* internal QF interface */
+#endif /* QP_IMPL */
+
+#endif /* QF_PORT_H */
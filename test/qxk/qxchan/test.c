@@ -0,0 +1,269 @@
+#include "et.h"       /* Embedded Test (ET) */
+
+/* includes for the CUT... */
+#define QP_IMPL       /* the test stands in for the QXK implementation */
+#include "qf_port.h"
+#include "qassert.h"  /* QP embedded systems-friendly assertions */
+#include "qs_dummy.h" /* QS/C dummy (inactive) interface */
+
+/* The blocking calls of QXChannel cannot really block on the host, so the
+* QXK_sched_() stub below plays the role of the other threads: when the
+* current thread has removed itself from the ready-set (is blocking), the
+* stub invokes the l_onBlock() callback of the test, which commits or
+* releases slots, or expires the timeout, before the "blocked" call
+* continues.
+*/
+typedef struct { uint32_t seq; int16_t x, y, z; } Sample;
+
+enum { N_SLOTS = 4 };
+
+static Sample l_sto[N_SLOTS];
+static QXChannel l_chan;
+
+static QXThread l_thr;        /* the "current" extended thread */
+static QXThread l_waiter[2];  /* other extended threads */
+static void (*l_onBlock)(void);
+static uint_fast16_t l_armed; /* last timeout passed to QXThread_teArm_() */
+static unsigned l_nBlock;     /* number of times l_thr blocked */
+
+static void thread_init(QXThread * const thr, uint8_t const prio) {
+    thr->super.prio = prio;
+    thr->super.osObject = &l_sto[0]; /* extended thread (non-NULL stack) */
+    thr->super.super.temp.obj = (QMState *)0;
+    thr->timeEvt.super.sig = 0U;
+    thr->timeEvt.super.refCtr_ = 0U; /* tick rate 0 */
+    QActive_registry_[prio] = &thr->super;
+    QPSet_insert(&QF_readySet_, prio);
+}
+
+void setup(void) {
+    QF_bzero(&QF_readySet_, sizeof(QF_readySet_));
+    QF_bzero(&QXK_deadlines_[0], sizeof(QXK_deadlines_));
+    thread_init(&l_thr, 3U);
+    thread_init(&l_waiter[0], 2U);
+    thread_init(&l_waiter[1], 5U);
+    QXK_attr_.curr = &l_thr.super;
+    QF_intNest_ = 0U;
+    l_onBlock = (void (*)(void))0;
+    l_armed = 0U;
+    l_nBlock = 0U;
+    QXCHANNEL_INIT(&l_chan, l_sto);
+}
+
+void teardown(void) {
+}
+
+/* "other threads" invoked while l_thr is blocked ..........................*/
+static void commitFromIsr(void) {
+    ++QF_intNest_;
+    Sample * const s = (Sample *)QXChannel_tryReserve(&l_chan, sizeof(Sample));
+    VERIFY(s != (Sample *)0);
+    s->seq = 42U;
+    QXChannel_commit(&l_chan, s);
+    --QF_intNest_;
+}
+static void timeout(void) {
+    /* what QXK_tickDeadlines_() does when the deadline is reached */
+    l_thr.timeEvt.super.sig = 0U;
+    QPSet_insert(&QF_readySet_, l_thr.super.prio);
+}
+static void commitAndSteal(void) {
+    if (l_nBlock == 1U) {
+        commitFromIsr(); /* wakes l_thr up... */
+        VERIFY(QPSet_hasElement(&QF_readySet_, l_thr.super.prio));
+
+        /* ...but a higher-priority thread takes the slot first */
+        QXK_deadlines_[0].now += 3U;
+        VERIFY(QXChannel_tryReceive(&l_chan, sizeof(Sample))
+               == &l_sto[0]);
+    }
+    else {
+        timeout();
+    }
+}
+
+/* test group --------------------------------------------------------------*/
+TEST_GROUP("QXChannel") {
+
+TEST("slots are passed in place and in FIFO order") {
+    for (uint32_t i = 0U; i < N_SLOTS; ++i) {
+        Sample * const s =
+            (Sample *)QXChannel_tryReserve(&l_chan, sizeof(Sample));
+        VERIFY(s == &l_sto[i]);
+        s->seq = i;
+        QXChannel_commit(&l_chan, s);
+    }
+    VERIFY((void *)0 == QXChannel_tryReserve(&l_chan, sizeof(Sample)));
+    for (uint32_t i = 0U; i < N_SLOTS; ++i) {
+        Sample const * const s =
+            (Sample const *)QXChannel_tryReceive(&l_chan, sizeof(Sample));
+        VERIFY((s == &l_sto[i]) && (s->seq == i));
+        QXChannel_release(&l_chan, s);
+    }
+    VERIFY((void const *)0 == QXChannel_tryReceive(&l_chan, sizeof(Sample)));
+}
+
+TEST("slots are received in the reservation order") {
+    void * const a = QXChannel_tryReserve(&l_chan, sizeof(Sample));
+    void * const b = QXChannel_tryReserve(&l_chan, sizeof(Sample));
+    QXChannel_commit(&l_chan, b);
+    VERIFY((void const *)0 == QXChannel_tryReceive(&l_chan, sizeof(Sample)));
+    QXChannel_commit(&l_chan, a);
+    VERIFY(a == QXChannel_tryReceive(&l_chan, sizeof(Sample)));
+    VERIFY(b == QXChannel_tryReceive(&l_chan, sizeof(Sample)));
+}
+
+TEST("a released slot is reused only in the ring order") {
+    void *s[N_SLOTS];
+    for (uint_fast8_t i = 0U; i < N_SLOTS; ++i) {
+        s[i] = QXChannel_tryReserve(&l_chan, sizeof(Sample));
+        QXChannel_commit(&l_chan, s[i]);
+        VERIFY(s[i] == QXChannel_tryReceive(&l_chan, sizeof(Sample)));
+    }
+    QXChannel_release(&l_chan, s[1]);
+    VERIFY((void *)0 == QXChannel_tryReserve(&l_chan, sizeof(Sample)));
+    QXChannel_release(&l_chan, s[0]);
+    VERIFY(s[0] == QXChannel_tryReserve(&l_chan, sizeof(Sample)));
+    VERIFY(s[1] == QXChannel_tryReserve(&l_chan, sizeof(Sample)));
+}
+
+TEST("blocking receive is woken up by a commit") {
+    l_onBlock = &commitFromIsr;
+    Sample const * const s = QXCHANNEL_RECEIVE(&l_chan, Sample, 10U);
+    VERIFY((s == &l_sto[0]) && (s->seq == 42U));
+    VERIFY(l_nBlock == 1U);
+    VERIFY(l_armed == 10U);
+    VERIFY(QPSet_isEmpty(&l_chan.recvSet));
+    VERIFY(l_thr.super.super.temp.obj == (QMState *)0);
+}
+
+TEST("blocking receive times out") {
+    l_onBlock = &timeout;
+    VERIFY((Sample const *)0 == QXCHANNEL_RECEIVE(&l_chan, Sample, 10U));
+    VERIFY(l_nBlock == 1U);
+    VERIFY(QPSet_isEmpty(&l_chan.recvSet));
+    VERIFY(l_thr.super.super.temp.obj == (QMState *)0);
+}
+
+TEST("blocking reserve times out on a full channel") {
+    for (uint_fast8_t i = 0U; i < N_SLOTS; ++i) {
+        VERIFY((void *)0 != QXChannel_tryReserve(&l_chan, sizeof(Sample)));
+    }
+    l_onBlock = &timeout;
+    VERIFY((Sample *)0 == QXCHANNEL_RESERVE(&l_chan, Sample, 5U));
+    VERIFY(QPSet_isEmpty(&l_chan.sendSet));
+}
+
+TEST("stolen slot makes the receiver wait for the rest of the timeout") {
+    l_onBlock = &commitAndSteal;
+    VERIFY((Sample const *)0 == QXCHANNEL_RECEIVE(&l_chan, Sample, 10U));
+    VERIFY(l_nBlock == 2U);
+    VERIFY(l_armed == 7U);
+    VERIFY(QPSet_isEmpty(&l_chan.recvSet));
+}
+
+TEST("commit wakes up only the highest-priority receiver") {
+    for (uint_fast8_t i = 0U; i < 2U; ++i) {
+        QPSet_remove(&QF_readySet_, l_waiter[i].super.prio);
+        QPSet_insert(&l_chan.recvSet, l_waiter[i].super.prio);
+        l_waiter[i].super.super.temp.obj = (QMState *)&l_chan;
+    }
+    commitFromIsr();
+    VERIFY(QPSet_hasElement(&QF_readySet_, 5U));
+    VERIFY(!QPSet_hasElement(&QF_readySet_, 2U));
+    VERIFY(QPSet_hasElement(&l_chan.recvSet, 2U));
+
+    commitFromIsr(); /* the second slot for the second receiver */
+    VERIFY(QPSet_hasElement(&QF_readySet_, 2U));
+    VERIFY(QPSet_isEmpty(&l_chan.recvSet));
+}
+
+TEST("receiver taking a slot passes the next committed slot on") {
+    for (uint_fast8_t i = 0U; i < 2U; ++i) {
+        QPSet_remove(&QF_readySet_, l_waiter[i].super.prio);
+        QPSet_insert(&l_chan.recvSet, l_waiter[i].super.prio);
+        l_waiter[i].super.super.temp.obj = (QMState *)&l_chan;
+    }
+    void * const a = QXChannel_tryReserve(&l_chan, sizeof(Sample));
+    void * const b = QXChannel_tryReserve(&l_chan, sizeof(Sample));
+    QXChannel_commit(&l_chan, b);
+    VERIFY(!QPSet_hasElement(&QF_readySet_, 5U)); /* b is not next */
+    QXChannel_commit(&l_chan, a);
+    VERIFY(QPSet_hasElement(&QF_readySet_, 5U));
+    VERIFY(!QPSet_hasElement(&QF_readySet_, 2U));
+
+    /* the woken receiver takes 'a' and wakes up the other one for 'b' */
+    QXK_attr_.curr = &l_waiter[1].super;
+    l_waiter[1].super.super.temp.obj = (QMState *)0;
+    VERIFY(a == QXChannel_tryReceive(&l_chan, sizeof(Sample)));
+    VERIFY(QPSet_hasElement(&QF_readySet_, 2U));
+    VERIFY(QPSet_isEmpty(&l_chan.recvSet));
+}
+
+TEST("message larger than the slot (expected assertion)") {
+    ET_expect_assert("qxk_chan", 300);
+    (void)QXChannel_tryReserve(&l_chan, sizeof(Sample) + 1U);
+}
+
+} /* TEST_GROUP() */
+
+/* =========================================================================*/
+/* dependencies for the CUT ... */
+
+uint_fast8_t volatile QF_intLock_;
+uint_fast8_t volatile QF_intNest_;
+QPSet QF_readySet_;
+QXK QXK_attr_;
+QXK_Deadlines QXK_deadlines_[QF_MAX_TICK_RATE];
+QActive *QActive_registry_[QF_MAX_ACTIVE + 1U];
+
+/*..........................................................................*/
+uint_fast8_t QXK_sched_(void) {
+    /* is the current thread blocking? */
+    if ((QXK_attr_.curr == &l_thr.super)
+        && (!QPSet_hasElement(&QF_readySet_, l_thr.super.prio)))
+    {
+        ++l_nBlock;
+        VERIFY(l_onBlock != (void (*)(void))0);
+        (*l_onBlock)();
+        /* the blocked thread must be ready to run again */
+        VERIFY(QPSet_hasElement(&QF_readySet_, l_thr.super.prio));
+    }
+    return 0U;
+}
+/*..........................................................................*/
+void QXThread_teArm_(QXThread * const me,
+    enum_t const sig,
+    uint_fast16_t const nTicks)
+{
+    me->timeEvt.super.sig = (QSignal)sig;
+    me->deadline = QXK_deadlines_[0].now + (uint32_t)nTicks;
+    l_armed = nTicks;
+}
+/*..........................................................................*/
+bool QXThread_teDisarm_(QXThread * const me) {
+    (void)me;
+    return true;
+}
+/*..........................................................................*/
+uint_fast8_t QF_LOG2(QPSetBits x) {
+    uint_fast8_t n = 0U;
+    for (; x != 0U; x >>= 1U) {
+        ++n;
+    }
+    return n;
+}
+/*..........................................................................*/
+void QF_bzero(void * const start, uint_fast16_t const len) {
+    uint8_t *ptr = (uint8_t *)start;
+    for (uint_fast16_t n = len; n > 0U; --n) {
+        *ptr = 0U;
+        ++ptr;
+    }
+}
+/*..........................................................................*/
+Q_NORETURN Q_onAssert(char const * const module, int_t const location) {
+    VERIFY_ASSERT(module, location);
+    for (;;) { /* explicitly make it "noreturn" */
+    }
+}